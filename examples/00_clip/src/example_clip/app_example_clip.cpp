@@ -6,6 +6,7 @@
 #include <eely_app/component_skeleton.h>
 #include <eely_app/component_transform.h>
 #include <eely_app/filesystem_utils.h>
+#include <eely_app/project_cache.h>
 #include <eely_app/scene.h>
 #include <eely_app/system_camera.h>
 #include <eely_app/system_render.h>
@@ -24,12 +25,13 @@
 
 #include <filesystem>
 #include <memory>
+#include <vector>
 
 namespace eely {
 constexpr bgfx::ViewId view_id{0};
 constexpr uint32_t view_clear_color{0x31363DFF};
 
-static std::unique_ptr<project> import_and_cook_resources()
+static std::vector<std::byte> import_and_cook_resources()
 {
   const std::filesystem::path fbx_path{get_executable_dir() / "res/sitting_clap.fbx"};
 
@@ -46,16 +48,15 @@ static std::unique_ptr<project> import_and_cook_resources()
 
   // Convert into runtime project
 
-  static constexpr size_t buffer_size_bytes{gsl::narrow<size_t>(1024 * 256)};
-  std::array<std::byte, buffer_size_bytes> buffer;
-  project::cook(project_uncooked, buffer);
-  return std::make_unique<project>(buffer);
+  return project::cook(project_uncooked);
 }
 
 app_example_clip::app_example_clip(const unsigned int width,
                                    const unsigned int height,
                                    const std::string& title)
-    : app(width, height, title), _project{import_and_cook_resources()}, _scene(*this)
+    : app(width, height, title),
+      _project{project_load_cached(&import_and_cook_resources)},
+      _scene(*this)
 {
   _scene.add_system(&system_skeleton_update);
   _scene.add_system(&system_camera_update);
@@ -6,6 +6,7 @@
 #include <eely_app/component_skeleton.h>
 #include <eely_app/component_transform.h>
 #include <eely_app/filesystem_utils.h>
+#include <eely_app/project_cache.h>
 #include <eely_app/scene.h>
 #include <eely_app/system_camera.h>
 #include <eely_app/system_render.h>
@@ -39,6 +40,7 @@
 
 #include <filesystem>
 #include <memory>
+#include <vector>
 
 namespace eely {
 constexpr bgfx::ViewId view_id{0};
@@ -52,7 +54,7 @@ static constexpr float param_speed_walk{1.0F};
 static constexpr float param_speed_jog{2.0F};
 static constexpr float param_speed_run{3.0F};
 
-static std::unique_ptr<project> import_and_cook_resources()
+static std::vector<std::byte> import_and_cook_resources()
 {
   using namespace eely::internal;
 
@@ -199,16 +201,15 @@ static std::unique_ptr<project> import_and_cook_resources()
 
   // Convert into runtime project
 
-  static constexpr size_t buffer_size_bytes{gsl::narrow<size_t>(1024 * 1024)};
-  std::array<std::byte, buffer_size_bytes> buffer;
-  project::cook(project_uncooked, buffer);
-  return std::make_unique<project>(buffer);
+  return project::cook(project_uncooked);
 }
 
 app_example_additive::app_example_additive(const unsigned int width,
                                            const unsigned int height,
                                            const std::string& title)
-    : app(width, height, title), _project{import_and_cook_resources()}, _scene(*this)
+    : app(width, height, title),
+      _project{project_load_cached(&import_and_cook_resources)},
+      _scene(*this)
 {
   _scene.add_system(&system_skeleton_update);
   _scene.add_system(&system_camera_update);
@@ -241,8 +242,9 @@ app_example_additive::app_example_additive(const unsigned int width,
   _params.get_value<float>(param_id_look_angle) = 0.0F;
   _params.get_value<float>(param_id_playback_speed) = 1.0F;
 
-  // Initialize graph editor for visualization
+  // Initialize graph editor for visualization, along with profiling of costs it shows
 
+  component_anim_graph.player->set_profiling_enabled(true);
   _anim_graph_editor =
       std::make_unique<anim_graph_editor>(graph, component_anim_graph.player.get());
 }
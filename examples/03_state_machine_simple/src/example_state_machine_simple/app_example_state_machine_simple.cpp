@@ -6,6 +6,7 @@
 #include <eely_app/component_skeleton.h>
 #include <eely_app/component_transform.h>
 #include <eely_app/filesystem_utils.h>
+#include <eely_app/project_cache.h>
 #include <eely_app/scene.h>
 #include <eely_app/system_camera.h>
 #include <eely_app/system_render.h>
@@ -40,6 +41,7 @@
 
 #include <filesystem>
 #include <memory>
+#include <vector>
 
 namespace eely {
 constexpr bgfx::ViewId view_id{0};
@@ -48,7 +50,7 @@ constexpr uint32_t view_clear_color{0x31363DFF};
 static const string_id param_id_trigger_taunt{"taunt"};
 static const string_id param_id_playback_speed{"playback_speed"};
 
-static std::unique_ptr<project> import_and_cook_resources()
+static std::vector<std::byte> import_and_cook_resources()
 {
   using namespace eely::internal;
 
@@ -145,16 +147,15 @@ static std::unique_ptr<project> import_and_cook_resources()
 
   // Convert into runtime project
 
-  static constexpr size_t buffer_size_bytes{gsl::narrow<size_t>(1024 * 1024)};
-  std::array<std::byte, buffer_size_bytes> buffer;
-  project::cook(project_uncooked, buffer);
-  return std::make_unique<project>(buffer);
+  return project::cook(project_uncooked);
 }
 
 app_example_state_machine_simple::app_example_state_machine_simple(const unsigned int width,
                                                                    const unsigned int height,
                                                                    const std::string& title)
-    : app(width, height, title), _project{import_and_cook_resources()}, _scene(*this)
+    : app(width, height, title),
+      _project{project_load_cached(&import_and_cook_resources)},
+      _scene(*this)
 {
   _scene.add_system(&system_skeleton_update);
   _scene.add_system(&system_camera_update);
@@ -185,8 +186,9 @@ app_example_state_machine_simple::app_example_state_machine_simple(const unsigne
 
   _params.get_value<float>(param_id_playback_speed) = 1.0F;
 
-  // Initialize graph editor for visualization
+  // Initialize graph editor for visualization, along with profiling of costs it shows
 
+  component_anim_graph.player->set_profiling_enabled(true);
   _anim_graph_editor =
       std::make_unique<anim_graph_editor>(graph, component_anim_graph.player.get());
 }
@@ -202,7 +204,7 @@ void app_example_state_machine_simple::update(const float dt_s)
   if (ImGui::Begin(
           "State machine", nullptr,
           ImGuiWindowFlags_NoResize | ImGuiWindowFlags_NoMove | ImGuiWindowFlags_NoCollapse)) {
-    _params.get_value<bool>(param_id_trigger_taunt) = ImGui::Button("Taunt");
+    _params.set_value(param_id_trigger_taunt, ImGui::Button("Taunt"));
 
     float& playback_speed{_params.get_value<float>(param_id_playback_speed)};
     ImGui::SliderFloat("Playback speed", &playback_speed, 0.0F, 2.0F, "%.2f");
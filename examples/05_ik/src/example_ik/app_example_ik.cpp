@@ -6,6 +6,7 @@
 #include <eely_app/component_skeleton.h>
 #include <eely_app/component_transform.h>
 #include <eely_app/filesystem_utils.h>
+#include <eely_app/project_cache.h>
 #include <eely_app/scene.h>
 #include <eely_app/system_camera.h>
 #include <eely_app/system_render.h>
@@ -14,6 +15,7 @@
 #include <eely_importer/importer.h>
 
 #include <eely/clip/clip.h>
+#include <eely/ik/ik.h>
 #include <eely/math/float4.h>
 #include <eely/math/quaternion.h>
 #include <eely/project/axis_system.h>
@@ -27,13 +29,18 @@
 
 #include <imgui.h>
 
+#include <chrono>
 #include <filesystem>
 #include <memory>
+#include <vector>
 
 namespace eely {
 constexpr bgfx::ViewId view_id{0};
 constexpr uint32_t view_clear_color{0x31363DFF};
 
+// Number of solves averaged to measure time of a single solve.
+constexpr int ik_benchmark_solves_count{100};
+
 void set_swing_twist(skeleton_pose& pose,
                      gsl::index joint_index,
                      const float twist_rad,
@@ -78,7 +85,7 @@ void set_swing_twist(skeleton_pose& pose,
   pose.set_transform_joint_space(joint_index, new_child_transform_joint_space);
 }
 
-static std::unique_ptr<project> import_and_cook_resources()
+static std::vector<std::byte> import_and_cook_resources()
 {
   const std::filesystem::path fbx_path{get_executable_dir() / "res/sitting_clap.fbx"};
 
@@ -97,16 +104,15 @@ static std::unique_ptr<project> import_and_cook_resources()
 
   // Convert into runtime project
 
-  static constexpr size_t buffer_size_bytes{gsl::narrow<size_t>(1024 * 256)};
-  std::array<std::byte, buffer_size_bytes> buffer;
-  project::cook(project_uncooked, buffer);
-  return std::make_unique<project>(buffer);
+  return project::cook(project_uncooked);
 }
 
 app_example_ik::app_example_ik(const unsigned int width,
                                const unsigned int height,
                                const std::string& title)
-    : app(width, height, title), _project{import_and_cook_resources()}, _scene(*this)
+    : app(width, height, title),
+      _project{project_load_cached(&import_and_cook_resources)},
+      _scene(*this)
 {
   _scene.add_system(&system_skeleton_update);
   _scene.add_system(&system_camera_update);
@@ -170,6 +176,86 @@ void app_example_ik::update(const float dt_s)
     switch (_mode) {
       case mode::ik: {
         component_skeleton.joint_renders.clear();
+
+        const skeleton& skeleton{*component_skeleton.skeleton};
+
+        // Solver selection
+
+        int solver_int{static_cast<int>(_ik_solver)};
+        ImGui::TextUnformatted("Solver: ");
+        ImGui::SameLine();
+        ImGui::RadioButton("Two bone", &solver_int, static_cast<int>(ik_solver::two_bone));
+        ImGui::SameLine();
+        ImGui::RadioButton("FABRIK", &solver_int, static_cast<int>(ik_solver::fabrik));
+        _ik_solver = static_cast<ik_solver>(solver_int);
+
+        ImGui::SliderFloat3("Target", &_ik_target.x, -1.5F, 2.0F, "%.2F");
+
+        // Every solve starts from a rest pose,
+        // and is repeated several times to get a stable time of a single solve
+
+        skeleton_pose pose_rest{skeleton};
+        skeleton_pose& pose{component_skeleton.pose};
+
+        switch (_ik_solver) {
+          case ik_solver::two_bone: {
+            int limb_int{static_cast<int>(_ik_limb)};
+            ImGui::Combo("Limb", &limb_int, "Left arm\0Right arm\0Left leg\0Right leg\0");
+            _ik_limb = static_cast<ik_limb>(limb_int);
+
+            const std::optional<ik_two_bone_joints> joints{
+                ik_two_bone_joints_from_limb(skeleton, _ik_limb)};
+            if (!joints.has_value()) {
+              break;
+            }
+
+            const auto start{std::chrono::steady_clock::now()};
+            for (int i{0}; i < ik_benchmark_solves_count; ++i) {
+              pose = pose_rest;
+              ik_two_bone_solve(pose, joints.value(), _ik_target, std::nullopt);
+            }
+            const auto end{std::chrono::steady_clock::now()};
+
+            _ik_solve_time_us =
+                std::chrono::duration<float, std::micro>(end - start).count() /
+                static_cast<float>(ik_benchmark_solves_count);
+
+            ImGui::Text("Time per solve: %.2f us", _ik_solve_time_us);
+          } break;
+
+          case ik_solver::fabrik: {
+            ImGui::SliderInt("Max iterations", &_ik_fabrik_settings.max_iterations, 1, 64);
+            ImGui::SliderFloat("Tolerance", &_ik_fabrik_settings.tolerance, 0.0001F, 0.1F,
+                               "%.4F", ImGuiSliderFlags_Logarithmic);
+            ImGui::Checkbox("Constrained", &_ik_fabrik_settings.constrained);
+
+            std::vector<gsl::index> chain;
+            if (!ik_chain_collect(skeleton, skeleton.get_mapping().left_shoulder.value(),
+                                  skeleton.get_mapping().left_hand.value(), chain)) {
+              break;
+            }
+
+            const auto start{std::chrono::steady_clock::now()};
+            for (int i{0}; i < ik_benchmark_solves_count; ++i) {
+              pose = pose_rest;
+              _ik_fabrik_result = ik_fabrik_solve(pose, chain, _ik_target, _ik_fabrik_settings,
+                                                  _ik_fabrik_scratch);
+            }
+            const auto end{std::chrono::steady_clock::now()};
+
+            _ik_solve_time_us =
+                std::chrono::duration<float, std::micro>(end - start).count() /
+                static_cast<float>(ik_benchmark_solves_count);
+
+            ImGui::Text("Iterations: %d", _ik_fabrik_result.iterations);
+            ImGui::Text("Error: %.4f", _ik_fabrik_result.error);
+            ImGui::Text("Time per solve: %.2f us", _ik_solve_time_us);
+          } break;
+        }
+
+        eely::component_skeleton& component_skeleton_unconstrained{
+            registry.get<eely::component_skeleton>(_character_unconstrained)};
+        component_skeleton_unconstrained.pose = pose_rest;
       } break;
 
       case mode::constraints: {
@@ -237,7 +323,7 @@ void app_example_ik::update(const float dt_s)
             registry.get<eely::component_skeleton>(_character_unconstrained)};
         component_skeleton_unconstrained.pose = component_skeleton.pose;
 
-        constraint_force(component_skeleton.pose);
+        constraint_force(component_skeleton.pose, _constraints_rotations_scratch);
 
       } break;
     }
@@ -3,10 +3,15 @@
 #include <eely_app/app.h>
 #include <eely_app/scene.h>
 
+#include <eely/ik/ik.h>
+#include <eely/math/float3.h>
+#include <eely/math/quaternion.h>
 #include <eely/project/project.h>
 
 #include <entt/entt.hpp>
 
+#include <vector>
+
 namespace eely {
 class app_example_ik final : public app {
 public:
@@ -23,11 +28,23 @@ private:
   entt::entity _character_unconstrained;
   mode _mode{mode::constraints};
 
+  // IK mode
+  enum class ik_solver { two_bone, fabrik };
+
+  ik_solver _ik_solver{ik_solver::two_bone};
+  ik_limb _ik_limb{ik_limb::left_arm};
+  float3 _ik_target{0.5F, 1.3F, 0.3F};
+  ik_fabrik_settings _ik_fabrik_settings;
+  ik_fabrik_result _ik_fabrik_result;
+  ik_fabrik_scratch _ik_fabrik_scratch;
+  float _ik_solve_time_us{0.0F};
+
   // Constraints mode
   string_id _constraints_selected_joint_id;
   bool _constraints_render_joint_frame{true};
   bool _constraints_render_parent_constraint_frame{false};
   bool _constraints_render_child_constraint_frame{false};
   bool _constraints_render_limits{false};
+  std::vector<quaternion> _constraints_rotations_scratch;
 };
 }  // namespace eely
\ No newline at end of file
@@ -0,0 +1,206 @@
+#include "example_crowd/app_example_crowd.h"
+
+#include "example_crowd/crowd.h"
+#include "example_crowd/crowd_import.h"
+
+#include <eely_app/app.h>
+#include <eely_app/component_anim_graph.h>
+#include <eely_app/component_camera.h>
+#include <eely_app/component_skeleton.h>
+#include <eely_app/component_transform.h>
+#include <eely_app/project_cache.h>
+#include <eely_app/scene.h>
+#include <eely_app/system_camera.h>
+#include <eely_app/system_render.h>
+#include <eely_app/system_skeleton.h>
+
+#include <eely/anim_graph/anim_graph_player.h>
+#include <eely/math/float3.h>
+#include <eely/math/math_utils.h>
+#include <eely/math/transform.h>
+#include <eely/params/params.h>
+#include <eely/skeleton/skeleton.h>
+#include <eely/skeleton/skeleton_pose.h>
+
+#include <bgfx/bgfx.h>
+
+#include <entt/entt.hpp>
+
+#include <gsl/narrow>
+
+#include <imgui.h>
+
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace eely {
+constexpr bgfx::ViewId view_id{0};
+constexpr uint32_t view_clear_color{0x31363DFF};
+
+// Number of recent frames statistics are shown for.
+static constexpr gsl::index timings_window_size{120};
+
+// Distance between neighbouring characters in a grid.
+static constexpr float characters_spacing{1.0F};
+
+app_example_crowd::app_example_crowd(const unsigned int width,
+                                     const unsigned int height,
+                                     const std::string& title)
+    : app(width, height, title),
+      _project{project_load_cached(&crowd_import_and_cook_resources)},
+      _scene(*this),
+      _timings{timings_window_size}
+{
+  // Skeletons are updated by the app itself, to measure how long that takes
+  _scene.add_system(&system_camera_update);
+  _scene.add_system(&system_render_update);
+
+  entt::registry& registry{_scene.get_registry()};
+
+  // Create camera looking at the crowd from above
+
+  entt::entity camera{registry.create()};
+  registry.emplace<component_transform>(camera, transform{float3{0.0F, 6.0F, 6.0F}});
+  component_camera& component_camera{registry.emplace<eely::component_camera>(camera)};
+  component_camera.yaw = pi;
+  component_camera.pitch = 0.5F;
+
+  spawn_characters();
+}
+
+void app_example_crowd::update(const float dt_s)
+{
+  bgfx::setViewRect(view_id, 0, 0, gsl::narrow<uint16_t>(get_width()),
+                    gsl::narrow<uint16_t>(get_height()));
+  bgfx::setViewClear(view_id, BGFX_CLEAR_COLOR | BGFX_CLEAR_DEPTH, view_clear_color);
+
+  entt::registry& registry{_scene.get_registry()};
+
+  ImGui::SetNextWindowSize(ImVec2(350.0F, 0.0F));
+  ImGui::SetNextWindowPos(ImVec2(10.0F, 10.0F));
+  if (ImGui::Begin(
+          "Crowd", nullptr,
+          ImGuiWindowFlags_NoResize | ImGuiWindowFlags_NoMove | ImGuiWindowFlags_NoCollapse)) {
+    // Crowd is respawned once a slider is released, not while it is being dragged
+    ImGui::SliderInt("Characters", &_characters_count, 1, 20000, "%d",
+                     ImGuiSliderFlags_Logarithmic | ImGuiSliderFlags_AlwaysClamp);
+    bool respawn{ImGui::IsItemDeactivatedAfterEdit()};
+
+    static constexpr std::array<const char*, 3> graph_names{"Blend", "State machine", "Mixed"};
+    int graph_index{static_cast<int>(_graph)};
+    if (ImGui::Combo("Graph", &graph_index, graph_names.data(),
+                     gsl::narrow<int>(graph_names.size()))) {
+      _graph = static_cast<crowd_graph>(graph_index);
+      respawn = true;
+    }
+
+    if (ImGui::SliderInt("Update period", &_update_period, 1, 8)) {
+      for (const entt::entity character : _characters) {
+        registry.get<component_anim_graph>(character).player->set_update_period(_update_period);
+      }
+    }
+
+    ImGui::Checkbox("Parallel update", &_parallel_update);
+
+    if (ImGui::SliderInt("Rendered characters", &_characters_rendered_max, 0, 20000)) {
+      for (gsl::index i{0}; i < std::ssize(_characters); ++i) {
+        registry.get<component_skeleton>(_characters[i]).pose_render =
+            i < _characters_rendered_max;
+      }
+    }
+
+    if (respawn) {
+      spawn_characters();
+    }
+
+    ImGui::Separator();
+
+    const float average_us{_timings.get_average_us()};
+    const float poses_per_s{
+        average_us > 0.0F ? static_cast<float>(_characters.size()) / (average_us * 1e-6F) : 0.0F};
+
+    ImGui::Text("Animation update: %.2f ms (p99 %.2f ms)", average_us / 1000.0F,
+                _timings.get_percentile_us(99.0F) / 1000.0F);
+    ImGui::Text("Throughput: %.0f poses/s", poses_per_s);
+    ImGui::Text("Player memory: %.1f KB per character",
+                static_cast<float>(_player_bytes_per_character) / 1024.0F);
+
+    ImGui::End();
+  }
+
+  for (params& params : _characters_params) {
+    crowd_update_params(params, dt_s, _random_generator);
+  }
+
+  const auto begin{std::chrono::steady_clock::now()};
+
+  if (_parallel_update) {
+    system_skeleton_update_parallel(*this, registry, dt_s);
+  }
+  else {
+    system_skeleton_update(*this, registry, dt_s);
+  }
+
+  const auto end{std::chrono::steady_clock::now()};
+  _timings.add(std::chrono::duration<float, std::micro>(end - begin).count());
+
+  _scene.update(dt_s);
+}
+
+void app_example_crowd::spawn_characters()
+{
+  entt::registry& registry{_scene.get_registry()};
+
+  registry.destroy(_characters.begin(), _characters.end());
+  _characters.clear();
+  _characters_params.clear();
+  _timings.clear();
+
+  const skeleton& skeleton{crowd_get_skeleton(*_project)};
+
+  const int64_t player_bytes_begin{_players_memory_resource.get_allocated_bytes()};
+
+  // Params are referenced by components, so their storage should not be reallocated
+  _characters.reserve(_characters_count);
+  _characters_params.resize(_characters_count);
+
+  // Characters are placed in a square grid in front of the camera
+  const auto columns_count{static_cast<gsl::index>(std::ceil(std::sqrt(_characters_count)))};
+
+  for (gsl::index i{0}; i < _characters_count; ++i) {
+    const float x{(static_cast<float>(i % columns_count) -
+                   static_cast<float>(columns_count - 1) / 2.0F) *
+                  characters_spacing};
+    const float z{-static_cast<float>(i / columns_count) * characters_spacing};
+
+    params& params{_characters_params[i]};
+    crowd_randomize_params(params, _random_generator);
+
+    const entt::entity character{registry.create()};
+    _characters.push_back(character);
+
+    registry.emplace<component_transform>(character, transform{float3{x, 0.0F, z}});
+    auto& component_skeleton{registry.emplace<eely::component_skeleton>(
+        character, &skeleton, skeleton_pose(skeleton))};
+    component_skeleton.pose_render = i < _characters_rendered_max;
+
+    auto& component_anim_graph{registry.emplace<eely::component_anim_graph>(
+        character, std::make_unique<anim_graph_player>(crowd_get_graph(*_project, _graph, i),
+                                            &_players_memory_resource),
+        &params)};
+
+    anim_graph_player& player{*component_anim_graph.player};
+    player.set_random_seed(static_cast<uint32_t>(_random_generator()));
+    crowd_apply_phase_offset(player, params, component_skeleton.pose, _random_generator);
+    player.set_update_period(_update_period);
+  }
+
+  _player_bytes_per_character =
+      (_players_memory_resource.get_allocated_bytes() - player_bytes_begin) / _characters_count;
+}
+}  // namespace eely
\ No newline at end of file
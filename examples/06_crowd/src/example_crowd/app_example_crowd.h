@@ -0,0 +1,54 @@
+#pragma once
+
+#include "example_crowd/crowd.h"
+
+#include <eely_app/app.h>
+#include <eely_app/scene.h>
+
+#include <eely/base/counting_memory_resource.h>
+#include <eely/params/params.h>
+#include <eely/project/project.h>
+
+#include <entt/entt.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace eely {
+class app_example_crowd final : public app {
+public:
+  app_example_crowd(unsigned int width, unsigned int height, const std::string& title);
+
+  void update(float dt_s) override;
+
+private:
+  // Destroy current characters and create a new crowd with current settings.
+  void spawn_characters();
+
+  std::unique_ptr<project> _project;
+
+  // Players are allocated with this resource, so it is declared before the scene that owns them
+  counting_memory_resource _players_memory_resource;
+
+  scene _scene;
+  std::mt19937 _random_generator{0};
+
+  // Settings
+  int _characters_count{1000};
+  int _characters_rendered_max{20000};
+  crowd_graph _graph{crowd_graph::mixed};
+  int _update_period{1};
+  bool _parallel_update{true};
+
+  // Characters, their params are referenced by anim graph components
+  std::vector<entt::entity> _characters;
+  std::vector<params> _characters_params;
+
+  // Statistics
+  crowd_timings _timings;
+  int64_t _player_bytes_per_character{0};
+};
+}  // namespace eely
\ No newline at end of file
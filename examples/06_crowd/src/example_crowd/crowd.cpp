@@ -0,0 +1,344 @@
+#include "example_crowd/crowd.h"
+
+#include <eely/anim_graph/anim_graph.h>
+#include <eely/anim_graph/anim_graph_node_blend.h>
+#include <eely/anim_graph/anim_graph_node_clip.h>
+#include <eely/anim_graph/anim_graph_node_param.h>
+#include <eely/anim_graph/anim_graph_node_param_comparison.h>
+#include <eely/anim_graph/anim_graph_node_random.h>
+#include <eely/anim_graph/anim_graph_node_speed.h>
+#include <eely/anim_graph/anim_graph_node_state.h>
+#include <eely/anim_graph/anim_graph_node_state_machine.h>
+#include <eely/anim_graph/anim_graph_node_state_transition.h>
+#include <eely/anim_graph/anim_graph_uncooked.h>
+#include <eely/base/assert.h>
+#include <eely/base/string_id.h>
+#include <eely/project/project.h>
+#include <eely/project/project_uncooked.h>
+#include <eely/skeleton/skeleton.h>
+
+#include <gsl/narrow>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <optional>
+#include <random>
+#include <string_view>
+#include <vector>
+
+namespace eely {
+static const string_id graph_id_blend{"blend"};
+static const string_id graph_id_state_machine{"state_machine"};
+
+static const string_id param_id_speed{"speed"};
+static const string_id param_id_crouch{"crouch"};
+static const string_id param_id_gait{"gait"};
+static const string_id param_id_playback_speed{"playback_speed"};
+
+static constexpr float param_speed_walk{1.0F};
+static constexpr float param_speed_jog{2.0F};
+static constexpr float param_speed_run{3.0F};
+
+// States of the state machine graph, selected with `gait` parameter.
+enum class gait { walk, run, crouch, count };
+
+// Average time between gait changes of a character.
+static constexpr float gait_change_period_s{4.0F};
+
+// Maximum time a player is advanced by when spawned.
+static constexpr float phase_offset_max_s{2.0F};
+
+static void add_blend_graph(project_uncooked& project_uncooked, const string_id& skeleton_id)
+{
+  // Same blending graph as in the blend example:
+  //  - three standing movement animations, blended by speed
+  //  - two crouching movement animations, blended by speed
+  //  - standing and movement animations are blended by crouching parameter
+  // Additional node controls playback speed of this whole tree.
+
+  auto& graph{project_uncooked.add_resource<anim_graph_uncooked>(graph_id_blend)};
+
+  graph.set_skeleton_id(skeleton_id);
+
+  auto& node_walk{graph.add_node<anim_graph_node_clip>()};
+  node_walk.set_clip_id("walk");
+
+  auto& node_jog{graph.add_node<anim_graph_node_clip>()};
+  node_jog.set_clip_id("jog");
+
+  auto& node_run{graph.add_node<anim_graph_node_clip>()};
+  node_run.set_clip_id("run");
+
+  auto& node_crouch_walk{graph.add_node<anim_graph_node_clip>()};
+  node_crouch_walk.set_clip_id("walk_crouch");
+
+  auto& node_crouch_run{graph.add_node<anim_graph_node_clip>()};
+  node_crouch_run.set_clip_id("run_crouch");
+
+  auto& node_speed_param_for_walk{graph.add_node<anim_graph_node_param>()};
+  node_speed_param_for_walk.set_param_id(param_id_speed);
+
+  auto& node_speed_param_for_crouch{graph.add_node<anim_graph_node_param>()};
+  node_speed_param_for_crouch.set_param_id(param_id_speed);
+
+  auto& node_crouch_param{graph.add_node<anim_graph_node_param>()};
+  node_crouch_param.set_param_id(param_id_crouch);
+
+  auto& node_playback_speed_param{graph.add_node<anim_graph_node_param>()};
+  node_playback_speed_param.set_param_id(param_id_playback_speed);
+
+  auto& node_blend_walk_jog_run{graph.add_node<anim_graph_node_blend>()};
+  node_blend_walk_jog_run.get_pose_nodes() = {
+      {.id = node_walk.get_id(), .factor = param_speed_walk},
+      {.id = node_jog.get_id(), .factor = param_speed_jog},
+      {.id = node_run.get_id(), .factor = param_speed_run},
+  };
+  node_blend_walk_jog_run.set_factor_node_id(node_speed_param_for_walk.get_id());
+
+  auto& node_blend_crouch_walk_run{graph.add_node<anim_graph_node_blend>()};
+  node_blend_crouch_walk_run.get_pose_nodes() = {
+      {.id = node_crouch_walk.get_id(), .factor = param_speed_walk},
+      {.id = node_crouch_run.get_id(), .factor = param_speed_run},
+  };
+  node_blend_crouch_walk_run.set_factor_node_id(node_speed_param_for_crouch.get_id());
+
+  auto& node_blend_stand_crouch{graph.add_node<anim_graph_node_blend>()};
+  node_blend_stand_crouch.get_pose_nodes() = {
+      {.id = node_blend_walk_jog_run.get_id(), .factor = 0.0F},
+      {.id = node_blend_crouch_walk_run.get_id(), .factor = 1.0F},
+  };
+  node_blend_stand_crouch.set_factor_node_id(node_crouch_param.get_id());
+
+  auto& node_playback_speed{graph.add_node<anim_graph_node_speed>()};
+  node_playback_speed.set_speed_provider_node(node_playback_speed_param.get_id());
+  node_playback_speed.set_child_node(node_blend_stand_crouch.get_id());
+
+  graph.set_root_node_id(node_playback_speed.get_id());
+}
+
+static void add_state_machine_graph(project_uncooked& project_uncooked,
+                                    const string_id& skeleton_id)
+{
+  // State machine graph with three states, selected with `gait` parameter:
+  //  - walking, single clip
+  //  - running, single clip
+  //  - crouching, which chooses crouch walking or crouch running at random on each iteration
+  // Every state can transition into any other one.
+  // Additional node controls playback speed of this whole tree.
+
+  auto& graph{project_uncooked.add_resource<anim_graph_uncooked>(graph_id_state_machine)};
+
+  graph.set_skeleton_id(skeleton_id);
+
+  auto& node_walk{graph.add_node<anim_graph_node_clip>()};
+  node_walk.set_clip_id("walk");
+
+  auto& node_run{graph.add_node<anim_graph_node_clip>()};
+  node_run.set_clip_id("run");
+
+  auto& node_crouch_walk{graph.add_node<anim_graph_node_clip>()};
+  node_crouch_walk.set_clip_id("walk_crouch");
+
+  auto& node_crouch_run{graph.add_node<anim_graph_node_clip>()};
+  node_crouch_run.set_clip_id("run_crouch");
+
+  auto& node_crouch{graph.add_node<anim_graph_node_random>()};
+  node_crouch.get_children_nodes() = {node_crouch_walk.get_id(), node_crouch_run.get_id()};
+
+  const std::array<int, static_cast<size_t>(gait::count)> pose_nodes{
+      node_walk.get_id(), node_run.get_id(), node_crouch.get_id()};
+  const std::array<string_id, static_cast<size_t>(gait::count)> state_names{"walk", "run",
+                                                                            "crouch"};
+
+  std::array<anim_graph_node_state*, static_cast<size_t>(gait::count)> states{};
+  for (size_t i{0}; i < states.size(); ++i) {
+    states[i] = &graph.add_node<anim_graph_node_state>();
+    states[i]->set_pose_node(pose_nodes[i]);
+    states[i]->set_name(state_names[i]);
+  }
+
+  for (size_t source{0}; source < states.size(); ++source) {
+    for (size_t destination{0}; destination < states.size(); ++destination) {
+      if (source == destination) {
+        continue;
+      }
+
+      auto& node_condition{graph.add_node<anim_graph_node_param_comparison>()};
+      node_condition.set_param_id(param_id_gait);
+      node_condition.set_value(gsl::narrow<int>(destination));
+
+      auto& node_transition{graph.add_node<anim_graph_node_state_transition>()};
+      node_transition.set_condition_node(node_condition.get_id());
+      node_transition.set_destination_state_node(states[destination]->get_id());
+      node_transition.set_duration_s(0.3F);
+
+      states[source]->get_out_transition_nodes().push_back(node_transition.get_id());
+    }
+  }
+
+  auto& node_state_machine{graph.add_node<anim_graph_node_state_machine>()};
+  for (const anim_graph_node_state* state : states) {
+    node_state_machine.get_state_nodes().push_back(state->get_id());
+  }
+
+  auto& node_speed_param{graph.add_node<anim_graph_node_param>()};
+  node_speed_param.set_param_id(param_id_playback_speed);
+
+  auto& node_speed{graph.add_node<anim_graph_node_speed>()};
+  node_speed.set_speed_provider_node(node_speed_param.get_id());
+  node_speed.set_child_node(node_state_machine.get_id());
+
+  graph.set_root_node_id(node_speed.get_id());
+}
+
+std::optional<crowd_graph> crowd_graph_from_name(const std::string_view name)
+{
+  for (const crowd_graph graph :
+       {crowd_graph::blend, crowd_graph::state_machine, crowd_graph::mixed}) {
+    if (name == crowd_graph_get_name(graph)) {
+      return graph;
+    }
+  }
+
+  return std::nullopt;
+}
+
+const char* crowd_graph_get_name(const crowd_graph graph)
+{
+  switch (graph) {
+    case crowd_graph::blend: {
+      return "blend";
+    } break;
+
+    case crowd_graph::state_machine: {
+      return "state_machine";
+    } break;
+
+    case crowd_graph::mixed: {
+      return "mixed";
+    } break;
+  }
+
+  return "";
+}
+
+void crowd_add_graphs(project_uncooked& project_uncooked, const string_id& skeleton_id)
+{
+  add_blend_graph(project_uncooked, skeleton_id);
+  add_state_machine_graph(project_uncooked, skeleton_id);
+}
+
+const skeleton& crowd_get_skeleton(const project& project)
+{
+  // Both graphs use the same skeleton
+  const string_id& skeleton_id{project.get_resource<anim_graph>(graph_id_blend)->get_skeleton_id()};
+  return *project.get_resource<skeleton>(skeleton_id);
+}
+
+const anim_graph& crowd_get_graph(const project& project,
+                                  const crowd_graph graph,
+                                  const gsl::index character_index)
+{
+  const bool use_blend{graph == crowd_graph::blend ||
+                       (graph == crowd_graph::mixed && character_index % 2 == 0)};
+
+  return *project.get_resource<anim_graph>(use_blend ? graph_id_blend : graph_id_state_machine);
+}
+
+void crowd_randomize_params(params& params, std::mt19937& random_generator)
+{
+  std::uniform_real_distribution<float> speed_distribution{param_speed_walk, param_speed_run};
+  std::uniform_real_distribution<float> playback_speed_distribution{0.8F, 1.2F};
+  std::bernoulli_distribution crouch_distribution{0.25};
+  std::uniform_int_distribution<int> gait_distribution{0, static_cast<int>(gait::count) - 1};
+
+  params.set_value(param_id_speed, speed_distribution(random_generator));
+  params.set_value(param_id_crouch, crouch_distribution(random_generator) ? 1.0F : 0.0F);
+  params.set_value(param_id_gait, gait_distribution(random_generator));
+  params.set_value(param_id_playback_speed, playback_speed_distribution(random_generator));
+}
+
+void crowd_update_params(params& params, const float dt_s, std::mt19937& random_generator)
+{
+  // Speed drifts slowly, so that blend weights change every frame without visible pops
+
+  std::uniform_real_distribution<float> speed_change_distribution{-0.5F, 0.5F};
+
+  const float speed{params.get_value<float>(param_id_speed) +
+                    speed_change_distribution(random_generator) * dt_s};
+  params.set_value(param_id_speed, std::clamp(speed, param_speed_walk, param_speed_run));
+
+  std::bernoulli_distribution gait_change_distribution{dt_s / gait_change_period_s};
+  if (gait_change_distribution(random_generator)) {
+    std::uniform_int_distribution<int> gait_distribution{0, static_cast<int>(gait::count) - 1};
+    params.set_value(param_id_gait, gait_distribution(random_generator));
+  }
+}
+
+void crowd_apply_phase_offset(anim_graph_player& player,
+                              const params& params,
+                              skeleton_pose& out_pose,
+                              std::mt19937& random_generator)
+{
+  std::uniform_real_distribution<float> offset_distribution{0.0F, phase_offset_max_s};
+  player.play(offset_distribution(random_generator), params, out_pose);
+}
+
+crowd_timings::crowd_timings(const gsl::index window_size) : _window_size{window_size}
+{
+  EXPECTS(window_size > 0);
+  _updates_us.reserve(window_size);
+}
+
+void crowd_timings::add(const float update_us)
+{
+  if (std::ssize(_updates_us) < _window_size) {
+    _updates_us.push_back(update_us);
+  }
+  else {
+    _updates_us[_next_index] = update_us;
+  }
+
+  _next_index = (_next_index + 1) % _window_size;
+}
+
+void crowd_timings::clear()
+{
+  _updates_us.clear();
+  _next_index = 0;
+}
+
+bool crowd_timings::is_empty() const
+{
+  return _updates_us.empty();
+}
+
+float crowd_timings::get_average_us() const
+{
+  if (_updates_us.empty()) {
+    return 0.0F;
+  }
+
+  return std::accumulate(_updates_us.begin(), _updates_us.end(), 0.0F) /
+         static_cast<float>(_updates_us.size());
+}
+
+float crowd_timings::get_percentile_us(const float percentile) const
+{
+  if (_updates_us.empty()) {
+    return 0.0F;
+  }
+
+  std::vector<float> sorted_updates_us{_updates_us};
+  std::sort(sorted_updates_us.begin(), sorted_updates_us.end());
+
+  const auto rank{static_cast<gsl::index>(
+      std::ceil(percentile / 100.0F * static_cast<float>(sorted_updates_us.size())))};
+  return sorted_updates_us[std::clamp<gsl::index>(rank - 1, 0,
+                                                  std::ssize(sorted_updates_us) - 1)];
+}
+}  // namespace eely
\ No newline at end of file
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <eely/anim_graph/anim_graph.h>
+#include <eely/anim_graph/anim_graph_player.h>
+#include <eely/base/string_id.h>
+#include <eely/params/params.h>
+#include <eely/project/project.h>
+#include <eely/project/project_uncooked.h>
+#include <eely/skeleton/skeleton_pose.h>
+
+#include <gsl/util>
+
+#include <cstddef>
+#include <optional>
+#include <random>
+#include <string_view>
+#include <vector>
+
+// Resources and utilities shared by the windowed and the headless crowd examples.
+
+namespace eely {
+// Graphs characters of a crowd play.
+enum class crowd_graph {
+  // Every character plays the blend graph.
+  blend,
+
+  // Every character plays the state machine graph.
+  state_machine,
+
+  // Characters play both graphs in turns.
+  mixed
+};
+
+// Return graph type with specified name, or `std::nullopt` if there is no such type.
+[[nodiscard]] std::optional<crowd_graph> crowd_graph_from_name(std::string_view name);
+
+// Return name of a graph type.
+[[nodiscard]] const char* crowd_graph_get_name(crowd_graph graph);
+
+// Add a blend graph and a state machine graph for a skeleton with specified id.
+// Graphs play clips "walk", "jog", "run", "walk_crouch" and "run_crouch".
+void crowd_add_graphs(project_uncooked& project_uncooked, const string_id& skeleton_id);
+
+// Return skeleton all crowd graphs use.
+[[nodiscard]] const skeleton& crowd_get_skeleton(const project& project);
+
+// Return graph a character with specified index plays.
+[[nodiscard]] const anim_graph& crowd_get_graph(const project& project,
+                                                crowd_graph graph,
+                                                gsl::index character_index);
+
+// Set random initial values of parameters used by crowd graphs.
+void crowd_randomize_params(params& params, std::mt19937& random_generator);
+
+// Change parameters slightly as gameplay would,
+// and occasionally switch states of state machines.
+void crowd_update_params(params& params, float dt_s, std::mt19937& random_generator);
+
+// Advance a freshly created player by a random amount of time,
+// so that characters do not move in sync.
+void crowd_apply_phase_offset(anim_graph_player& player,
+                              const params& params,
+                              skeleton_pose& out_pose,
+                              std::mt19937& random_generator);
+
+// Durations of crowd animation updates over a window of recent frames.
+class crowd_timings final {
+public:
+  // Create timings that keep specified number of most recent durations.
+  explicit crowd_timings(gsl::index window_size);
+
+  // Add duration of an update.
+  void add(float update_us);
+
+  // Remove all durations.
+  void clear();
+
+  // Return `true` if there are no durations.
+  [[nodiscard]] bool is_empty() const;
+
+  // Return average duration of an update.
+  [[nodiscard]] float get_average_us() const;
+
+  // Return duration at specified percentile, using nearest rank.
+  [[nodiscard]] float get_percentile_us(float percentile) const;
+
+private:
+  std::vector<float> _updates_us;
+  gsl::index _window_size;
+  gsl::index _next_index{0};
+};
+}  // namespace eely
\ No newline at end of file
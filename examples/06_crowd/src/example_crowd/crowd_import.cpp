@@ -0,0 +1,47 @@
+#include "example_crowd/crowd_import.h"
+
+#include "example_crowd/crowd.h"
+
+#include <eely_app/filesystem_utils.h>
+
+#include <eely_importer/importer.h>
+
+#include <eely/project/axis_system.h>
+#include <eely/project/measurement_unit.h>
+#include <eely/project/project.h>
+#include <eely/project/project_uncooked.h>
+#include <eely/skeleton/skeleton_uncooked.h>
+
+#include <cstddef>
+#include <filesystem>
+#include <vector>
+
+namespace eely {
+std::vector<std::byte> crowd_import_and_cook_resources()
+{
+  project_uncooked project_uncooked{measurement_unit::meters, axis_system::y_up_x_right_z_forward};
+
+  const std::filesystem::path exec_dir{get_executable_dir()};
+
+  // Skeleton
+
+  importer skeleton_importer{project_uncooked, exec_dir / "res/walk.fbx"};
+  const skeleton_uncooked& skeleton_uncooked{skeleton_importer.import_skeleton(0)};
+
+  // Clips
+
+  importer{project_uncooked, exec_dir / "res/jog.fbx"}.import_clip(0, skeleton_uncooked);
+  importer{project_uncooked, exec_dir / "res/run_crouch.fbx"}.import_clip(0, skeleton_uncooked);
+  importer{project_uncooked, exec_dir / "res/run.fbx"}.import_clip(0, skeleton_uncooked);
+  importer{project_uncooked, exec_dir / "res/walk_crouch.fbx"}.import_clip(0, skeleton_uncooked);
+  importer{project_uncooked, exec_dir / "res/walk.fbx"}.import_clip(0, skeleton_uncooked);
+
+  // Graphs
+
+  crowd_add_graphs(project_uncooked, skeleton_uncooked.get_id());
+
+  // Convert into runtime project
+
+  return project::cook(project_uncooked);
+}
+}  // namespace eely
\ No newline at end of file
@@ -0,0 +1,13 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+// Importing of crowd resources, used by the windowed example only.
+// The headless one loads a project cooked by eely_cook, so that it does not depend on FBX SDK.
+
+namespace eely {
+// Import resources from FBX (a skeleton, movement clips, a blend graph and a state machine graph)
+// and cook them into a buffer of a runtime project shared by all characters.
+[[nodiscard]] std::vector<std::byte> crowd_import_and_cook_resources();
+}  // namespace eely
\ No newline at end of file
@@ -0,0 +1,11 @@
+#include "example_crowd/app_example_crowd.h"
+
+#include <SDL.h>
+
+int main(int /*argc*/, char** /*argv*/)
+{
+  using namespace eely;
+
+  app_example_crowd app{1024, 768, "Example: crowd"};
+  return app.run();
+}
\ No newline at end of file
@@ -0,0 +1,219 @@
+#include "example_crowd/crowd.h"
+
+#include <eely/anim_graph/anim_graph_player.h>
+#include <eely/base/counting_memory_resource.h>
+#include <eely/base/file_utils.h>
+#include <eely/params/params.h>
+#include <eely/project/project.h>
+#include <eely/skeleton/skeleton.h>
+#include <eely/skeleton/skeleton_pose.h>
+
+#include <fmt/format.h>
+
+#include <gsl/util>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <execution>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Headless variant of the crowd example, to be used as a regression benchmark.
+// Spawns crowds of specified sizes without a window,
+// updates them for a number of frames and prints one line of results per crowd.
+// Depends on eely only, resources are loaded from a project cooked by eely_cook
+// from res/crowd.json, the build does that and puts crowd.eely next to this executable.
+//
+// Usage: example_crowd_headless --project <path> [options] [characters...]
+// Options:
+//   --project <path>         cooked project with crowd resources, required
+//   --frames <count>         frames to update every crowd for, 600 by default
+//   --graph <name>           graph characters play: blend, state_machine or mixed (default)
+//   --update-period <count>  update period of every player, 1 by default
+//   --serial                 update characters on the calling thread only
+// Crowds of 100, 1000 and 10000 characters are benchmarked if no sizes are given.
+
+namespace eely {
+// Benchmark settings parsed from command line.
+struct benchmark_settings final {
+  std::filesystem::path project_path;
+  int frames_count{600};
+  crowd_graph graph{crowd_graph::mixed};
+  int update_period{1};
+  bool parallel{true};
+  std::vector<int> characters_counts;
+};
+
+// Everything a single character of a crowd needs.
+struct benchmark_character final {
+  std::unique_ptr<anim_graph_player> player;
+  params params;
+  skeleton_pose pose;
+};
+
+static constexpr float frame_dt_s{1.0F / 60.0F};
+
+static benchmark_settings parse_settings(const int argc, char** argv)
+{
+  benchmark_settings result;
+
+  // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic), C interface
+  for (int i{1}; i < argc; ++i) {
+    const std::string_view arg{argv[i]};
+
+    const auto next_value = [&]() -> std::string_view {
+      if (i + 1 >= argc) {
+        throw std::runtime_error{fmt::format("Missing value for {}", arg)};
+      }
+
+      return argv[++i];
+    };
+
+    if (arg == "--project") {
+      result.project_path = next_value();
+    }
+    else if (arg == "--frames") {
+      result.frames_count = std::stoi(std::string{next_value()});
+    }
+    else if (arg == "--graph") {
+      const std::string_view name{next_value()};
+      const std::optional<crowd_graph> graph{crowd_graph_from_name(name)};
+      if (!graph.has_value()) {
+        throw std::runtime_error{fmt::format("Unknown graph {}", name)};
+      }
+
+      result.graph = graph.value();
+    }
+    else if (arg == "--update-period") {
+      result.update_period = std::stoi(std::string{next_value()});
+    }
+    else if (arg == "--serial") {
+      result.parallel = false;
+    }
+    else {
+      result.characters_counts.push_back(std::stoi(std::string{arg}));
+    }
+  }
+  // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+
+  if (result.project_path.empty()) {
+    throw std::runtime_error{"Project path is required, cook one with eely_cook res/crowd.json"};
+  }
+
+  if (result.frames_count <= 0 || result.update_period <= 0) {
+    throw std::runtime_error{"Frames count and update period should be positive"};
+  }
+
+  if (result.characters_counts.empty()) {
+    result.characters_counts = {100, 1000, 10000};
+  }
+
+  if (std::any_of(result.characters_counts.begin(), result.characters_counts.end(),
+                  [](const int count) { return count <= 0; })) {
+    throw std::runtime_error{"Characters count should be positive"};
+  }
+
+  return result;
+}
+
+static void benchmark(const project& project,
+                      const benchmark_settings& settings,
+                      const int characters_count)
+{
+  const skeleton& skeleton{crowd_get_skeleton(project)};
+
+  // Same seed for every run, so that results of different builds can be compared
+  std::mt19937 random_generator{0};
+
+  // Players are allocated with this resource to measure memory they take,
+  // it is declared before characters so that it outlives them
+  counting_memory_resource players_memory_resource;
+
+  std::vector<benchmark_character> characters;
+  characters.reserve(characters_count);
+
+  for (gsl::index i{0}; i < characters_count; ++i) {
+    benchmark_character& c{characters.emplace_back(benchmark_character{
+        .player = std::make_unique<anim_graph_player>(crowd_get_graph(project, settings.graph, i),
+                                                      &players_memory_resource),
+        .params = {},
+        .pose = skeleton_pose{skeleton}})};
+
+    c.player->set_random_seed(static_cast<uint32_t>(random_generator()));
+    crowd_randomize_params(c.params, random_generator);
+    crowd_apply_phase_offset(*c.player, c.params, c.pose, random_generator);
+    c.player->set_update_period(settings.update_period);
+  }
+
+  const int64_t player_bytes_per_character{players_memory_resource.get_allocated_bytes() /
+                                           characters_count};
+
+  crowd_timings timings{settings.frames_count};
+
+  for (int frame{0}; frame < settings.frames_count; ++frame) {
+    for (benchmark_character& c : characters) {
+      crowd_update_params(c.params, frame_dt_s, random_generator);
+    }
+
+    const auto begin{std::chrono::steady_clock::now()};
+
+    const auto update = [](benchmark_character& c) {
+      c.player->play(frame_dt_s, c.params, c.pose);
+    };
+    if (settings.parallel) {
+      std::for_each(std::execution::par, characters.begin(), characters.end(), update);
+    }
+    else {
+      std::for_each(characters.begin(), characters.end(), update);
+    }
+
+    const auto end{std::chrono::steady_clock::now()};
+    timings.add(std::chrono::duration<float, std::micro>(end - begin).count());
+  }
+
+  const float average_us{timings.get_average_us()};
+  const float poses_per_s{static_cast<float>(characters_count) / (average_us * 1e-6F)};
+
+  fmt::print("{:>10} {:>14} {:>10.3f} {:>10.3f} {:>10.3f} {:>14.0f} {:>12.1f}\n",
+             characters_count, crowd_graph_get_name(settings.graph), average_us / 1000.0F,
+             timings.get_percentile_us(99.0F) / 1000.0F,
+             timings.get_percentile_us(100.0F) / 1000.0F, poses_per_s,
+             static_cast<float>(player_bytes_per_character) / 1024.0F);
+}
+}  // namespace eely
+
+int main(int argc, char** argv)
+{
+  using namespace eely;
+
+  try {
+    const benchmark_settings settings{parse_settings(argc, argv)};
+
+    std::vector<std::byte> project_buffer{read_file(settings.project_path)};
+    const project project{project_buffer};
+
+    fmt::print("{} frames, update period {}, {} update\n", settings.frames_count,
+               settings.update_period, settings.parallel ? "parallel" : "serial");
+    fmt::print("{:>10} {:>14} {:>10} {:>10} {:>10} {:>14} {:>12}\n", "characters", "graph",
+               "avg ms", "p99 ms", "max ms", "poses/s", "KB/player");
+
+    for (const int characters_count : settings.characters_counts) {
+      benchmark(project, settings, characters_count);
+    }
+  }
+  catch (const std::exception& e) {
+    fmt::print(stderr, "Crowd benchmark failed: {}\n", e.what());
+    return 1;
+  }
+
+  return 0;
+}
\ No newline at end of file
@@ -0,0 +1,380 @@
+#include "eely_cook/json.h"
+
+#include <fmt/format.h>
+
+#include <gsl/narrow>
+#include <gsl/util>
+
+#include <charconv>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+namespace eely {
+// Maximum nesting of arrays and objects, so that malicious texts cannot overflow the stack.
+static constexpr gsl::index json_max_depth{64};
+
+static bool is_digit(const char c)
+{
+  return c >= '0' && c <= '9';
+}
+
+// Recursive descent parser over a JSON text.
+class json_parser final {
+public:
+  explicit json_parser(std::string_view text);
+
+  // Parse the whole text as a single value.
+  json_value parse_document();
+
+private:
+  json_value parse_value();
+  json_value parse_object();
+  json_value parse_array();
+  std::string parse_string();
+  double parse_number();
+  void parse_literal(std::string_view literal);
+
+  void skip_whitespace();
+  char peek() const;
+  void expect(char c);
+
+  [[noreturn]] void fail(std::string_view message) const;
+
+  std::string_view _text;
+  gsl::index _position{0};
+  gsl::index _depth{0};
+};
+
+json_parser::json_parser(const std::string_view text) : _text{text} {}
+
+json_value json_parser::parse_document()
+{
+  json_value result{parse_value()};
+
+  skip_whitespace();
+  if (_position != std::ssize(_text)) {
+    fail("unexpected trailing characters");
+  }
+
+  return result;
+}
+
+json_value json_parser::parse_value()
+{
+  skip_whitespace();
+
+  const char c{peek()};
+
+  if (c == '{' || c == '[') {
+    if (_depth == json_max_depth) {
+      fail("too deeply nested");
+    }
+
+    ++_depth;
+    json_value result{c == '{' ? parse_object() : parse_array()};
+    --_depth;
+
+    return result;
+  }
+
+  switch (c) {
+    case '"': {
+      return json_value{parse_string()};
+    }
+
+    case 't': {
+      parse_literal("true");
+      return json_value{true};
+    }
+
+    case 'f': {
+      parse_literal("false");
+      return json_value{false};
+    }
+
+    case 'n': {
+      parse_literal("null");
+      return json_value{nullptr};
+    }
+
+    default: {
+      return json_value{parse_number()};
+    }
+  }
+}
+
+json_value json_parser::parse_object()
+{
+  expect('{');
+
+  json_value::object result;
+
+  skip_whitespace();
+  if (peek() == '}') {
+    ++_position;
+    return json_value{std::move(result)};
+  }
+
+  while (true) {
+    skip_whitespace();
+    std::string name{parse_string()};
+
+    skip_whitespace();
+    expect(':');
+
+    result.emplace_back(std::move(name), parse_value());
+
+    skip_whitespace();
+    if (peek() == ',') {
+      ++_position;
+      continue;
+    }
+
+    expect('}');
+    return json_value{std::move(result)};
+  }
+}
+
+json_value json_parser::parse_array()
+{
+  expect('[');
+
+  json_value::array result;
+
+  skip_whitespace();
+  if (peek() == ']') {
+    ++_position;
+    return json_value{std::move(result)};
+  }
+
+  while (true) {
+    result.push_back(parse_value());
+
+    skip_whitespace();
+    if (peek() == ',') {
+      ++_position;
+      continue;
+    }
+
+    expect(']');
+    return json_value{std::move(result)};
+  }
+}
+
+std::string json_parser::parse_string()
+{
+  expect('"');
+
+  std::string result;
+
+  while (true) {
+    const char c{peek()};
+    ++_position;
+
+    if (c == '"') {
+      return result;
+    }
+
+    if (c != '\\') {
+      result.push_back(c);
+      continue;
+    }
+
+    const char escaped{peek()};
+    ++_position;
+
+    switch (escaped) {
+      case '"':
+      case '\\':
+      case '/': {
+        result.push_back(escaped);
+      } break;
+
+      case 'b': {
+        result.push_back('\b');
+      } break;
+
+      case 'f': {
+        result.push_back('\f');
+      } break;
+
+      case 'n': {
+        result.push_back('\n');
+      } break;
+
+      case 'r': {
+        result.push_back('\r');
+      } break;
+
+      case 't': {
+        result.push_back('\t');
+      } break;
+
+      default: {
+        // Ids are expected to be ASCII, `\u` escapes are not supported
+        fail(fmt::format("unsupported escape sequence '\\{}'", escaped));
+      }
+    }
+  }
+}
+
+double json_parser::parse_number()
+{
+  // `std::from_chars` also accepts infinities and NaNs, which are not valid in JSON
+  const gsl::index digit_position{peek() == '-' ? _position + 1 : _position};
+  if (digit_position >= std::ssize(_text) || !is_digit(_text[digit_position])) {
+    fail("expected a value");
+  }
+
+  const char* begin{_text.data() + _position};
+  const char* end{_text.data() + _text.size()};
+
+  double result{0.0};
+  const std::from_chars_result from_chars_result{std::from_chars(begin, end, result)};
+  if (from_chars_result.ec != std::errc{}) {
+    fail("expected a value");
+  }
+
+  _position += from_chars_result.ptr - begin;
+
+  return result;
+}
+
+void json_parser::parse_literal(const std::string_view literal)
+{
+  if (!_text.substr(_position).starts_with(literal)) {
+    fail(fmt::format("expected '{}'", literal));
+  }
+
+  _position += std::ssize(literal);
+}
+
+void json_parser::skip_whitespace()
+{
+  while (_position < std::ssize(_text)) {
+    const char c{_text[_position]};
+    if (c != ' ' && c != '\t' && c != '\n' && c != '\r') {
+      break;
+    }
+
+    ++_position;
+  }
+}
+
+char json_parser::peek() const
+{
+  if (_position >= std::ssize(_text)) {
+    fail("unexpected end of text");
+  }
+
+  return _text[_position];
+}
+
+void json_parser::expect(const char c)
+{
+  if (peek() != c) {
+    fail(fmt::format("expected '{}'", c));
+  }
+
+  ++_position;
+}
+
+void json_parser::fail(const std::string_view message) const
+{
+  throw std::runtime_error{fmt::format("JSON error at offset {}: {}", _position, message)};
+}
+
+json_value json_parse(const std::string_view text)
+{
+  json_parser parser{text};
+  return parser.parse_document();
+}
+
+const json_value* json_find(const json_value& value, const std::string_view name)
+{
+  const auto* object{std::get_if<json_value::object>(&value.data)};
+  if (object == nullptr) {
+    throw std::runtime_error{fmt::format("JSON error: expected an object with '{}'", name)};
+  }
+
+  for (const auto& [member_name, member_value] : *object) {
+    if (member_name == name) {
+      return &member_value;
+    }
+  }
+
+  return nullptr;
+}
+
+const json_value& json_get(const json_value& value, const std::string_view name)
+{
+  const json_value* member{json_find(value, name)};
+  if (member == nullptr) {
+    throw std::runtime_error{fmt::format("JSON error: missing '{}'", name)};
+  }
+
+  return *member;
+}
+
+float json_as_float(const json_value& value)
+{
+  const auto* number{std::get_if<double>(&value.data)};
+  if (number == nullptr) {
+    throw std::runtime_error{"JSON error: expected a number"};
+  }
+
+  return static_cast<float>(*number);
+}
+
+bool json_as_bool(const json_value& value)
+{
+  const auto* boolean{std::get_if<bool>(&value.data)};
+  if (boolean == nullptr) {
+    throw std::runtime_error{"JSON error: expected a boolean"};
+  }
+
+  return *boolean;
+}
+
+const std::string& json_as_string(const json_value& value)
+{
+  const auto* string{std::get_if<std::string>(&value.data)};
+  if (string == nullptr) {
+    throw std::runtime_error{"JSON error: expected a string"};
+  }
+
+  return *string;
+}
+
+const json_value::array& json_as_array(const json_value& value)
+{
+  const auto* array{std::get_if<json_value::array>(&value.data)};
+  if (array == nullptr) {
+    throw std::runtime_error{"JSON error: expected an array"};
+  }
+
+  return *array;
+}
+
+std::vector<float> json_as_floats(const json_value& value, const gsl::index size)
+{
+  const json_value::array& array{json_as_array(value)};
+  if (std::ssize(array) != size) {
+    throw std::runtime_error{fmt::format("JSON error: expected an array of {} numbers", size)};
+  }
+
+  std::vector<float> result;
+  result.reserve(array.size());
+
+  for (const json_value& element : array) {
+    result.push_back(json_as_float(element));
+  }
+
+  return result;
+}
+}  // namespace eely
\ No newline at end of file
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <gsl/util>
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace eely {
+// Value parsed from a JSON text.
+struct json_value final {
+  using array = std::vector<json_value>;
+
+  // Members are kept in the order they appear in a text.
+  using object = std::vector<std::pair<std::string, json_value>>;
+
+  std::variant<std::nullptr_t, bool, double, std::string, array, object> data;
+};
+
+// Parse JSON text.
+// Throw `std::runtime_error` if text is not a valid JSON.
+json_value json_parse(std::string_view text);
+
+// Return member with specified name, or `nullptr` if there is no such member.
+// Throw `std::runtime_error` if value is not an object.
+const json_value* json_find(const json_value& value, std::string_view name);
+
+// Return member with specified name.
+// Throw `std::runtime_error` if value is not an object or there is no such member.
+const json_value& json_get(const json_value& value, std::string_view name);
+
+// Return value as a number.
+// Throw `std::runtime_error` if value has a different type.
+float json_as_float(const json_value& value);
+
+// Return value as a boolean.
+// Throw `std::runtime_error` if value has a different type.
+bool json_as_bool(const json_value& value);
+
+// Return value as a string.
+// Throw `std::runtime_error` if value has a different type.
+const std::string& json_as_string(const json_value& value);
+
+// Return value as an array.
+// Throw `std::runtime_error` if value has a different type.
+const json_value::array& json_as_array(const json_value& value);
+
+// Return value as an array of numbers with specified size.
+// Throw `std::runtime_error` if value has a different type or size.
+std::vector<float> json_as_floats(const json_value& value, gsl::index size);
+}  // namespace eely
\ No newline at end of file
@@ -0,0 +1,73 @@
+#include "eely_cook/json.h"
+#include "eely_cook/project_json.h"
+
+#include <eely/base/bit_reader.h>
+#include <eely/base/file_utils.h>
+#include <eely/project/project.h>
+#include <eely/project/project_uncooked.h>
+
+#include <fmt/format.h>
+
+#include <cstddef>
+#include <cstdio>
+#include <exception>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Headless cooker: converts uncooked projects into cooked ones,
+// so that applications can load them directly without importing and cooking on startup.
+//
+// Usage: eely_cook <input> <output>
+// Input is either a serialized `project_uncooked`,
+// or a JSON description of one if file has ".json" extension (see `project_json.h`).
+
+static std::unique_ptr<eely::project_uncooked> load_project_uncooked(
+    const std::filesystem::path& path)
+{
+  using namespace eely;
+  using namespace eely::internal;
+
+  const std::vector<std::byte> data{read_file(path)};
+
+  if (path.extension() == ".json") {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast), old interface
+    const std::string text{reinterpret_cast<const char*>(data.data()), data.size()};
+    return project_uncooked_from_json(json_parse(text));
+  }
+
+  bit_reader reader{data};
+  return std::make_unique<project_uncooked>(reader);
+}
+
+int main(int argc, char** argv)
+{
+  using namespace eely;
+
+  if (argc != 3) {
+    fmt::print(stderr, "Usage: eely_cook <input> <output>\n");
+    return 1;
+  }
+
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic), C interface
+  const std::filesystem::path input_path{argv[1]};
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic), C interface
+  const std::filesystem::path output_path{argv[2]};
+
+  try {
+    const std::unique_ptr<project_uncooked> uncooked{load_project_uncooked(input_path)};
+
+    const std::vector<std::byte> buffer{project::cook(*uncooked)};
+    write_file(output_path, buffer);
+
+    fmt::print("Cooked {} into {} ({} bytes)\n", input_path.string(), output_path.string(),
+               buffer.size());
+  }
+  catch (const std::exception& e) {
+    fmt::print(stderr, "Cooking {} failed: {}\n", input_path.string(), e.what());
+    return 1;
+  }
+
+  return 0;
+}
\ No newline at end of file
@@ -0,0 +1,520 @@
+#include "eely_cook/project_json.h"
+
+#include "eely_cook/json.h"
+
+#include <eely/anim_graph/anim_graph_node_base.h>
+#include <eely/anim_graph/anim_graph_node_blend.h>
+#include <eely/anim_graph/anim_graph_node_clip.h>
+#include <eely/anim_graph/anim_graph_node_param.h>
+#include <eely/anim_graph/anim_graph_node_param_comparison.h>
+#include <eely/anim_graph/anim_graph_node_random.h>
+#include <eely/anim_graph/anim_graph_node_speed.h>
+#include <eely/anim_graph/anim_graph_node_state.h>
+#include <eely/anim_graph/anim_graph_node_state_machine.h>
+#include <eely/anim_graph/anim_graph_node_state_transition.h>
+#include <eely/anim_graph/anim_graph_uncooked.h>
+#include <eely/base/string_id.h>
+#include <eely/clip/clip_compression_scheme.h>
+#include <eely/clip/clip_player_base.h>
+#include <eely/clip/clip_uncooked.h>
+#include <eely/math/float3.h>
+#include <eely/math/quaternion.h>
+#include <eely/math/transform.h>
+#include <eely/params/params.h>
+#include <eely/project/axis_system.h>
+#include <eely/project/measurement_unit.h>
+#include <eely/project/project_uncooked.h>
+#include <eely/skeleton/skeleton_uncooked.h>
+#include <eely/skeleton_mask/skeleton_mask_uncooked.h>
+
+#include <fmt/format.h>
+
+#include <gsl/util>
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace eely {
+static const json_value::array& get_array_or_empty(const json_value& value,
+                                                   const std::string_view name)
+{
+  static const json_value::array empty;
+
+  const json_value* member{json_find(value, name)};
+  return member != nullptr ? json_as_array(*member) : empty;
+}
+
+static float3 get_float3(const json_value& value, const std::string_view name, const float3& def)
+{
+  const json_value* member{json_find(value, name)};
+  if (member == nullptr) {
+    return def;
+  }
+
+  const std::vector<float> floats{json_as_floats(*member, 3)};
+  return float3{floats[0], floats[1], floats[2]};
+}
+
+static std::optional<float3> get_float3_opt(const json_value& value, const std::string_view name)
+{
+  if (json_find(value, name) == nullptr) {
+    return std::nullopt;
+  }
+
+  return get_float3(value, name, float3::zeroes);
+}
+
+static std::optional<quaternion> get_quaternion_opt(const json_value& value,
+                                                    const std::string_view name)
+{
+  const json_value* member{json_find(value, name)};
+  if (member == nullptr) {
+    return std::nullopt;
+  }
+
+  const std::vector<float> floats{json_as_floats(*member, 4)};
+  return quaternion{floats[0], floats[1], floats[2], floats[3]};
+}
+
+static std::optional<clip_additive_uncooked::range> get_range_opt(const json_value& value,
+                                                                  const std::string_view name)
+{
+  const json_value* member{json_find(value, name)};
+  if (member == nullptr) {
+    return std::nullopt;
+  }
+
+  const std::vector<float> floats{json_as_floats(*member, 2)};
+  return clip_additive_uncooked::range{.from_s = floats[0], .to_s = floats[1]};
+}
+
+static string_id get_id_or_empty(const json_value& value, const std::string_view name)
+{
+  const json_value* member{json_find(value, name)};
+  return member != nullptr ? json_as_string(*member) : string_id{};
+}
+
+static measurement_unit parse_measurement_unit(const std::string& name)
+{
+  if (name == "meters") {
+    return measurement_unit::meters;
+  }
+
+  if (name == "centimeters") {
+    return measurement_unit::centimeters;
+  }
+
+  throw std::runtime_error{fmt::format("Unknown measurement unit: {}", name)};
+}
+
+static clip_compression_scheme parse_compression_scheme(const json_value& clip_description)
+{
+  const json_value* member{json_find(clip_description, "compression")};
+  if (member == nullptr) {
+    return clip_compression_scheme::acl;
+  }
+
+  const std::string& name{json_as_string(*member)};
+
+  if (name == "none") {
+    return clip_compression_scheme::none;
+  }
+
+  if (name == "fixed") {
+    return clip_compression_scheme::fixed;
+  }
+
+  if (name == "acl") {
+    return clip_compression_scheme::acl;
+  }
+
+  if (name == "uniform") {
+    return clip_compression_scheme::uniform;
+  }
+
+  throw std::runtime_error{fmt::format("Unknown compression scheme: {}", name)};
+}
+
+static void add_skeleton(project_uncooked& project, const json_value& description)
+{
+  auto& skeleton{
+      project.add_resource<skeleton_uncooked>(json_as_string(json_get(description, "id")))};
+
+  std::vector<skeleton_uncooked::joint> joints;
+
+  for (const json_value& joint_description : json_as_array(json_get(description, "joints"))) {
+    skeleton_uncooked::joint joint{.id = json_as_string(json_get(joint_description, "id"))};
+
+    if (const json_value* parent{json_find(joint_description, "parent")}) {
+      const string_id& parent_id{json_as_string(*parent)};
+      const auto parent_iter{std::find_if(
+          joints.begin(), joints.end(), [&parent_id](const auto& j) { return j.id == parent_id; })};
+      if (parent_iter == joints.end()) {
+        throw std::runtime_error{
+            fmt::format("Joint {} is listed before its parent {}", joint.id, parent_id)};
+      }
+
+      joint.parent_index = std::distance(joints.begin(), parent_iter);
+    }
+
+    joint.rest_pose_transform.translation =
+        get_float3(joint_description, "translation", float3::zeroes);
+    joint.rest_pose_transform.rotation =
+        get_quaternion_opt(joint_description, "rotation").value_or(quaternion::identity);
+    joint.rest_pose_transform.scale = get_float3(joint_description, "scale", float3::ones);
+
+    joints.push_back(joint);
+  }
+
+  skeleton.get_joints() = std::move(joints);
+}
+
+static void add_skeleton_mask(project_uncooked& project, const json_value& description)
+{
+  auto& skeleton_mask{
+      project.add_resource<skeleton_mask_uncooked>(json_as_string(json_get(description, "id")))};
+  skeleton_mask.set_target_skeleton_id(json_as_string(json_get(description, "skeleton")));
+
+  for (const json_value& weight_description : get_array_or_empty(description, "weights")) {
+    const auto get_weight = [&weight_description](const std::string_view name) {
+      const json_value* member{json_find(weight_description, name)};
+      return member != nullptr ? json_as_float(*member) : 1.0F;
+    };
+
+    skeleton_mask.get_weights()[json_as_string(json_get(weight_description, "joint"))] =
+        joint_weight{.translation = get_weight("translation"),
+                     .rotation = get_weight("rotation"),
+                     .scale = get_weight("scale")};
+  }
+}
+
+static void add_clip(project_uncooked& project, const json_value& description)
+{
+  auto& clip{project.add_resource<clip_uncooked>(json_as_string(json_get(description, "id")))};
+  clip.set_target_skeleton_id(json_as_string(json_get(description, "skeleton")));
+  clip.set_skeleton_mask_id(get_id_or_empty(description, "skeleton_mask"));
+  clip.set_compression_scheme(parse_compression_scheme(description));
+
+  if (const json_value* optimize_loops{json_find(description, "optimize_loops")}) {
+    clip.set_acl_optimize_loops(json_as_bool(*optimize_loops));
+  }
+
+  std::vector<clip_uncooked_track> tracks;
+
+  for (const json_value& track_description : get_array_or_empty(description, "tracks")) {
+    clip_uncooked_track& track{tracks.emplace_back(clip_uncooked_track{
+        .joint_id = json_as_string(json_get(track_description, "joint"))})};
+
+    for (const json_value& key_description : get_array_or_empty(track_description, "keys")) {
+      const float time_s{json_as_float(json_get(key_description, "time"))};
+      track.keys[time_s] = {.translation = get_float3_opt(key_description, "translation"),
+                            .rotation = get_quaternion_opt(key_description, "rotation"),
+                            .scale = get_float3_opt(key_description, "scale")};
+    }
+  }
+
+  clip.set_tracks(std::move(tracks));
+}
+
+static void add_clip_additive(project_uncooked& project, const json_value& description)
+{
+  auto& clip{
+      project.add_resource<clip_additive_uncooked>(json_as_string(json_get(description, "id")))};
+  clip.set_target_skeleton_id(json_as_string(json_get(description, "skeleton")));
+  clip.set_skeleton_mask_id(get_id_or_empty(description, "skeleton_mask"));
+  clip.set_compression_scheme(parse_compression_scheme(description));
+  clip.set_base_clip_id(json_as_string(json_get(description, "base_clip")));
+  clip.set_base_clip_range(get_range_opt(description, "base_range"));
+  clip.set_source_clip_id(json_as_string(json_get(description, "source_clip")));
+  clip.set_source_clip_range(get_range_opt(description, "source_range"));
+}
+
+// Ids of graph nodes by their names, nodes reference each other by names in a description.
+using node_ids_by_name = std::unordered_map<std::string, int>;
+
+static int get_node_id(const node_ids_by_name& node_ids, const json_value& name_value)
+{
+  const std::string& name{json_as_string(name_value)};
+
+  const auto iter{node_ids.find(name)};
+  if (iter == node_ids.end()) {
+    throw std::runtime_error{fmt::format("Unknown node: {}", name)};
+  }
+
+  return iter->second;
+}
+
+static std::optional<int> get_node_id_opt(const node_ids_by_name& node_ids,
+                                          const json_value& description,
+                                          const std::string_view name)
+{
+  const json_value* member{json_find(description, name)};
+  if (member == nullptr) {
+    return std::nullopt;
+  }
+
+  return get_node_id(node_ids, *member);
+}
+
+static std::vector<int> get_node_ids(const node_ids_by_name& node_ids,
+                                     const json_value& description,
+                                     const std::string_view name)
+{
+  std::vector<int> result;
+  for (const json_value& name_value : get_array_or_empty(description, name)) {
+    result.push_back(get_node_id(node_ids, name_value));
+  }
+
+  return result;
+}
+
+static clip_sample_rounding parse_sample_rounding(const std::string& name)
+{
+  if (name == "none") {
+    return clip_sample_rounding::none;
+  }
+
+  if (name == "floor") {
+    return clip_sample_rounding::floor;
+  }
+
+  if (name == "ceil") {
+    return clip_sample_rounding::ceil;
+  }
+
+  if (name == "nearest") {
+    return clip_sample_rounding::nearest;
+  }
+
+  throw std::runtime_error{fmt::format("Unknown sample rounding: {}", name)};
+}
+
+static clip_looping_policy parse_looping_policy(const std::string& name)
+{
+  if (name == "as_cooked") {
+    return clip_looping_policy::as_cooked;
+  }
+
+  if (name == "wrap") {
+    return clip_looping_policy::wrap;
+  }
+
+  throw std::runtime_error{fmt::format("Unknown looping policy: {}", name)};
+}
+
+static param_value parse_param_value(const json_value& description)
+{
+  if (const json_value* value{json_find(description, "value_int")}) {
+    const float number{json_as_float(*value)};
+    if (std::trunc(number) != number) {
+      throw std::runtime_error{fmt::format("Value {} is not an integer", number)};
+    }
+
+    return static_cast<int>(number);
+  }
+
+  if (const json_value* value{json_find(description, "value_float")}) {
+    return json_as_float(*value);
+  }
+
+  if (const json_value* value{json_find(description, "value_bool")}) {
+    return json_as_bool(*value);
+  }
+
+  throw std::runtime_error{"Param comparison has no value"};
+}
+
+static anim_graph_node_base& add_graph_node(anim_graph_uncooked& graph, const std::string& type)
+{
+  if (type == "blend") {
+    return graph.add_node<anim_graph_node_blend>();
+  }
+
+  if (type == "clip") {
+    return graph.add_node<anim_graph_node_clip>();
+  }
+
+  if (type == "param") {
+    return graph.add_node<anim_graph_node_param>();
+  }
+
+  if (type == "param_comparison") {
+    return graph.add_node<anim_graph_node_param_comparison>();
+  }
+
+  if (type == "random") {
+    return graph.add_node<anim_graph_node_random>();
+  }
+
+  if (type == "speed") {
+    return graph.add_node<anim_graph_node_speed>();
+  }
+
+  if (type == "state") {
+    return graph.add_node<anim_graph_node_state>();
+  }
+
+  if (type == "state_machine") {
+    return graph.add_node<anim_graph_node_state_machine>();
+  }
+
+  if (type == "state_transition") {
+    return graph.add_node<anim_graph_node_state_transition>();
+  }
+
+  throw std::runtime_error{fmt::format("Unknown node type: {}", type)};
+}
+
+// Set node's properties from its description, `node` is of type added by `add_graph_node`.
+static void set_graph_node(anim_graph_node_base& node,
+                           const std::string& type,
+                           const json_value& description,
+                           const node_ids_by_name& node_ids)
+{
+  if (type == "blend") {
+    auto& blend{static_cast<anim_graph_node_blend&>(node)};
+    for (const json_value& pose_description : get_array_or_empty(description, "poses")) {
+      blend.get_pose_nodes().push_back(
+          {.id = get_node_id(node_ids, json_get(pose_description, "node")),
+           .factor = json_as_float(json_get(pose_description, "factor"))});
+    }
+    blend.set_factor_node_id(get_node_id_opt(node_ids, description, "factor_node"));
+  }
+  else if (type == "clip") {
+    auto& clip{static_cast<anim_graph_node_clip&>(node)};
+    clip.set_clip_id(json_as_string(json_get(description, "clip")));
+    if (const json_value* rounding{json_find(description, "sample_rounding")}) {
+      clip.set_sample_rounding(parse_sample_rounding(json_as_string(*rounding)));
+    }
+    if (const json_value* looping{json_find(description, "looping_policy")}) {
+      clip.set_looping_policy(parse_looping_policy(json_as_string(*looping)));
+    }
+  }
+  else if (type == "param") {
+    static_cast<anim_graph_node_param&>(node).set_param_id(
+        json_as_string(json_get(description, "param")));
+  }
+  else if (type == "param_comparison") {
+    auto& comparison{static_cast<anim_graph_node_param_comparison&>(node)};
+    comparison.set_param_id(json_as_string(json_get(description, "param")));
+    comparison.set_value(parse_param_value(description));
+    if (const json_value* op{json_find(description, "op")}) {
+      const std::string& op_name{json_as_string(*op)};
+      if (op_name == "equal") {
+        comparison.set_op(anim_graph_node_param_comparison::op::equal);
+      }
+      else if (op_name == "not_equal") {
+        comparison.set_op(anim_graph_node_param_comparison::op::not_equal);
+      }
+      else {
+        throw std::runtime_error{fmt::format("Unknown comparison: {}", op_name)};
+      }
+    }
+  }
+  else if (type == "random") {
+    static_cast<anim_graph_node_random&>(node).get_children_nodes() =
+        get_node_ids(node_ids, description, "children");
+  }
+  else if (type == "speed") {
+    auto& speed{static_cast<anim_graph_node_speed&>(node)};
+    speed.set_child_node(get_node_id_opt(node_ids, description, "child"));
+    speed.set_speed_provider_node(get_node_id_opt(node_ids, description, "speed_provider"));
+  }
+  else if (type == "state") {
+    auto& state{static_cast<anim_graph_node_state&>(node)};
+    state.set_name(get_id_or_empty(description, "name"));
+    state.set_pose_node(get_node_id_opt(node_ids, description, "pose"));
+    state.get_out_transition_nodes() = get_node_ids(node_ids, description, "transitions");
+  }
+  else if (type == "state_machine") {
+    static_cast<anim_graph_node_state_machine&>(node).get_state_nodes() =
+        get_node_ids(node_ids, description, "states");
+  }
+  else if (type == "state_transition") {
+    auto& transition{static_cast<anim_graph_node_state_transition&>(node)};
+    transition.set_condition_node(get_node_id_opt(node_ids, description, "condition"));
+    transition.set_destination_state_node(get_node_id_opt(node_ids, description, "destination"));
+    if (const json_value* duration{json_find(description, "duration")}) {
+      transition.set_duration_s(json_as_float(*duration));
+    }
+    if (const json_value* reversible{json_find(description, "reversible")}) {
+      transition.set_reversible(json_as_bool(*reversible));
+    }
+  }
+}
+
+static void add_anim_graph(project_uncooked& project, const json_value& description)
+{
+  auto& graph{
+      project.add_resource<anim_graph_uncooked>(json_as_string(json_get(description, "id")))};
+  graph.set_skeleton_id(json_as_string(json_get(description, "skeleton")));
+
+  // Nodes can reference nodes listed after them,
+  // thus all nodes are added first and their properties are set afterwards
+
+  const json_value::array& node_descriptions{json_as_array(json_get(description, "nodes"))};
+
+  node_ids_by_name node_ids;
+  std::vector<anim_graph_node_base*> nodes;
+
+  for (const json_value& node_description : node_descriptions) {
+    const std::string& name{json_as_string(json_get(node_description, "id"))};
+    anim_graph_node_base& node{
+        add_graph_node(graph, json_as_string(json_get(node_description, "type")))};
+
+    if (!node_ids.emplace(name, node.get_id()).second) {
+      throw std::runtime_error{fmt::format("Node {} is listed twice", name)};
+    }
+
+    nodes.push_back(&node);
+  }
+
+  for (gsl::index i{0}; i < std::ssize(nodes); ++i) {
+    set_graph_node(*nodes[i], json_as_string(json_get(node_descriptions[i], "type")),
+                   node_descriptions[i], node_ids);
+  }
+
+  graph.set_root_node_id(get_node_id_opt(node_ids, description, "root"));
+}
+
+std::unique_ptr<project_uncooked> project_uncooked_from_json(const json_value& description)
+{
+  measurement_unit unit{measurement_unit::meters};
+  if (const json_value* unit_description{json_find(description, "measurement_unit")}) {
+    unit = parse_measurement_unit(json_as_string(*unit_description));
+  }
+
+  auto project{std::make_unique<project_uncooked>(unit, axis_system::y_up_x_right_z_forward)};
+
+  for (const json_value& d : get_array_or_empty(description, "skeletons")) {
+    add_skeleton(*project, d);
+  }
+
+  for (const json_value& d : get_array_or_empty(description, "skeleton_masks")) {
+    add_skeleton_mask(*project, d);
+  }
+
+  for (const json_value& d : get_array_or_empty(description, "clips")) {
+    add_clip(*project, d);
+  }
+
+  for (const json_value& d : get_array_or_empty(description, "clips_additive")) {
+    add_clip_additive(*project, d);
+  }
+
+  for (const json_value& d : get_array_or_empty(description, "anim_graphs")) {
+    add_anim_graph(*project, d);
+  }
+
+  return project;
+}
+}  // namespace eely
\ No newline at end of file
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "eely_cook/json.h"
+
+#include <eely/project/project_uncooked.h>
+
+#include <memory>
+
+namespace eely {
+// Create uncooked project from its JSON description.
+// Throw `std::runtime_error` if description is malformed.
+//
+// Description is an object with following members, all optional:
+//   "measurement_unit": "meters" or "centimeters"
+//   "skeletons": [{"id", "joints": [{"id", "parent", "translation", "rotation", "scale"}]}]
+//   "skeleton_masks": [{"id", "skeleton", "weights": [{"joint", "translation",
+//                                                      "rotation", "scale"}]}]
+//   "clips": [{"id", "skeleton", "skeleton_mask", "compression", "optimize_loops",
+//              "tracks": [{"joint", "keys": [{"time", "translation", "rotation", "scale"}]}]}]
+//   "clips_additive": [{"id", "skeleton", "skeleton_mask", "compression",
+//                       "base_clip", "base_range", "source_clip", "source_range"}]
+//   "anim_graphs": [{"id", "skeleton", "root", "nodes": [{"id", "type", ...}]}]
+//
+// Joint's "parent" is an id of a joint listed before it, root joints have none.
+// Translations and scales are arrays of three numbers, rotations are quaternions [x, y, z, w].
+// Ranges are arrays of two numbers: start and end time in seconds.
+// Compression is "none", "fixed", "acl" or "uniform".
+// Clip's "optimize_loops" is a boolean, see `clip_uncooked::set_acl_optimize_loops`.
+//
+// Graph nodes reference each other by their "id", which is unique within a graph.
+// Supported node types and their members:
+//   "blend": "poses": [{"node", "factor"}], "factor_node"
+//   "clip": "clip", "sample_rounding" ("none", "floor", "ceil", "nearest"),
+//           "looping_policy" ("as_cooked", "wrap")
+//   "param": "param"
+//   "param_comparison": "param", one of "value_int", "value_float", "value_bool",
+//                       "op" ("equal", "not_equal")
+//   "random": "children"
+//   "speed": "child", "speed_provider"
+//   "state": "name", "pose", "transitions"
+//   "state_machine": "states"
+//   "state_transition": "condition", "destination", "duration", "reversible"
+// Graphs with other node types can only be cooked from serialized uncooked projects.
+std::unique_ptr<project_uncooked> project_uncooked_from_json(const json_value& description);
+}  // namespace eely
\ No newline at end of file
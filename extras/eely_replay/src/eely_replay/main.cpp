@@ -0,0 +1,138 @@
+#include <eely/anim_graph/anim_graph.h>
+#include <eely/anim_graph/anim_graph_player.h>
+#include <eely/base/file_utils.h>
+#include <eely/base/string_id.h>
+#include <eely/params/params.h>
+#include <eely/params/params_recording.h>
+#include <eely/project/project.h>
+#include <eely/skeleton/skeleton.h>
+#include <eely/skeleton/skeleton_pose.h>
+
+#include <fmt/format.h>
+
+#include <gsl/util>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <exception>
+#include <filesystem>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Headless benchmark: replays a session recorded with `params_recorder`
+// on many instances of a graph player and reports frame time percentiles.
+// Replays are deterministic, so the same spikes can be reproduced and profiled over and over.
+//
+// Usage: eely_replay <project> <graph> <recording> [instances] [repeats]
+// Project is a cooked project file, graph is an id of an animation graph in it.
+
+// Return value at specified percentile from sorted values, using nearest rank.
+static float get_percentile(const std::vector<float>& sorted_values, const float percentile)
+{
+  const auto rank{static_cast<gsl::index>(
+      std::ceil(percentile / 100.0F * static_cast<float>(sorted_values.size())))};
+  return sorted_values[std::clamp<gsl::index>(rank - 1, 0, std::ssize(sorted_values) - 1)];
+}
+
+// Replay recording on specified number of fresh players,
+// and append time every frame took into `out_frame_times_us`.
+static void replay(const eely::anim_graph& graph,
+                   const eely::skeleton& skeleton,
+                   eely::params_replayer& replayer,
+                   const gsl::index instances_count,
+                   std::vector<float>& out_frame_times_us)
+{
+  using namespace eely;
+
+  // Recording starts with fresh players, so does the replay
+  std::vector<std::unique_ptr<anim_graph_player>> players;
+  std::vector<skeleton_pose> poses;
+  for (gsl::index i{0}; i < instances_count; ++i) {
+    players.push_back(std::make_unique<anim_graph_player>(graph));
+    players.back()->set_random_seed(replayer.get_random_seed());
+    poses.emplace_back(skeleton);
+  }
+
+  params params;
+
+  replayer.restart();
+  while (!replayer.is_finished()) {
+    const float dt_s{replayer.replay(params)};
+
+    const auto begin{std::chrono::steady_clock::now()};
+
+    for (gsl::index i{0}; i < instances_count; ++i) {
+      players[i]->play(dt_s, params, poses[i]);
+    }
+
+    const auto end{std::chrono::steady_clock::now()};
+    out_frame_times_us.push_back(std::chrono::duration<float, std::micro>(end - begin).count());
+  }
+}
+
+int main(int argc, char** argv)
+{
+  using namespace eely;
+
+  if (argc < 4 || argc > 6) {
+    fmt::print(stderr, "Usage: eely_replay <project> <graph> <recording> [instances] [repeats]\n");
+    return 1;
+  }
+
+  // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic), C interface
+  const std::filesystem::path project_path{argv[1]};
+  const string_id graph_id{argv[2]};
+  const std::filesystem::path recording_path{argv[3]};
+  const int instances_count{argc > 4 ? std::stoi(argv[4]) : 100};
+  const int repeats_count{argc > 5 ? std::stoi(argv[5]) : 1};
+  // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+
+  try {
+    std::vector<std::byte> project_data{read_file(project_path)};
+    const project cooked_project{project_data};
+
+    const auto* graph{cooked_project.get_resource<anim_graph>(graph_id)};
+    if (graph == nullptr) {
+      throw std::runtime_error{fmt::format("There is no animation graph {}", graph_id)};
+    }
+
+    const auto* graph_skeleton{cooked_project.get_resource<skeleton>(graph->get_skeleton_id())};
+    if (graph_skeleton == nullptr) {
+      throw std::runtime_error{fmt::format("There is no skeleton {}", graph->get_skeleton_id())};
+    }
+
+    const std::vector<std::byte> recording{read_file(recording_path)};
+    params_replayer replayer{recording};
+
+    std::vector<float> frame_times_us;
+    for (int i{0}; i < repeats_count; ++i) {
+      replay(*graph, *graph_skeleton, replayer, instances_count, frame_times_us);
+    }
+
+    if (frame_times_us.empty()) {
+      throw std::runtime_error{"Recording has no frames"};
+    }
+
+    std::sort(frame_times_us.begin(), frame_times_us.end());
+
+    fmt::print("Replayed {} frames {} times on {} instances\n", replayer.get_frames_count(),
+               repeats_count, instances_count);
+
+    for (const float percentile : {50.0F, 90.0F, 99.0F, 99.9F, 100.0F}) {
+      const float frame_time_us{get_percentile(frame_times_us, percentile)};
+      fmt::print("p{:<5}: {:10.1f} us per frame, {:8.2f} us per instance\n", percentile,
+                 frame_time_us, frame_time_us / static_cast<float>(instances_count));
+    }
+  }
+  catch (const std::exception& e) {
+    fmt::print(stderr, "Replaying {} failed: {}\n", recording_path.string(), e.what());
+    return 1;
+  }
+
+  return 0;
+}
\ No newline at end of file
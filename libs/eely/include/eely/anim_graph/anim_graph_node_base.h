@@ -18,6 +18,8 @@ enum class anim_graph_node_type {
   and_logic,  // `and` is a keyword :(
   blend,
   clip,
+  ik,
+  layer,
   param_comparison,
   param,
   random,
@@ -4,6 +4,9 @@
 #include "eely/base/bit_reader.h"
 #include "eely/base/bit_writer.h"
 #include "eely/base/string_id.h"
+#include "eely/clip/clip_player_base.h"
+
+#include <gsl/util>
 
 #include <memory>
 #include <unordered_set>
@@ -30,7 +33,28 @@ public:
   // Set id of a clip to play.
   void set_clip_id(string_id value);
 
+  // Get how time between two samples is handled when clip is played.
+  [[nodiscard]] clip_sample_rounding get_sample_rounding() const;
+
+  // Set how time between two samples is handled when clip is played,
+  // see `clip_player_base::set_sample_rounding`.
+  void set_sample_rounding(clip_sample_rounding value);
+
+  // Get how end of a clip is handled when clip is played.
+  [[nodiscard]] clip_looping_policy get_looping_policy() const;
+
+  // Set how end of a clip is handled when clip is played,
+  // see `clip_player_base::set_looping_policy`.
+  void set_looping_policy(clip_looping_policy value);
+
 private:
   string_id _clip_id;
+  clip_sample_rounding _sample_rounding{clip_sample_rounding::none};
+  clip_looping_policy _looping_policy{clip_looping_policy::as_cooked};
 };
+
+namespace internal {
+static constexpr gsl::index bits_clip_sample_rounding = 2;
+static constexpr gsl::index bits_clip_looping_policy = 1;
+}
 }  // namespace eely
\ No newline at end of file
@@ -0,0 +1,102 @@
+#pragma once
+
+#include "eely/anim_graph/anim_graph_node_base.h"
+#include "eely/base/bit_reader.h"
+#include "eely/base/bit_writer.h"
+#include "eely/base/string_id.h"
+#include "eely/ik/ik.h"
+
+#include <array>
+#include <memory>
+#include <optional>
+
+namespace eely {
+// Node that modifies a pose with inverse kinematics,
+// so that end of a chain reaches a target provided by other nodes.
+class anim_graph_node_ik final : public anim_graph_node_base {
+public:
+  // Describes which solver is used.
+  enum class solver {
+    // Analytic solver for a two-bone limb from skeleton mapping.
+    two_bone,
+
+    // Iterative solver for an arbitrary chain of joints.
+    fabrik
+  };
+
+  // Construct a node with specified unique ID within a graph.
+  explicit anim_graph_node_ik(int id);
+
+  // Construct a node from a memory buffer.
+  explicit anim_graph_node_ik(internal::bit_reader& reader);
+
+  void serialize(internal::bit_writer& writer) const override;
+
+  [[nodiscard]] anim_graph_node_uptr clone() const override;
+
+  // Get a node that produces a pose to modify.
+  [[nodiscard]] std::optional<int> get_pose_node_id() const;
+
+  // Set a node that produces a pose to modify.
+  void set_pose_node_id(std::optional<int> value);
+
+  // Get nodes that provide x, y and z coordinates of a target, relative to the object.
+  [[nodiscard]] const std::array<std::optional<int>, 3>& get_target_node_ids() const;
+
+  // Set nodes that provide x, y and z coordinates of a target, relative to the object.
+  void set_target_node_ids(const std::array<std::optional<int>, 3>& value);
+
+  // Get a node that provides weight between original and solved poses.
+  [[nodiscard]] std::optional<int> get_weight_node_id() const;
+
+  // Set a node that provides weight between original and solved poses.
+  // If not set, solved pose is used as is.
+  void set_weight_node_id(std::optional<int> value);
+
+  // Get solver type.
+  [[nodiscard]] solver get_solver() const;
+
+  // Set solver type.
+  void set_solver(solver value);
+
+  // Get limb solved by a two-bone solver.
+  [[nodiscard]] ik_limb get_limb() const;
+
+  // Set limb solved by a two-bone solver.
+  void set_limb(ik_limb value);
+
+  // Get id of a chain's root joint for a FABRIK solver.
+  [[nodiscard]] const string_id& get_chain_root_joint_id() const;
+
+  // Set id of a chain's root joint for a FABRIK solver.
+  void set_chain_root_joint_id(string_id value);
+
+  // Get id of a chain's tip joint for a FABRIK solver.
+  [[nodiscard]] const string_id& get_chain_tip_joint_id() const;
+
+  // Set id of a chain's tip joint for a FABRIK solver.
+  void set_chain_tip_joint_id(string_id value);
+
+  // Get FABRIK solver settings.
+  [[nodiscard]] const ik_fabrik_settings& get_fabrik_settings() const;
+
+  // Set FABRIK solver settings.
+  void set_fabrik_settings(const ik_fabrik_settings& value);
+
+private:
+  std::optional<int> _pose_node;
+  std::array<std::optional<int>, 3> _target_nodes;
+  std::optional<int> _weight_node;
+  solver _solver{solver::two_bone};
+  ik_limb _limb{ik_limb::left_arm};
+  string_id _chain_root_joint_id;
+  string_id _chain_tip_joint_id;
+  ik_fabrik_settings _fabrik_settings;
+};
+
+namespace internal {
+static constexpr gsl::index bits_ik_solver = 2;
+static constexpr gsl::index bits_ik_limb = 2;
+static constexpr gsl::index bits_ik_max_iterations = 8;
+}
+}  // namespace eely
\ No newline at end of file
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "eely/anim_graph/anim_graph_node_base.h"
+#include "eely/base/bit_reader.h"
+#include "eely/base/bit_writer.h"
+#include "eely/base/string_id.h"
+
+#include <memory>
+#include <optional>
+#include <unordered_set>
+
+namespace eely {
+// Node that layers one pose on top of another at runtime.
+// Each joint participates according to its weight in a skeleton mask,
+// multiplied by a global weight provided by another node.
+// This allows to store clips once and combine them per body part on the fly,
+// instead of cooking masked copies of clips for every combination.
+class anim_graph_node_layer final : public anim_graph_node_base {
+public:
+  // Describes how layer pose is combined with a base pose.
+  enum class mode {
+    // Layer pose replaces base pose according to weights.
+    blend,
+
+    // Layer pose is additive and is added to base pose according to weights.
+    add
+  };
+
+  // Construct a node with specified unique ID within a graph.
+  explicit anim_graph_node_layer(int id);
+
+  // Construct a node from a memory buffer.
+  explicit anim_graph_node_layer(internal::bit_reader& reader);
+
+  void serialize(internal::bit_writer& writer) const override;
+
+  void collect_dependencies(std::unordered_set<string_id>& out_dependencies) override;
+
+  [[nodiscard]] anim_graph_node_uptr clone() const override;
+
+  // Get a node that produces base pose.
+  [[nodiscard]] std::optional<int> get_base_node_id() const;
+
+  // Set a node that produces base pose.
+  void set_base_node_id(std::optional<int> value);
+
+  // Get a node that produces layer pose.
+  [[nodiscard]] std::optional<int> get_layer_node_id() const;
+
+  // Set a node that produces layer pose.
+  void set_layer_node_id(std::optional<int> value);
+
+  // Get a node that provides global weight of a layer.
+  [[nodiscard]] std::optional<int> get_weight_node_id() const;
+
+  // Set a node that provides global weight of a layer.
+  void set_weight_node_id(std::optional<int> value);
+
+  // Get id of a skeleton mask with per-joint weights.
+  [[nodiscard]] const string_id& get_skeleton_mask_id() const;
+
+  // Set id of a skeleton mask with per-joint weights.
+  void set_skeleton_mask_id(string_id value);
+
+  // Get mode by which layer pose is combined with a base pose.
+  [[nodiscard]] mode get_mode() const;
+
+  // Set mode by which layer pose is combined with a base pose.
+  void set_mode(mode value);
+
+private:
+  std::optional<int> _base_node;
+  std::optional<int> _layer_node;
+  std::optional<int> _weight_node;
+  string_id _skeleton_mask_id;
+  mode _mode{mode::blend};
+};
+
+namespace internal {
+static constexpr gsl::index bits_layer_mode = 2;
+}
+}  // namespace eely
\ No newline at end of file
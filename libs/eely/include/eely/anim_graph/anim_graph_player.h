@@ -2,27 +2,97 @@
 
 #include "eely/anim_graph/anim_graph.h"
 #include "eely/anim_graph/anim_graph_player_node_base.h"
+#include "eely/base/profiling.h"
+#include "eely/clip/clip_pose_cache.h"
 #include "eely/job/job_queue.h"
 #include "eely/params/params.h"
 #include "eely/project/project.h"
+#include "eely/skeleton/skeleton.h"
 #include "eely/skeleton/skeleton_pose.h"
 
+#include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <memory_resource>
+#include <optional>
 #include <unordered_map>
 #include <vector>
 
 namespace eely {
+// Average cost of a runtime node per graph computation.
+// Gathered by `anim_graph_player` only when compiled with `EELY_PROFILING`
+// and enabled for the player with `set_profiling_enabled`.
+struct anim_graph_player_node_cost final {
+  // Time of computing this node without its children.
+  float self_us{0.0F};
+
+  // Time of computing this node with its children.
+  float total_us{0.0F};
+
+  // Number of jobs this node adds.
+  float jobs_count{0.0F};
+
+  // Time of executing jobs this node adds.
+  float jobs_us{0.0F};
+
+  // Time of computing this node and all of its descendants, including their jobs.
+  float subtree_us{0.0F};
+};
+
 // Player for animation graphs.
 class anim_graph_player final {
 public:
   // Create a player for the specified graph.
-  explicit anim_graph_player(const anim_graph& anim_graph);
+  // Runtime nodes, their list and job queue's lists are allocated with `memory_resource`,
+  // which should outlive the player, e.g. to measure memory a player takes.
+  // Clip cursors, poses and containers owned by nodes use global allocator.
+  explicit anim_graph_player(
+      const anim_graph& anim_graph,
+      std::pmr::memory_resource* memory_resource = std::pmr::get_default_resource());
+
+  anim_graph_player(const anim_graph_player&) = delete;
+  anim_graph_player(anim_graph_player&&) = delete;
+
+  ~anim_graph_player();
+
+  anim_graph_player& operator=(const anim_graph_player&) = delete;
+  anim_graph_player& operator=(anim_graph_player&&) = delete;
 
   // Play a graph and put results into `out_pose`.
   void play(float dt_s, const params& params, skeleton_pose& out_pose);
 
+  // Set how often a graph is computed.
+  // With a period of N the graph is computed on every Nth `play` call only,
+  // and poses in between are extrapolated from the last two computed poses.
+  // Time of skipped calls is accumulated and passed to the next computation,
+  // thus phases keep advancing with the same speed.
+  // `offset` selects which calls compute the graph.
+  // Players with different offsets compute on different frames, which keeps per-frame cost flat.
+  // If offset is not specified, it is derived from player's random seed.
+  // Throws if period is not positive or offset is negative.
+  void set_update_period(int period, std::optional<int> offset = std::nullopt);
+
+  // Return how often a graph is computed, 1 means on every `play` call.
+  [[nodiscard]] int get_update_period() const;
+
+  // Return `true` if next `play` call is going to compute the graph.
+  [[nodiscard]] bool is_next_play_computed() const;
+
+  // Seed random generators of the graph's nodes.
+  // Players created for the same graph with the same seed make the same random choices,
+  // given the same `play` calls, which allows to replay recorded sessions.
+  // By default a player is seeded with a non-deterministic random number.
+  void set_random_seed(uint32_t seed);
+
+  // Return seed random generators of the graph's nodes were seeded with.
+  [[nodiscard]] uint32_t get_random_seed() const;
+
+  // Set cache of decoded clip poses to share with other players, `nullptr` disables caching.
+  // Cache should outlive the player.
+  void set_pose_cache(clip_pose_cache* pose_cache);
+
   // Get list of all runtime nodes.
-  [[nodiscard]] const std::vector<internal::anim_graph_player_node_uptr>& get_nodes() const;
+  [[nodiscard]] const std::pmr::vector<internal::anim_graph_player_node_uptr>& get_nodes() const;
 
   // Get runtime node by id.
   [[nodiscard]] const internal::anim_graph_player_node_base* get_player_node(int id) const;
@@ -32,17 +102,77 @@ public:
   // because nodes don't receive any signals about being deactivated.
   [[nodiscard]] bool is_player_node_active(const internal::anim_graph_player_node_base& node) const;
 
+  // Enable or disable gathering of profiling results for this player, disabled by default.
+  // Gathering aggregates recorded events after every computation,
+  // so it should only be enabled for players that are inspected, e.g. in an editor.
+  // Does nothing unless compiled with `EELY_PROFILING`.
+  void set_profiling_enabled(bool enabled);
+
+  // Return `true` if profiling results are gathered for this player.
+  [[nodiscard]] bool is_profiling_enabled() const;
+
+  // Return average time of a graph computation, including execution of its jobs.
+  // Averages are updated once per `profiling_window_size` computations,
+  // and are only available when profiling is enabled, otherwise zero is returned.
+  [[nodiscard]] float get_profiled_computation_us() const;
+
+  // Return average cost of a node with specified id,
+  // or `nullptr` if it wasn't computed during last profiling window.
+  [[nodiscard]] const anim_graph_player_node_cost* get_profiled_node_cost(int id) const;
+
+  // Number of graph computations profiling results are averaged over.
+  static constexpr int profiling_window_size{30};
+
 private:
-  internal::anim_graph_player_node_uptr create_player_node(const anim_graph_node_uptr& node);
+  internal::anim_graph_player_node_uptr create_player_node(const anim_graph_node_uptr& node,
+                                                           std::byte*& storage);
   static void init_player_node(
       const anim_graph_node_uptr& node,
       internal::anim_graph_player_node_base* player_node,
       const std::unordered_map<int, internal::anim_graph_player_node_base*>& id_to_player_node);
 
+#if defined(EELY_PROFILING)
+  // Gather events of a computation that started with specified events count and time.
+  void profiling_gather(int64_t events_count_begin, int64_t begin_ns);
+
+  // Average gathered statistics and start a new profiling window.
+  void profiling_finish_window();
+#endif
+
   const project& _project;
-  std::vector<internal::anim_graph_player_node_uptr> _nodes;
+  const skeleton& _skeleton;
+
+  std::pmr::memory_resource* _memory_resource{nullptr};
+
+  // All runtime nodes are placed into a single contiguous storage,
+  // released in destructor after nodes are destroyed.
+  std::byte* _nodes_storage{nullptr};
+  size_t _nodes_storage_size{0};
+  std::pmr::vector<internal::anim_graph_player_node_uptr> _nodes;
   internal::anim_graph_player_node_base* _root_node{nullptr};
   internal::job_queue _job_queue;
+  clip_pose_cache* _pose_cache{nullptr};
+  uint32_t _random_seed{0};
   int _play_counter{0};
+
+  // Update rate LOD
+  int _update_period{1};
+  std::optional<int> _update_offset;
+  int _calls_counter{0};
+  float _accumulated_dt_s{0.0F};
+  float _computed_interval_s{0.0F};
+  std::optional<skeleton_pose> _pose_computed_previous;
+  std::optional<skeleton_pose> _pose_computed_last;
+
+  // Profiling
+#if defined(EELY_PROFILING)
+  bool _profiling_enabled{false};
+  float _profiled_computation_us{0.0F};
+  std::unordered_map<int, anim_graph_player_node_cost> _profiled_node_costs;
+  std::vector<profiling_event> _profiling_events;
+  std::unordered_map<int, profiling_node_stats> _profiling_window_stats;
+  int64_t _profiling_window_ns{0};
+  int _profiling_window_computations{0};
+#endif
 };
 }  // namespace eely
\ No newline at end of file
@@ -1,11 +1,14 @@
 #pragma once
 
+#include "eely/clip/clip_pose_cache.h"
 #include "eely/job/job_queue.h"
 #include "eely/params/params.h"
 
 #include <optional>
 
 namespace eely::internal {
+class anim_graph_player_node_state_machine;
+
 // Context for animation graph update.
 struct anim_graph_player_context final {
   // Queue to feed jobs into by pose nodes.
@@ -31,5 +34,13 @@ struct anim_graph_player_context final {
 
   // Phase given by a parent node to be used in sync mode.
   std::optional<float> sync_phase;
+
+  // Innermost state machine that is being updated, `nullptr` if there is none.
+  // Used by state machine's descendants to query information about current states etc.
+  // Kept in a context instead of a global stack, so that graphs can be played on multiple threads.
+  const anim_graph_player_node_state_machine* state_machine{nullptr};
+
+  // Cache of decoded clip poses shared with other players, `nullptr` if caching is disabled.
+  clip_pose_cache* pose_cache{nullptr};
 };
 }  // namespace eely::internal
\ No newline at end of file
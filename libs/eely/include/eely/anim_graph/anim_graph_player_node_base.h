@@ -38,6 +38,11 @@ public:
   // Return last graph's play counter during which this node was active.
   [[nodiscard]] std::optional<int> get_last_play_counter() const;
 
+  // Remember this node being played on current update.
+  // Nodes are registered when computed, this is for results that are reused without computing,
+  // so that the node is still reported as active.
+  void register_play(const anim_graph_player_context& context) const;
+
 protected:
   virtual void compute_impl(const anim_graph_player_context& context, std::any& out_result);
 
@@ -48,9 +53,6 @@ protected:
   [[nodiscard]] bool is_first_play(const anim_graph_player_context& context) const;
 
 private:
-  // Remember this node being played on current update.
-  void register_play(const anim_graph_player_context& context) const;
-
   anim_graph_node_type _type;
   int _id;
 
@@ -61,7 +63,15 @@ private:
 };
 
 // Shorter name for unique pointer to a player node.
-using anim_graph_player_node_uptr = std::unique_ptr<anim_graph_player_node_base>;
+// Deleter for nodes that are constructed in a storage owned by someone else,
+// e.g. in a contiguous storage of `anim_graph_player`.
+// Only destroys a node, memory is released by the storage's owner.
+struct anim_graph_player_node_destroyer final {
+  void operator()(anim_graph_player_node_base* node) const;
+};
+
+using anim_graph_player_node_uptr =
+    std::unique_ptr<anim_graph_player_node_base, anim_graph_player_node_destroyer>;
 
 // Implementation
 
@@ -75,6 +85,11 @@ inline int anim_graph_player_node_base::get_id() const
   return _id;
 }
 
+inline void anim_graph_player_node_destroyer::operator()(anim_graph_player_node_base* node) const
+{
+  std::destroy_at(node);
+}
+
 inline std::optional<int> anim_graph_player_node_base::get_last_play_counter() const
 {
   return _last_graph_play_counter;
@@ -11,13 +11,17 @@ namespace eely::internal {
 // Runtime version of `anim_graph_node_clip`.
 class anim_graph_player_node_clip final : public anim_graph_player_node_pose_base {
 public:
-  // Construct node with specified clip resource.
-  explicit anim_graph_player_node_clip(int id, const clip& clip);
+  // Construct node with specified clip resource and policies it is played with.
+  explicit anim_graph_player_node_clip(int id,
+                                       const clip& clip,
+                                       clip_sample_rounding sample_rounding,
+                                       clip_looping_policy looping_policy);
 
 protected:
   void compute_impl(const anim_graph_player_context& context, std::any& out_result) override;
 
 private:
+  const clip& _clip;
   std::unique_ptr<clip_player_base> _player;
   job_clip _job_clip;
 };
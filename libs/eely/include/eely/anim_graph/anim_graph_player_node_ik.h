@@ -0,0 +1,65 @@
+#pragma once
+
+#include "eely/anim_graph/anim_graph_node_ik.h"
+#include "eely/anim_graph/anim_graph_player_context.h"
+#include "eely/anim_graph/anim_graph_player_node_base.h"
+#include "eely/anim_graph/anim_graph_player_node_pose_base.h"
+#include "eely/ik/ik.h"
+#include "eely/job/job_ik_fabrik.h"
+#include "eely/job/job_ik_two_bone.h"
+
+#include <gsl/util>
+
+#include <any>
+#include <array>
+#include <optional>
+#include <vector>
+
+namespace eely::internal {
+// Runtime version of `anim_graph_node_ik`.
+class anim_graph_player_node_ik final : public anim_graph_player_node_pose_base {
+public:
+  // Construct node with resolved joints.
+  // `two_bone_joints` and `chain` are used by according solvers,
+  // if joints are missing in a skeleton, pose is passed through unchanged.
+  // Children data must be filled via setters instead of ctor params,
+  // because of the possible circular dependencies in a graph.
+  explicit anim_graph_player_node_ik(int id,
+                                     anim_graph_node_ik::solver solver,
+                                     const std::optional<ik_two_bone_joints>& two_bone_joints,
+                                     std::vector<gsl::index> chain,
+                                     const ik_fabrik_settings& fabrik_settings);
+
+  void update_duration(const anim_graph_player_context& context) override;
+
+  void collect_descendants(
+      std::vector<const anim_graph_player_node_base*>& out_descendants) const override;
+
+  // Set a node that produces a pose to modify.
+  void set_pose_node(anim_graph_player_node_pose_base* node);
+
+  // Set nodes that provide x, y and z coordinates of a target.
+  void set_target_nodes(const std::array<anim_graph_player_node_base*, 3>& nodes);
+
+  // Set a node that provides weight between original and solved poses.
+  void set_weight_node(anim_graph_player_node_base* node);
+
+  // Get statistics of the last FABRIK solve.
+  [[nodiscard]] const ik_fabrik_result& get_last_fabrik_result() const;
+
+protected:
+  void compute_impl(const anim_graph_player_context& context, std::any& out_result) override;
+
+private:
+  anim_graph_node_ik::solver _solver;
+  std::optional<ik_two_bone_joints> _two_bone_joints;
+  std::vector<gsl::index> _chain;
+
+  anim_graph_player_node_pose_base* _pose_node{nullptr};
+  std::array<anim_graph_player_node_base*, 3> _target_nodes{};
+  anim_graph_player_node_base* _weight_node{nullptr};
+
+  job_ik_two_bone _job_ik_two_bone;
+  job_ik_fabrik _job_ik_fabrik;
+};
+}  // namespace eely::internal
\ No newline at end of file
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "eely/anim_graph/anim_graph_node_layer.h"
+#include "eely/anim_graph/anim_graph_player_context.h"
+#include "eely/anim_graph/anim_graph_player_node_base.h"
+#include "eely/anim_graph/anim_graph_player_node_pose_base.h"
+#include "eely/job/job_add_masked.h"
+#include "eely/job/job_blend_masked.h"
+#include "eely/skeleton_mask/skeleton_mask.h"
+
+#include <any>
+#include <vector>
+
+namespace eely::internal {
+// Runtime version of `anim_graph_node_layer`.
+class anim_graph_player_node_layer final : public anim_graph_player_node_pose_base {
+public:
+  // Construct node with specified mode and skeleton mask.
+  // The rest of the data must be filled via setters instead of ctor params,
+  // because of the possible circular dependencies in a graph.
+  explicit anim_graph_player_node_layer(int id,
+                                        anim_graph_node_layer::mode mode,
+                                        const skeleton_mask& mask);
+
+  void update_duration(const anim_graph_player_context& context) override;
+
+  void collect_descendants(
+      std::vector<const anim_graph_player_node_base*>& out_descendants) const override;
+
+  // Get a node that produces base pose.
+  [[nodiscard]] anim_graph_player_node_pose_base* get_base_node() const;
+
+  // Set a node that produces base pose.
+  void set_base_node(anim_graph_player_node_pose_base* node);
+
+  // Get a node that produces layer pose.
+  [[nodiscard]] anim_graph_player_node_pose_base* get_layer_node() const;
+
+  // Set a node that produces layer pose.
+  void set_layer_node(anim_graph_player_node_pose_base* node);
+
+  // Get a node that provides global weight of a layer.
+  [[nodiscard]] anim_graph_player_node_base* get_weight_node() const;
+
+  // Set a node that provides global weight of a layer.
+  void set_weight_node(anim_graph_player_node_base* node);
+
+  // Return global weight of a layer used on last play.
+  [[nodiscard]] float get_current_weight() const;
+
+protected:
+  void compute_impl(const anim_graph_player_context& context, std::any& out_result) override;
+
+private:
+  anim_graph_node_layer::mode _mode;
+  const skeleton_mask& _mask;
+
+  anim_graph_player_node_pose_base* _base_node{nullptr};
+  anim_graph_player_node_pose_base* _layer_node{nullptr};
+  anim_graph_player_node_base* _weight_node{nullptr};
+
+  float _weight{0.0F};
+
+  job_blend_masked _job_blend_masked;
+  job_add_masked _job_add_masked;
+};
+}  // namespace eely::internal
\ No newline at end of file
@@ -12,12 +12,23 @@ namespace eely::internal {
 class anim_graph_player_node_param final : public anim_graph_player_node_base {
 public:
   // Construct node for given parameter id.
-  explicit anim_graph_player_node_param(int id, string_id param_id);
+  // Id is referenced from a cooked graph and must outlive the node.
+  explicit anim_graph_player_node_param(int id, const string_id& param_id);
+
+  // Return id of a parameter this node reads.
+  [[nodiscard]] const string_id& get_param_id() const;
 
 protected:
   void compute_impl(const anim_graph_player_context& context, std::any& out_result) override;
 
 private:
-  string_id _param_id;
+  const string_id& _param_id;
 };
+
+// Implementation
+
+inline const string_id& anim_graph_player_node_param::get_param_id() const
+{
+  return _param_id;
+}
 }  // namespace eely::internal
\ No newline at end of file
@@ -13,17 +13,28 @@ namespace eely::internal {
 class anim_graph_player_node_param_comparison final : public anim_graph_player_node_base {
 public:
   // Construct node for specific parameter and value.
+  // Id and value are referenced from a cooked graph and must outlive the node.
   explicit anim_graph_player_node_param_comparison(int id,
-                                                   string_id param_id,
+                                                   const string_id& param_id,
                                                    const param_value& value,
                                                    anim_graph_node_param_comparison::op op);
 
+  // Return id of a parameter this node compares.
+  [[nodiscard]] const string_id& get_param_id() const;
+
 protected:
   void compute_impl(const anim_graph_player_context& context, std::any& out_result) override;
 
 private:
-  string_id _param_id;
-  param_value _value;
+  const string_id& _param_id;
+  const param_value& _value;
   anim_graph_node_param_comparison::op _op;
 };
+
+// Implementation
+
+inline const string_id& anim_graph_player_node_param_comparison::get_param_id() const
+{
+  return _param_id;
+}
 }  // namespace eely::internal
\ No newline at end of file
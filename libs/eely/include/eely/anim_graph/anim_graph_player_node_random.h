@@ -4,6 +4,7 @@
 #include "eely/anim_graph/anim_graph_player_node_pose_base.h"
 
 #include <any>
+#include <cstdint>
 #include <random>
 #include <vector>
 
@@ -27,13 +28,18 @@ public:
   // Set list of children nodes.
   void set_children_nodes(std::vector<anim_graph_player_node_pose_base*> children_nodes);
 
+  // Seed random generator used to select children.
+  void set_random_seed(uint32_t seed);
+
 protected:
   void compute_impl(const anim_graph_player_context& context, std::any& out_result) override;
 
 private:
   void select_node();
 
-  std::mt19937 _random_generator;
+  // Small generator is enough to pick among a few children,
+  // `std::mt19937` would add several kilobytes to every graph instance.
+  std::minstd_rand _random_generator;
   std::uniform_int_distribution<> _random_distribution;
 
   std::vector<anim_graph_player_node_pose_base*> _children_nodes;
@@ -13,9 +13,10 @@ namespace eely::internal {
 class anim_graph_player_node_state final : public anim_graph_player_node_pose_base {
 public:
   // Construct node with specified name.
+  // Name is referenced from a cooked graph and must outlive the node.
   // The rest of the data must be filled via setters instead of ctor params,
   // because of the possible circular dependencies in a graph.
-  explicit anim_graph_player_node_state(int id, string_id name);
+  explicit anim_graph_player_node_state(int id, const string_id& name);
 
   void update_duration(const anim_graph_player_context& context) override;
 
@@ -51,7 +52,7 @@ protected:
   void compute_impl(const anim_graph_player_context& context, std::any& out_result) override;
 
 private:
-  string_id _name;
+  const string_id& _name;
   anim_graph_player_node_pose_base* _pose_node{nullptr};
   std::vector<anim_graph_player_node_state_transition*> _out_transition_nodes;
   std::vector<float> _breakpoints;
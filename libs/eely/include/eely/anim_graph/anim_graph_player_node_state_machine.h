@@ -6,18 +6,12 @@
 #include "eely/anim_graph/anim_graph_player_node_state.h"
 
 #include <any>
-#include <stack>
 #include <vector>
 
 namespace eely::internal {
 // Runtime version of `anim_graph_node_state_machine`.
 class anim_graph_player_node_state_machine final : public anim_graph_player_node_pose_base {
 public:
-  // Return currently running state machine.
-  // Can be used by children nodes during their updates
-  // to query information about current states etc.
-  static const anim_graph_player_node_state_machine* get_current();
-
   // Construct empty node.
   // Data must be filled via setters instead of ctor params,
   // because of the possible circular dependencies in a graph.
@@ -51,14 +45,6 @@ private:
 
   void update_phase_copy_source();
 
-  // Contains pointer to a state machine being updated.
-  // Stack is needed because state machines can be nested.
-  //
-  // Disable warning on purpose.
-  // This seems to be the easiest way to give access to the current state machine.
-  // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
-  static std::stack<anim_graph_player_node_state_machine*> active_state_machines_stack;
-
   std::vector<anim_graph_player_node_state*> _state_nodes;
 
   anim_graph_player_node_pose_base* _current_node{nullptr};
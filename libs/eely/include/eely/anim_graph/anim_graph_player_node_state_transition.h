@@ -4,12 +4,16 @@
 #include "eely/anim_graph/anim_graph_player_context.h"
 #include "eely/anim_graph/anim_graph_player_node_base.h"
 #include "eely/anim_graph/anim_graph_player_node_pose_base.h"
+#include "eely/base/string_id.h"
 #include "eely/job/job_blend.h"
 #include "eely/job/job_restore.h"
 #include "eely/job/job_save.h"
 
 #include <any>
 #include <array>
+#include <cstdint>
+#include <optional>
+#include <vector>
 
 namespace eely::internal {
 // Forward declaration to cut out cyclic dependencies for compilation
@@ -34,6 +38,8 @@ public:
 
   // Return `true` if all conditions for this transition are satisfied
   // and transition can be initiated.
+  // Result is cached and conditions are only reevaluated
+  // when parameters they depend on change, or when source state's phase crosses a breakpoint.
   [[nodiscard]] bool conditions_are_satisfied(const anim_graph_player_context& context) const;
 
   // Return `true` if this transition will be finished at specified phase,
@@ -46,6 +52,10 @@ public:
   // Set node that checks conditions for this transition.
   void set_condition_node(anim_graph_player_node_base* node);
 
+  // Collect parameters and phases conditions of this transition depend on.
+  // Must be called after condition nodes are fully initialized.
+  void update_condition_dependencies();
+
   // Get state this transition is set up to go to in a graph.
   // Note: source state is not kept in a transition node,
   // since multiple states can go to the same destination state via one transition.
@@ -69,6 +79,21 @@ private:
   anim_graph_player_node_base* _condition_node{nullptr};
   anim_graph_player_node_state* _destination_state_node{nullptr};
 
+  // Conditions can be cached only if they consist of nodes with known dependencies
+  bool _conditions_cacheable{false};
+  std::vector<const string_id*> _conditions_params;
+  std::vector<float> _conditions_phases;
+  std::vector<const anim_graph_player_node_base*> _conditions_nodes;
+
+  mutable std::optional<bool> _conditions_cached_result;
+  mutable std::uint64_t _conditions_cached_params_version{0};
+  mutable std::vector<std::uint64_t> _conditions_cached_params_versions;
+  mutable gsl::index _conditions_cached_phase_interval{0};
+
+  // Condition nodes computed for the cached result, they are registered as played
+  // when the result is reused, as if they were computed again
+  mutable std::vector<const anim_graph_player_node_base*> _conditions_cached_played_nodes;
+
   bool _reversed{false};
   anim_graph_player_node_state* _current_source{nullptr};
   anim_graph_player_node_state* _current_destination{nullptr};
@@ -25,11 +25,27 @@ public:
   // If reading goes beyond given buffer, exception is thrown.
   uint32_t read(gsl::index size_bits);
 
+  // Read bytes at current position into `out_bytes`,
+  // and advance position for their size in bits.
+  // Result is the same as reading each byte with `read`,
+  // but when position is at the start of a byte, bytes are copied at once.
+  // If reading goes beyond given buffer, exception is thrown.
+  void read_bytes(const std::span<std::byte>& out_bytes);
+
+  // Advance position for specified number of bytes without reading them.
+  // If skipping goes beyond given buffer, exception is thrown.
+  void skip_bytes(gsl::index bytes_count);
+
+  // Move position to the start of the next byte,
+  // matching `bit_writer::align`.
+  void align();
+
   // Return current position in bits.
   [[nodiscard]] gsl::index get_position_bits() const;
 
 private:
   const std::byte* _data;
+  gsl::index _data_size_bytes;
   gsl::index _data_size_bits;
   gsl::index _position_bits{0};
 };
@@ -8,7 +8,9 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <limits>
 #include <optional>
+#include <span>
 #include <type_traits>
 
 namespace eely::internal {
@@ -40,6 +42,10 @@ public:
   // Construct bit writer targeted at specified buffer.
   explicit bit_writer(const std::span<std::byte>& data);
 
+  // Construct bit writer that does not touch any memory and only counts written bits.
+  // Used to calculate size of a buffer before writing into it.
+  explicit bit_writer() = default;
+
   // Write specified number of bits from the value into the buffer,
   // starting from current position.
   // Bit position will advance for `params.size_bits`.
@@ -50,6 +56,12 @@ public:
   // Bit position of the writter will not change.
   void patch(const patch_params& params);
 
+  // Write bytes into the buffer, starting from current position.
+  // Result is the same as writing each byte with `write`,
+  // but when position is at the start of a byte, bytes are copied at once.
+  // Bit position will advance for the size of `bytes` in bits.
+  void write_bytes(const std::span<const std::byte>& bytes);
+
   // Move bit position to the start of the next byte.
   // All skipped bits will be set to zero.
   void align();
@@ -59,7 +71,7 @@ public:
 
 private:
   std::byte* _data = nullptr;
-  gsl::index _data_size_bits;
+  gsl::index _data_size_bits{std::numeric_limits<gsl::index>::max()};
   gsl::index _position_bits{0};
 };
 
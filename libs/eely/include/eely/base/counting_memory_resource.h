@@ -0,0 +1,30 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+
+namespace eely {
+// Memory resource that forwards allocations to another one
+// and counts how many bytes are currently allocated through it,
+// e.g. to measure memory taken by players that are given this resource.
+// Counting is thread-safe if upstream resource is.
+class counting_memory_resource final : public std::pmr::memory_resource {
+public:
+  // Create resource that forwards allocations to `upstream`, which should outlive this resource.
+  explicit counting_memory_resource(
+      std::pmr::memory_resource* upstream = std::pmr::get_default_resource());
+
+  // Return number of bytes currently allocated through this resource.
+  [[nodiscard]] int64_t get_allocated_bytes() const;
+
+private:
+  void* do_allocate(size_t bytes, size_t alignment) override;
+  void do_deallocate(void* ptr, size_t bytes, size_t alignment) override;
+  [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+  std::pmr::memory_resource* _upstream{nullptr};
+  std::atomic<int64_t> _allocated_bytes{0};
+};
+}  // namespace eely
\ No newline at end of file
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <span>
+#include <vector>
+
+namespace eely {
+// Return binary content of a file, throw `std::runtime_error` if it cannot be read.
+[[nodiscard]] std::vector<std::byte> read_file(const std::filesystem::path& path);
+
+// Write binary content into a file, replacing it,
+// throw `std::runtime_error` if it cannot be written.
+void write_file(const std::filesystem::path& path, std::span<const std::byte> data);
+}  // namespace eely
\ No newline at end of file
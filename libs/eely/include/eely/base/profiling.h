@@ -0,0 +1,154 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace eely {
+// Kind of code an instrumentation scope was recorded for.
+enum class profiling_scope_type {
+  anim_graph_player,
+  node,
+  job,
+  clip_player,
+  object_space
+};
+
+// Time span of a single instrumentation scope.
+struct profiling_event final {
+  // Static string describing the scope, e.g. node type or job class.
+  const char* name{nullptr};
+
+  // Node id for `profiling_scope_type::node` scopes,
+  // id of a node that added the job for `profiling_scope_type::job` scopes,
+  // -1 otherwise.
+  int id{-1};
+
+  profiling_scope_type type{profiling_scope_type::node};
+
+  // Index of a thread the scope was recorded on, in order of first recording.
+  int thread_index{0};
+
+  int64_t begin_ns{0};
+  int64_t end_ns{0};
+};
+
+// Aggregated time of all node scopes with the same id.
+struct profiling_node_stats final {
+  int calls_count{0};
+
+  // Time including nested scopes, i.e. computation of child nodes.
+  int64_t total_ns{0};
+
+  // Time excluding nested scopes.
+  int64_t self_ns{0};
+
+  int64_t max_ns{0};
+
+  // Number of jobs this node added.
+  int jobs_count{0};
+
+  // Time of executing jobs this node added.
+  int64_t jobs_ns{0};
+
+  // Time of executing jobs this node and nodes nested into it added.
+  int64_t subtree_jobs_ns{0};
+};
+
+// Return `true` if the library was compiled with `EELY_PROFILING`.
+// Otherwise instrumentation scopes compile to nothing and no events are ever recorded.
+constexpr bool profiling_is_enabled();
+
+// Return events recorded on all threads since last `profiling_clear`.
+// Each thread keeps only a limited number of latest events in its ring buffer.
+// Should not be called while instrumented code is running on other threads.
+std::vector<profiling_event> profiling_collect_events();
+
+// Forget all events recorded so far.
+void profiling_clear();
+
+// Return events formatted as Chrome `trace_event` JSON,
+// that can be opened in `chrome://tracing` or Perfetto.
+std::string profiling_events_to_chrome_trace(std::span<const profiling_event> events);
+
+// Return statistics of node scopes grouped by node id.
+// Nodes with the same id from different graphs are merged together.
+std::unordered_map<int, profiling_node_stats> profiling_aggregate_nodes(
+    std::span<const profiling_event> events);
+
+// Implementation
+
+constexpr bool profiling_is_enabled()
+{
+#if defined(EELY_PROFILING)
+  return true;
+#else
+  return false;
+#endif
+}
+}  // namespace eely
+
+namespace eely::internal {
+// Return current time used for profiling events.
+int64_t profiling_get_time_ns();
+
+// Put event into calling thread's ring buffer.
+// Never blocks, except for the very first event on a thread.
+void profiling_record(const profiling_event& event);
+
+// Return number of events recorded on calling thread so far.
+int64_t profiling_get_thread_events_count();
+
+// Put events recorded on calling thread, starting from specified number, into `out_events`.
+// Events that are already overwritten in a ring buffer are skipped.
+// Never blocks, except for a thread that hasn't recorded anything yet.
+void profiling_get_thread_events(int64_t from_count, std::vector<profiling_event>& out_events);
+
+// Records an event for the lifetime of this object.
+// Use via `EELY_PROFILE_SCOPE`, so that it's compiled out without `EELY_PROFILING`.
+class profiling_scope final {
+public:
+  // Start measuring a scope.
+  // `name` must be a string that outlives profiling results.
+  explicit profiling_scope(profiling_scope_type type, const char* name, int id = -1);
+
+  ~profiling_scope();
+
+  profiling_scope(const profiling_scope&) = delete;
+  profiling_scope(profiling_scope&&) = delete;
+
+  profiling_scope& operator=(const profiling_scope&) = delete;
+  profiling_scope& operator=(profiling_scope&&) = delete;
+
+private:
+  profiling_event _event;
+};
+
+// Implementation
+
+inline profiling_scope::profiling_scope(const profiling_scope_type type,
+                                        const char* name,
+                                        const int id)
+    : _event{.name = name, .id = id, .type = type, .begin_ns = profiling_get_time_ns()}
+{
+}
+
+inline profiling_scope::~profiling_scope()
+{
+  _event.end_ns = profiling_get_time_ns();
+  profiling_record(_event);
+}
+}  // namespace eely::internal
+
+// Measure the rest of current scope when compiled with `EELY_PROFILING`, do nothing otherwise.
+#if defined(EELY_PROFILING)
+#define EELY_PROFILE_SCOPE_CONCAT_IMPL(a, b) a##b
+#define EELY_PROFILE_SCOPE_CONCAT(a, b) EELY_PROFILE_SCOPE_CONCAT_IMPL(a, b)
+#define EELY_PROFILE_SCOPE(...)           \
+  const ::eely::internal::profiling_scope \
+      EELY_PROFILE_SCOPE_CONCAT(eely_profile_scope_, __LINE__){__VA_ARGS__}
+#else
+#define EELY_PROFILE_SCOPE(...)
+#endif
\ No newline at end of file
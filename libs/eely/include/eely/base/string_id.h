@@ -6,6 +6,7 @@
 #include <gsl/util>
 
 #include <bit>
+#include <span>
 #include <string>
 
 namespace eely {
@@ -33,10 +34,7 @@ inline string_id bit_reader_read(bit_reader& reader)
 
   string_id result;
   result.resize(size);
-
-  for (gsl::index i{0}; i < size; ++i) {
-    result[i] = bit_reader_read<char>(reader);
-  }
+  reader.read_bytes(std::as_writable_bytes(std::span{result}));
 
   return result;
 }
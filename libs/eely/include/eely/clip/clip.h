@@ -8,6 +8,7 @@
 #include "eely/project/project_uncooked.h"
 #include "eely/project/resource.h"
 
+#include <cstddef>
 #include <memory>
 
 namespace eely {
@@ -35,10 +36,36 @@ public:
   // Get clip's duration in seconds.
   [[nodiscard]] float get_duration_s() const;
 
+  // Return `true` if clip produces additive poses.
+  [[nodiscard]] bool is_additive() const;
+
   // Create a player for this clip.
   // Players should not outlive the clip.
   [[nodiscard]] std::unique_ptr<clip_player_base> create_player() const;
 
+  // Return number of bytes data of specified streaming tier takes,
+  // zero if clip has no such tier (see `clip_acl_database_settings`).
+  [[nodiscard]] size_t get_streaming_tier_size(clip_streaming_tier tier) const;
+
+  // Return number of bytes data of specified streaming tier currently takes in memory.
+  // If project reads tiers on demand, only tiers that are streamed in take memory.
+  [[nodiscard]] size_t get_streaming_tier_resident_size(clip_streaming_tier tier) const;
+
+  // Return `true` if data of specified streaming tier is used by players.
+  [[nodiscard]] bool is_streamed_in(clip_streaming_tier tier) const;
+
+  // Make players use data of specified streaming tier,
+  // reading it first if project reads tiers on demand.
+  // Does nothing if clip has no such tier.
+  // Must not be called while players of this clip are playing, e.g. during a parallel update.
+  void stream_in(clip_streaming_tier tier);
+
+  // Stop using data of specified streaming tier, players will continue with lower quality.
+  // Tier's memory is released if project reads tiers on demand.
+  // Does nothing if clip has no such tier.
+  // Must not be called while players of this clip are playing, e.g. during a parallel update.
+  void stream_out(clip_streaming_tier tier);
+
 private:
   std::unique_ptr<internal::clip_impl_base> _impl;
 };
@@ -14,9 +14,30 @@ enum class clip_compression_scheme {
   fixed,
 
   // Clip is compressed using ACL library.
-  acl
+  acl,
+
+  // Clip data is resampled into uniform frames quantized into fixed number of bits.
+  // Any time can be sampled directly, thus random access and backward playback are cheap.
+  uniform
 };
 
+// Settings for clips compressed with `clip_compression_scheme::acl`
+// that move their least important keys into a database.
+// Database is split into tiers that can be streamed in and out at runtime,
+// e.g. to keep full quality only for characters close to the camera.
+struct clip_acl_database_settings final {
+  // Proportion of keys that go into the medium importance tier, within [0, 1].
+  float medium_tier_proportion{0.0F};
+
+  // Proportion of keys that go into the low importance tier, within [0, 1].
+  // Sum with `medium_tier_proportion` should not exceed one.
+  float low_tier_proportion{0.5F};
+};
+
+// Tiers of clip data that can be streamed in and out.
+// Without them clip is played with lower quality.
+enum class clip_streaming_tier { medium, low };
+
 namespace internal {
 static constexpr gsl::index bits_clip_compression_scheme = 2;
 }
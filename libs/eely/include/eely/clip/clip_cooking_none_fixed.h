@@ -99,7 +99,8 @@ void clip_cook(const std::vector<clip_uncooked_track>& tracks,
   // Cooking puts all tracks in a single buffer as a collection of keys.
   // Each key has:
   //   - Flags, that say what data this key holds
-  //   - Index of a joint, if it is changed from previous key
+  //   - Slot index of a joint (i.e. its position among animated joints),
+  //     if it is changed from previous key
   //   - Key time, if it is changed from previous key
   //   - Joint transform components (can have full transform or a subset, e.g rotation and scale)
   //
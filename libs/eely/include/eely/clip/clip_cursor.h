@@ -8,6 +8,8 @@
 
 #include <gsl/util>
 
+#include <algorithm>
+#include <array>
 #include <concepts>
 #include <limits>
 #include <vector>
@@ -16,28 +18,50 @@
 // with `clip_compression_scheme::none` and `clip_compression_scheme::fixed`.
 
 namespace eely::internal {
-// Cursor into animation data for a specific transform component.
+// Cursors into animation data for all joints that have specific transform component animated.
 // Each component is described by up to two points,
 // and result value is interpolation between them based on time.
+// Data is stored as a structure of arrays, indexed by component's dense index,
+// and padded to a multiple of `cursor_components_lanes` so that all values are processed with SIMD.
 template <typename T>
 requires std::same_as<T, float3> || std::same_as<T, quaternion>
-struct cursor_component final {
-  // Index of a joint this cursor is for.
-  gsl::index joint_index{std::numeric_limits<gsl::index>::max()};
+struct cursor_components final {
+  // Number of floats in a component.
+  static constexpr gsl::index size{std::same_as<T, quaternion> ? 4 : 3};
 
-  // Time for a left component.
+  // Time for left components.
   // If negative, there is no left component.
-  float left_time_s{-1.0F};
+  std::vector<float> left_times_s;
 
-  // Time for a right component.
+  // Time for right components.
   // If negative, there is no right component.
-  float right_time_s{-1.0F};
+  std::vector<float> right_times_s;
+
+  // Left transform components, one array per axis.
+  std::array<std::vector<float>, size> lefts;
 
-  // Left transform component.
-  T left;
+  // Right transform components, one array per axis.
+  std::array<std::vector<float>, size> rights;
 
-  // Right transform component.
-  T right;
+  // Components calculated for the last played time, one array per axis.
+  // Used as a scratch buffer by `cursor_calculate_pose`.
+  mutable std::array<std::vector<float>, size> results;
+};
+
+// Number of components processed at once by `cursor_calculate_pose`.
+static constexpr gsl::index cursor_components_lanes{4};
+
+// Describes animated joint and where its components are in a cursor.
+// Cooked data addresses joints by slot indices,
+// so that no search is needed to find component cursors when playing.
+struct cursor_slot final {
+  // Index of a joint in a skeleton.
+  gsl::index joint_index{std::numeric_limits<gsl::index>::max()};
+
+  // Indices in cursor's component arrays, negative if component is not animated.
+  gsl::index translation_index{-1};
+  gsl::index rotation_index{-1};
+  gsl::index scale_index{-1};
 };
 
 // Cursor into animation data.
@@ -52,17 +76,20 @@ struct cursor final {
   // Last time read.
   float last_data_time_s{-1.0F};
 
-  // Last joint read.
-  gsl::index last_data_joint_index{std::numeric_limits<gsl::index>::max()};
+  // Last slot read.
+  gsl::index last_data_slot_index{std::numeric_limits<gsl::index>::max()};
+
+  // Animated joints sorted by joint index.
+  std::vector<cursor_slot> slots;
 
   // Component cursors for joint translations.
-  std::vector<cursor_component<float3>> translations;
+  cursor_components<float3> translations;
 
   // Component cursors for joint rotations.
-  std::vector<cursor_component<quaternion>> rotations;
+  cursor_components<quaternion> rotations;
 
   // Component cursors for joint scales.
-  std::vector<cursor_component<float3>> scales;
+  cursor_components<float3> scales;
 
   // Shallow joint index for an animation,
   // i.e. first index of a joint that is changed in an animation.
@@ -76,29 +103,30 @@ struct joint_components final {
   int components{0};
 };
 
-// Reset cursor to default state, removing its left and right values.
+// Prepare component cursors for specified number of components.
 template <typename T>
-void cursor_component_reset(cursor_component<T>& cursor_component);
+void cursor_components_init(cursor_components<T>& cursor_components, gsl::index size);
 
-// Return `true` if cursor's data is outdated for specified time,
+// Reset component cursors to default state, removing their left and right values.
+template <typename T>
+void cursor_components_reset(cursor_components<T>& cursor_components);
+
+// Return `true` if component cursor's data is outdated for specified time,
 // assuming there is still data to be used.
 // E.g. either it has no value or value is too old.
 template <typename T>
-[[nodiscard]] bool cursor_component_is_outdated(const cursor_component<T>& cursor_component,
+[[nodiscard]] bool cursor_component_is_outdated(const cursor_components<T>& cursor_components,
+                                                gsl::index index,
                                                 float time_s);
 
-// Advance to the next value.
+// Advance component cursor to the next value.
 // Old right moves to the left, and next value becomes the new right.
 template <typename T>
-void cursor_component_advance(cursor_component<T>& cursor_component,
+void cursor_component_advance(cursor_components<T>& cursor_components,
+                              gsl::index index,
                               const T& next_value,
                               float next_time_s);
 
-// Calculate value for specified time.
-template <typename T>
-[[nodiscard]] T cursor_component_calculate(const cursor_component<T>& cursor_component,
-                                           float time_s);
-
 // Prepare cursor for playing tracks with specified joint components.
 void cursor_init(cursor& cursor, const std::vector<joint_components>& joints_components);
 
@@ -113,68 +141,71 @@ void joint_components_collect(const std::vector<clip_uncooked_track>& tracks,
                               const skeleton& skeleton,
                               std::vector<joint_components>& out_joints_components);
 
+// Return slot index of a joint, i.e. its index in sorted joints components.
+// This is what cooked data uses to address joints.
+[[nodiscard]] gsl::index joint_components_get_slot_index(
+    const std::vector<joint_components>& joints_components,
+    gsl::index joint_index);
+
 // Implementation
 
 template <typename T>
-void cursor_component_reset(cursor_component<T>& cursor_component)
+void cursor_components_init(cursor_components<T>& cursor_components, const gsl::index size)
+{
+  const gsl::index size_padded{(size + cursor_components_lanes - 1) / cursor_components_lanes *
+                               cursor_components_lanes};
+
+  cursor_components.left_times_s.resize(size_padded, -1.0F);
+  cursor_components.right_times_s.resize(size_padded, -1.0F);
+
+  for (gsl::index axis{0}; axis < cursor_components.size; ++axis) {
+    // Padding rotations are identities, so that they can be normalized
+    const float value{axis == 3 ? 1.0F : 0.0F};
+
+    cursor_components.lefts[axis].resize(size_padded, value);
+    cursor_components.rights[axis].resize(size_padded, value);
+    cursor_components.results[axis].resize(size_padded, value);
+  }
+}
+
+template <typename T>
+void cursor_components_reset(cursor_components<T>& cursor_components)
 {
-  cursor_component.left_time_s = -1.0F;
-  cursor_component.right_time_s = -1.0F;
+  std::fill(cursor_components.left_times_s.begin(), cursor_components.left_times_s.end(), -1.0F);
+  std::fill(cursor_components.right_times_s.begin(), cursor_components.right_times_s.end(), -1.0F);
 }
 
 template <typename T>
-bool cursor_component_is_outdated(const cursor_component<T>& cursor_component, const float time_s)
+bool cursor_component_is_outdated(const cursor_components<T>& cursor_components,
+                                  const gsl::index index,
+                                  const float time_s)
 {
   // Outdated when we either have no left key,
   // or we have both keys but they're too old.
-  return cursor_component.left_time_s < 0.0F || cursor_component.right_time_s < time_s;
+  return cursor_components.left_times_s[index] < 0.0F ||
+         cursor_components.right_times_s[index] < time_s;
 }
 
 template <typename T>
-void cursor_component_advance(cursor_component<T>& cursor_component,
+void cursor_component_advance(cursor_components<T>& cursor_components,
+                              const gsl::index index,
                               const T& next_value,
                               const float next_time_s)
 {
-  cursor_component.left = cursor_component.right;
-  cursor_component.left_time_s = cursor_component.right_time_s;
+  cursor_components.left_times_s[index] = cursor_components.right_times_s[index];
+  cursor_components.right_times_s[index] = next_time_s;
 
-  cursor_component.right = next_value;
-  cursor_component.right_time_s = next_time_s;
-}
-
-template <typename T>
-T cursor_component_calculate(const cursor_component<T>& cursor_component, const float time_s)
-{
-  if (cursor_component.left_time_s < 0.0F) {
-    // A single key
-    EXPECTS(cursor_component.right_time_s >= 0.0F);
-    return cursor_component.right;
-  }
+  const auto advance_axis = [&cursor_components, index](const gsl::index axis, const float value) {
+    cursor_components.lefts[axis][index] = cursor_components.rights[axis][index];
+    cursor_components.rights[axis][index] = value;
+  };
 
-  EXPECTS(cursor_component.left_time_s >= 0.0F);
-  EXPECTS(cursor_component.right_time_s >= 0.0F);
-
-  const float duration{cursor_component.right_time_s - cursor_component.left_time_s};
-  EXPECTS(duration > 0.0F);
-
-  // Coeff can be negative if time requested is smaller than left time,
-  // and can be higher than one if time is greater than right one
-  const float coeff{(time_s - cursor_component.left_time_s) / duration};
-
-  if (coeff <= 0.0F) {
-    return cursor_component.left;
-  }
-
-  if (coeff >= 1.0F) {
-    return cursor_component.right;
-  }
-
-  if constexpr (std::is_same_v<T, float3>) {
-    return float3_lerp(cursor_component.left, cursor_component.right, coeff);
-  }
+  advance_axis(0, next_value.x);
+  advance_axis(1, next_value.y);
+  advance_axis(2, next_value.z);
 
-  if constexpr (std::is_same_v<T, quaternion>) {
-    return quaternion_slerp(cursor_component.left, cursor_component.right, coeff);
+  if constexpr (std::same_as<T, quaternion>) {
+    advance_axis(3, next_value.w);
   }
 }
 }  // namespace eely::internal
\ No newline at end of file
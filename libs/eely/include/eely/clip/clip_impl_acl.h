@@ -4,32 +4,110 @@
 #include "eely/base/bit_writer.h"
 #include "eely/clip/clip_impl_base.h"
 #include "eely/clip/clip_uncooked.h"
+#include "eely/project/project.h"
 
 #include <acl/compression/compress.h>
 #include <acl/core/ansi_allocator.h>
+#include <acl/core/compressed_database.h>
+#include <acl/decompression/database/database.h>
+#include <acl/decompression/database/database_streamer.h>
 #include <acl/decompression/decompress.h>
 
 #include <gsl/util>
 
 #include <cstdint>
 #include <memory>
+#include <optional>
+#include <span>
 #include <vector>
 
 namespace eely::internal {
+// Decompression settings for ACL clips, with database support enabled.
+struct acl_decompression_settings final : public acl::default_transform_decompression_settings {
+  using database_settings_type = acl::default_database_settings;
+};
+
+using acl_database_context = acl::database_context<acl::default_database_settings>;
+
+// Streamer for a single tier of a clip's ACL database.
+// Tier data is either resident, copied from a cooked project when it is loaded,
+// or read from project's data on stream in and released on stream out.
+// Requests are completed synchronously.
+class acl_database_streamer final : public acl::database_streamer {
+public:
+  // Construct streamer for resident tier data.
+  explicit acl_database_streamer(std::vector<uint8_t> bulk_data);
+
+  // Construct streamer that reads tier data of specified size at specified offset with `reader`.
+  // Reader is referenced and must outlive the streamer.
+  explicit acl_database_streamer(const project_data_reader& reader, size_t offset, size_t size);
+
+  ~acl_database_streamer() override;
+
+  acl_database_streamer(const acl_database_streamer&) = delete;
+  acl_database_streamer(acl_database_streamer&&) = delete;
+
+  acl_database_streamer& operator=(const acl_database_streamer&) = delete;
+  acl_database_streamer& operator=(acl_database_streamer&&) = delete;
+
+  [[nodiscard]] bool is_initialized() const override;
+
+  [[nodiscard]] const uint8_t* get_bulk_data(acl::quality_tier tier) const override;
+
+  void stream_in(uint32_t offset,
+                 uint32_t size,
+                 bool can_allocate_bulk_data,
+                 acl::quality_tier tier,
+                 acl::streaming_request_id request_id) override;
+
+  void stream_out(uint32_t offset,
+                  uint32_t size,
+                  bool can_deallocate_bulk_data,
+                  acl::quality_tier tier,
+                  acl::streaming_request_id request_id) override;
+
+  // Return size of tier data.
+  [[nodiscard]] size_t get_size() const;
+
+  // Return number of bytes tier data currently takes in memory.
+  [[nodiscard]] size_t get_resident_size() const;
+
+  // Return a copy of tier data, reading it if it is not resident.
+  [[nodiscard]] std::vector<uint8_t> copy_bulk_data() const;
+
+private:
+  const project_data_reader* _reader{nullptr};
+  size_t _offset{0};
+  size_t _size{0};
+
+  // Global `operator new` alignment satisfies `acl::k_database_bulk_data_alignment`
+  std::vector<uint8_t> _bulk_data;
+  acl::streaming_request _request;
+};
+
 // Metadata for clips compressed with `clip_compression_scheme::acl`.
 struct clip_metadata_acl final : public clip_metadata_base {
   gsl::index shallow_joint_index{std::numeric_limits<gsl::index>::max()};
 };
 
 // Implementation for clips clips compressed with `clip_compression_scheme::acl`.
+// If clip is cooked with `clip_acl_database_settings`,
+// its resident tiers are streamed in right after loading, so that clip is played in full quality.
 class clip_impl_acl final : public clip_impl_base {
 public:
-  explicit clip_impl_acl(bit_reader& reader);
+  // Construct clip from a memory buffer.
+  // If `tiers_reader` is not empty, tiers are read with it on demand instead of being resident.
+  // Reader is referenced and must outlive the clip.
+  explicit clip_impl_acl(bit_reader& reader, const project_data_reader& tiers_reader);
 
+  // Compress clip from uncooked tracks.
+  // If `optimize_loops` is `true`, last sample is dropped if it matches the first one.
   explicit clip_impl_acl(float duration_s,
                          const std::vector<clip_uncooked_track>& tracks,
                          bool is_additive,
-                         const skeleton& skeleton);
+                         const skeleton& skeleton,
+                         const std::optional<clip_acl_database_settings>& database_settings,
+                         bool optimize_loops);
 
   void serialize(bit_writer& writer) const override;
 
@@ -37,7 +115,23 @@ public:
 
   [[nodiscard]] std::unique_ptr<clip_player_base> create_player() const override;
 
+  [[nodiscard]] size_t get_streaming_tier_size(clip_streaming_tier tier) const override;
+
+  [[nodiscard]] size_t get_streaming_tier_resident_size(clip_streaming_tier tier) const override;
+
+  [[nodiscard]] bool is_streamed_in(clip_streaming_tier tier) const override;
+
+  void stream_in(clip_streaming_tier tier) override;
+
+  void stream_out(clip_streaming_tier tier) override;
+
 private:
+  // Bind database to its streamers once they are created.
+  void database_init();
+
+  // Return streamer for specified tier.
+  [[nodiscard]] acl_database_streamer& get_streamer(clip_streaming_tier tier) const;
+
   clip_metadata_acl _metadata;
 
   // Unique ptr for `std::aligned_alloc`/`std::free` pair,
@@ -46,5 +140,14 @@ private:
 
   acl::ansi_allocator _acl_allocator;
   const acl::compressed_tracks* _acl_compressed_tracks;
+
+  // Optional database with keys split into tiers that can be streamed.
+  // Bulk data of tiers is owned by their streamers, separately from the database itself.
+  std::unique_ptr<uint8_t, decltype(&std::free)> _acl_compressed_database_storage{nullptr,
+                                                                                   nullptr};
+  const acl::compressed_database* _acl_compressed_database{nullptr};
+  std::unique_ptr<acl_database_streamer> _acl_streamer_medium;
+  std::unique_ptr<acl_database_streamer> _acl_streamer_low;
+  acl_database_context _acl_database_context;
 };
 }  // namespace eely::internal
\ No newline at end of file
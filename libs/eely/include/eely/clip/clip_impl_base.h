@@ -2,8 +2,10 @@
 
 #include "eely/base/bit_reader.h"
 #include "eely/base/bit_writer.h"
+#include "eely/clip/clip_compression_scheme.h"
 #include "eely/clip/clip_player_base.h"
 
+#include <cstddef>
 #include <memory>
 
 namespace eely::internal {
@@ -27,5 +29,27 @@ public:
   [[nodiscard]] virtual const clip_metadata_base* get_metadata() const = 0;
 
   [[nodiscard]] virtual std::unique_ptr<clip_player_base> create_player() const = 0;
+
+  // Streaming is supported only by some schemes,
+  // by default clips have no tiers and all their data is always resident.
+
+  [[nodiscard]] virtual size_t get_streaming_tier_size(clip_streaming_tier /*tier*/) const
+  {
+    return 0;
+  }
+
+  [[nodiscard]] virtual size_t get_streaming_tier_resident_size(clip_streaming_tier /*tier*/) const
+  {
+    return 0;
+  }
+
+  [[nodiscard]] virtual bool is_streamed_in(clip_streaming_tier /*tier*/) const
+  {
+    return false;
+  }
+
+  virtual void stream_in(clip_streaming_tier /*tier*/) {}
+
+  virtual void stream_out(clip_streaming_tier /*tier*/) {}
 };
 }  // namespace eely::internal
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include "eely/clip/clip_cursor.h"
 #include "eely/clip/clip_impl_base.h"
 #include "eely/clip/clip_utils.h"
+#include "eely/math/float4.h"
 
 #include <gsl/util>
 
@@ -21,10 +22,29 @@ struct joint_range final {
   float range_scale_length{0.0F};
 };
 
+// Dequantization parameters of a single cursor slot.
+// Quantized values are restored as `range_from + value * range_scale`.
+// Computed when a clip is loaded to avoid divisions and range searches when playing.
+// `w` components are zeroes.
+struct joint_dequantization final {
+  float4 translation_range_from;
+  float4 translation_range_scale;
+  float4 scale_range_from;
+  float4 scale_range_scale;
+};
+
 // Metadata for clips compressed with `clip_compression_scheme::fixed`.
 struct clip_metadata_fixed final : public clip_metadata_base {
   std::vector<joint_components> joints_components;
   std::vector<joint_range> joints_ranges;
+
+  // Not serialized, derived from the data above.
+  // Dequantization parameters for each slot, in the same order as `joints_components`.
+  std::vector<joint_dequantization> slots_dequantization;
+
+  // Not serialized, derived from the data above.
+  // Scale to restore quantized key times with.
+  float time_scale{0.0F};
 };
 
 // Implementation for clips compressed with `clip_compression_scheme::fixed`.
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "eely/base/bit_reader.h"
+#include "eely/base/bit_writer.h"
+#include "eely/clip/clip_impl_base.h"
+#include "eely/clip/clip_uncooked.h"
+#include "eely/math/float4.h"
+#include "eely/math/transform.h"
+#include "eely/skeleton/skeleton.h"
+
+#include <gsl/util>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace eely::internal {
+// Rate with which clips compressed with `clip_compression_scheme::uniform` are resampled.
+static constexpr float clip_uniform_sample_rate{30.0F};
+
+// Describes a single animated component of a joint in a uniformly sampled clip.
+struct clip_track_uniform final {
+  gsl::index joint_index{0};
+  transform_components component{transform_components::translation};
+
+  // Quantized values are restored as `range_from + value * range_scale`.
+  // Scale is precomputed during cooking to avoid divisions when playing.
+  // For translations and scales `w` components are zeroes.
+  float4 range_from;
+  float4 range_scale;
+};
+
+// Metadata for clips compressed with `clip_compression_scheme::uniform`.
+struct clip_metadata_uniform final : public clip_metadata_base {
+  // Number of frames, first frame is at zero time and the last one is at clip's duration.
+  gsl::index frames_count{0};
+
+  // Animated tracks sorted by joint index, and then by component.
+  std::vector<clip_track_uniform> tracks;
+
+  // Number of values a single frame takes,
+  // three for translations and scales, and four for rotations.
+  gsl::index frame_size{0};
+};
+
+// Implementation for clips compressed with `clip_compression_scheme::uniform`.
+// Every animated component is resampled with a fixed rate and quantized into 16 bits,
+// with frames stored one after another. This allows to jump to any time directly,
+// thus random access and reversed playback cost the same as a forward one.
+class clip_impl_uniform final : public clip_impl_base {
+public:
+  explicit clip_impl_uniform(bit_reader& reader);
+
+  explicit clip_impl_uniform(float duration_s,
+                             const std::vector<clip_uncooked_track>& tracks,
+                             bool is_additive,
+                             const skeleton& skeleton);
+
+  void serialize(bit_writer& writer) const override;
+
+  [[nodiscard]] const clip_metadata_base* get_metadata() const override;
+
+  [[nodiscard]] std::unique_ptr<clip_player_base> create_player() const override;
+
+private:
+  clip_metadata_uniform _metadata;
+  std::vector<uint16_t> _data;
+};
+}  // namespace eely::internal
\ No newline at end of file
@@ -11,8 +11,11 @@ namespace eely::internal {
 // Player for clips compressed with `clip_compression_scheme::acl`.
 class clip_player_acl final : public clip_player_base {
 public:
+  // Database context is optional,
+  // if specified it should contain keys missing from compressed tracks.
   explicit clip_player_acl(const clip_metadata_acl& metadata,
-                           const acl::compressed_tracks& acl_compressed_tracks);
+                           const acl::compressed_tracks& acl_compressed_tracks,
+                           const acl_database_context* acl_database_context);
 
   [[nodiscard]] float get_duration_s() override;
 
@@ -20,7 +23,7 @@ public:
 
 private:
   const clip_metadata_acl& _metadata;
-  acl::decompression_context<acl::default_transform_decompression_settings> _decompression_context;
+  acl::decompression_context<acl_decompression_settings> _decompression_context;
 };
 
 }  // namespace eely::internal
\ No newline at end of file
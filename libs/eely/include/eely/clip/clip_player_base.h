@@ -3,6 +3,36 @@
 #include "eely/skeleton/skeleton_pose.h"
 
 namespace eely {
+// Describes how time between two samples is handled when playing a clip.
+enum class clip_sample_rounding {
+  // Interpolate between two closest samples.
+  none,
+
+  // Use previous sample.
+  floor,
+
+  // Use next sample.
+  ceil,
+
+  // Use closest sample.
+  // Skips interpolation, which is cheaper and can be used e.g. for distant characters.
+  nearest
+};
+
+// Describes how end of a clip is handled when playing.
+enum class clip_looping_policy {
+  // Clip is played as it was cooked, last sample is reached at clip's end.
+  // Clips, which last sample matched the first one, are looped without their duplicated sample,
+  // unless cooked otherwise (see `clip_uncooked::set_acl_optimize_loops`).
+  as_cooked,
+
+  // Last sample is interpolated into the first one,
+  // thus clip gets one sample interval longer and can be looped seamlessly.
+  // If last sample matched the first one and was removed during cooking,
+  // this is the same as `as_cooked`.
+  wrap
+};
+
 // Base class for all clip players.
 // Players produce poses from clips.
 class clip_player_base {
@@ -15,5 +45,45 @@ public:
   // Calculate skeleton pose at specified absolute time.
   // Time should be within [0.0F; duration] interval.
   virtual void play(float time_s, skeleton_pose& out_pose) = 0;
+
+  // Return how time between two samples is handled.
+  [[nodiscard]] clip_sample_rounding get_sample_rounding() const;
+
+  // Set how time between two samples is handled.
+  // Supported by clips compressed with `clip_compression_scheme::acl`
+  // and `clip_compression_scheme::uniform`, others always interpolate.
+  void set_sample_rounding(clip_sample_rounding rounding);
+
+  // Return how end of a clip is handled.
+  [[nodiscard]] clip_looping_policy get_looping_policy() const;
+
+  // Set how end of a clip is handled, this can change player's duration.
+  // Supported by clips compressed with `clip_compression_scheme::acl`,
+  // others are always played as cooked.
+  void set_looping_policy(clip_looping_policy policy);
+
+private:
+  clip_sample_rounding _sample_rounding{clip_sample_rounding::none};
+  clip_looping_policy _looping_policy{clip_looping_policy::as_cooked};
 };
+
+inline clip_sample_rounding clip_player_base::get_sample_rounding() const
+{
+  return _sample_rounding;
+}
+
+inline void clip_player_base::set_sample_rounding(const clip_sample_rounding rounding)
+{
+  _sample_rounding = rounding;
+}
+
+inline clip_looping_policy clip_player_base::get_looping_policy() const
+{
+  return _looping_policy;
+}
+
+inline void clip_player_base::set_looping_policy(const clip_looping_policy policy)
+{
+  _looping_policy = policy;
+}
 }  // namespace eely
\ No newline at end of file
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "eely/clip/clip_impl_uniform.h"
+#include "eely/clip/clip_player_base.h"
+#include "eely/skeleton/skeleton_pose.h"
+
+#include <cstdint>
+#include <span>
+
+namespace eely::internal {
+// Player for clips compressed with `clip_compression_scheme::uniform`.
+// Player has no state, every `play` call reads two frames around requested time.
+class clip_player_uniform final : public clip_player_base {
+public:
+  explicit clip_player_uniform(const clip_metadata_uniform& metadata,
+                               std::span<const uint16_t> data);
+
+  [[nodiscard]] float get_duration_s() override;
+
+  void play(float time_s, skeleton_pose& out_pose) override;
+
+private:
+  const clip_metadata_uniform& _metadata;
+  const std::span<const uint16_t> _data;
+};
+}  // namespace eely::internal
\ No newline at end of file
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "eely/clip/clip.h"
+#include "eely/clip/clip_player_base.h"
+#include "eely/skeleton/skeleton_pose.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace eely {
+// Cache of decoded clip poses shared between multiple players.
+// Players that play the same clip at nearly the same time get the same pose,
+// which is decoded only once. Times are quantized with a configurable tolerance,
+// and a clip is played at the quantized time, thus results don't depend on which player came first.
+// Entries are valid until `clear` is called, which is expected to happen once per frame.
+// Cache is thread-safe, so graphs that share it can be played in parallel.
+class clip_pose_cache final {
+public:
+  // Create cache with specified time tolerance.
+  explicit clip_pose_cache(float time_tolerance_s = 1.0F / 120.0F);
+
+  // Set time tolerance, i.e. size of a time bucket players share a pose within.
+  // Cache is cleared, since old entries were computed with a different tolerance.
+  void set_time_tolerance_s(float time_tolerance_s);
+
+  // Return time tolerance.
+  [[nodiscard]] float get_time_tolerance_s() const;
+
+  // Remove all cached poses.
+  // Memory for poses is kept for future use.
+  void clear();
+
+  // Play a clip at specified time using cached pose if there is one.
+  // Otherwise the pose is decoded with `player` and stored in the cache.
+  // Poses are shared only between players with the same sample rounding and looping policy.
+  void play(const clip& clip, clip_player_base& player, float time_s, skeleton_pose& out_pose);
+
+  // Return number of `play` calls that were served from the cache.
+  [[nodiscard]] std::int64_t get_hits_count() const;
+
+  // Return number of `play` calls that had to decode a pose.
+  [[nodiscard]] std::int64_t get_misses_count() const;
+
+  // Reset hits and misses counters.
+  void reset_counters();
+
+private:
+  struct key final {
+    const clip* clip{nullptr};
+    std::int64_t time_bucket{0};
+    skeleton_pose::type pose_type{skeleton_pose::type::absolute};
+    clip_sample_rounding sample_rounding{clip_sample_rounding::none};
+    clip_looping_policy looping_policy{clip_looping_policy::as_cooked};
+
+    bool operator==(const key& other) const = default;
+  };
+
+  struct key_hash final {
+    std::size_t operator()(const key& key) const;
+  };
+
+  float _time_tolerance_s{0.0F};
+
+  mutable std::shared_mutex _mutex;
+  std::unordered_map<key, std::unique_ptr<skeleton_pose>, key_hash> _poses;
+  std::vector<std::unique_ptr<skeleton_pose>> _poses_free;
+
+  std::atomic<std::int64_t> _hits_count{0};
+  std::atomic<std::int64_t> _misses_count{0};
+};
+}  // namespace eely
\ No newline at end of file
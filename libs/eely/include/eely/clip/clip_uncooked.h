@@ -70,6 +70,23 @@ public:
   // Set compression scheme for the clip.
   void set_compression_scheme(clip_compression_scheme scheme);
 
+  // Return database settings used when clip is compressed with `clip_compression_scheme::acl`.
+  [[nodiscard]] const std::optional<clip_acl_database_settings>& get_acl_database_settings() const;
+
+  // Set database settings used when clip is compressed with `clip_compression_scheme::acl`.
+  // If empty, all clip data is always resident and cannot be streamed.
+  void set_acl_database_settings(const std::optional<clip_acl_database_settings>& settings);
+
+  // Return `true` if last sample, which matches the first one,
+  // is dropped when clip is compressed with `clip_compression_scheme::acl`.
+  [[nodiscard]] bool get_acl_optimize_loops() const;
+
+  // Set if last sample, which matches the first one,
+  // is dropped when clip is compressed with `clip_compression_scheme::acl`, enabled by default.
+  // This makes looped clips smaller, clips that are played once can disable it
+  // to keep their last sample, so that `clip_looping_policy::wrap` doesn't apply to them.
+  void set_acl_optimize_loops(bool optimize_loops);
+
   // Return clip's duration in seconds.
   [[nodiscard]] float get_duration_s() const;
 
@@ -77,6 +94,8 @@ private:
   string_id _target_skeleton_id;
   string_id _skeleton_mask_id;
   clip_compression_scheme _compression_scheme;
+  std::optional<clip_acl_database_settings> _acl_database_settings;
+  bool _acl_optimize_loops{true};
   std::vector<clip_uncooked_track> _tracks;
 };
 
@@ -1,7 +1,9 @@
 #pragma once
 
 #include "eely/base/assert.h"
+#include "eely/base/string_id.h"
 #include "eely/clip/clip_uncooked.h"
+#include "eely/math/float3.h"
 #include "eely/math/quaternion.h"
 #include "eely/math/transform.h"
 #include "eely/project/project.h"
@@ -11,6 +13,7 @@
 #include <gsl/util>
 
 #include <limits>
+#include <type_traits>
 #include <vector>
 
 namespace eely::internal {
@@ -21,35 +24,42 @@ struct clip_sampling_info final {
   gsl::index rate{0};
 };
 
-// Return `true` if a key has a value for specified component.
-// Helper for template methods.
-template <transform_components TComponent>
-bool clip_uncooked_key_has_component(const clip_uncooked_key& key);
+// Keys of a single component in a track, stored as parallel arrays sorted by time.
+template <typename TValue>
+struct clip_component_keys final {
+  std::vector<float> times;
+  std::vector<TValue> values;
+};
 
-// Return value of a specified component in a key,
-// Helper for template methods.
-template <transform_components TComponent>
-auto& clip_uncooked_key_get_component(const clip_uncooked_key& key);
+// Columnar representation of an uncooked track.
+// Each component's keys are stored separately, so that cooking passes
+// can iterate them linearly instead of skipping keys that miss a component.
+struct clip_track_columnar final {
+  string_id joint_id;
+  clip_component_keys<float3> translations;
+  clip_component_keys<quaternion> rotations;
+  clip_component_keys<float3> scales;
+};
 
-// Return element of a vector which has data for specified joint index,
-// and remember current position. This is to speedup subsequent getters,
-// assuming that vector is sorted by joint.
-template <typename TVector>
-auto& get_by_joint_index(TVector& data, gsl::index& data_index, gsl::index joint_index);
+// Convert a track into columnar representation.
+clip_track_columnar clip_track_columnar_from_uncooked(const clip_uncooked_track& track);
 
-// Find key that has specified component and matches a predicate.
-template <transform_components TComponent, typename TIter, typename TPredicate>
-TIter find_key_component(const TIter& begin, const TIter& end, const TPredicate& predicate);
+// Return keys of specified component in a columnar track.
+template <transform_components TComponent>
+const auto& clip_track_columnar_get_keys(const clip_track_columnar& track);
 
 // Calculate number of samples produced with specified time range and rate.
 gsl::index clip_sampling_info_calculate_samples(const clip_sampling_info& info);
 
-// Sample component's value in a track for specified time.
-// If there are no keys for this component, default value will be returned.
-template <transform_components TComponent>
-auto clip_sample_component(const clip_uncooked_track& track,
-                           const auto& default_value,
-                           float time_s);
+// Sample component's value for specified time.
+// If there are no keys, default value will be returned.
+// `cursor` is an index of a left key from the previous call, should start at zero,
+// which makes sampling with non-decreasing times a linear sweep over the keys.
+template <typename TValue>
+TValue clip_sample_component_keys(const clip_component_keys<TValue>& keys,
+                                  const TValue& default_value,
+                                  float time_s,
+                                  gsl::index& cursor);
 
 // Calculate transforms for a track's joint.
 // Values for components that are not present will taken from `default_value`.
@@ -72,117 +82,56 @@ void clip_calculate_additive_tracks(const project_uncooked& project,
 // Implementation
 
 template <transform_components TComponent>
-bool clip_uncooked_key_has_component(const clip_uncooked_key& key)
+const auto& clip_track_columnar_get_keys(const clip_track_columnar& track)
 {
   if constexpr (TComponent == transform_components::translation) {
-    return key.translation.has_value();
+    return track.translations;
   }
   else if constexpr (TComponent == transform_components::rotation) {
-    return key.rotation.has_value();
+    return track.rotations;
   }
   else {
-    return key.scale.has_value();
+    return track.scales;
   }
 }
 
-template <transform_components TComponent>
-auto& clip_uncooked_key_get_component(const clip_uncooked_key& key)
+template <typename TValue>
+TValue clip_sample_component_keys(const clip_component_keys<TValue>& keys,
+                                  const TValue& default_value,
+                                  const float time_s,
+                                  gsl::index& cursor)
 {
-  if constexpr (TComponent == transform_components::translation) {
-    return key.translation.value();
-  }
-  else if constexpr (TComponent == transform_components::rotation) {
-    return key.rotation.value();
-  }
-  else {
-    return key.scale.value();
-  }
-}
-
-template <typename TVector>
-auto& get_by_joint_index(TVector& data, gsl::index& data_index, gsl::index joint_index)
-{
-  const gsl::index data_size{std::ssize(data)};
-
-  [[maybe_unused]] const gsl::index initial_index{data_index};
-
-  while (true) {
-    auto& element{data[data_index]};
-    if (element.joint_index == joint_index) {
-      return element;
-    }
-
-    ++data_index;
+  // Find last key with time <= `time_s`, starting from the previous one.
+  // If there isn't one, output default value.
+  // If it's the last key, output its value, otherwise interpolate with the next one.
 
-    if (data_index == data_size) {
-      data_index = 0;
-    }
-
-    EXPECTS(data_index != initial_index);
-  }
-}
-
-template <transform_components TComponent, typename TIter, typename TPredicate>
-TIter find_key_component(const TIter& begin, const TIter& end, const TPredicate& predicate)
-{
-  auto find_iter{std::find_if(begin, end, [&predicate](const auto& kvp) {
-    return clip_uncooked_key_has_component<TComponent>(kvp.second) && predicate(kvp);
-  })};
-
-  return find_iter;
-}
-
-// Calculate component's value in a track for specified time.
-template <transform_components TComponent>
-auto clip_sample_component(const clip_uncooked_track& track,
-                           const auto& default_value,
-                           const float time_s)
-{
-  // Track can have 0, 1 or >1 keys for this component
-  // Seach for a key that has this component,
-  // and there isn't one, this component will have rest pose value outputed.
-  // If there is one, check if is another to lerp between.
-
-  auto key_left_iter{
-      std::find_if(track.keys.rbegin(), track.keys.rend(), [time_s](const auto& kvp) {
-        return clip_uncooked_key_has_component<TComponent>(kvp.second) && kvp.first <= time_s;
-      })};
-
-  if (key_left_iter == track.keys.rend()) {
-    // No keys, output rest pose value
+  const gsl::index keys_count{std::ssize(keys.times)};
+  if (keys_count == 0 || time_s < keys.times[0]) {
     return default_value;
   }
 
-  auto key_right_iter{std::find_if(key_left_iter.base(), track.keys.end(), [](const auto& k) {
-    return clip_uncooked_key_has_component<TComponent>(k.second);
-  })};
-
-  if (key_right_iter == track.keys.end()) {
-    // Only one key, output constant value
-    const clip_uncooked_key& key{key_left_iter->second};
-    return clip_uncooked_key_get_component<TComponent>(key);
+  if (cursor >= keys_count || keys.times[cursor] > time_s) {
+    // Time went backwards, restart the sweep
+    cursor = 0;
   }
 
-  // Both keys, output lerped value
-
-  const clip_uncooked_key& key_left{key_left_iter->second};
-  const clip_uncooked_key& key_right{key_right_iter->second};
-
-  const float interpolation_coeff{(time_s - key_left_iter->first) /
-                                  (key_right_iter->first - key_left_iter->first)};
-
-  if constexpr (TComponent == transform_components::translation) {
-    return float3_lerp(key_left.translation.value(), key_right.translation.value(),
-                       interpolation_coeff);
+  while (cursor + 1 < keys_count && keys.times[cursor + 1] <= time_s) {
+    ++cursor;
   }
 
-  if constexpr (TComponent == transform_components::rotation) {
-    return quaternion_slerp(key_left.rotation.value(), key_right.rotation.value(),
-                            interpolation_coeff);
+  if (cursor + 1 == keys_count) {
+    return keys.values[cursor];
   }
 
-  if constexpr (TComponent == transform_components::scale) {
-    return float3_lerp(key_left.scale.value(), key_right.scale.value(), interpolation_coeff);
+  const float time_left_s{keys.times[cursor]};
+  const float time_right_s{keys.times[cursor + 1]};
+  const float interpolation_coeff{(time_s - time_left_s) / (time_right_s - time_left_s)};
+
+  if constexpr (std::is_same_v<TValue, quaternion>) {
+    return quaternion_slerp(keys.values[cursor], keys.values[cursor + 1], interpolation_coeff);
+  }
+  else {
+    return float3_lerp(keys.values[cursor], keys.values[cursor + 1], interpolation_coeff);
   }
 }
 }  // namespace eely::internal
\ No newline at end of file
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "eely/math/float3.h"
+#include "eely/math/quaternion.h"
+#include "eely/skeleton/skeleton.h"
+#include "eely/skeleton/skeleton_pose.h"
+
+#include <gsl/util>
+
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace eely {
+// Limb of a humanoid skeleton that can be solved with a two-bone IK.
+enum class ik_limb { left_arm, right_arm, left_leg, right_leg };
+
+// Joints of a two-bone chain, e.g. shoulder, elbow and wrist.
+// Each joint must be a direct child of the previous one.
+struct ik_two_bone_joints final {
+  gsl::index root{0};
+  gsl::index mid{0};
+  gsl::index tip{0};
+};
+
+// Settings of a FABRIK solver.
+struct ik_fabrik_settings final {
+  // Maximum number of backward and forward passes.
+  int max_iterations{10};
+
+  // Distance between the chain's tip and a target at which solving stops.
+  float tolerance{0.001F};
+
+  // Whether joint constraints from a skeleton are forced after every pass.
+  bool constrained{true};
+};
+
+// Statistics of a FABRIK solve.
+struct ik_fabrik_result final {
+  // Number of passes that were made.
+  int iterations{0};
+
+  // Distance between the chain's tip and a target after solving.
+  float error{0.0F};
+};
+
+// Buffers a FABRIK solver works in.
+// Owned by a caller and reused between solves,
+// so that solving does not allocate once buffers are big enough for a chain.
+struct ik_fabrik_scratch final {
+  std::vector<float3> positions;
+  std::vector<quaternion> rotations_joint_space;
+  std::vector<quaternion> rotations_joint_space_original;
+  std::vector<float3> bones;
+  std::vector<float> lengths;
+};
+
+// Return joints of a specified limb using skeleton mapping,
+// or `std::nullopt` if mapping does not have them.
+std::optional<ik_two_bone_joints> ik_two_bone_joints_from_limb(const skeleton& skeleton,
+                                                               ik_limb limb);
+
+// Analytically solve a two-bone chain to reach `target_object_space`.
+// Chain bends towards `pole_object_space` if it is specified,
+// otherwise current plane of the chain is kept.
+// Only rotations of root and mid joints are modified,
+// `weight` blends between original and solved rotations.
+void ik_two_bone_solve(skeleton_pose& pose,
+                       const ik_two_bone_joints& joints,
+                       const float3& target_object_space,
+                       const std::optional<float3>& pole_object_space,
+                       float weight = 1.0F);
+
+// Collect joints from `root` to `tip` into `out_chain`, suitable for `ik_fabrik_solve`.
+// Return `false` if `tip` is not a descendant of `root`.
+bool ik_chain_collect(const skeleton& skeleton,
+                      gsl::index root,
+                      gsl::index tip,
+                      std::vector<gsl::index>& out_chain);
+
+// Solve a chain of joints with FABRIK to reach `target_object_space`.
+// `chain` lists joints from root to tip, each joint must be a direct child of the previous one.
+// Bone lengths are taken from the pose.
+// Solving stops early once the tip is within `settings.tolerance` from a target.
+// Only rotations of chain's joints are modified,
+// `weight` blends between original and solved rotations.
+// Intermediate results are kept in `scratch`.
+ik_fabrik_result ik_fabrik_solve(skeleton_pose& pose,
+                                 std::span<const gsl::index> chain,
+                                 const float3& target_object_space,
+                                 const ik_fabrik_settings& settings,
+                                 ik_fabrik_scratch& scratch,
+                                 float weight = 1.0F);
+}  // namespace eely
\ No newline at end of file
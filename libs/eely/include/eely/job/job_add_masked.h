@@ -0,0 +1,83 @@
+#pragma once
+
+#include "eely/base/assert.h"
+#include "eely/job/job_base.h"
+#include "eely/job/job_queue.h"
+#include "eely/skeleton/skeleton_pose.h"
+#include "eely/skeleton/skeleton_pose_pool.h"
+#include "eely/skeleton_mask/skeleton_mask.h"
+
+#include <gsl/util>
+
+#include <memory>
+
+namespace eely::internal {
+// Job that adds an additive pose to another with per-joint weights from a skeleton mask,
+// multiplied by a global weight.
+// Used to layer additive poses at runtime instead of cooking masked versions of clips.
+class job_add_masked final : public job_base {
+public:
+  // Set index of a job that produces a first pose (the one that produces main pose).
+  void set_first_job_index(gsl::index index);
+
+  // Set index of a job that produces a second pose (the one that produces additive pose).
+  void set_second_job_index(gsl::index index);
+
+  // Set skeleton mask with per-joint weights.
+  void set_skeleton_mask(const skeleton_mask& mask);
+
+  // Set global weight of an additive pose.
+  void set_weight(float weight);
+
+private:
+  skeleton_pose_pool::ptr execute_impl(job_queue& queue) override;
+
+  std::optional<gsl::index> _first;
+  std::optional<gsl::index> _second;
+  const skeleton_mask* _mask{nullptr};
+  float _weight{0.0F};
+};
+
+// Implementation
+
+inline void job_add_masked::set_first_job_index(const gsl::index index)
+{
+  _first = index;
+}
+
+inline void job_add_masked::set_second_job_index(const gsl::index index)
+{
+  _second = index;
+}
+
+inline void job_add_masked::set_skeleton_mask(const skeleton_mask& mask)
+{
+  _mask = &mask;
+}
+
+inline void job_add_masked::set_weight(const float weight)
+{
+  _weight = weight;
+}
+
+inline skeleton_pose_pool::ptr job_add_masked::execute_impl(job_queue& queue)
+{
+  EXPECTS(_mask != nullptr);
+
+  job_base& first_job{queue.get_job(_first.value())};
+  job_base& second_job{queue.get_job(_second.value())};
+
+  // We can reuse one pose from the pool here,
+  // let it be a pose from the first job.
+  // Second one can be released after the addition, no longer needed.
+
+  skeleton_pose_pool::ptr p0{first_job.transfer_result_pose()};
+  const skeleton_pose_pool::ptr& p1{second_job.get_result_pose()};
+
+  skeleton_pose_add_masked(*p0, *p1, *_mask, _weight, *p0);
+
+  second_job.release_result_pose();
+
+  return p0;
+}
+}  // namespace eely::internal
\ No newline at end of file
@@ -32,9 +32,18 @@ public:
   // Should only be called after this job is executed.
   void release_result_pose();
 
+#if defined(EELY_PROFILING)
+  // Set id of a graph node that added this job, to attribute its cost to.
+  void set_profiling_node_id(int node_id);
+#endif
+
 private:
   virtual skeleton_pose_pool::ptr execute_impl(job_queue& queue) = 0;
 
   skeleton_pose_pool::ptr _result;
+
+#if defined(EELY_PROFILING)
+  int _profiling_node_id{-1};
+#endif
 };
 }  // namespace eely::internal
\ No newline at end of file
@@ -1,6 +1,8 @@
 #pragma once
 
+#include "eely/clip/clip.h"
 #include "eely/clip/clip_player_base.h"
+#include "eely/clip/clip_pose_cache.h"
 #include "eely/job/job_base.h"
 #include "eely/job/job_queue.h"
 #include "eely/skeleton/skeleton_pose.h"
@@ -15,6 +17,10 @@ public:
   // Set player for the job to use.
   void set_player(clip_player_base& player);
 
+  // Set cache to look up decoded poses in before playing, `nullptr` disables caching.
+  // `clip` must be the one player was created for.
+  void set_cache(clip_pose_cache* cache, const clip& clip);
+
   // Set time to play the clip at.
   void set_time(float time_s);
 
@@ -22,6 +28,8 @@ private:
   skeleton_pose_pool::ptr execute_impl(job_queue& queue) override;
 
   clip_player_base* _player{nullptr};
+  clip_pose_cache* _cache{nullptr};
+  const clip* _clip{nullptr};
   float _time_s{0.0F};
 };
 
@@ -32,6 +40,12 @@ inline void job_clip::set_player(clip_player_base& player)
   _player = &player;
 }
 
+inline void job_clip::set_cache(clip_pose_cache* cache, const clip& clip)
+{
+  _cache = cache;
+  _clip = &clip;
+}
+
 inline void job_clip::set_time(const float time_s)
 {
   EXPECTS(_player != nullptr);
@@ -43,7 +57,15 @@ inline void job_clip::set_time(const float time_s)
 inline skeleton_pose_pool::ptr job_clip::execute_impl(job_queue& queue)
 {
   auto pose_ptr{queue.get_pose_pool().borrow()};
-  _player->play(_time_s, *pose_ptr);
+
+  if (_cache != nullptr) {
+    EXPECTS(_clip != nullptr);
+    _cache->play(*_clip, *_player, _time_s, *pose_ptr);
+  }
+  else {
+    _player->play(_time_s, *pose_ptr);
+  }
+
   return pose_ptr;
 }
 }  // namespace eely::internal
\ No newline at end of file
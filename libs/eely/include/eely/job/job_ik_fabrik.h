@@ -0,0 +1,92 @@
+#pragma once
+
+#include "eely/ik/ik.h"
+#include "eely/job/job_base.h"
+#include "eely/job/job_queue.h"
+#include "eely/math/float3.h"
+#include "eely/skeleton/skeleton_pose.h"
+#include "eely/skeleton/skeleton_pose_pool.h"
+
+#include <gsl/util>
+
+#include <memory>
+#include <optional>
+#include <span>
+
+namespace eely::internal {
+// Job that solves a chain of another job's pose with FABRIK to reach a target.
+class job_ik_fabrik final : public job_base {
+public:
+  // Set index of a job that produces a pose to solve.
+  void set_job_index(gsl::index index);
+
+  // Set joints of a chain, from root to tip.
+  // Chain is not copied and must outlive the job.
+  void set_chain(std::span<const gsl::index> chain);
+
+  // Set target to reach, relative to the object.
+  void set_target(const float3& target);
+
+  // Set solver settings.
+  void set_settings(const ik_fabrik_settings& settings);
+
+  // Set weight between original and solved poses.
+  void set_weight(float weight);
+
+  // Get statistics of the last solve.
+  [[nodiscard]] const ik_fabrik_result& get_result() const;
+
+private:
+  skeleton_pose_pool::ptr execute_impl(job_queue& queue) override;
+
+  std::optional<gsl::index> _job_index;
+  std::span<const gsl::index> _chain;
+  float3 _target;
+  ik_fabrik_settings _settings;
+  float _weight{1.0F};
+  ik_fabrik_result _result;
+  ik_fabrik_scratch _scratch;
+};
+
+// Implementation
+
+inline void job_ik_fabrik::set_job_index(const gsl::index index)
+{
+  _job_index = index;
+}
+
+inline void job_ik_fabrik::set_chain(const std::span<const gsl::index> chain)
+{
+  _chain = chain;
+}
+
+inline void job_ik_fabrik::set_target(const float3& target)
+{
+  _target = target;
+}
+
+inline void job_ik_fabrik::set_settings(const ik_fabrik_settings& settings)
+{
+  _settings = settings;
+}
+
+inline void job_ik_fabrik::set_weight(const float weight)
+{
+  _weight = weight;
+}
+
+inline const ik_fabrik_result& job_ik_fabrik::get_result() const
+{
+  return _result;
+}
+
+inline skeleton_pose_pool::ptr job_ik_fabrik::execute_impl(job_queue& queue)
+{
+  job_base& job{queue.get_job(_job_index.value())};
+
+  skeleton_pose_pool::ptr pose{job.transfer_result_pose()};
+  _result = ik_fabrik_solve(*pose, _chain, _target, _settings, _scratch, _weight);
+
+  return pose;
+}
+}  // namespace eely::internal
\ No newline at end of file
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "eely/ik/ik.h"
+#include "eely/job/job_base.h"
+#include "eely/job/job_queue.h"
+#include "eely/math/float3.h"
+#include "eely/skeleton/skeleton_pose.h"
+#include "eely/skeleton/skeleton_pose_pool.h"
+
+#include <gsl/util>
+
+#include <memory>
+#include <optional>
+
+namespace eely::internal {
+// Job that solves a two-bone chain of another job's pose to reach a target.
+class job_ik_two_bone final : public job_base {
+public:
+  // Set index of a job that produces a pose to solve.
+  void set_job_index(gsl::index index);
+
+  // Set joints of a chain.
+  void set_joints(const ik_two_bone_joints& joints);
+
+  // Set target to reach, relative to the object.
+  void set_target(const float3& target);
+
+  // Set optional pole the chain bends towards, relative to the object.
+  void set_pole(const std::optional<float3>& pole);
+
+  // Set weight between original and solved poses.
+  void set_weight(float weight);
+
+private:
+  skeleton_pose_pool::ptr execute_impl(job_queue& queue) override;
+
+  std::optional<gsl::index> _job_index;
+  ik_two_bone_joints _joints;
+  float3 _target;
+  std::optional<float3> _pole;
+  float _weight{1.0F};
+};
+
+// Implementation
+
+inline void job_ik_two_bone::set_job_index(const gsl::index index)
+{
+  _job_index = index;
+}
+
+inline void job_ik_two_bone::set_joints(const ik_two_bone_joints& joints)
+{
+  _joints = joints;
+}
+
+inline void job_ik_two_bone::set_target(const float3& target)
+{
+  _target = target;
+}
+
+inline void job_ik_two_bone::set_pole(const std::optional<float3>& pole)
+{
+  _pole = pole;
+}
+
+inline void job_ik_two_bone::set_weight(const float weight)
+{
+  _weight = weight;
+}
+
+inline skeleton_pose_pool::ptr job_ik_two_bone::execute_impl(job_queue& queue)
+{
+  job_base& job{queue.get_job(_job_index.value())};
+
+  skeleton_pose_pool::ptr pose{job.transfer_result_pose()};
+  ik_two_bone_solve(*pose, _joints, _target, _pole, _weight);
+
+  return pose;
+}
+}  // namespace eely::internal
\ No newline at end of file
@@ -6,6 +6,7 @@
 
 #include <gsl/util>
 
+#include <memory_resource>
 #include <vector>
 
 namespace eely::internal {
@@ -16,7 +17,9 @@ class job_base;
 class job_queue final {
 public:
   // Construct job queue for specified skeleton.
-  explicit job_queue(const skeleton& skeleton);
+  // Lists of jobs and saved poses are allocated with `memory_resource`.
+  explicit job_queue(const skeleton& skeleton,
+                     std::pmr::memory_resource* memory_resource = std::pmr::get_default_resource());
 
   // Add job to be executed and return its index.
   gsl::index add_job(job_base& job);
@@ -39,9 +42,18 @@ public:
   // Restore pose from a speicifed slot.
   const skeleton_pose_pool::ptr& restore_pose(gsl::index pose_slot);
 
+#if defined(EELY_PROFILING)
+  // Set id of a graph node that adds jobs from now on and return the previous one.
+  int exchange_profiling_node_id(int node_id);
+#endif
+
 private:
-  std::vector<job_base*> _jobs;
+  std::pmr::vector<job_base*> _jobs;
   skeleton_pose_pool _pose_pool;
-  std::vector<skeleton_pose_pool::ptr> _saved_poses;
+  std::pmr::vector<skeleton_pose_pool::ptr> _saved_poses;
+
+#if defined(EELY_PROFILING)
+  int _profiling_node_id{-1};
+#endif
 };
 }  // namespace eely::internal
\ No newline at end of file
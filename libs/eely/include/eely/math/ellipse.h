@@ -12,6 +12,9 @@ struct ellipse final {
   float radius_y{0.0F};
 };
 
+// Maximum error of `ellipse_project_point_fixed`, relative to the larger radius.
+static constexpr float ellipse_project_point_fixed_max_error{0.002F};
+
 // Calculate point on an ellipse from a given positive angle.
 [[nodiscard]] float2 ellipse_point_from_angle(const ellipse& ellipse, float angle_rad);
 
@@ -19,6 +22,13 @@ struct ellipse final {
 // e.g. return another point that lies on an ellipse that is closest to the given point.
 [[nodiscard]] float2 ellipse_project_point(const ellipse& ellipse, const float2& point);
 
+// Calculate projection of a given point on an ellipse using fixed number of iterations.
+// Cheaper than `ellipse_project_point`, but less precise for elongated ellipses:
+// result always lies on the ellipse, and its distance to the point is longer than the exact one
+// by at most `ellipse_project_point_fixed_max_error` of the larger radius
+// (measured for radii ratios up to 64 and points up to ten radii away).
+[[nodiscard]] float2 ellipse_project_point_fixed(const ellipse& ellipse, const float2& point);
+
 // Return `true` if point is on a given ellipse.
 [[nodiscard]] bool ellipse_is_point_on(const ellipse& ellipse, const float2& point);
 
@@ -23,6 +23,7 @@ bool elliptical_cone_is_direction_on(const elliptical_cone& cone, const float3&
                                                        const float3& direction);
 
 // Project direction vector onto the cone.
+// Uses `ellipse_project_point_fixed`, so the result is within its error bound.
 [[nodiscard]] float3 elliptical_cone_project_direction(const elliptical_cone& cone,
                                                        float3 direction);
 }  // namespace eely::internal
\ No newline at end of file
@@ -0,0 +1,116 @@
+#pragma once
+
+#include "eely/math/float3.h"
+#include "eely/math/quaternion.h"
+#include "eely/math/transform.h"
+
+#include <rtm/qvvf.h>
+#include <rtm/quatf.h>
+#include <rtm/vector4f.h>
+
+#include <cmath>
+
+// Conversions between eely's math types and rtm's SIMD types.
+// eely types stay the storage and API format,
+// rtm types are used for computations in hot paths when `EELY_MATH_RTM` is defined.
+
+namespace eely::internal {
+// Load `float3` into rtm vector, `w` component is undefined.
+rtm::vector4f float3_to_rtm(const float3& v);
+
+// Store xyz components of rtm vector into `float3`.
+void float3_from_rtm(rtm::vector4f_arg0 v, float3& out_v);
+
+// Load `quaternion` into rtm quaternion.
+rtm::quatf quaternion_to_rtm(const quaternion& q);
+
+// Store rtm quaternion into `quaternion`.
+void quaternion_from_rtm(rtm::quatf_arg0 q, quaternion& out_q);
+
+// Load `transform` into rtm qvv transform.
+rtm::qvvf transform_to_rtm(const transform& t);
+
+// Store rtm qvv transform into `transform`.
+void transform_from_rtm(rtm::qvvf_arg0 t, transform& out_t);
+
+// Return result of `t0 * t1` for rtm transforms.
+// Unlike `rtm::qvv_mul`, which goes through matrices for negative scales,
+// this follows `transform` semantics exactly: scales are multiplied componentwise.
+rtm::qvvf transform_mul_rtm(rtm::qvvf_arg0 t0, rtm::qvvf_arg1 t1);
+
+// Return result of `quaternion_slerp` for rtm quaternions.
+// Unlike `rtm::quat_slerp`, this falls back to normalized lerp for close rotations
+// and thus is safe to use with equal quaternions.
+rtm::quatf quaternion_slerp_rtm(rtm::quatf_arg0 q0, rtm::quatf_arg1 q1, float t);
+
+// Implementation
+
+inline rtm::vector4f float3_to_rtm(const float3& v)
+{
+  return rtm::vector_load3(&v.x);
+}
+
+inline void float3_from_rtm(rtm::vector4f_arg0 v, float3& out_v)
+{
+  rtm::vector_store3(v, &out_v.x);
+}
+
+inline rtm::quatf quaternion_to_rtm(const quaternion& q)
+{
+  return rtm::quat_load(&q.x);
+}
+
+inline void quaternion_from_rtm(rtm::quatf_arg0 q, quaternion& out_q)
+{
+  rtm::quat_store(q, &out_q.x);
+}
+
+inline rtm::qvvf transform_to_rtm(const transform& t)
+{
+  return rtm::qvv_set(quaternion_to_rtm(t.rotation), float3_to_rtm(t.translation),
+                      float3_to_rtm(t.scale));
+}
+
+inline void transform_from_rtm(rtm::qvvf_arg0 t, transform& out_t)
+{
+  float3_from_rtm(t.translation, out_t.translation);
+  quaternion_from_rtm(t.rotation, out_t.rotation);
+  float3_from_rtm(t.scale, out_t.scale);
+}
+
+inline rtm::qvvf transform_mul_rtm(rtm::qvvf_arg0 t0, rtm::qvvf_arg1 t1)
+{
+  // rtm multiplication order is reversed: `rtm::quat_mul(local_to_parent, parent_to_world)`
+  const rtm::quatf rotation = rtm::quat_mul(t1.rotation, t0.rotation);
+  const rtm::vector4f translation = rtm::qvv_mul_point3(t1.translation, t0);
+  const rtm::vector4f scale = rtm::vector_mul(t0.scale, t1.scale);
+
+  return rtm::qvv_set(rotation, translation, scale);
+}
+
+inline rtm::quatf quaternion_slerp_rtm(rtm::quatf_arg0 q0, rtm::quatf_arg1 q1, const float t)
+{
+  float cos_angle{rtm::quat_dot(q0, q1)};
+
+  rtm::quatf q1_shortest{q1};
+  if (cos_angle < 0.0F) {
+    cos_angle = -cos_angle;
+    q1_shortest = rtm::quat_neg(q1);
+  }
+
+  float k0{1.0F - t};
+  float k1{t};
+  if (cos_angle < 0.95F) {
+    const float angle{std::acos(cos_angle)};
+    const float sin_inversed{1.0F / std::sin(angle)};
+
+    k0 = std::sin(k0 * angle) * sin_inversed;
+    k1 = std::sin(k1 * angle) * sin_inversed;
+  }
+
+  const rtm::vector4f result{
+      rtm::vector_add(rtm::vector_mul(rtm::quat_to_vector(q0), k0),
+                      rtm::vector_mul(rtm::quat_to_vector(q1_shortest), k1))};
+  return rtm::quat_normalize(rtm::vector_to_quat(result));
+}
+}  // namespace eely::internal
\ No newline at end of file
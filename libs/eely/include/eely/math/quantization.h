@@ -4,7 +4,10 @@
 
 #include <gsl/util>
 
+#include <rtm/vector4f.h>
+
 #include <cstdint>
+#include <cstring>
 #include <span>
 
 namespace eely::internal {
@@ -36,6 +39,30 @@ std::array<uint16_t, 4> quaternion_quantize(const quaternion& q);
 // Dequantize quaternion from 64 bits (so `data` should have at least four `uint16_t`).
 quaternion quaternion_dequantize(std::span<const uint16_t> data);
 
+// Dequantize four consecutive 16-bit values starting at `data`
+// as `range_from + value * range_scale`, all at once.
+// Scale is expected to be precomputed as `range_length / 65535`,
+// so that no divisions and branches are needed.
+rtm::vector4f vector_dequantize4(const uint16_t* data,
+                                 rtm::vector4f_arg0 range_from,
+                                 rtm::vector4f_arg1 range_scale);
+
+// Same as `vector_dequantize4`, but reads only three values.
+// Use for data that might end right after these values.
+// Resulting `w` component is `range_from`'s `w`.
+rtm::vector4f vector_dequantize3(const uint16_t* data,
+                                 rtm::vector4f_arg0 range_from,
+                                 rtm::vector4f_arg1 range_scale);
+
+// Half precision
+
+// Convert float into IEEE 754 half precision float, rounding to nearest even.
+// Values that are too big for half precision become infinities.
+uint16_t float_to_half(float value);
+
+// Convert IEEE 754 half precision float into float.
+float half_to_float(uint16_t value);
+
 // Implementation
 
 inline float float_dequantize(const float_dequantize_params& params)
@@ -56,6 +83,44 @@ inline float float_dequantize(const float_dequantize_params& params)
   return result;
 }
 
+inline rtm::vector4f vector_dequantize4(const uint16_t* data,
+                                        rtm::vector4f_arg0 range_from,
+                                        rtm::vector4f_arg1 range_scale)
+{
+#if defined(RTM_SSE2_INTRINSICS)
+  const __m128i data_u16{_mm_loadl_epi64(reinterpret_cast<const __m128i*>(data))};
+  const __m128i data_u32{_mm_unpacklo_epi16(data_u16, _mm_setzero_si128())};
+  const rtm::vector4f quantized = _mm_cvtepi32_ps(data_u32);
+#else
+  const rtm::vector4f quantized = rtm::vector_set(
+      static_cast<float>(data[0]), static_cast<float>(data[1]), static_cast<float>(data[2]),
+      static_cast<float>(data[3]));
+#endif
+
+  return rtm::vector_mul_add(quantized, range_scale, range_from);
+}
+
+inline rtm::vector4f vector_dequantize3(const uint16_t* data,
+                                        rtm::vector4f_arg0 range_from,
+                                        rtm::vector4f_arg1 range_scale)
+{
+#if defined(RTM_SSE2_INTRINSICS)
+  int32_t data_xy{0};
+  std::memcpy(&data_xy, data, sizeof(data_xy));
+
+  __m128i data_u16{_mm_cvtsi32_si128(data_xy)};
+  data_u16 = _mm_insert_epi16(data_u16, data[2], 2);
+
+  const __m128i data_u32{_mm_unpacklo_epi16(data_u16, _mm_setzero_si128())};
+  const rtm::vector4f quantized = _mm_cvtepi32_ps(data_u32);
+#else
+  const rtm::vector4f quantized = rtm::vector_set(
+      static_cast<float>(data[0]), static_cast<float>(data[1]), static_cast<float>(data[2]), 0.0F);
+#endif
+
+  return rtm::vector_mul_add(quantized, range_scale, range_from);
+}
+
 inline quaternion quaternion_dequantize(const std::span<const uint16_t> data)
 {
   float_dequantize_params params{.bits_count = 16, .range_from = -1.0F, .range_length = 2.0F};
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "eely/base/base_utils.h"
 #include "eely/base/bit_reader.h"
 #include "eely/base/bit_writer.h"
 #include "eely/base/string_id.h"
@@ -9,6 +10,7 @@
 #include <exception>
 #include <stdexcept>
 #include <unordered_map>
+#include <utility>
 #include <variant>
 
 namespace eely {
@@ -21,6 +23,17 @@ using param_value = std::variant<std::monostate, int, float, bool>;
 // TODO: assign indices to params and use them instead of map lookups.
 struct params final {
 public:
+  params() = default;
+  params(const params&) = default;
+
+  // Moved-from parameters are empty and get a new version.
+  params(params&& other) noexcept;
+
+  ~params() = default;
+
+  params& operator=(const params&) = default;
+  params& operator=(params&& other) noexcept;
+
   // Get parameter as a variant.
   const param_value& get(const string_id& id) const;
 
@@ -29,17 +42,58 @@ public:
   [[nodiscard]] const T& get_value(const string_id& id) const;
 
   // Get modifiable parameter value.
+  // Parameter is considered changed on every call, since it can be modified via returned reference.
+  // Thus returned reference should not be kept and modified across graph updates,
+  // and `set_value` is preferred if value might stay the same.
   template <typename T>
   [[nodiscard]] T& get_value(const string_id& id);
 
+  // Set parameter value.
+  // Parameter is considered changed only if new value differs from the current one.
+  template <typename T>
+  void set_value(const string_id& id, const T& value);
+
+  // Set parameter as a variant.
+  // Parameter is considered changed only if new value differs from the current one.
+  void set(const string_id& id, const param_value& value);
+
+  // Call `func(id, value)` for every parameter that might have changed after specified version.
+  // Parameters are visited in unspecified order.
+  template <typename TFunc>
+  void for_each_changed(std::uint64_t version, const TFunc& func) const;
+
+  // Return version of all parameters.
+  // Version changes every time any parameter might have changed.
+  // Versions are unique across all parameters objects,
+  // so equal versions of two objects mean that their parameters are equal too,
+  // e.g. if one is a copy of another.
+  [[nodiscard]] std::uint64_t get_version() const;
+
+  // Return version of a specific parameter.
+  // Version changes every time this parameter might have changed,
+  // and is unique across all parameters objects as well.
+  // Can be used to skip computations that only depend on unchanged parameters,
+  // even if they are given another parameters object.
+  [[nodiscard]] std::uint64_t get_version(const string_id& id) const;
+
 private:
+  struct entry final {
+    param_value value;
+    std::uint64_t version{0};
+  };
+
+  entry& get_entry_changed(const string_id& id) const;
+
   // Mutable to intiailize default values in const getters.
-  mutable std::unordered_map<string_id, param_value> _parameters;
+  mutable std::unordered_map<string_id, entry> _parameters;
+  mutable std::uint64_t _version{0};
 };
 
 namespace internal {
+// Return next version of parameters, unique across all parameters objects.
+std::uint64_t params_version_next();
+
 static constexpr gsl::index bits_param_value_type_index{5};
-static constexpr gsl::index bits_param_value_int{16};
 
 // Return `param_value` value read from a memory buffer.
 template <>
@@ -51,17 +105,38 @@ void bit_writer_write(bit_writer& writer, const param_value& value);
 
 // Implementation
 
+inline params::params(params&& other) noexcept
+    : _parameters{std::move(other._parameters)}, _version{other._version}
+{
+  other._parameters.clear();
+  other._version = internal::params_version_next();
+}
+
+inline params& params::operator=(params&& other) noexcept
+{
+  if (this != &other) {
+    _parameters = std::move(other._parameters);
+    _version = other._version;
+
+    other._parameters.clear();
+    other._version = internal::params_version_next();
+  }
+
+  return *this;
+}
+
 inline const param_value& params::get(const string_id& id) const
 {
-  return _parameters[id];
+  return _parameters[id].value;
 }
 
 template <typename T>
 const T& params::get_value(const string_id& id) const
 {
-  param_value& variant{_parameters[id]};
+  param_value& variant{_parameters[id].value};
 
   if (std::get_if<std::monostate>(&variant) != nullptr) {
+    get_entry_changed(id);
     variant = T{};
   }
 
@@ -71,7 +146,7 @@ const T& params::get_value(const string_id& id) const
 template <typename T>
 T& params::get_value(const string_id& id)
 {
-  param_value& variant{_parameters[id]};
+  param_value& variant{get_entry_changed(id).value};
 
   if (std::get_if<std::monostate>(&variant) != nullptr) {
     variant = T{};
@@ -80,6 +155,59 @@ T& params::get_value(const string_id& id)
   return std::get<T>(variant);
 }
 
+template <typename T>
+void params::set_value(const string_id& id, const T& value)
+{
+  const entry& current{_parameters[id]};
+
+  const T* current_value{std::get_if<T>(&current.value)};
+  if (current_value != nullptr && *current_value == value) {
+    return;
+  }
+
+  get_entry_changed(id).value = value;
+}
+
+inline void params::set(const string_id& id, const param_value& value)
+{
+  if (_parameters[id].value == value) {
+    return;
+  }
+
+  get_entry_changed(id).value = value;
+}
+
+template <typename TFunc>
+void params::for_each_changed(const std::uint64_t version, const TFunc& func) const
+{
+  for (const auto& [id, entry] : _parameters) {
+    if (entry.version > version) {
+      func(id, entry.value);
+    }
+  }
+}
+
+inline std::uint64_t params::get_version() const
+{
+  return _version;
+}
+
+inline std::uint64_t params::get_version(const string_id& id) const
+{
+  const auto iter{_parameters.find(id)};
+  return iter != _parameters.end() ? iter->second.version : 0;
+}
+
+inline params::entry& params::get_entry_changed(const string_id& id) const
+{
+  entry& result{_parameters[id]};
+
+  _version = internal::params_version_next();
+  result.version = _version;
+
+  return result;
+}
+
 namespace internal {
 template <>
 inline param_value bit_reader_read(bit_reader& reader)
@@ -94,7 +222,8 @@ inline param_value bit_reader_read(bit_reader& reader)
 
     case 1: {
       static_assert(std::is_same_v<std::variant_alternative_t<1, param_value>, int>);
-      result = bit_reader_read<int>(reader, bits_param_value_int);
+      static_assert(sizeof(int) == sizeof(uint32_t));
+      result = bit_cast<int>(bit_reader_read<uint32_t>(reader));
     } break;
 
     case 2: {
@@ -0,0 +1,98 @@
+#pragma once
+
+#include "eely/base/bit_reader.h"
+#include "eely/base/bit_writer.h"
+#include "eely/base/string_id.h"
+#include "eely/params/params.h"
+
+#include <gsl/util>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace eely {
+// Records inputs of an animation graph player, so that a session could be replayed later,
+// e.g. to reproduce a performance spike in a benchmark.
+// Per frame only delta time and changed parameters are recorded.
+// Recording should start along with a freshly created player,
+// since player's own state, such as current states in state machines, is not recorded.
+class params_recorder final {
+public:
+  // Start recording a session of a player seeded with `random_seed`
+  // (see `anim_graph_player::get_random_seed`).
+  explicit params_recorder(uint32_t random_seed);
+
+  // Record inputs of a single `anim_graph_player::play` call.
+  // Throw `std::runtime_error` if recording would exceed 65535 different parameters
+  // or 2^32 - 1 frames, nothing is recorded in this case.
+  void record(float dt_s, const params& params);
+
+  // Return number of recorded frames.
+  [[nodiscard]] gsl::index get_frames_count() const;
+
+  // Write recording with specified writer.
+  void serialize(internal::bit_writer& writer) const;
+
+  // Return recording in an exactly sized memory buffer.
+  [[nodiscard]] std::vector<std::byte> serialize() const;
+
+private:
+  struct frame final {
+    float dt_s{0.0F};
+
+    // Indices into `_ids` and new values.
+    std::vector<std::pair<gsl::index, param_value>> changes;
+  };
+
+  uint32_t _random_seed;
+
+  // Parameter ids are written once, frames refer to them by index.
+  std::vector<string_id> _ids;
+  std::unordered_map<string_id, gsl::index> _id_to_index;
+
+  std::vector<frame> _frames;
+  std::uint64_t _recorded_version{0};
+};
+
+// Plays back a recording made with `params_recorder`.
+// Frames are decoded one at a time, directly from recording's memory.
+class params_replayer final {
+public:
+  // Start replaying specified recording.
+  // Recording's memory must outlive the replayer.
+  explicit params_replayer(std::span<const std::byte> recording);
+
+  // Return seed a player should be seeded with for the replay to be deterministic.
+  [[nodiscard]] uint32_t get_random_seed() const;
+
+  // Return number of frames in a recording.
+  [[nodiscard]] gsl::index get_frames_count() const;
+
+  // Return `true` if all frames have been replayed.
+  [[nodiscard]] bool is_finished() const;
+
+  // Apply parameter changes of the next frame to `out_params`,
+  // and return delta time to play a player with.
+  float replay(params& out_params);
+
+  // Start replaying from the first frame.
+  // Parameters should be reset by the caller as well, e.g. by creating a new `params` object.
+  void restart();
+
+private:
+  // Read everything that goes before frames.
+  void read_header();
+
+  std::span<const std::byte> _recording;
+  internal::bit_reader _reader;
+
+  uint32_t _random_seed{0};
+  std::vector<string_id> _ids;
+  gsl::index _frames_count{0};
+  gsl::index _frame_index{0};
+};
+}  // namespace eely
\ No newline at end of file
@@ -5,17 +5,41 @@
 #include "eely/project/project_uncooked.h"
 #include "eely/project/resource.h"
 
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <memory>
 #include <span>
 #include <unordered_map>
+#include <vector>
 
 namespace eely {
+// Version of cooked projects' format, written at the start of every cooked project.
+// Loading a project cooked with a different version throws `std::runtime_error`.
+// Increment it whenever serialization of any resource changes.
+static constexpr uint32_t project_cooked_version{1};
+
+// Function that reads bytes of a cooked project starting at specified offset into `out_bytes`,
+// e.g. from a file the project was cooked into.
+using project_data_reader = std::function<void(size_t offset, std::span<std::byte> out_bytes)>;
+
 // Represents a set of cooked resources used in an application.
 class project final {
 public:
   // Create project from a memory buffer.
+  // Throw `std::runtime_error` if the project was cooked with another format version.
+  // Tiers of clips cooked with `clip_acl_database_settings` are copied from the buffer,
+  // they stay resident and are streamed in after loading.
   explicit project(const std::span<std::byte>& buffer);
 
+  // Create project from a memory buffer,
+  // reading tiers of clips cooked with `clip_acl_database_settings` on demand.
+  // Tiers are read with `tiers_reader` when streamed in and released when streamed out,
+  // offsets passed to it are relative to the start of `buffer`.
+  // Buffer is not referenced after loading, reader is kept until the project is destroyed.
+  // Tiers are streamed out after loading, use `clips_stream` to stream them in.
+  explicit project(const std::span<std::byte>& buffer, project_data_reader tiers_reader);
+
   ~project() = default;
 
   project(const project&) = delete;
@@ -35,16 +59,54 @@ public:
   requires std::derived_from<TRes, resource>
   [[nodiscard]] std::vector<string_id> get_ids() const;
 
+  // Stream tiers of clips cooked with `clip_acl_database_settings` in or out,
+  // so that streamed data of all clips fits into specified memory budget.
+  // Clips are processed in given order, most important first,
+  // and each gets as many tiers as fit into what is left of the budget.
+  // Clips that are not listed are streamed out completely.
+  // Budget limits memory only if project reads tiers on demand (see constructors),
+  // otherwise tiers stay resident and budget limits how much of them players use.
+  // Must not be called while clips are played, e.g. during a parallel update.
+  // Return number of bytes streamed data takes after this call.
+  size_t clips_stream(std::span<const string_id> clip_ids_by_priority, size_t budget_bytes);
+
+  // Return function tiers of streamed clips are read with,
+  // empty if they are resident (see constructors).
+  [[nodiscard]] const project_data_reader& get_tiers_reader() const;
+
   // Cook project from uncooked version
   // and write results into a memory buffer.
   static void cook(const project_uncooked& project_uncooked,
                    const std::span<std::byte>& out_buffer);
 
+  // Cook project from uncooked version
+  // and write results with specified writer.
+  static void cook(const project_uncooked& project_uncooked, internal::bit_writer& writer);
+
+  // Cook project from uncooked version
+  // and return results in an exactly sized memory buffer.
+  // Resources are cooked once, their size is measured before writing.
+  static std::vector<std::byte> cook(const project_uncooked& project_uncooked);
+
+  // Return size in bytes of a cooked project.
+  // Project is cooked without writing results, so the cost is the same as of `cook`.
+  static size_t cook_size(const project_uncooked& project_uncooked);
+
 private:
   // Used only during cooking
   explicit project() = default;
 
+  // Cook all resources from uncooked project into this one.
+  // Return resources in the order they were cooked.
+  [[nodiscard]] std::vector<const resource*> cook_resources(
+      const project_uncooked& project_uncooked);
+
+  // Write resources in the order `cook_resources` returned.
+  static void serialize_resources(const std::vector<const resource*>& cooking_order,
+                                  internal::bit_writer& writer);
+
   std::unordered_map<string_id, std::unique_ptr<resource>> _resources;
+  project_data_reader _tiers_reader;
 };
 
 template <typename TRes>
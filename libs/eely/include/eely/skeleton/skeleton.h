@@ -3,6 +3,7 @@
 #include "eely/base/bit_reader.h"
 #include "eely/base/bit_writer.h"
 #include "eely/base/string_id.h"
+#include "eely/math/elliptical_cone.h"
 #include "eely/math/transform.h"
 #include "eely/project/resource.h"
 #include "eely/skeleton/skeleton_uncooked.h"
@@ -32,6 +33,14 @@ public:
     std::optional<gsl::index> right_arm;
     std::optional<gsl::index> right_forearm;
     std::optional<gsl::index> right_hand;
+
+    std::optional<gsl::index> left_up_leg;
+    std::optional<gsl::index> left_leg;
+    std::optional<gsl::index> left_foot;
+
+    std::optional<gsl::index> right_up_leg;
+    std::optional<gsl::index> right_leg;
+    std::optional<gsl::index> right_foot;
   };
 
   // Represents joint limits.
@@ -50,6 +59,13 @@ public:
     // Distance from parent to child,
     // i.e. bone length.
     float distance{0.0F};
+
+    // Precomputed inverse of `child_constraint_delta`.
+    quaternion child_constraint_delta_inverse;
+
+    // Precomputed cone of allowed swings,
+    // valid only if both swing limits are specified.
+    internal::elliptical_cone swing_cone;
   };
 
   // Construct a skeleton from a memory buffer.
@@ -78,31 +94,56 @@ public:
   // (or to object, if joint is a root).
   [[nodiscard]] const std::vector<transform>& get_rest_pose_transforms() const;
 
+  // Return inverse bind transforms,
+  // i.e. inverses of rest pose transforms relative to the object.
+  // Used to build skinning palettes.
+  [[nodiscard]] const std::vector<transform>& get_inverse_bind_transforms() const;
+
   // Get constraint of a joint with specified index.
   [[nodiscard]] const constraint& get_constraint(gsl::index index) const;
 
+  // Return indices of joints that have any limits, in ascending order.
+  [[nodiscard]] const std::vector<gsl::index>& get_constrained_joint_indices() const;
+
   // Get skeleton mapping.
   [[nodiscard]] const mapping& get_mapping() const;
 
 private:
   static constexpr gsl::index null_index{internal::joints_max_count};
 
+  void calculate_inverse_bind_transforms();
+
   std::vector<string_id> _joint_ids;
   std::vector<gsl::index> _joint_parents;
   std::vector<transform> _rest_pose;
+  std::vector<transform> _inverse_bind;
   std::vector<constraint> _constraints;
+  std::vector<gsl::index> _constrained_joint_indices;
   mapping _mapping;
 };
 
 // Force constraints on all joints in a pose.
+// Only joints with limits are visited and object space is updated once for the whole pass,
+// so it is much cheaper than forcing constraints joint by joint.
+// `rotations_object_space_scratch` is a caller-owned buffer for object space rotations,
+// it is resized to the number of joints, thus no allocations happen once it is big enough.
 // Return `true` if any joint was constrained from its previous transform.
-bool constraint_force(skeleton_pose& pose);
+bool constraint_force(skeleton_pose& pose,
+                      std::vector<quaternion>& rotations_object_space_scratch);
 
 // Force constraint on a given joint in a pose.
 // Return `true` if a joint was constrained from its previous transform.
 bool constraint_force(skeleton_pose& pose, gsl::index joint_index);
 
+// Force constraint on a joint with specified object space rotation of it and its parent.
+// Used when object space rotations are already known, e.g. by IK solvers.
+// Return `true` if `rotation_object_space` was constrained.
+bool constraint_force(const skeleton::constraint& constraint,
+                      const quaternion& parent_rotation_object_space,
+                      quaternion& rotation_object_space);
+
 // Force constraint on a given orientation.
+// Uses swing cone precomputed in `constraint` during cooking.
 // Return `true` if constraint was indeed forced.
 bool constraint_force(const skeleton::constraint& constraint, quaternion& q);
 }  // namespace eely
\ No newline at end of file
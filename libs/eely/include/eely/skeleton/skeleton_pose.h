@@ -3,15 +3,39 @@
 #include "eely/math/quaternion.h"
 #include "eely/math/transform.h"
 #include "eely/skeleton/skeleton.h"
+#include "eely/skeleton_mask/skeleton_mask.h"
 
 #include <gsl/narrow>
 #include <gsl/pointers>
 #include <gsl/util>
 
+#include <cstddef>
 #include <optional>
+#include <span>
 #include <vector>
 
 namespace eely {
+// Layout of a single joint in a skinning palette.
+// Every joint's entry is object space transform multiplied by joint's inverse bind transform.
+enum class skinning_palette_format {
+  // 3x4 row-major float matrix, 48 bytes.
+  // Rows are (rotation and scale, translation), for column vectors.
+  matrix3x4,
+
+  // Same as `matrix3x4`, but with half precision floats, 24 bytes.
+  matrix3x4_half,
+
+  // Dual quaternion as real quaternion followed by dual quaternion (xyzw), 32 bytes.
+  // Scale is not representable and is ignored.
+  dual_quaternion,
+
+  // Same as `dual_quaternion`, but with half precision floats, 16 bytes.
+  dual_quaternion_half
+};
+
+// Return number of bytes a single joint takes in a skinning palette of specified format.
+gsl::index skinning_palette_get_joint_size(skinning_palette_format format);
+
 // Represents pose of a skeleton.
 // Pose is always linked to the specific skeleton, and should never outlive it.
 class skeleton_pose final {
@@ -59,6 +83,12 @@ public:
   // relative to the skeleton object.
   [[nodiscard]] const transform& get_transform_object_space(gsl::index index) const;
 
+  // Write skinning palette for all joints into `out_buffer`,
+  // which must be at least `get_joints_count() * skinning_palette_get_joint_size(format)` bytes.
+  // Object space transforms are recalculated in the same pass if needed.
+  void write_skinning_palette(skinning_palette_format format,
+                              std::span<std::byte> out_buffer) const;
+
   // Return number of joints in a pose.
   [[nodiscard]] gsl::index get_joints_count() const;
 
@@ -94,6 +124,32 @@ void skeleton_pose_blend(const skeleton_pose& p0,
 
 void skeleton_pose_add(const skeleton_pose& p0, const skeleton_pose& p1, skeleton_pose& out_result);
 
+// Interpolate between two poses using normalized lerp for rotations.
+// Cheaper than `skeleton_pose_blend` and also allows weights outside of [0.0, 1.0],
+// which extrapolates motion from `p0` to `p1`.
+void skeleton_pose_nlerp(const skeleton_pose& p0,
+                         const skeleton_pose& p1,
+                         float weight,
+                         skeleton_pose& out_result);
+
+// Blend between two poses using per-joint weights from a skeleton mask.
+// Each joint component is blended with its mask weight multiplied by `weight`,
+// thus joints that are masked out keep their values from `p0`.
+void skeleton_pose_blend_masked(const skeleton_pose& p0,
+                                const skeleton_pose& p1,
+                                const skeleton_mask& mask,
+                                float weight,
+                                skeleton_pose& out_result);
+
+// Add an additive pose `p1` to `p0` using per-joint weights from a skeleton mask.
+// Each additive joint component is scaled towards identity
+// by its mask weight multiplied by `weight` before being added.
+void skeleton_pose_add_masked(const skeleton_pose& p0,
+                              const skeleton_pose& p1,
+                              const skeleton_mask& mask,
+                              float weight,
+                              skeleton_pose& out_result);
+
 // Implementation
 
 inline const transform& skeleton_pose::get_transform_joint_space(gsl::index index) const
@@ -28,6 +28,14 @@ public:
     string_id right_arm;
     string_id right_forearm;
     string_id right_hand;
+
+    string_id left_up_leg;
+    string_id left_leg;
+    string_id left_foot;
+
+    string_id right_up_leg;
+    string_id right_leg;
+    string_id right_foot;
   };
 
   // Represents joint limits.
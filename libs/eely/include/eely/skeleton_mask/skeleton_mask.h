@@ -3,6 +3,7 @@
 #include "eely/base/assert.h"
 #include "eely/base/bit_reader.h"
 #include "eely/base/bit_writer.h"
+#include "eely/base/string_id.h"
 #include "eely/project/project.h"
 #include "eely/project/resource.h"
 #include "eely/skeleton_mask/skeleton_mask_uncooked.h"
@@ -24,15 +25,32 @@ public:
 
   void serialize(internal::bit_writer& writer) const override;
 
+  // Return id of a skeleton this mask was cooked for.
+  [[nodiscard]] const string_id& get_target_skeleton_id() const;
+
+  // Return number of joints this mask has weights for.
+  [[nodiscard]] gsl::index get_joints_count() const;
+
   // Return weight of a joint.
   [[nodiscard]] const joint_weight& get_weight(gsl::index joint_index) const;
 
 private:
+  string_id _skeleton_id;
   std::vector<joint_weight> _weights;
 };
 
 // Implementation
 
+inline const string_id& skeleton_mask::get_target_skeleton_id() const
+{
+  return _skeleton_id;
+}
+
+inline gsl::index skeleton_mask::get_joints_count() const
+{
+  return std::ssize(_weights);
+}
+
 inline const joint_weight& skeleton_mask::get_weight(const gsl::index joint_index) const
 {
   return _weights.at(joint_index);
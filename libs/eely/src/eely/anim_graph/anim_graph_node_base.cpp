@@ -3,6 +3,8 @@
 #include "eely/anim_graph/anim_graph_node_and.h"
 #include "eely/anim_graph/anim_graph_node_blend.h"
 #include "eely/anim_graph/anim_graph_node_clip.h"
+#include "eely/anim_graph/anim_graph_node_ik.h"
+#include "eely/anim_graph/anim_graph_node_layer.h"
 #include "eely/anim_graph/anim_graph_node_param.h"
 #include "eely/anim_graph/anim_graph_node_param_comparison.h"
 #include "eely/anim_graph/anim_graph_node_random.h"
@@ -83,6 +85,14 @@ anim_graph_node_uptr bit_reader_read(bit_reader& reader)
       return std::make_unique<anim_graph_node_clip>(reader);
     } break;
 
+    case anim_graph_node_type::ik: {
+      return std::make_unique<anim_graph_node_ik>(reader);
+    } break;
+
+    case anim_graph_node_type::layer: {
+      return std::make_unique<anim_graph_node_layer>(reader);
+    } break;
+
     case anim_graph_node_type::random: {
       return std::make_unique<anim_graph_node_random>(reader);
     } break;
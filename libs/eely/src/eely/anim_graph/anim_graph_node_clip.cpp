@@ -4,6 +4,7 @@
 #include "eely/base/bit_reader.h"
 #include "eely/base/bit_writer.h"
 #include "eely/base/string_id.h"
+#include "eely/clip/clip_player_base.h"
 
 #include <memory>
 #include <unordered_set>
@@ -20,6 +21,8 @@ anim_graph_node_clip::anim_graph_node_clip(internal::bit_reader& reader)
   using namespace eely::internal;
 
   _clip_id = bit_reader_read<string_id>(reader);
+  _sample_rounding = bit_reader_read<clip_sample_rounding>(reader, bits_clip_sample_rounding);
+  _looping_policy = bit_reader_read<clip_looping_policy>(reader, bits_clip_looping_policy);
 }
 
 void anim_graph_node_clip::serialize(internal::bit_writer& writer) const
@@ -29,6 +32,8 @@ void anim_graph_node_clip::serialize(internal::bit_writer& writer) const
   anim_graph_node_base::serialize(writer);
 
   bit_writer_write(writer, _clip_id);
+  bit_writer_write(writer, _sample_rounding, bits_clip_sample_rounding);
+  bit_writer_write(writer, _looping_policy, bits_clip_looping_policy);
 }
 
 void anim_graph_node_clip::collect_dependencies(std::unordered_set<string_id>& out_dependencies)
@@ -50,4 +55,24 @@ void anim_graph_node_clip::set_clip_id(string_id value)
 {
   _clip_id = std::move(value);
 }
+
+clip_sample_rounding anim_graph_node_clip::get_sample_rounding() const
+{
+  return _sample_rounding;
+}
+
+void anim_graph_node_clip::set_sample_rounding(const clip_sample_rounding value)
+{
+  _sample_rounding = value;
+}
+
+clip_looping_policy anim_graph_node_clip::get_looping_policy() const
+{
+  return _looping_policy;
+}
+
+void anim_graph_node_clip::set_looping_policy(const clip_looping_policy value)
+{
+  _looping_policy = value;
+}
 }  // namespace eely
\ No newline at end of file
@@ -0,0 +1,142 @@
+#include "eely/anim_graph/anim_graph_node_ik.h"
+
+#include "eely/anim_graph/anim_graph_node_base.h"
+#include "eely/base/bit_reader.h"
+#include "eely/base/bit_writer.h"
+#include "eely/base/string_id.h"
+#include "eely/ik/ik.h"
+
+#include <array>
+#include <memory>
+#include <optional>
+
+namespace eely {
+anim_graph_node_ik::anim_graph_node_ik(const int id)
+    : anim_graph_node_base{anim_graph_node_type::ik, id}
+{
+}
+
+anim_graph_node_ik::anim_graph_node_ik(internal::bit_reader& reader)
+    : anim_graph_node_base{anim_graph_node_type::ik, reader}
+{
+  using namespace eely::internal;
+
+  _pose_node = bit_reader_read<std::optional<int>>(reader, bits_anim_graph_node_id);
+  for (std::optional<int>& target_node : _target_nodes) {
+    target_node = bit_reader_read<std::optional<int>>(reader, bits_anim_graph_node_id);
+  }
+  _weight_node = bit_reader_read<std::optional<int>>(reader, bits_anim_graph_node_id);
+  _solver = bit_reader_read<solver>(reader, bits_ik_solver);
+  _limb = bit_reader_read<ik_limb>(reader, bits_ik_limb);
+  _chain_root_joint_id = bit_reader_read<string_id>(reader);
+  _chain_tip_joint_id = bit_reader_read<string_id>(reader);
+  _fabrik_settings.max_iterations = bit_reader_read<int>(reader, bits_ik_max_iterations);
+  _fabrik_settings.tolerance = bit_reader_read<float>(reader);
+  _fabrik_settings.constrained = bit_reader_read<bool>(reader);
+}
+
+void anim_graph_node_ik::serialize(internal::bit_writer& writer) const
+{
+  using namespace eely::internal;
+
+  anim_graph_node_base::serialize(writer);
+
+  bit_writer_write(writer, _pose_node, bits_anim_graph_node_id);
+  for (const std::optional<int>& target_node : _target_nodes) {
+    bit_writer_write(writer, target_node, bits_anim_graph_node_id);
+  }
+  bit_writer_write(writer, _weight_node, bits_anim_graph_node_id);
+  bit_writer_write(writer, _solver, bits_ik_solver);
+  bit_writer_write(writer, _limb, bits_ik_limb);
+  bit_writer_write(writer, _chain_root_joint_id);
+  bit_writer_write(writer, _chain_tip_joint_id);
+  bit_writer_write(writer, _fabrik_settings.max_iterations, bits_ik_max_iterations);
+  bit_writer_write(writer, _fabrik_settings.tolerance);
+  bit_writer_write(writer, _fabrik_settings.constrained);
+}
+
+anim_graph_node_uptr anim_graph_node_ik::clone() const
+{
+  return std::make_unique<anim_graph_node_ik>(*this);
+}
+
+std::optional<int> anim_graph_node_ik::get_pose_node_id() const
+{
+  return _pose_node;
+}
+
+void anim_graph_node_ik::set_pose_node_id(const std::optional<int> value)
+{
+  _pose_node = value;
+}
+
+const std::array<std::optional<int>, 3>& anim_graph_node_ik::get_target_node_ids() const
+{
+  return _target_nodes;
+}
+
+void anim_graph_node_ik::set_target_node_ids(const std::array<std::optional<int>, 3>& value)
+{
+  _target_nodes = value;
+}
+
+std::optional<int> anim_graph_node_ik::get_weight_node_id() const
+{
+  return _weight_node;
+}
+
+void anim_graph_node_ik::set_weight_node_id(const std::optional<int> value)
+{
+  _weight_node = value;
+}
+
+anim_graph_node_ik::solver anim_graph_node_ik::get_solver() const
+{
+  return _solver;
+}
+
+void anim_graph_node_ik::set_solver(const solver value)
+{
+  _solver = value;
+}
+
+ik_limb anim_graph_node_ik::get_limb() const
+{
+  return _limb;
+}
+
+void anim_graph_node_ik::set_limb(const ik_limb value)
+{
+  _limb = value;
+}
+
+const string_id& anim_graph_node_ik::get_chain_root_joint_id() const
+{
+  return _chain_root_joint_id;
+}
+
+void anim_graph_node_ik::set_chain_root_joint_id(string_id value)
+{
+  _chain_root_joint_id = std::move(value);
+}
+
+const string_id& anim_graph_node_ik::get_chain_tip_joint_id() const
+{
+  return _chain_tip_joint_id;
+}
+
+void anim_graph_node_ik::set_chain_tip_joint_id(string_id value)
+{
+  _chain_tip_joint_id = std::move(value);
+}
+
+const ik_fabrik_settings& anim_graph_node_ik::get_fabrik_settings() const
+{
+  return _fabrik_settings;
+}
+
+void anim_graph_node_ik::set_fabrik_settings(const ik_fabrik_settings& value)
+{
+  _fabrik_settings = value;
+}
+}  // namespace eely
\ No newline at end of file
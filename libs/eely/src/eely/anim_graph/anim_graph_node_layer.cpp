@@ -0,0 +1,102 @@
+#include "eely/anim_graph/anim_graph_node_layer.h"
+
+#include "eely/anim_graph/anim_graph_node_base.h"
+#include "eely/base/bit_reader.h"
+#include "eely/base/bit_writer.h"
+#include "eely/base/string_id.h"
+
+#include <memory>
+#include <optional>
+#include <unordered_set>
+
+namespace eely {
+anim_graph_node_layer::anim_graph_node_layer(const int id)
+    : anim_graph_node_base{anim_graph_node_type::layer, id}
+{
+}
+
+anim_graph_node_layer::anim_graph_node_layer(internal::bit_reader& reader)
+    : anim_graph_node_base{anim_graph_node_type::layer, reader}
+{
+  using namespace eely::internal;
+
+  _base_node = bit_reader_read<std::optional<int>>(reader, bits_anim_graph_node_id);
+  _layer_node = bit_reader_read<std::optional<int>>(reader, bits_anim_graph_node_id);
+  _weight_node = bit_reader_read<std::optional<int>>(reader, bits_anim_graph_node_id);
+  _skeleton_mask_id = bit_reader_read<string_id>(reader);
+  _mode = bit_reader_read<mode>(reader, bits_layer_mode);
+}
+
+void anim_graph_node_layer::serialize(internal::bit_writer& writer) const
+{
+  using namespace eely::internal;
+
+  anim_graph_node_base::serialize(writer);
+
+  bit_writer_write(writer, _base_node, bits_anim_graph_node_id);
+  bit_writer_write(writer, _layer_node, bits_anim_graph_node_id);
+  bit_writer_write(writer, _weight_node, bits_anim_graph_node_id);
+  bit_writer_write(writer, _skeleton_mask_id);
+  bit_writer_write(writer, _mode, bits_layer_mode);
+}
+
+void anim_graph_node_layer::collect_dependencies(std::unordered_set<string_id>& out_dependencies)
+{
+  out_dependencies.insert(_skeleton_mask_id);
+}
+
+anim_graph_node_uptr anim_graph_node_layer::clone() const
+{
+  return std::make_unique<anim_graph_node_layer>(*this);
+}
+
+std::optional<int> anim_graph_node_layer::get_base_node_id() const
+{
+  return _base_node;
+}
+
+void anim_graph_node_layer::set_base_node_id(const std::optional<int> value)
+{
+  _base_node = value;
+}
+
+std::optional<int> anim_graph_node_layer::get_layer_node_id() const
+{
+  return _layer_node;
+}
+
+void anim_graph_node_layer::set_layer_node_id(const std::optional<int> value)
+{
+  _layer_node = value;
+}
+
+std::optional<int> anim_graph_node_layer::get_weight_node_id() const
+{
+  return _weight_node;
+}
+
+void anim_graph_node_layer::set_weight_node_id(const std::optional<int> value)
+{
+  _weight_node = value;
+}
+
+const string_id& anim_graph_node_layer::get_skeleton_mask_id() const
+{
+  return _skeleton_mask_id;
+}
+
+void anim_graph_node_layer::set_skeleton_mask_id(string_id value)
+{
+  _skeleton_mask_id = std::move(value);
+}
+
+anim_graph_node_layer::mode anim_graph_node_layer::get_mode() const
+{
+  return _mode;
+}
+
+void anim_graph_node_layer::set_mode(const mode value)
+{
+  _mode = value;
+}
+}  // namespace eely
\ No newline at end of file
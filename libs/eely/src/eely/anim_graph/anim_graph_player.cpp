@@ -5,6 +5,8 @@
 #include "eely/anim_graph/anim_graph_node_base.h"
 #include "eely/anim_graph/anim_graph_node_blend.h"
 #include "eely/anim_graph/anim_graph_node_clip.h"
+#include "eely/anim_graph/anim_graph_node_ik.h"
+#include "eely/anim_graph/anim_graph_node_layer.h"
 #include "eely/anim_graph/anim_graph_node_param.h"
 #include "eely/anim_graph/anim_graph_node_param_comparison.h"
 #include "eely/anim_graph/anim_graph_node_random.h"
@@ -18,6 +20,8 @@
 #include "eely/anim_graph/anim_graph_player_node_base.h"
 #include "eely/anim_graph/anim_graph_player_node_blend.h"
 #include "eely/anim_graph/anim_graph_player_node_clip.h"
+#include "eely/anim_graph/anim_graph_player_node_ik.h"
+#include "eely/anim_graph/anim_graph_player_node_layer.h"
 #include "eely/anim_graph/anim_graph_player_node_param.h"
 #include "eely/anim_graph/anim_graph_player_node_param_comparison.h"
 #include "eely/anim_graph/anim_graph_player_node_pose_base.h"
@@ -30,33 +34,155 @@
 #include "eely/anim_graph/anim_graph_player_node_sum.h"
 #include "eely/base/base_utils.h"
 #include "eely/base/graph.h"
+#include "eely/base/profiling.h"
 #include "eely/clip/clip.h"
+#include "eely/ik/ik.h"
 #include "eely/job/job_queue.h"
 #include "eely/params/params.h"
 #include "eely/project/project.h"
+#include "eely/skeleton/skeleton.h"
 #include "eely/skeleton/skeleton_pose.h"
+#include "eely/skeleton_mask/skeleton_mask.h"
 
+#include <algorithm>
+#include <array>
+#include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <memory_resource>
+#include <new>
+#include <optional>
+#include <random>
+#include <stdexcept>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace eely {
-anim_graph_player::anim_graph_player(const anim_graph& anim_graph)
+// Return size a node of specified type takes in player's nodes storage.
+// Sizes are rounded up to keep every node properly aligned.
+template <typename T>
+static constexpr size_t get_player_node_storage_size()
+{
+  constexpr size_t alignment{alignof(std::max_align_t)};
+  static_assert(alignof(T) <= alignment);
+
+  return (sizeof(T) + alignment - 1) / alignment * alignment;
+}
+
+// Return size a node of specified type takes in player's nodes storage.
+static size_t get_player_node_storage_size(const anim_graph_node_type type)
+{
+  using namespace eely::internal;
+
+  switch (type) {
+    case anim_graph_node_type::and_logic: {
+      return get_player_node_storage_size<anim_graph_player_node_and>();
+    } break;
+
+    case anim_graph_node_type::blend: {
+      return get_player_node_storage_size<anim_graph_player_node_blend>();
+    } break;
+
+    case anim_graph_node_type::clip: {
+      return get_player_node_storage_size<anim_graph_player_node_clip>();
+    } break;
+
+    case anim_graph_node_type::ik: {
+      return get_player_node_storage_size<anim_graph_player_node_ik>();
+    } break;
+
+    case anim_graph_node_type::layer: {
+      return get_player_node_storage_size<anim_graph_player_node_layer>();
+    } break;
+
+    case anim_graph_node_type::param_comparison: {
+      return get_player_node_storage_size<anim_graph_player_node_param_comparison>();
+    } break;
+
+    case anim_graph_node_type::param: {
+      return get_player_node_storage_size<anim_graph_player_node_param>();
+    } break;
+
+    case anim_graph_node_type::random: {
+      return get_player_node_storage_size<anim_graph_player_node_random>();
+    } break;
+
+    case anim_graph_node_type::speed: {
+      return get_player_node_storage_size<anim_graph_player_node_speed>();
+    } break;
+
+    case anim_graph_node_type::state_condition: {
+      return get_player_node_storage_size<anim_graph_player_node_state_condition>();
+    } break;
+
+    case anim_graph_node_type::state_machine: {
+      return get_player_node_storage_size<anim_graph_player_node_state_machine>();
+    } break;
+
+    case anim_graph_node_type::state_transition: {
+      return get_player_node_storage_size<anim_graph_player_node_state_transition>();
+    } break;
+
+    case anim_graph_node_type::state: {
+      return get_player_node_storage_size<anim_graph_player_node_state>();
+    } break;
+
+    case anim_graph_node_type::sum: {
+      return get_player_node_storage_size<anim_graph_player_node_sum>();
+    } break;
+
+    default: {
+      EXPECTS(false);
+      return 0;
+    } break;
+  }
+}
+
+// Construct a node in player's nodes storage and move storage pointer past it.
+template <typename T, typename... TArgs>
+static internal::anim_graph_player_node_uptr construct_player_node(std::byte*& storage,
+                                                                   TArgs&&... args)
+{
+  T* node{new (storage) T(std::forward<TArgs>(args)...)};
+  storage += get_player_node_storage_size<T>();
+
+  return internal::anim_graph_player_node_uptr{node};
+}
+
+anim_graph_player::anim_graph_player(const anim_graph& anim_graph,
+                                     std::pmr::memory_resource* memory_resource)
     : _project{anim_graph.get_project()},
-      _job_queue{*_project.get_resource<skeleton>(anim_graph.get_skeleton_id())}
+      _skeleton{*_project.get_resource<skeleton>(anim_graph.get_skeleton_id())},
+      _memory_resource{memory_resource},
+      _nodes{memory_resource},
+      _job_queue{_skeleton, memory_resource}
 {
   using namespace eely::internal;
 
   // Runtime nodes are created in three steps:
   //  - constructing the nodes
   //  - filling their data (done after creation due to possible circular dependencies)
-  //  - initializing state's breakpoints (they require fully inited states and transitions)
+  //  - initializing state's breakpoints and transition's condition dependencies
+  //    (they require fully inited states, transitions and conditions)
 
   const std::vector<anim_graph_node_uptr>& nodes{anim_graph.get_nodes()};
 
   std::unordered_map<int, anim_graph_player_node_base*> id_to_player_node;
 
+  // Allocate storage for all the nodes at once,
+  // this keeps per-instance data compact and close in memory
+
+  for (const anim_graph_node_uptr& node : nodes) {
+    _nodes_storage_size += get_player_node_storage_size(node->get_type());
+  }
+
+  _nodes_storage = static_cast<std::byte*>(
+      _memory_resource->allocate(_nodes_storage_size, alignof(std::max_align_t)));
+  std::byte* nodes_storage_current{_nodes_storage};
+
+  _nodes.reserve(nodes.size());
+
   // Create nodes
 
   const int root_node_id{anim_graph.get_root_node_id()};
@@ -66,7 +192,7 @@ anim_graph_player::anim_graph_player(const anim_graph& anim_graph)
 
     EXPECTS(!id_to_player_node.contains(node_id));
 
-    anim_graph_player_node_uptr player_node{create_player_node(node)};
+    anim_graph_player_node_uptr player_node{create_player_node(node, nodes_storage_current)};
     EXPECTS(player_node);
 
     id_to_player_node[node_id] = player_node.get();
@@ -79,6 +205,7 @@ anim_graph_player::anim_graph_player(const anim_graph& anim_graph)
 
   EXPECTS(!_nodes.empty());
   EXPECTS(_root_node != nullptr);
+  EXPECTS(nodes_storage_current == _nodes_storage + _nodes_storage_size);
 
   // Fill node's data
 
@@ -91,9 +218,23 @@ anim_graph_player::anim_graph_player(const anim_graph& anim_graph)
     init_player_node(node, player_node, id_to_player_node);
   }
 
-  // Initialize breakpoints
+  // Initialize breakpoints and condition dependencies
 
   for (const anim_graph_node_uptr& node : nodes) {
+    if (node->get_type() == anim_graph_node_type::state_transition) {
+      const int node_id{node->get_id()};
+
+      EXPECTS(id_to_player_node.contains(node_id));
+
+      auto* player_node_state_transition{
+          polymorphic_downcast<anim_graph_player_node_state_transition*>(
+              id_to_player_node[node_id])};
+
+      player_node_state_transition->update_condition_dependencies();
+
+      continue;
+    }
+
     if (node->get_type() != anim_graph_node_type::state) {
       continue;
     }
@@ -107,23 +248,142 @@ anim_graph_player::anim_graph_player(const anim_graph& anim_graph)
 
     player_node_state->update_breakpoints();
   }
+
+  set_random_seed(std::random_device{}());
+}
+
+anim_graph_player::~anim_graph_player()
+{
+  // Nodes are destroyed in place, storage is released only after that
+  _nodes.clear();
+  _memory_resource->deallocate(_nodes_storage, _nodes_storage_size, alignof(std::max_align_t));
 }
 
 void anim_graph_player::play(float dt_s, const params& params, skeleton_pose& out_pose)
 {
   using namespace eely::internal;
 
+  EELY_PROFILE_SCOPE(profiling_scope_type::anim_graph_player, "anim_graph_player::play");
+
+  const bool compute{is_next_play_computed()};
+
+  _calls_counter = (_calls_counter + 1) % _update_period;
+  _accumulated_dt_s += dt_s;
+
+  if (!compute) {
+    // Extrapolate from two last computed poses,
+    // but not further than one more computation interval to avoid overshooting
+    if (_pose_computed_previous.has_value() && _computed_interval_s > 0.0F) {
+      const float weight{1.0F + std::min(_accumulated_dt_s / _computed_interval_s, 1.0F)};
+      skeleton_pose_nlerp(*_pose_computed_previous, *_pose_computed_last, weight, out_pose);
+    }
+    else {
+      out_pose = *_pose_computed_last;
+    }
+
+    return;
+  }
+
   ++_play_counter;
 
-  anim_graph_player_context context{
-      .job_queue = _job_queue, .params = params, .play_counter = _play_counter, .dt_s = dt_s};
+#if defined(EELY_PROFILING)
+  const int64_t profiling_events_count_begin{
+      _profiling_enabled ? profiling_get_thread_events_count() : 0};
+  const int64_t profiling_begin_ns{_profiling_enabled ? profiling_get_time_ns() : 0};
+#endif
+
+  anim_graph_player_context context{.job_queue = _job_queue,
+                                    .params = params,
+                                    .play_counter = _play_counter,
+                                    .dt_s = _accumulated_dt_s,
+                                    .pose_cache = _pose_cache};
 
   _root_node->compute(context);
 
   _job_queue.execute(out_pose);
+
+#if defined(EELY_PROFILING)
+  if (_profiling_enabled) {
+    profiling_gather(profiling_events_count_begin, profiling_begin_ns);
+  }
+#endif
+
+  if (_update_period > 1) {
+    std::swap(_pose_computed_previous, _pose_computed_last);
+    if (_pose_computed_last.has_value()) {
+      *_pose_computed_last = out_pose;
+    }
+    else {
+      _pose_computed_last.emplace(out_pose);
+    }
+  }
+
+  _computed_interval_s = _accumulated_dt_s;
+  _accumulated_dt_s = 0.0F;
 }
 
-const std::vector<internal::anim_graph_player_node_uptr>& anim_graph_player::get_nodes() const
+void anim_graph_player::set_update_period(const int period, const std::optional<int> offset)
+{
+  if (period < 1) {
+    throw std::runtime_error("Update period must be positive");
+  }
+
+  if (offset.has_value() && offset.value() < 0) {
+    throw std::runtime_error("Update offset must not be negative");
+  }
+
+  _update_period = period;
+  _update_offset = offset.has_value() ? std::optional<int>{offset.value() % period} : std::nullopt;
+  _calls_counter %= period;
+
+  if (_update_period == 1) {
+    _pose_computed_previous.reset();
+    _pose_computed_last.reset();
+  }
+}
+
+int anim_graph_player::get_update_period() const
+{
+  return _update_period;
+}
+
+bool anim_graph_player::is_next_play_computed() const
+{
+  // Without an explicit offset players are staggered by their seeds,
+  // which are different for different players and don't depend on construction order
+  const int offset{_update_offset.value_or(
+      static_cast<int>(_random_seed % static_cast<uint32_t>(_update_period)))};
+
+  return !_pose_computed_last.has_value() || (_calls_counter + offset) % _update_period == 0;
+}
+
+void anim_graph_player::set_random_seed(const uint32_t seed)
+{
+  using namespace eely::internal;
+
+  _random_seed = seed;
+
+  // Every node gets its own sequence, so that adding a node doesn't change choices of others
+  for (const anim_graph_player_node_uptr& node : _nodes) {
+    if (node->get_type() == anim_graph_node_type::random) {
+      auto* node_random{polymorphic_downcast<anim_graph_player_node_random*>(node.get())};
+      node_random->set_random_seed(seed + static_cast<uint32_t>(node->get_id()));
+    }
+  }
+}
+
+uint32_t anim_graph_player::get_random_seed() const
+{
+  return _random_seed;
+}
+
+void anim_graph_player::set_pose_cache(clip_pose_cache* pose_cache)
+{
+  _pose_cache = pose_cache;
+}
+
+const std::pmr::vector<internal::anim_graph_player_node_uptr>& anim_graph_player::get_nodes()
+    const
 {
   return _nodes;
 }
@@ -147,8 +407,108 @@ bool anim_graph_player::is_player_node_active(
   return node.get_last_play_counter() == _play_counter;
 }
 
+void anim_graph_player::set_profiling_enabled([[maybe_unused]] const bool enabled)
+{
+#if defined(EELY_PROFILING)
+  if (_profiling_enabled == enabled) {
+    return;
+  }
+
+  // Start from scratch, so that results don't mix with computations from before
+  _profiling_enabled = enabled;
+  _profiled_computation_us = 0.0F;
+  _profiled_node_costs.clear();
+  _profiling_window_stats.clear();
+  _profiling_window_ns = 0;
+  _profiling_window_computations = 0;
+#endif
+}
+
+bool anim_graph_player::is_profiling_enabled() const
+{
+#if defined(EELY_PROFILING)
+  return _profiling_enabled;
+#else
+  return false;
+#endif
+}
+
+float anim_graph_player::get_profiled_computation_us() const
+{
+#if defined(EELY_PROFILING)
+  return _profiled_computation_us;
+#else
+  return 0.0F;
+#endif
+}
+
+const anim_graph_player_node_cost* anim_graph_player::get_profiled_node_cost(
+    [[maybe_unused]] const int id) const
+{
+#if defined(EELY_PROFILING)
+  auto iter{_profiled_node_costs.find(id)};
+  return iter != _profiled_node_costs.end() ? &iter->second : nullptr;
+#else
+  return nullptr;
+#endif
+}
+
+#if defined(EELY_PROFILING)
+void anim_graph_player::profiling_gather(const int64_t events_count_begin,
+                                         const int64_t begin_ns)
+{
+  _profiling_window_ns += internal::profiling_get_time_ns() - begin_ns;
+  ++_profiling_window_computations;
+
+  // Everything recorded on this thread since computation started belongs to this player
+
+  _profiling_events.clear();
+  internal::profiling_get_thread_events(events_count_begin, _profiling_events);
+
+  for (const auto& [id, stats] : profiling_aggregate_nodes(_profiling_events)) {
+    profiling_node_stats& window_stats{_profiling_window_stats[id]};
+    window_stats.calls_count += stats.calls_count;
+    window_stats.total_ns += stats.total_ns;
+    window_stats.self_ns += stats.self_ns;
+    window_stats.max_ns = std::max(window_stats.max_ns, stats.max_ns);
+    window_stats.jobs_count += stats.jobs_count;
+    window_stats.jobs_ns += stats.jobs_ns;
+    window_stats.subtree_jobs_ns += stats.subtree_jobs_ns;
+  }
+
+  if (_profiling_window_computations == profiling_window_size) {
+    profiling_finish_window();
+  }
+}
+
+void anim_graph_player::profiling_finish_window()
+{
+  const auto ns_to_average_us = [this](const int64_t ns) {
+    return static_cast<float>(ns) / 1000.0F / static_cast<float>(_profiling_window_computations);
+  };
+
+  _profiled_computation_us = ns_to_average_us(_profiling_window_ns);
+
+  _profiled_node_costs.clear();
+  for (const auto& [id, stats] : _profiling_window_stats) {
+    _profiled_node_costs[id] = {
+        .self_us = ns_to_average_us(stats.self_ns),
+        .total_us = ns_to_average_us(stats.total_ns),
+        .jobs_count = static_cast<float>(stats.jobs_count) /
+                      static_cast<float>(_profiling_window_computations),
+        .jobs_us = ns_to_average_us(stats.jobs_ns),
+        .subtree_us = ns_to_average_us(stats.total_ns + stats.subtree_jobs_ns)};
+  }
+
+  _profiling_window_stats.clear();
+  _profiling_window_ns = 0;
+  _profiling_window_computations = 0;
+}
+#endif
+
 internal::anim_graph_player_node_uptr anim_graph_player::create_player_node(
-    const anim_graph_node_uptr& node)
+    const anim_graph_node_uptr& node,
+    std::byte*& storage)
 {
   using namespace eely::internal;
 
@@ -156,66 +516,102 @@ internal::anim_graph_player_node_uptr anim_graph_player::create_player_node(
 
   switch (node->get_type()) {
     case anim_graph_node_type::and_logic: {
-      return std::make_unique<anim_graph_player_node_and>(id);
+      return construct_player_node<anim_graph_player_node_and>(storage, id);
     } break;
 
     case anim_graph_node_type::blend: {
-      return std::make_unique<anim_graph_player_node_blend>(id);
+      return construct_player_node<anim_graph_player_node_blend>(storage, id);
     } break;
 
     case anim_graph_node_type::clip: {
       const auto* node_clip{polymorphic_downcast<const anim_graph_node_clip*>(node.get())};
       const auto& clip{*_project.get_resource<eely::clip>(node_clip->get_clip_id())};
-      return std::make_unique<anim_graph_player_node_clip>(id, clip);
+      return construct_player_node<anim_graph_player_node_clip>(
+          storage, id, clip, node_clip->get_sample_rounding(), node_clip->get_looping_policy());
+    } break;
+
+    case anim_graph_node_type::ik: {
+      const auto* node_ik{polymorphic_downcast<const anim_graph_node_ik*>(node.get())};
+
+      // Joints are resolved once here, so that solving does not look them up on every play
+
+      std::vector<gsl::index> chain;
+      const std::optional<gsl::index> chain_root_index{
+          _skeleton.get_joint_index(node_ik->get_chain_root_joint_id())};
+      const std::optional<gsl::index> chain_tip_index{
+          _skeleton.get_joint_index(node_ik->get_chain_tip_joint_id())};
+      if (chain_root_index.has_value() && chain_tip_index.has_value()) {
+        ik_chain_collect(_skeleton, chain_root_index.value(), chain_tip_index.value(), chain);
+      }
+
+      return construct_player_node<anim_graph_player_node_ik>(
+          storage, id, node_ik->get_solver(),
+          ik_two_bone_joints_from_limb(_skeleton, node_ik->get_limb()), std::move(chain),
+          node_ik->get_fabrik_settings());
+    } break;
+
+    case anim_graph_node_type::layer: {
+      const auto* node_layer{polymorphic_downcast<const anim_graph_node_layer*>(node.get())};
+      const auto& mask{
+          *_project.get_resource<skeleton_mask>(node_layer->get_skeleton_mask_id())};
+
+      // Mask cooked for another skeleton would apply weights to wrong joints
+      EXPECTS(mask.get_target_skeleton_id() == _skeleton.get_id());
+      EXPECTS(mask.get_joints_count() == _skeleton.get_joints_count());
+
+      return construct_player_node<anim_graph_player_node_layer>(storage, id,
+                                                                 node_layer->get_mode(), mask);
     } break;
 
     case anim_graph_node_type::param_comparison: {
       const auto* node_param_comparison{
           polymorphic_downcast<const anim_graph_node_param_comparison*>(node.get())};
-      return std::make_unique<anim_graph_player_node_param_comparison>(
-          id, node_param_comparison->get_param_id(), node_param_comparison->get_value(),
+      return construct_player_node<anim_graph_player_node_param_comparison>(
+          storage, id, node_param_comparison->get_param_id(), node_param_comparison->get_value(),
           node_param_comparison->get_op());
     } break;
 
     case anim_graph_node_type::param: {
       const auto* node_param{polymorphic_downcast<const anim_graph_node_param*>(node.get())};
-      return std::make_unique<anim_graph_player_node_param>(id, node_param->get_param_id());
+      return construct_player_node<anim_graph_player_node_param>(storage, id,
+                                                                 node_param->get_param_id());
     } break;
 
     case anim_graph_node_type::random: {
-      return std::make_unique<anim_graph_player_node_random>(id);
+      return construct_player_node<anim_graph_player_node_random>(storage, id);
     } break;
 
     case anim_graph_node_type::speed: {
-      return std::make_unique<anim_graph_player_node_speed>(id);
+      return construct_player_node<anim_graph_player_node_speed>(storage, id);
     } break;
 
     case anim_graph_node_type::state_condition: {
       const auto* node_state_condition{
           polymorphic_downcast<const anim_graph_node_state_condition*>(node.get())};
-      return std::make_unique<anim_graph_player_node_state_condition>(
-          id, node_state_condition->get_phase());
+      return construct_player_node<anim_graph_player_node_state_condition>(
+          storage, id, node_state_condition->get_phase());
     } break;
 
     case anim_graph_node_type::state_machine: {
-      return std::make_unique<anim_graph_player_node_state_machine>(id);
+      return construct_player_node<anim_graph_player_node_state_machine>(storage, id);
     } break;
 
     case anim_graph_node_type::state_transition: {
       const auto* node_state_transition{
           polymorphic_downcast<const anim_graph_node_state_transition*>(node.get())};
-      return std::make_unique<anim_graph_player_node_state_transition>(
-          id, node_state_transition->get_transition_type(), node_state_transition->get_duration_s(),
-          node_state_transition->get_reversible());
+      return construct_player_node<anim_graph_player_node_state_transition>(
+          storage, id, node_state_transition->get_transition_type(),
+          node_state_transition->get_duration_s(), node_state_transition->get_reversible());
     } break;
 
     case anim_graph_node_type::state: {
       const auto* node_state{polymorphic_downcast<const anim_graph_node_state*>(node.get())};
-      return std::make_unique<anim_graph_player_node_state>(id, node_state->get_name());
+      return construct_player_node<anim_graph_player_node_state>(storage, id,
+                                                                 node_state->get_name());
     } break;
 
     case anim_graph_node_type::sum: {
-      return std::make_unique<anim_graph_player_node_sum>(id);
+      return construct_player_node<anim_graph_player_node_sum>(storage, id);
     } break;
 
     default: {
@@ -285,6 +681,70 @@ void anim_graph_player::init_player_node(
       player_node_blend->set_factor_node(player_factor_node);
     } break;
 
+    case anim_graph_node_type::ik: {
+      const auto* node_ik{polymorphic_downcast<const anim_graph_node_ik*>(node.get())};
+      auto* player_node_ik{polymorphic_downcast<anim_graph_player_node_ik*>(player_node)};
+
+      EXPECTS(node_ik->get_pose_node_id().has_value());
+      const int pose_node_id{node_ik->get_pose_node_id().value()};
+
+      EXPECTS(id_to_player_node.contains(pose_node_id));
+      auto* player_node_pose{polymorphic_downcast<anim_graph_player_node_pose_base*>(
+          id_to_player_node.at(pose_node_id))};
+
+      std::array<anim_graph_player_node_base*, 3> player_target_nodes{};
+      for (gsl::index i{0}; i < std::ssize(player_target_nodes); ++i) {
+        const std::optional<int>& target_node_id{node_ik->get_target_node_ids()[i]};
+
+        EXPECTS(target_node_id.has_value());
+        EXPECTS(id_to_player_node.contains(target_node_id.value()));
+        player_target_nodes[i] = id_to_player_node.at(target_node_id.value());
+      }
+
+      // Weight is optional, without it solved pose is used as is
+
+      anim_graph_player_node_base* player_node_weight{nullptr};
+      if (node_ik->get_weight_node_id().has_value()) {
+        const int weight_node_id{node_ik->get_weight_node_id().value()};
+
+        EXPECTS(id_to_player_node.contains(weight_node_id));
+        player_node_weight = id_to_player_node.at(weight_node_id);
+      }
+
+      player_node_ik->set_pose_node(player_node_pose);
+      player_node_ik->set_target_nodes(player_target_nodes);
+      player_node_ik->set_weight_node(player_node_weight);
+    } break;
+
+    case anim_graph_node_type::layer: {
+      const auto* node_layer{polymorphic_downcast<const anim_graph_node_layer*>(node.get())};
+      auto* player_node_layer{polymorphic_downcast<anim_graph_player_node_layer*>(player_node)};
+
+      EXPECTS(node_layer->get_base_node_id().has_value());
+      const int base_node_id{node_layer->get_base_node_id().value()};
+
+      EXPECTS(id_to_player_node.contains(base_node_id));
+      auto* player_node_base{polymorphic_downcast<anim_graph_player_node_pose_base*>(
+          id_to_player_node.at(base_node_id))};
+
+      EXPECTS(node_layer->get_layer_node_id().has_value());
+      const int layer_node_id{node_layer->get_layer_node_id().value()};
+
+      EXPECTS(id_to_player_node.contains(layer_node_id));
+      auto* player_node_layer_pose{polymorphic_downcast<anim_graph_player_node_pose_base*>(
+          id_to_player_node.at(layer_node_id))};
+
+      EXPECTS(node_layer->get_weight_node_id().has_value());
+      const int weight_node_id{node_layer->get_weight_node_id().value()};
+
+      EXPECTS(id_to_player_node.contains(weight_node_id));
+      anim_graph_player_node_base* player_node_weight{id_to_player_node.at(weight_node_id)};
+
+      player_node_layer->set_base_node(player_node_base);
+      player_node_layer->set_layer_node(player_node_layer_pose);
+      player_node_layer->set_weight_node(player_node_weight);
+    } break;
+
     case anim_graph_node_type::random: {
       const auto* node_random{polymorphic_downcast<const anim_graph_node_random*>(node.get())};
       auto* player_node_random{polymorphic_downcast<anim_graph_player_node_random*>(player_node)};
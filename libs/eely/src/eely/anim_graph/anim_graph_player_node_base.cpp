@@ -2,10 +2,26 @@
 
 #include "eely/anim_graph/anim_graph_node_base.h"
 #include "eely/anim_graph/anim_graph_player_context.h"
+#include "eely/base/profiling.h"
 
+#include <array>
+#include <cstddef>
 #include <optional>
 
 namespace eely::internal {
+#if defined(EELY_PROFILING)
+// Return name of a node type to show in profiling results.
+static const char* get_profiling_name(const anim_graph_node_type type)
+{
+  // Same order as in `anim_graph_node_type`
+  static constexpr std::array<const char*, 14> names{
+      "and", "blend", "clip", "ik", "layer", "param_comparison", "param",
+      "random", "speed", "state_condition", "state_machine", "state_transition", "state", "sum"};
+
+  return names.at(static_cast<size_t>(type));
+}
+#endif
+
 anim_graph_player_node_base::anim_graph_player_node_base(const anim_graph_node_type type,
                                                          const int id)
     : _type{type}, _id{id}
@@ -14,9 +30,20 @@ anim_graph_player_node_base::anim_graph_player_node_base(const anim_graph_node_t
 
 std::any anim_graph_player_node_base::compute(const anim_graph_player_context& context)
 {
+  EELY_PROFILE_SCOPE(profiling_scope_type::node, get_profiling_name(_type), _id);
+
+#if defined(EELY_PROFILING)
+  // Jobs added while this node is computed belong to it, unless a child node adds them
+  const int profiling_parent_node_id{context.job_queue.exchange_profiling_node_id(_id)};
+#endif
+
   std::any result;
   compute_impl(context, result);
 
+#if defined(EELY_PROFILING)
+  context.job_queue.exchange_profiling_node_id(profiling_parent_node_id);
+#endif
+
   return result;
 }
 
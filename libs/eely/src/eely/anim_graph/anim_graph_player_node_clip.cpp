@@ -10,10 +10,19 @@
 #include <memory>
 
 namespace eely::internal {
-anim_graph_player_node_clip::anim_graph_player_node_clip(const int id, const clip& clip)
+anim_graph_player_node_clip::anim_graph_player_node_clip(
+    const int id,
+    const clip& clip,
+    const clip_sample_rounding sample_rounding,
+    const clip_looping_policy looping_policy)
     : anim_graph_player_node_pose_base{anim_graph_node_type::clip, id},
+      _clip{clip},
       _player{clip.create_player()}
 {
+  // Looping policy can change player's duration
+  _player->set_sample_rounding(sample_rounding);
+  _player->set_looping_policy(looping_policy);
+
   _job_clip.set_player(*_player);
   set_duration_s(_player->get_duration_s());
 }
@@ -25,6 +34,7 @@ void anim_graph_player_node_clip::compute_impl(const anim_graph_player_context&
 
   apply_next_phase(context);
 
+  _job_clip.set_cache(context.pose_cache, _clip);
   _job_clip.set_time(get_phase() * get_duration_s());
   out_result = context.job_queue.add_job(_job_clip);
 }
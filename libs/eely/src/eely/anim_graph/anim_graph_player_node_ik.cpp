@@ -0,0 +1,140 @@
+#include "eely/anim_graph/anim_graph_player_node_ik.h"
+
+#include "eely/anim_graph/anim_graph_node_ik.h"
+#include "eely/anim_graph/anim_graph_player_context.h"
+#include "eely/anim_graph/anim_graph_player_node_base.h"
+#include "eely/anim_graph/anim_graph_player_node_pose_base.h"
+#include "eely/base/assert.h"
+#include "eely/ik/ik.h"
+#include "eely/job/job_ik_fabrik.h"
+#include "eely/job/job_ik_two_bone.h"
+#include "eely/math/float3.h"
+
+#include <gsl/util>
+
+#include <algorithm>
+#include <any>
+#include <array>
+#include <optional>
+#include <vector>
+
+namespace eely::internal {
+anim_graph_player_node_ik::anim_graph_player_node_ik(
+    const int id,
+    const anim_graph_node_ik::solver solver,
+    const std::optional<ik_two_bone_joints>& two_bone_joints,
+    std::vector<gsl::index> chain,
+    const ik_fabrik_settings& fabrik_settings)
+    : anim_graph_player_node_pose_base{anim_graph_node_type::ik, id},
+      _solver{solver},
+      _two_bone_joints{two_bone_joints},
+      _chain{std::move(chain)}
+{
+  if (_two_bone_joints.has_value()) {
+    _job_ik_two_bone.set_joints(_two_bone_joints.value());
+  }
+
+  _job_ik_fabrik.set_chain(_chain);
+  _job_ik_fabrik.set_settings(fabrik_settings);
+}
+
+void anim_graph_player_node_ik::update_duration(const anim_graph_player_context& context)
+{
+  EXPECTS(_pose_node != nullptr);
+
+  anim_graph_player_node_pose_base::update_duration(context);
+
+  _pose_node->update_duration(context);
+  set_duration_s(_pose_node->get_duration_s());
+}
+
+void anim_graph_player_node_ik::collect_descendants(
+    std::vector<const anim_graph_player_node_base*>& out_descendants) const
+{
+  if (_pose_node != nullptr) {
+    out_descendants.push_back(_pose_node);
+    _pose_node->collect_descendants(out_descendants);
+  }
+
+  for (const anim_graph_player_node_base* target_node : _target_nodes) {
+    if (target_node != nullptr) {
+      out_descendants.push_back(target_node);
+      target_node->collect_descendants(out_descendants);
+    }
+  }
+
+  if (_weight_node != nullptr) {
+    out_descendants.push_back(_weight_node);
+    _weight_node->collect_descendants(out_descendants);
+  }
+}
+
+void anim_graph_player_node_ik::set_pose_node(anim_graph_player_node_pose_base* const node)
+{
+  _pose_node = node;
+}
+
+void anim_graph_player_node_ik::set_target_nodes(
+    const std::array<anim_graph_player_node_base*, 3>& nodes)
+{
+  _target_nodes = nodes;
+}
+
+void anim_graph_player_node_ik::set_weight_node(anim_graph_player_node_base* const node)
+{
+  _weight_node = node;
+}
+
+const ik_fabrik_result& anim_graph_player_node_ik::get_last_fabrik_result() const
+{
+  return _job_ik_fabrik.get_result();
+}
+
+void anim_graph_player_node_ik::compute_impl(const anim_graph_player_context& context,
+                                             std::any& out_result)
+{
+  EXPECTS(_pose_node != nullptr);
+  EXPECTS(std::ranges::none_of(_target_nodes, [](auto* node) { return node == nullptr; }));
+
+  anim_graph_player_node_pose_base::compute_impl(context, out_result);
+
+  apply_next_phase(context);
+
+  const auto pose_job_index{std::any_cast<gsl::index>(_pose_node->compute(context))};
+
+  const float weight{_weight_node != nullptr
+                         ? std::clamp(std::any_cast<float>(_weight_node->compute(context)), 0.0F,
+                                      1.0F)
+                         : 1.0F};
+
+  const float3 target{std::any_cast<float>(_target_nodes[0]->compute(context)),
+                      std::any_cast<float>(_target_nodes[1]->compute(context)),
+                      std::any_cast<float>(_target_nodes[2]->compute(context))};
+
+  switch (_solver) {
+    case anim_graph_node_ik::solver::two_bone: {
+      if (weight == 0.0F || !_two_bone_joints.has_value()) {
+        out_result = pose_job_index;
+        return;
+      }
+
+      _job_ik_two_bone.set_job_index(pose_job_index);
+      _job_ik_two_bone.set_target(target);
+      _job_ik_two_bone.set_weight(weight);
+      out_result = context.job_queue.add_job(_job_ik_two_bone);
+    } break;
+
+    case anim_graph_node_ik::solver::fabrik: {
+      if (weight == 0.0F || _chain.size() < 2) {
+        out_result = pose_job_index;
+        return;
+      }
+
+      _job_ik_fabrik.set_job_index(pose_job_index);
+      _job_ik_fabrik.set_target(target);
+      _job_ik_fabrik.set_weight(weight);
+      out_result = context.job_queue.add_job(_job_ik_fabrik);
+    } break;
+  }
+}
+}  // namespace eely::internal
\ No newline at end of file
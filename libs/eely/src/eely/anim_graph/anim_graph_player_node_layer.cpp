@@ -0,0 +1,138 @@
+#include "eely/anim_graph/anim_graph_player_node_layer.h"
+
+#include "eely/anim_graph/anim_graph_node_layer.h"
+#include "eely/anim_graph/anim_graph_player_context.h"
+#include "eely/anim_graph/anim_graph_player_node_base.h"
+#include "eely/anim_graph/anim_graph_player_node_pose_base.h"
+#include "eely/base/assert.h"
+#include "eely/job/job_add_masked.h"
+#include "eely/job/job_blend_masked.h"
+#include "eely/skeleton_mask/skeleton_mask.h"
+
+#include <gsl/util>
+
+#include <algorithm>
+#include <any>
+#include <vector>
+
+namespace eely::internal {
+anim_graph_player_node_layer::anim_graph_player_node_layer(const int id,
+                                                           const anim_graph_node_layer::mode mode,
+                                                           const skeleton_mask& mask)
+    : anim_graph_player_node_pose_base{anim_graph_node_type::layer, id}, _mode{mode}, _mask{mask}
+{
+  _job_blend_masked.set_skeleton_mask(_mask);
+  _job_add_masked.set_skeleton_mask(_mask);
+}
+
+void anim_graph_player_node_layer::update_duration(const anim_graph_player_context& context)
+{
+  EXPECTS(_base_node != nullptr);
+  EXPECTS(_layer_node != nullptr);
+
+  anim_graph_player_node_pose_base::update_duration(context);
+
+  // Layer is an overlay on top of a base pose,
+  // so it's the base pose that drives duration of this node.
+
+  _base_node->update_duration(context);
+  _layer_node->update_duration(context);
+  set_duration_s(_base_node->get_duration_s());
+}
+
+void anim_graph_player_node_layer::collect_descendants(
+    std::vector<const anim_graph_player_node_base*>& out_descendants) const
+{
+  if (_base_node != nullptr) {
+    out_descendants.push_back(_base_node);
+    _base_node->collect_descendants(out_descendants);
+  }
+
+  if (_layer_node != nullptr) {
+    out_descendants.push_back(_layer_node);
+    _layer_node->collect_descendants(out_descendants);
+  }
+
+  if (_weight_node != nullptr) {
+    out_descendants.push_back(_weight_node);
+    _weight_node->collect_descendants(out_descendants);
+  }
+}
+
+anim_graph_player_node_pose_base* anim_graph_player_node_layer::get_base_node() const
+{
+  return _base_node;
+}
+
+void anim_graph_player_node_layer::set_base_node(anim_graph_player_node_pose_base* const node)
+{
+  _base_node = node;
+}
+
+anim_graph_player_node_pose_base* anim_graph_player_node_layer::get_layer_node() const
+{
+  return _layer_node;
+}
+
+void anim_graph_player_node_layer::set_layer_node(anim_graph_player_node_pose_base* const node)
+{
+  _layer_node = node;
+}
+
+anim_graph_player_node_base* anim_graph_player_node_layer::get_weight_node() const
+{
+  return _weight_node;
+}
+
+void anim_graph_player_node_layer::set_weight_node(anim_graph_player_node_base* const node)
+{
+  _weight_node = node;
+}
+
+float anim_graph_player_node_layer::get_current_weight() const
+{
+  return _weight;
+}
+
+void anim_graph_player_node_layer::compute_impl(const anim_graph_player_context& context,
+                                                std::any& out_result)
+{
+  EXPECTS(_base_node != nullptr);
+  EXPECTS(_layer_node != nullptr);
+  EXPECTS(_weight_node != nullptr);
+
+  anim_graph_player_node_pose_base::compute_impl(context, out_result);
+
+  apply_next_phase(context);
+
+  _weight = std::clamp(std::any_cast<float>(_weight_node->compute(context)), 0.0F, 1.0F);
+
+  const auto base_job_index{std::any_cast<gsl::index>(_base_node->compute(context))};
+
+  // Layer with zero weight does not contribute anything,
+  // skip it entirely to avoid decoding and blending a pose that is thrown away.
+  // Layer nodes are then treated as inactive and restart once weight becomes non-zero.
+  if (_weight == 0.0F) {
+    out_result = base_job_index;
+    return;
+  }
+
+  const auto layer_job_index{std::any_cast<gsl::index>(_layer_node->compute(context))};
+
+  switch (_mode) {
+    case anim_graph_node_layer::mode::blend: {
+      _job_blend_masked.set_first_job_index(base_job_index);
+      _job_blend_masked.set_second_job_index(layer_job_index);
+      _job_blend_masked.set_weight(_weight);
+      out_result = context.job_queue.add_job(_job_blend_masked);
+    } break;
+
+    case anim_graph_node_layer::mode::add: {
+      _job_add_masked.set_first_job_index(base_job_index);
+      _job_add_masked.set_second_job_index(layer_job_index);
+      _job_add_masked.set_weight(_weight);
+      out_result = context.job_queue.add_job(_job_add_masked);
+    } break;
+  }
+}
+}  // namespace eely::internal
\ No newline at end of file
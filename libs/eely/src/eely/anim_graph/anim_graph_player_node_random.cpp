@@ -7,13 +7,13 @@
 #include <gsl/narrow>
 
 #include <any>
+#include <cstdint>
 #include <random>
 #include <vector>
 
 namespace eely::internal {
 anim_graph_player_node_random::anim_graph_player_node_random(const int id)
-    : anim_graph_player_node_pose_base{anim_graph_node_type::random, id},
-      _random_generator{std::random_device{}()}
+    : anim_graph_player_node_pose_base{anim_graph_node_type::random, id}
 {
   set_phase_rules(phase_rules::copy);
 }
@@ -62,6 +62,11 @@ void anim_graph_player_node_random::set_children_nodes(
       std::uniform_int_distribution<>(0, gsl::narrow<int>(_children_nodes.size() - 1));
 }
 
+void anim_graph_player_node_random::set_random_seed(const uint32_t seed)
+{
+  _random_generator.seed(seed);
+}
+
 void anim_graph_player_node_random::compute_impl(const anim_graph_player_context& context,
                                                  std::any& out_result)
 {
@@ -26,7 +26,7 @@ void anim_graph_player_node_state_condition::compute_impl(const anim_graph_playe
 {
   anim_graph_player_node_base::compute_impl(context, out_result);
 
-  const auto* const node_state_machine = anim_graph_player_node_state_machine::get_current();
+  const auto* const node_state_machine = context.state_machine;
   EXPECTS(node_state_machine != nullptr);
 
   if (_phase.has_value()) {
@@ -10,21 +10,9 @@
 
 #include <algorithm>
 #include <any>
-#include <stack>
 #include <vector>
 
 namespace eely::internal {
-// Disable warning on purpose.
-// This seems to be the easiest way to give access to the current state machine.
-std::stack<anim_graph_player_node_state_machine*>
-    anim_graph_player_node_state_machine::active_state_machines_stack;  // NOLINT
-
-const anim_graph_player_node_state_machine* anim_graph_player_node_state_machine::get_current()
-{
-  EXPECTS(!active_state_machines_stack.empty());
-  return active_state_machines_stack.top();
-}
-
 anim_graph_player_node_state_machine::anim_graph_player_node_state_machine(const int id)
     : anim_graph_player_node_pose_base{anim_graph_node_type::state_machine, id}
 {
@@ -36,7 +24,9 @@ void anim_graph_player_node_state_machine::update_duration(const anim_graph_play
 {
   anim_graph_player_node_pose_base::update_duration(context);
 
-  anim_graph_player_node_state_machine::active_state_machines_stack.push(this);
+  // Descendants access current state machine via context
+  anim_graph_player_context context_pass_on{context};
+  context_pass_on.state_machine = this;
 
   if (is_first_play(context)) {
     // Reset state when state machine becomes active for the first time.
@@ -61,18 +51,18 @@ void anim_graph_player_node_state_machine::update_duration(const anim_graph_play
                            !context.sync_enabled};
 
   if (predict_phase) {
-    _current_node->update_duration(context);
+    _current_node->update_duration(context_pass_on);
 
-    const float next_phase{_current_node->get_next_phase_unwrapped(context)};
+    const float next_phase{_current_node->get_next_phase_unwrapped(context_pass_on)};
 
-    if (update_state(context, next_phase)) {
+    if (update_state(context_pass_on, next_phase)) {
       // If we switched to another state, we must update duration of it as well
-      _current_node->update_duration(context);
+      _current_node->update_duration(context_pass_on);
     }
   }
   else {
-    update_state(context, get_phase());
-    _current_node->update_duration(context);
+    update_state(context_pass_on, get_phase());
+    _current_node->update_duration(context_pass_on);
   }
 
   // Update state machine's duration
@@ -94,8 +84,6 @@ void anim_graph_player_node_state_machine::update_duration(const anim_graph_play
   }
 
   update_phase_copy_source();
-
-  anim_graph_player_node_state_machine::active_state_machines_stack.pop();
 }
 
 void anim_graph_player_node_state_machine::collect_descendants(
@@ -140,7 +128,8 @@ void anim_graph_player_node_state_machine::compute_impl(const anim_graph_player_
 {
   anim_graph_player_node_pose_base::compute_impl(context, out_result);
 
-  anim_graph_player_node_state_machine::active_state_machines_stack.push(this);
+  anim_graph_player_context context_pass_on{context};
+  context_pass_on.state_machine = this;
 
   if (context.sync_enabled) {
     // See comment in `update_duration` on why state is updated here as well for synced mode.
@@ -153,17 +142,15 @@ void anim_graph_player_node_state_machine::compute_impl(const anim_graph_player_
           polymorphic_downcast<anim_graph_player_node_state*>(_current_node);
 
       if (!current_state->get_breakpoints().empty()) {
-        update_state(context, get_phase());
+        update_state(context_pass_on, get_phase());
       }
     }
   }
 
-  out_result = _current_node->compute(context);
+  out_result = _current_node->compute(context_pass_on);
 
   update_phase_copy_source();
   apply_next_phase(context);
-
-  anim_graph_player_node_state_machine::active_state_machines_stack.pop();
 }
 
 bool anim_graph_player_node_state_machine::update_state(const anim_graph_player_context& context,
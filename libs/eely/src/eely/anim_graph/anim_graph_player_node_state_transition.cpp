@@ -4,16 +4,23 @@
 #include "eely/anim_graph/anim_graph_node_state_transition.h"
 #include "eely/anim_graph/anim_graph_player_context.h"
 #include "eely/anim_graph/anim_graph_player_node_base.h"
+#include "eely/anim_graph/anim_graph_player_node_param.h"
+#include "eely/anim_graph/anim_graph_player_node_param_comparison.h"
 #include "eely/anim_graph/anim_graph_player_node_pose_base.h"
 #include "eely/anim_graph/anim_graph_player_node_state.h"
+#include "eely/anim_graph/anim_graph_player_node_state_condition.h"
 #include "eely/anim_graph/anim_graph_player_node_state_machine.h"
+#include "eely/base/base_utils.h"
+#include "eely/params/params.h"
 #include "eely/job/job_blend.h"
 #include "eely/job/job_restore.h"
 #include "eely/job/job_save.h"
 
+#include <algorithm>
 #include <any>
 #include <array>
 #include <cmath>
+#include <vector>
 
 namespace eely::internal {
 anim_graph_player_node_state_transition::anim_graph_player_node_state_transition(
@@ -79,7 +86,7 @@ void anim_graph_player_node_state_transition::update_duration(
 
   // Update current source and destination states and update destination's duration
 
-  const auto* const state_machine = anim_graph_player_node_state_machine::get_current();
+  const auto* const state_machine = context.state_machine;
   EXPECTS(state_machine != nullptr);
 
   if (_reversed) {
@@ -111,7 +118,63 @@ void anim_graph_player_node_state_transition::collect_descendants(
 bool anim_graph_player_node_state_transition::conditions_are_satisfied(
     const anim_graph_player_context& context) const
 {
-  return std::any_cast<bool>(_condition_node->compute(context));
+  if (!_conditions_cacheable) {
+    return std::any_cast<bool>(_condition_node->compute(context));
+  }
+
+  // State conditions only compare candidate phase with their phase,
+  // thus result can only change when candidate phase moves to another interval between them
+
+  gsl::index phase_interval{0};
+  if (!_conditions_phases.empty()) {
+    EXPECTS(context.state_machine != nullptr);
+    const float candidate_phase{context.state_machine->get_transition_source_candidate_phase()};
+    phase_interval = std::distance(
+        _conditions_phases.begin(),
+        std::upper_bound(_conditions_phases.begin(), _conditions_phases.end(), candidate_phase));
+  }
+
+  bool dirty{!_conditions_cached_result.has_value() ||
+             _conditions_cached_phase_interval != phase_interval};
+
+  // Check versions of specific parameters only if some of the parameters have changed at all,
+  // versions are unique across parameters objects, so this works if another object is given
+
+  if (!dirty && _conditions_cached_params_version != context.params.get_version()) {
+    for (gsl::index i{0}; i < std::ssize(_conditions_params); ++i) {
+      if (context.params.get_version(*_conditions_params[i]) !=
+          _conditions_cached_params_versions[i]) {
+        dirty = true;
+        break;
+      }
+    }
+  }
+
+  if (dirty) {
+    _conditions_cached_result = std::any_cast<bool>(_condition_node->compute(context));
+    _conditions_cached_phase_interval = phase_interval;
+
+    for (gsl::index i{0}; i < std::ssize(_conditions_params); ++i) {
+      _conditions_cached_params_versions[i] = context.params.get_version(*_conditions_params[i]);
+    }
+
+    // Not all of the nodes are computed, e.g. `and` stops at first unsatisfied child
+    _conditions_cached_played_nodes.clear();
+    for (const anim_graph_player_node_base* node : _conditions_nodes) {
+      if (node->get_last_play_counter() == context.play_counter) {
+        _conditions_cached_played_nodes.push_back(node);
+      }
+    }
+  }
+  else {
+    for (const anim_graph_player_node_base* node : _conditions_cached_played_nodes) {
+      node->register_play(context);
+    }
+  }
+
+  _conditions_cached_params_version = context.params.get_version();
+
+  return _conditions_cached_result.value();
 }
 
 bool anim_graph_player_node_state_transition::is_finished(const float phase) const
@@ -129,6 +192,56 @@ const anim_graph_player_node_base* anim_graph_player_node_state_transition::get_
   return _condition_node;
 }
 
+void anim_graph_player_node_state_transition::update_condition_dependencies()
+{
+  EXPECTS(_condition_node != nullptr);
+
+  _conditions_cacheable = true;
+  _conditions_params.clear();
+  _conditions_phases.clear();
+  _conditions_nodes.clear();
+  _conditions_cached_result.reset();
+
+  _conditions_nodes.push_back(_condition_node);
+  _condition_node->collect_descendants(_conditions_nodes);
+
+  for (const anim_graph_player_node_base* condition : _conditions_nodes) {
+    switch (condition->get_type()) {
+      case anim_graph_node_type::and_logic: {
+      } break;
+
+      case anim_graph_node_type::param_comparison: {
+        const auto* param_comparison{
+            polymorphic_downcast<const anim_graph_player_node_param_comparison*>(condition)};
+        _conditions_params.push_back(&param_comparison->get_param_id());
+      } break;
+
+      case anim_graph_node_type::param: {
+        const auto* param{polymorphic_downcast<const anim_graph_player_node_param*>(condition)};
+        _conditions_params.push_back(&param->get_param_id());
+      } break;
+
+      case anim_graph_node_type::state_condition: {
+        const auto* state_condition{
+            polymorphic_downcast<const anim_graph_player_node_state_condition*>(condition)};
+        if (state_condition->get_phase().has_value()) {
+          _conditions_phases.push_back(state_condition->get_phase().value());
+        }
+      } break;
+
+      default: {
+        // Node with unknown dependencies, conditions must be evaluated every time
+        _conditions_cacheable = false;
+      } break;
+    }
+  }
+
+  std::sort(_conditions_phases.begin(), _conditions_phases.end());
+
+  _conditions_cached_params_versions.resize(_conditions_params.size());
+  _conditions_cached_played_nodes.reserve(_conditions_nodes.size());
+}
+
 void anim_graph_player_node_state_transition::set_condition_node(
     anim_graph_player_node_base* const node)
 {
@@ -175,7 +288,7 @@ void anim_graph_player_node_state_transition::compute_impl(const anim_graph_play
   const gsl::index saved_pose_transition_slot{
       _saved_pose_source_slot_index == 0 ? _saved_pose_slots[1] : _saved_pose_slots[0]};
 
-  const auto* const state_machine = anim_graph_player_node_state_machine::get_current();
+  const auto* const state_machine = context.state_machine;
   EXPECTS(state_machine != nullptr);
 
   if (is_first_play(context)) {
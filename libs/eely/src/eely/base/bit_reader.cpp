@@ -6,14 +6,36 @@
 #include <gsl/narrow>
 #include <gsl/util>
 
+#include <algorithm>
+#include <bit>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <span>
 #include <stdexcept>
 
 namespace eely::internal {
+// Bits are stored starting from the lowest ones, so a word assembled from bytes in memory order
+// holds them in the same order. On little endian machines that is a plain copy.
+static uint64_t load_word(const std::byte* bytes, const gsl::index bytes_count)
+{
+  uint64_t word = 0;
+
+  if constexpr (std::endian::native == std::endian::little) {
+    std::memcpy(&word, bytes, bytes_count);
+  }
+  else {
+    for (gsl::index i{0}; i < bytes_count; ++i) {
+      // NOLINTNEXTLINE (intentionally using pointer arithmetics)
+      word |= uint64_t{std::to_integer<uint8_t>(bytes[i])} << (i * 8);
+    }
+  }
+
+  return word;
+}
+
 bit_reader::bit_reader(const std::span<const std::byte>& data)
-    : _data{data.data()}, _data_size_bits{std::ssize(data) * 8}
+    : _data{data.data()}, _data_size_bytes{std::ssize(data)}, _data_size_bits{_data_size_bytes * 8}
 {
   EXPECTS(_data != nullptr);
   EXPECTS(_data_size_bits > 0);
@@ -37,41 +59,70 @@ uint32_t bit_reader::read(const gsl::index size_bits)
   // Starting bit index inside starting byte
   const gsl::index bit_index = _position_bits % 8;
 
-  // Number of bits left in starting byte
-  const gsl::index remaining_bits = 8 - bit_index;
-
+  // Load the whole bit string with a single word,
+  // near the end of a buffer only bytes that are there
+  const gsl::index bytes_count =
+      byte_index + 8 <= _data_size_bytes ? 8 : (bit_index + size_bits + 7) / 8;
   // NOLINTNEXTLINE (intentionally using pointer arithmetics)
-  uint32_t result = std::to_integer<uint32_t>(_data[byte_index]) >> bit_index;
-  if (size_bits > remaining_bits) {
-    uint32_t v = 0;
+  const uint64_t word = load_word(_data + byte_index, bytes_count);
 
-    if (size_bits - remaining_bits > 24) {
-      // NOLINTNEXTLINE (intentionally using pointer arithmetics)
-      v |= std::to_integer<uint32_t>(_data[byte_index + 4]) << 24;
-    }
-    if (size_bits - remaining_bits > 16) {
-      // NOLINTNEXTLINE (intentionally using pointer arithmetics)
-      v |= std::to_integer<uint32_t>(_data[byte_index + 3]) << 16;
-    }
-    if (size_bits - remaining_bits > 8) {
+  const uint64_t mask = (uint64_t{1} << size_bits) - 1;
+  const auto result = static_cast<uint32_t>((word >> bit_index) & mask);
+
+  _position_bits += size_bits;
+
+  return result;
+}
+
+void bit_reader::read_bytes(const std::span<std::byte>& out_bytes)
+{
+  const gsl::index bytes_count{std::ssize(out_bytes)};
+
+  if (_position_bits + bytes_count * 8 > _data_size_bits) {
+    throw std::runtime_error("Attempt to read past specified buffer");
+  }
+
+  if ((_position_bits % 8) == 0) {
+    if (bytes_count > 0) {
       // NOLINTNEXTLINE (intentionally using pointer arithmetics)
-      v |= std::to_integer<uint32_t>(_data[byte_index + 2]) << 8;
+      std::memcpy(out_bytes.data(), _data + _position_bits / 8, bytes_count);
     }
 
-    // NOLINTNEXTLINE (intentionally using pointer arithmetics)
-    v |= std::to_integer<uint32_t>(_data[byte_index + 1]);
+    _position_bits += bytes_count * 8;
+    return;
+  }
+
+  // Not aligned to a byte, read as many full words as possible,
+  // their bytes are in memory order on little endian machines only
+
+  gsl::index i{0};
 
-    v <<= remaining_bits;
-    result |= v;
+  if constexpr (std::endian::native == std::endian::little) {
+    for (; i + 4 <= bytes_count; i += 4) {
+      const uint32_t word{read(32)};
+      std::memcpy(&out_bytes[i], &word, 4);
+    }
   }
 
-  if (size_bits < 32) {
-    result &= (1U << size_bits) - 1;
+  for (; i < bytes_count; ++i) {
+    out_bytes[i] = static_cast<std::byte>(read(8));
   }
+}
 
-  _position_bits += size_bits;
+void bit_reader::skip_bytes(const gsl::index bytes_count)
+{
+  EXPECTS(bytes_count >= 0);
 
-  return result;
+  if (_position_bits + bytes_count * 8 > _data_size_bits) {
+    throw std::runtime_error("Attempt to read past specified buffer");
+  }
+
+  _position_bits += bytes_count * 8;
+}
+
+void bit_reader::align()
+{
+  _position_bits = std::min((_position_bits + 7) / 8 * 8, _data_size_bits);
 }
 
 gsl::index bit_reader::get_position_bits() const
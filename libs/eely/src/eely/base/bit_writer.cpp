@@ -9,9 +9,43 @@
 #include <bit>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <span>
 #include <stdexcept>
 
 namespace eely::internal {
+// Bits are stored starting from the lowest ones, so a word assembled from bytes in memory order
+// holds them in the same order. On little endian machines that is a plain copy.
+static uint64_t load_word(const std::byte* bytes, const gsl::index bytes_count)
+{
+  uint64_t word = 0;
+
+  if constexpr (std::endian::native == std::endian::little) {
+    std::memcpy(&word, bytes, bytes_count);
+  }
+  else {
+    for (gsl::index i{0}; i < bytes_count; ++i) {
+      // NOLINTNEXTLINE (intentionally using pointer arithmetics)
+      word |= uint64_t{std::to_integer<uint8_t>(bytes[i])} << (i * 8);
+    }
+  }
+
+  return word;
+}
+
+static void store_word(std::byte* bytes, const gsl::index bytes_count, const uint64_t word)
+{
+  if constexpr (std::endian::native == std::endian::little) {
+    std::memcpy(bytes, &word, bytes_count);
+  }
+  else {
+    for (gsl::index i{0}; i < bytes_count; ++i) {
+      // NOLINTNEXTLINE (intentionally using pointer arithmetics)
+      bytes[i] = static_cast<std::byte>(word >> (i * 8));
+    }
+  }
+}
+
 bit_writer::bit_writer(const std::span<std::byte>& data)
     : _data{data.data()}, _data_size_bits{std::ssize(data) * 8}
 {
@@ -46,62 +80,69 @@ void bit_writer::patch(const patch_params& params)
     throw std::runtime_error("Attempt to write past specified buffer");
   }
 
+  if (params.size_bits == 0 || _data == nullptr) {
+    // Nothing to write or only counting bits
+    return;
+  }
+
   // Starting byte where to write bit string
   const gsl::index byte_index = params.offset_bits / 8;
 
   // Starting bit index inside starting byte
   const gsl::index bit_index = params.offset_bits % 8;
 
-  // Number of bits left in starting byte
-  const gsl::index remaining_bits = 8 - bit_index;
+  // Read-modify-write bytes covered by the bit string as a single word,
+  // there are at most 5 of them since at most 32 bits are written.
+  // When buffer allows, whole word is copied, since fixed size copies are cheaper
+  const gsl::index bytes_count = byte_index + 8 <= _data_size_bits / 8
+                                    ? 8
+                                    : (bit_index + params.size_bits + 7) / 8;
 
-  if (params.size_bits == 1) {
-    const auto mask = static_cast<std::byte>(1 << bit_index);
-    // NOLINTNEXTLINE (intentionally using pointer arithmetics)
-    _data[byte_index] &= ~mask;
-    // NOLINTNEXTLINE (intentionally using pointer arithmetics)
-    _data[byte_index] |= static_cast<std::byte>(params.value & 0x01) << bit_index;
-  }
-  // Value bits do not cross byte boundary
-  else if (params.size_bits <= remaining_bits) {
-    const auto mask1 = static_cast<std::byte>((1 << bit_index) - 1);
-    const auto mask2 = static_cast<std::byte>(0xFF << (bit_index + params.size_bits));
-
-    // NOLINTNEXTLINE (intentionally using pointer arithmetics)
-    _data[byte_index] &= mask1 | mask2;
-    // NOLINTNEXTLINE (intentionally using pointer arithmetics)
-    _data[byte_index] |=
-        static_cast<std::byte>((params.value & std::to_integer<uint32_t>(~mask2)) << bit_index);
+  // NOLINTNEXTLINE (intentionally using pointer arithmetics)
+  std::byte* const bytes = _data + byte_index;
+
+  uint64_t word = load_word(bytes, bytes_count);
+
+  const uint64_t mask = ((uint64_t{1} << params.size_bits) - 1) << bit_index;
+  word = (word & ~mask) | ((uint64_t{params.value} << bit_index) & mask);
+
+  store_word(bytes, bytes_count, word);
+}
+
+void bit_writer::write_bytes(const std::span<const std::byte>& bytes)
+{
+  const gsl::index bytes_count{std::ssize(bytes)};
+
+  if (_position_bits + bytes_count * 8 > _data_size_bits) {
+    throw std::runtime_error("Attempt to write past specified buffer");
   }
-  else {
-    const auto mask = static_cast<std::byte>((1 << bit_index) - 1);
-
-    // NOLINTNEXTLINE (intentionally using pointer arithmetics)
-    _data[byte_index] &= mask;
-    // NOLINTNEXTLINE (intentionally using pointer arithmetics)
-    _data[byte_index] |= static_cast<std::byte>(params.value << bit_index);
-
-    uint32_t byte_offset = 1;
-    uint32_t value_shift = gsl::narrow_cast<uint32_t>(remaining_bits);
-    const uint32_t full_bytes = gsl::narrow_cast<uint32_t>(params.size_bits - remaining_bits) / 8;
-    const uint32_t tail_bits = (params.size_bits - remaining_bits) % 8;
-    for (uint32_t i = 0; i < full_bytes; ++i) {
+
+  if (_data == nullptr || (_position_bits % 8) == 0) {
+    if (_data != nullptr && bytes_count > 0) {
       // NOLINTNEXTLINE (intentionally using pointer arithmetics)
-      _data[byte_index + byte_offset] = static_cast<std::byte>(params.value >> value_shift);
-      value_shift += 8;
-      byte_offset += 1;
+      std::memcpy(_data + _position_bits / 8, bytes.data(), bytes_count);
     }
 
-    if (tail_bits != 0) {
-      const auto tail_mask = static_cast<std::byte>((1 << tail_bits) - 1);
+    _position_bits += bytes_count * 8;
+    return;
+  }
 
-      // NOLINTNEXTLINE (intentionally using pointer arithmetics)
-      _data[byte_index + byte_offset] &= ~tail_mask;
-      // NOLINTNEXTLINE (intentionally using pointer arithmetics)
-      _data[byte_index + byte_offset] |=
-          static_cast<std::byte>(params.value >> value_shift) & tail_mask;
+  // Not aligned to a byte, write as many full words as possible,
+  // their bytes are in memory order on little endian machines only
+
+  gsl::index i{0};
+
+  if constexpr (std::endian::native == std::endian::little) {
+    for (; i + 4 <= bytes_count; i += 4) {
+      uint32_t word{0};
+      std::memcpy(&word, &bytes[i], 4);
+      write({.value = word, .size_bits = 32});
     }
   }
+
+  for (; i < bytes_count; ++i) {
+    write({.value = std::to_integer<uint32_t>(bytes[i]), .size_bits = 8});
+  }
 }
 
 void bit_writer::align()
@@ -110,8 +151,11 @@ void bit_writer::align()
     const gsl::index byte_index = _position_bits / 8;
     const gsl::index bit_index = _position_bits % 8;
 
-    // NOLINTNEXTLINE (intentionally using pointer arithmetics)
-    _data[byte_index] &= static_cast<std::byte>((1 << bit_index) - 1);
+    if (_data != nullptr) {
+      // NOLINTNEXTLINE (intentionally using pointer arithmetics)
+      _data[byte_index] &= static_cast<std::byte>((1 << bit_index) - 1);
+    }
+
     _position_bits += 8 - bit_index;
   }
 }
@@ -0,0 +1,41 @@
+#include "eely/base/counting_memory_resource.h"
+
+#include "eely/base/assert.h"
+
+#include <gsl/narrow>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+
+namespace eely {
+counting_memory_resource::counting_memory_resource(std::pmr::memory_resource* upstream)
+    : _upstream{upstream}
+{
+  EXPECTS(_upstream != nullptr);
+}
+
+int64_t counting_memory_resource::get_allocated_bytes() const
+{
+  return _allocated_bytes.load(std::memory_order_relaxed);
+}
+
+void* counting_memory_resource::do_allocate(const size_t bytes, const size_t alignment)
+{
+  void* ptr{_upstream->allocate(bytes, alignment)};
+  _allocated_bytes.fetch_add(gsl::narrow<int64_t>(bytes), std::memory_order_relaxed);
+  return ptr;
+}
+
+void counting_memory_resource::do_deallocate(void* ptr, const size_t bytes, const size_t alignment)
+{
+  _allocated_bytes.fetch_sub(gsl::narrow_cast<int64_t>(bytes), std::memory_order_relaxed);
+  _upstream->deallocate(ptr, bytes, alignment);
+}
+
+bool counting_memory_resource::do_is_equal(const std::pmr::memory_resource& other) const noexcept
+{
+  return this == &other;
+}
+}  // namespace eely
\ No newline at end of file
@@ -0,0 +1,48 @@
+#include "eely/base/file_utils.h"
+
+#include <fmt/format.h>
+
+#include <gsl/narrow>
+
+#include <algorithm>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <ios>
+#include <iterator>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+namespace eely {
+std::vector<std::byte> read_file(const std::filesystem::path& path)
+{
+  std::ifstream file{path, std::ios::binary};
+  if (!file) {
+    throw std::runtime_error{fmt::format("Could not open file: {}", path.string())};
+  }
+
+  const std::vector<char> chars{std::istreambuf_iterator<char>{file},
+                                std::istreambuf_iterator<char>{}};
+
+  std::vector<std::byte> result(chars.size());
+  std::transform(chars.begin(), chars.end(), result.begin(),
+                 [](const char c) { return static_cast<std::byte>(c); });
+
+  return result;
+}
+
+void write_file(const std::filesystem::path& path, const std::span<const std::byte> data)
+{
+  std::ofstream file{path, std::ios::binary | std::ios::trunc};
+  if (!file) {
+    throw std::runtime_error{fmt::format("Could not open file: {}", path.string())};
+  }
+
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast), old interface
+  file.write(reinterpret_cast<const char*>(data.data()), gsl::narrow<std::streamsize>(data.size()));
+  if (!file) {
+    throw std::runtime_error{fmt::format("Could not write file: {}", path.string())};
+  }
+}
+}  // namespace eely
\ No newline at end of file
@@ -0,0 +1,263 @@
+#include "eely/base/profiling.h"
+
+#include <fmt/format.h>
+
+#include <gsl/util>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace eely::internal {
+// How many latest events each thread keeps.
+static constexpr int64_t profiling_ring_buffer_capacity{1 << 16};
+
+// Events of a single thread.
+// Only the owning thread writes events, so recording needs no locks,
+// readers see events up to `written_count`.
+struct profiling_ring_buffer final {
+  std::array<profiling_event, profiling_ring_buffer_capacity> events;
+  std::atomic<int64_t> written_count{0};
+
+  // Events before this one were cleared, guarded by `profiling_buffers_mutex`.
+  int64_t cleared_count{0};
+};
+
+// Ring buffers of all threads that recorded events.
+// Buffers are kept after threads finish, so that their events can still be collected.
+static std::mutex profiling_buffers_mutex;                                     // NOLINT
+static std::vector<std::unique_ptr<profiling_ring_buffer>> profiling_buffers;  // NOLINT
+static thread_local profiling_ring_buffer* profiling_thread_buffer{nullptr};   // NOLINT
+static thread_local int profiling_thread_index{0};                             // NOLINT
+
+static const std::chrono::steady_clock::time_point profiling_epoch{  // NOLINT
+    std::chrono::steady_clock::now()};
+
+// Return index in a ring buffer for an event with specified ordinal number.
+static size_t profiling_ring_buffer_slot(const int64_t index)
+{
+  return gsl::narrow_cast<size_t>(index % profiling_ring_buffer_capacity);
+}
+
+int64_t profiling_get_time_ns()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() -
+                                                              profiling_epoch)
+      .count();
+}
+
+// Return calling thread's ring buffer, create one if it's not there yet.
+static profiling_ring_buffer& profiling_get_thread_buffer()
+{
+  if (profiling_thread_buffer == nullptr) {
+    const std::scoped_lock lock{profiling_buffers_mutex};
+    profiling_thread_index = gsl::narrow_cast<int>(profiling_buffers.size());
+    profiling_thread_buffer =
+        profiling_buffers.emplace_back(std::make_unique<profiling_ring_buffer>()).get();
+  }
+
+  return *profiling_thread_buffer;
+}
+
+void profiling_record(const profiling_event& event)
+{
+  profiling_get_thread_buffer();
+
+  const int64_t index{profiling_thread_buffer->written_count.load(std::memory_order_relaxed)};
+
+  profiling_event& slot{profiling_thread_buffer->events[profiling_ring_buffer_slot(index)]};
+  slot = event;
+  slot.thread_index = profiling_thread_index;
+
+  profiling_thread_buffer->written_count.store(index + 1, std::memory_order_release);
+}
+
+int64_t profiling_get_thread_events_count()
+{
+  return profiling_get_thread_buffer().written_count.load(std::memory_order_relaxed);
+}
+
+void profiling_get_thread_events(const int64_t from_count,
+                                 std::vector<profiling_event>& out_events)
+{
+  // Only this thread writes into its buffer, so nothing can change while reading
+  const profiling_ring_buffer& buffer{profiling_get_thread_buffer()};
+  const int64_t end{buffer.written_count.load(std::memory_order_relaxed)};
+  const int64_t begin{std::max(from_count, end - profiling_ring_buffer_capacity)};
+
+  for (int64_t i{begin}; i < end; ++i) {
+    out_events.push_back(buffer.events[profiling_ring_buffer_slot(i)]);
+  }
+}
+}  // namespace eely::internal
+
+namespace eely {
+std::vector<profiling_event> profiling_collect_events()
+{
+  using namespace eely::internal;
+
+  std::vector<profiling_event> result;
+
+  const std::scoped_lock lock{profiling_buffers_mutex};
+
+  for (const auto& buffer : profiling_buffers) {
+    const int64_t end{buffer->written_count.load(std::memory_order_acquire)};
+    const int64_t begin{std::max(buffer->cleared_count, end - profiling_ring_buffer_capacity)};
+
+    for (int64_t i{begin}; i < end; ++i) {
+      result.push_back(buffer->events[profiling_ring_buffer_slot(i)]);
+    }
+  }
+
+  return result;
+}
+
+void profiling_clear()
+{
+  using namespace eely::internal;
+
+  const std::scoped_lock lock{profiling_buffers_mutex};
+
+  for (const auto& buffer : profiling_buffers) {
+    buffer->cleared_count = buffer->written_count.load(std::memory_order_acquire);
+  }
+}
+
+std::string profiling_events_to_chrome_trace(const std::span<const profiling_event> events)
+{
+  static constexpr std::array<const char*, 5> categories{
+      "anim_graph_player", "node", "job", "clip_player", "object_space"};
+
+  std::string result{"{\"traceEvents\":["};
+  auto out{std::back_inserter(result)};
+
+  for (gsl::index i{0}; i < std::ssize(events); ++i) {
+    const profiling_event& event{events[i]};
+
+    // Chrome expects timestamps in microseconds
+    fmt::format_to(out,
+                   R"({}{{"name":"{}","cat":"{}","ph":"X","ts":{:.3f},"dur":{:.3f},)"
+                   R"("pid":0,"tid":{},"args":{{"id":{}}}}})",
+                   i > 0 ? ",\n" : "\n", event.name != nullptr ? event.name : "",
+                   categories.at(static_cast<size_t>(event.type)),
+                   static_cast<double>(event.begin_ns) / 1000.0,
+                   static_cast<double>(event.end_ns - event.begin_ns) / 1000.0,
+                   event.thread_index, event.id);
+  }
+
+  result += "\n],\"displayTimeUnit\":\"ns\"}";
+
+  return result;
+}
+
+std::unordered_map<int, profiling_node_stats> profiling_aggregate_nodes(
+    const std::span<const profiling_event> events)
+{
+  // Order events so that every scope goes right before scopes nested into it,
+  // then self time of a scope is its duration minus durations of direct children
+
+  std::vector<gsl::index> order(events.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(), [&events](const gsl::index a, const gsl::index b) {
+    const profiling_event& event_a{events[a]};
+    const profiling_event& event_b{events[b]};
+
+    if (event_a.thread_index != event_b.thread_index) {
+      return event_a.thread_index < event_b.thread_index;
+    }
+
+    if (event_a.begin_ns != event_b.begin_ns) {
+      return event_a.begin_ns < event_b.begin_ns;
+    }
+
+    return event_a.end_ns > event_b.end_ns;
+  });
+
+  std::vector<int64_t> self_ns(events.size());
+  std::vector<gsl::index> open_scopes;
+
+  // Jobs are executed after nodes are computed, they are not nested into them.
+  // Remember which node is computed within which, so that jobs could be added to ancestors
+  std::unordered_map<int, int> node_parent_ids;
+
+  for (const gsl::index i : order) {
+    const profiling_event& event{events[i]};
+    self_ns[i] = event.end_ns - event.begin_ns;
+
+    while (!open_scopes.empty()) {
+      const profiling_event& parent{events[open_scopes.back()]};
+      if (parent.thread_index == event.thread_index && parent.end_ns >= event.end_ns) {
+        break;
+      }
+
+      open_scopes.pop_back();
+    }
+
+    if (!open_scopes.empty()) {
+      self_ns[open_scopes.back()] -= event.end_ns - event.begin_ns;
+    }
+
+    if (event.type == profiling_scope_type::node) {
+      const auto parent{std::find_if(
+          open_scopes.rbegin(), open_scopes.rend(), [&events](const gsl::index scope) {
+            return events[scope].type == profiling_scope_type::node;
+          })};
+      if (parent != open_scopes.rend()) {
+        node_parent_ids[event.id] = events[*parent].id;
+      }
+    }
+
+    open_scopes.push_back(i);
+  }
+
+  std::unordered_map<int, profiling_node_stats> result;
+
+  for (gsl::index i{0}; i < std::ssize(events); ++i) {
+    const profiling_event& event{events[i]};
+    const int64_t duration_ns{event.end_ns - event.begin_ns};
+
+    if (event.type == profiling_scope_type::job && event.id >= 0) {
+      profiling_node_stats& stats{result[event.id]};
+      ++stats.jobs_count;
+      stats.jobs_ns += duration_ns;
+
+      // Number of steps is limited, in case nodes were nested differently at different times
+      int id{event.id};
+      for (size_t step{0}; step <= node_parent_ids.size(); ++step) {
+        result[id].subtree_jobs_ns += duration_ns;
+
+        auto parent_iter{node_parent_ids.find(id)};
+        if (parent_iter == node_parent_ids.end()) {
+          break;
+        }
+
+        id = parent_iter->second;
+      }
+
+      continue;
+    }
+
+    if (event.type != profiling_scope_type::node) {
+      continue;
+    }
+
+    profiling_node_stats& stats{result[event.id]};
+    ++stats.calls_count;
+    stats.total_ns += duration_ns;
+    stats.self_ns += self_ns[i];
+    stats.max_ns = std::max(stats.max_ns, duration_ns);
+  }
+
+  return result;
+}
+}  // namespace eely
\ No newline at end of file
@@ -4,12 +4,12 @@
 
 #include <gsl/util>
 
+#include <span>
+
 namespace eely::internal {
 void bit_writer_write(bit_writer& writer, const string_id& id)
 {
   bit_writer_write(writer, id.size(), bits_string_id_size);
-  for (const char c : id) {
-    bit_writer_write(writer, c);
-  }
+  writer.write_bytes(std::as_bytes(std::span{id}));
 }
 }  // namespace eely::internal
\ No newline at end of file
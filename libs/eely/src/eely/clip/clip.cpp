@@ -7,6 +7,7 @@
 #include "eely/clip/clip_impl_base.h"
 #include "eely/clip/clip_impl_fixed.h"
 #include "eely/clip/clip_impl_none.h"
+#include "eely/clip/clip_impl_uniform.h"
 #include "eely/clip/clip_uncooked.h"
 #include "eely/clip/clip_utils.h"
 #include "eely/project/project.h"
@@ -33,7 +34,11 @@ clip::clip(const project& project, internal::bit_reader& reader) : resource(proj
     } break;
 
     case clip_compression_scheme::acl: {
-      _impl = std::make_unique<clip_impl_acl>(reader);
+      _impl = std::make_unique<clip_impl_acl>(reader, project.get_tiers_reader());
+    } break;
+
+    case clip_compression_scheme::uniform: {
+      _impl = std::make_unique<clip_impl_uniform>(reader);
     } break;
 
     default: {
@@ -67,7 +72,13 @@ clip::clip(const project& project,
     } break;
 
     case clip_compression_scheme::acl: {
-      _impl = std::make_unique<clip_impl_acl>(duration_s, tracks, false, skeleton);
+      _impl = std::make_unique<clip_impl_acl>(duration_s, tracks, false, skeleton,
+                                              uncooked.get_acl_database_settings(),
+                                              uncooked.get_acl_optimize_loops());
+    } break;
+
+    case clip_compression_scheme::uniform: {
+      _impl = std::make_unique<clip_impl_uniform>(duration_s, tracks, false, skeleton);
     } break;
 
     default: {
@@ -100,7 +111,12 @@ clip::clip(const project& project,
     } break;
 
     case clip_compression_scheme::acl: {
-      _impl = std::make_unique<clip_impl_acl>(duration_s, tracks_additive, true, skeleton);
+      _impl = std::make_unique<clip_impl_acl>(duration_s, tracks_additive, true, skeleton,
+                                              std::nullopt, true);
+    } break;
+
+    case clip_compression_scheme::uniform: {
+      _impl = std::make_unique<clip_impl_uniform>(duration_s, tracks_additive, true, skeleton);
     } break;
 
     default: {
@@ -122,6 +138,9 @@ void clip::serialize(internal::bit_writer& writer) const
   else if (dynamic_cast<const clip_impl_fixed*>(_impl.get()) != nullptr) {
     compression_scheme = clip_compression_scheme::fixed;
   }
+  else if (dynamic_cast<const clip_impl_uniform*>(_impl.get()) != nullptr) {
+    compression_scheme = clip_compression_scheme::uniform;
+  }
   else {
     compression_scheme = clip_compression_scheme::acl;
   }
@@ -136,8 +155,38 @@ float clip::get_duration_s() const
   return _impl->get_metadata()->duration_s;
 }
 
+bool clip::is_additive() const
+{
+  return _impl->get_metadata()->is_additive;
+}
+
 std::unique_ptr<clip_player_base> clip::create_player() const
 {
   return _impl->create_player();
 }
+
+size_t clip::get_streaming_tier_size(const clip_streaming_tier tier) const
+{
+  return _impl->get_streaming_tier_size(tier);
+}
+
+size_t clip::get_streaming_tier_resident_size(const clip_streaming_tier tier) const
+{
+  return _impl->get_streaming_tier_resident_size(tier);
+}
+
+bool clip::is_streamed_in(const clip_streaming_tier tier) const
+{
+  return _impl->is_streamed_in(tier);
+}
+
+void clip::stream_in(const clip_streaming_tier tier)
+{
+  _impl->stream_in(tier);
+}
+
+void clip::stream_out(const clip_streaming_tier tier)
+{
+  _impl->stream_out(tier);
+}
 }  // namespace eely
\ No newline at end of file
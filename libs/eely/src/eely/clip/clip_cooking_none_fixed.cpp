@@ -83,17 +83,22 @@ std::vector<clip_uncooked_track> remove_rest_pose_keys(
     clip_uncooked_track reduced_track;
     reduced_track.joint_id = track.joint_id;
 
+    // Keys come sorted, appending with a hint keeps this pass linear
     for (const auto& [time, key] : track.keys) {
+      clip_uncooked_key& reduced_key{
+          reduced_track.keys.emplace_hint(reduced_track.keys.end(), time, clip_uncooked_key{})
+              ->second};
+
       if (track_translation_differs) {
-        reduced_track.keys[time].translation = key.translation;
+        reduced_key.translation = key.translation;
       }
 
       if (track_rotation_differs) {
-        reduced_track.keys[time].rotation = key.rotation;
+        reduced_key.rotation = key.rotation;
       }
 
       if (track_scale_differs) {
-        reduced_track.keys[time].scale = key.scale;
+        reduced_key.scale = key.scale;
       }
     }
 
@@ -11,6 +11,12 @@
 
 #include <gsl/util>
 
+#include <rtm/quatf.h>
+#include <rtm/vector4f.h>
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
 #include <optional>
 #include <vector>
 
@@ -51,36 +57,52 @@ void joint_components_collect(const std::vector<clip_uncooked_track>& tracks,
             [](const auto& a, const auto& b) { return a.joint_index < b.joint_index; });
 }
 
+gsl::index joint_components_get_slot_index(const std::vector<joint_components>& joints_components,
+                                           const gsl::index joint_index)
+{
+  const auto iter{std::lower_bound(
+      joints_components.begin(), joints_components.end(), joint_index,
+      [](const joint_components& j, const gsl::index index) { return j.joint_index < index; })};
+  EXPECTS(iter != joints_components.end() && iter->joint_index == joint_index);
+
+  return std::distance(joints_components.begin(), iter);
+}
+
 void cursor_init(cursor& cursor, const std::vector<joint_components>& joints_components)
 {
   EXPECTS(!joints_components.empty());
-  EXPECTS(cursor.translations.empty());
-  EXPECTS(cursor.rotations.empty());
-  EXPECTS(cursor.scales.empty());
+  EXPECTS(cursor.slots.empty());
 
   cursor.shallow_joint_index = joints_components.front().joint_index;
 
+  gsl::index translations_count{0};
+  gsl::index rotations_count{0};
+  gsl::index scales_count{0};
+
+  cursor.slots.reserve(joints_components.size());
+
   for (const auto& [index, components] : joints_components) {
     EXPECTS(components != 0);
 
+    cursor_slot& slot{cursor.slots.emplace_back()};
+    slot.joint_index = index;
+
     if (has_flag(components, transform_components::translation)) {
-      cursor_component<float3> component;
-      component.joint_index = index;
-      cursor.translations.push_back(component);
+      slot.translation_index = translations_count++;
     }
 
     if (has_flag(components, transform_components::rotation)) {
-      cursor_component<quaternion> component;
-      component.joint_index = index;
-      cursor.rotations.push_back(component);
+      slot.rotation_index = rotations_count++;
     }
 
     if (has_flag(components, transform_components::scale)) {
-      cursor_component<float3> component;
-      component.joint_index = index;
-      cursor.scales.push_back(component);
+      slot.scale_index = scales_count++;
     }
   }
+
+  cursor_components_init(cursor.translations, translations_count);
+  cursor_components_init(cursor.rotations, rotations_count);
+  cursor_components_init(cursor.scales, scales_count);
 }
 
 void cursor_reset(cursor& cursor)
@@ -88,43 +110,170 @@ void cursor_reset(cursor& cursor)
   cursor.last_play_time_s = -1.0F;
   cursor.last_data_pos = 0;
   cursor.last_data_time_s = -1.0F;
-  cursor.last_data_joint_index = std::numeric_limits<gsl::index>::max();
+  cursor.last_data_slot_index = std::numeric_limits<gsl::index>::max();
 
-  for (auto& t : cursor.translations) {
-    cursor_component_reset(t);
-  }
+  cursor_components_reset(cursor.translations);
+  cursor_components_reset(cursor.rotations);
+  cursor_components_reset(cursor.scales);
+}
 
-  for (auto& r : cursor.rotations) {
-    cursor_component_reset(r);
+// Calculate interpolation coefficients for four component cursors starting at `index`.
+// Values outside of a cursor's time range are clamped to its ends,
+// and single key components always use right value.
+template <typename T>
+static rtm::vector4f cursor_components_calculate_coeffs(
+    const cursor_components<T>& cursor_components,
+    const gsl::index index,
+    const rtm::vector4f& time_s)
+{
+  const rtm::vector4f zero = rtm::vector_zero();
+  const rtm::vector4f one = rtm::vector_set(1.0F);
+
+  const rtm::vector4f left_times_s = rtm::vector_load(&cursor_components.left_times_s[index]);
+  const rtm::vector4f right_times_s = rtm::vector_load(&cursor_components.right_times_s[index]);
+
+  const rtm::vector4f coeffs = rtm::vector_clamp(
+      rtm::vector_div(rtm::vector_sub(time_s, left_times_s),
+                      rtm::vector_sub(right_times_s, left_times_s)),
+      zero, one);
+
+  return rtm::vector_select(rtm::vector_less_than(left_times_s, zero), one, coeffs);
+}
+
+static void cursor_components_calculate(const cursor_components<float3>& cursor_components,
+                                        const float time_s)
+{
+  const rtm::vector4f time_s_v = rtm::vector_set(time_s);
+  const gsl::index size{std::ssize(cursor_components.left_times_s)};
+
+  for (gsl::index i{0}; i < size; i += cursor_components_lanes) {
+    const rtm::vector4f coeffs = cursor_components_calculate_coeffs(cursor_components, i, time_s_v);
+
+    for (gsl::index axis{0}; axis < cursor_components.size; ++axis) {
+      const rtm::vector4f left = rtm::vector_load(&cursor_components.lefts[axis][i]);
+      const rtm::vector4f right = rtm::vector_load(&cursor_components.rights[axis][i]);
+      rtm::vector_store(rtm::vector_lerp(left, right, coeffs),
+                        &cursor_components.results[axis][i]);
+    }
   }
+}
 
-  for (auto& s : cursor.scales) {
-    cursor_component_reset(s);
+static void cursor_components_calculate(const cursor_components<quaternion>& cursor_components,
+                                        const float time_s)
+{
+  // Same math as `quaternion_slerp`, but for four rotations at once:
+  // interpolate along the shortest path,
+  // and use normalized lerp when rotations are close to each other
+
+  const rtm::vector4f time_s_v = rtm::vector_set(time_s);
+  const rtm::vector4f zero = rtm::vector_zero();
+  const rtm::vector4f one = rtm::vector_set(1.0F);
+  const rtm::vector4f slerp_threshold = rtm::vector_set(0.95F);
+  const gsl::index size{std::ssize(cursor_components.left_times_s)};
+
+  const auto& lefts{cursor_components.lefts};
+  const auto& rights{cursor_components.rights};
+  auto& results{cursor_components.results};
+
+  for (gsl::index i{0}; i < size; i += cursor_components_lanes) {
+    const rtm::vector4f coeffs = cursor_components_calculate_coeffs(cursor_components, i, time_s_v);
+
+    const rtm::vector4f left_x = rtm::vector_load(&lefts[0][i]);
+    const rtm::vector4f left_y = rtm::vector_load(&lefts[1][i]);
+    const rtm::vector4f left_z = rtm::vector_load(&lefts[2][i]);
+    const rtm::vector4f left_w = rtm::vector_load(&lefts[3][i]);
+
+    rtm::vector4f right_x = rtm::vector_load(&rights[0][i]);
+    rtm::vector4f right_y = rtm::vector_load(&rights[1][i]);
+    rtm::vector4f right_z = rtm::vector_load(&rights[2][i]);
+    rtm::vector4f right_w = rtm::vector_load(&rights[3][i]);
+
+    rtm::vector4f cos_angle = rtm::vector_mul(left_x, right_x);
+    cos_angle = rtm::vector_mul_add(left_y, right_y, cos_angle);
+    cos_angle = rtm::vector_mul_add(left_z, right_z, cos_angle);
+    cos_angle = rtm::vector_mul_add(left_w, right_w, cos_angle);
+
+    const rtm::mask4f is_angle_negative = rtm::vector_less_than(cos_angle, zero);
+    right_x = rtm::vector_select(is_angle_negative, rtm::vector_neg(right_x), right_x);
+    right_y = rtm::vector_select(is_angle_negative, rtm::vector_neg(right_y), right_y);
+    right_z = rtm::vector_select(is_angle_negative, rtm::vector_neg(right_z), right_z);
+    right_w = rtm::vector_select(is_angle_negative, rtm::vector_neg(right_w), right_w);
+    cos_angle = rtm::vector_min(rtm::vector_abs(cos_angle), one);
+
+    // Normalized lerp weights, used as is when all rotations are close,
+    // which is the most common case for densely sampled clips
+    rtm::vector4f k0 = rtm::vector_sub(one, coeffs);
+    rtm::vector4f k1 = coeffs;
+
+    if (rtm::vector_any_less_than(cos_angle, slerp_threshold)) {
+      const rtm::vector4f angle = rtm::vector_acos(cos_angle);
+      const rtm::vector4f sin_angle_inversed = rtm::vector_div(one, rtm::vector_sin(angle));
+      const rtm::vector4f k0_slerp =
+          rtm::vector_mul(rtm::vector_sin(rtm::vector_mul(k0, angle)), sin_angle_inversed);
+      const rtm::vector4f k1_slerp =
+          rtm::vector_mul(rtm::vector_sin(rtm::vector_mul(k1, angle)), sin_angle_inversed);
+
+      const rtm::mask4f is_slerp = rtm::vector_less_than(cos_angle, slerp_threshold);
+      k0 = rtm::vector_select(is_slerp, k0_slerp, k0);
+      k1 = rtm::vector_select(is_slerp, k1_slerp, k1);
+    }
+
+    rtm::vector4f x = rtm::vector_mul_add(right_x, k1, rtm::vector_mul(left_x, k0));
+    rtm::vector4f y = rtm::vector_mul_add(right_y, k1, rtm::vector_mul(left_y, k0));
+    rtm::vector4f z = rtm::vector_mul_add(right_z, k1, rtm::vector_mul(left_z, k0));
+    rtm::vector4f w = rtm::vector_mul_add(right_w, k1, rtm::vector_mul(left_w, k0));
+
+    rtm::vector4f length_squared = rtm::vector_mul(x, x);
+    length_squared = rtm::vector_mul_add(y, y, length_squared);
+    length_squared = rtm::vector_mul_add(z, z, length_squared);
+    length_squared = rtm::vector_mul_add(w, w, length_squared);
+    const rtm::vector4f length_inversed =
+        rtm::vector_div(one, rtm::vector_sqrt(length_squared));
+
+    rtm::vector_store(rtm::vector_mul(x, length_inversed), &results[0][i]);
+    rtm::vector_store(rtm::vector_mul(y, length_inversed), &results[1][i]);
+    rtm::vector_store(rtm::vector_mul(z, length_inversed), &results[2][i]);
+    rtm::vector_store(rtm::vector_mul(w, length_inversed), &results[3][i]);
   }
 }
 
 void cursor_calculate_pose(const cursor& cursor, const float time_s, skeleton_pose& out_pose)
 {
-  // Go over all components and set each one.
-  // Even though it means we're moving across transforms array up to 3 times,
-  // in practices we're dealing with rotations most of the times,
-  // and very small number of translations and scales.
+  // First calculate all components of the same type at once with SIMD,
+  // then go over animated joints in skeleton order and write them into a pose.
+  // Each slot knows where its components are, so no searching is involved,
+  // and pose's transforms are traversed only once.
+
+  cursor_components_calculate(cursor.translations, time_s);
+  cursor_components_calculate(cursor.rotations, time_s);
+  cursor_components_calculate(cursor.scales, time_s);
+
+  const auto& translations{cursor.translations.results};
+  const auto& rotations{cursor.rotations.results};
+  const auto& scales{cursor.scales.results};
 
   out_pose.sequence_start(cursor.shallow_joint_index);
 
-  for (const auto& rotation_component : cursor.rotations) {
-    const quaternion rotation{cursor_component_calculate(rotation_component, time_s)};
-    out_pose.sequence_set_rotation_joint_space(rotation_component.joint_index, rotation);
-  }
+  for (const cursor_slot& slot : cursor.slots) {
+    if (slot.translation_index >= 0) {
+      const gsl::index index{slot.translation_index};
+      out_pose.sequence_set_translation_joint_space(
+          slot.joint_index,
+          float3{translations[0][index], translations[1][index], translations[2][index]});
+    }
 
-  for (const auto& translation_component : cursor.translations) {
-    const float3 translation{cursor_component_calculate(translation_component, time_s)};
-    out_pose.sequence_set_translation_joint_space(translation_component.joint_index, translation);
-  }
+    if (slot.rotation_index >= 0) {
+      const gsl::index index{slot.rotation_index};
+      out_pose.sequence_set_rotation_joint_space(
+          slot.joint_index, quaternion{rotations[0][index], rotations[1][index],
+                                       rotations[2][index], rotations[3][index]});
+    }
 
-  for (const auto& scale_component : cursor.scales) {
-    const float3 scale{cursor_component_calculate(scale_component, time_s)};
-    out_pose.sequence_set_scale_joint_space(scale_component.joint_index, scale);
+    if (slot.scale_index >= 0) {
+      const gsl::index index{slot.scale_index};
+      out_pose.sequence_set_scale_joint_space(
+          slot.joint_index, float3{scales[0][index], scales[1][index], scales[2][index]});
+    }
   }
 }
 }  // namespace eely::internal
\ No newline at end of file
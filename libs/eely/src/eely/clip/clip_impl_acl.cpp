@@ -16,21 +16,116 @@
 #include <gsl/narrow>
 #include <gsl/util>
 
+#include <cstring>
 #include <malloc.h>
 #include <memory>
+#include <optional>
 #include <span>
+#include <utility>
 #include <vector>
 
 namespace eely::internal {
-std::unique_ptr<uint8_t, decltype(&aligned_free)> acl_allocate_compressed_tracks_storage(
-    const size_t size)
+std::unique_ptr<uint8_t, decltype(&aligned_free)> acl_allocate_storage(const size_t size,
+                                                                        const size_t alignment)
 {
-  const size_t alignment{alignof(acl::compressed_tracks)};
   const size_t aligned_size{align_size_to({.alignment = alignment, .size = size})};
 
   return {static_cast<uint8_t*>(aligned_alloc(alignment, aligned_size)), aligned_free};
 }
 
+std::unique_ptr<uint8_t, decltype(&aligned_free)> acl_allocate_compressed_tracks_storage(
+    const size_t size)
+{
+  return acl_allocate_storage(size, alignof(acl::compressed_tracks));
+}
+
+static acl::quality_tier acl_quality_tier(const clip_streaming_tier tier)
+{
+  return tier == clip_streaming_tier::medium ? acl::quality_tier::medium_importance
+                                             : acl::quality_tier::lowest_importance;
+}
+
+acl_database_streamer::acl_database_streamer(std::vector<uint8_t> bulk_data)
+    : acl::database_streamer{&_request, 1},
+      _size{bulk_data.size()},
+      _bulk_data{std::move(bulk_data)}
+{
+}
+
+acl_database_streamer::acl_database_streamer(const project_data_reader& reader,
+                                             const size_t offset,
+                                             const size_t size)
+    : acl::database_streamer{&_request, 1}, _reader{&reader}, _offset{offset}, _size{size}
+{
+}
+
+acl_database_streamer::~acl_database_streamer() = default;
+
+bool acl_database_streamer::is_initialized() const
+{
+  return true;
+}
+
+const uint8_t* acl_database_streamer::get_bulk_data(const acl::quality_tier /*tier*/) const
+{
+  return _bulk_data.empty() ? nullptr : _bulk_data.data();
+}
+
+void acl_database_streamer::stream_in(const uint32_t offset,
+                                      const uint32_t size,
+                                      const bool can_allocate_bulk_data,
+                                      const acl::quality_tier /*tier*/,
+                                      const acl::streaming_request_id request_id)
+{
+  EXPECTS(offset + size <= _size);
+
+  if (_reader != nullptr) {
+    if (can_allocate_bulk_data) {
+      _bulk_data.resize(_size);
+    }
+
+    (*_reader)(_offset + offset,
+               std::as_writable_bytes(std::span{_bulk_data}.subspan(offset, size)));
+  }
+
+  complete(request_id);
+}
+
+void acl_database_streamer::stream_out(const uint32_t /*offset*/,
+                                       const uint32_t /*size*/,
+                                       const bool can_deallocate_bulk_data,
+                                       const acl::quality_tier /*tier*/,
+                                       const acl::streaming_request_id request_id)
+{
+  // Resident data is kept, since it cannot be read again
+  if (_reader != nullptr && can_deallocate_bulk_data) {
+    _bulk_data = {};
+  }
+
+  complete(request_id);
+}
+
+size_t acl_database_streamer::get_size() const
+{
+  return _size;
+}
+
+size_t acl_database_streamer::get_resident_size() const
+{
+  return _bulk_data.size();
+}
+
+std::vector<uint8_t> acl_database_streamer::copy_bulk_data() const
+{
+  if (_reader == nullptr || !_bulk_data.empty()) {
+    return _bulk_data;
+  }
+
+  std::vector<uint8_t> result(_size);
+  (*_reader)(_offset, std::as_writable_bytes(std::span{result}));
+  return result;
+}
+
 // ACL needs equal number of samples for every track in a clip.
 // Uncooked data only contains keys that are authored,
 // thus we need to sample the clip at required rate and pass results to ACL.
@@ -42,6 +137,8 @@ std::unique_ptr<uint8_t, decltype(&std::free)> acl_compress(
     const float duration_s,
     const std::vector<clip_uncooked_track>& tracks,
     const skeleton& skeleton,
+    const bool enable_database_support,
+    const bool optimize_loops,
     acl::iallocator& acl_allocator)
 {
   using namespace acl;
@@ -150,6 +247,10 @@ std::unique_ptr<uint8_t, decltype(&std::free)> acl_compress(
 
   qvvf_transform_error_metric error_metric;
   settings.error_metric = &error_metric;
+  settings.enable_database_support = enable_database_support;
+
+  // Drop last sample if it matches the first one, played clip will wrap to the first sample
+  settings.optimize_loops = optimize_loops;
 
   output_stats stats;
 
@@ -166,7 +267,7 @@ std::unique_ptr<uint8_t, decltype(&std::free)> acl_compress(
   return storage;
 }
 
-clip_impl_acl::clip_impl_acl(bit_reader& reader)
+clip_impl_acl::clip_impl_acl(bit_reader& reader, const project_data_reader& tiers_reader)
 {
   // Metadata
 
@@ -186,20 +287,65 @@ clip_impl_acl::clip_impl_acl(bit_reader& reader)
 
   std::span<uint8_t> data_span{_acl_compressed_tracks_storage.get(),
                                gsl::narrow<size_t>(data_size)};
-  for (gsl::index i{0}; i < data_size; ++i) {
-    data_span[i] = bit_reader_read<uint8_t>(reader);
-  }
+  reader.align();
+  reader.read_bytes(std::as_writable_bytes(data_span));
 
   acl::error_result error_result;
   _acl_compressed_tracks = acl::make_compressed_tracks(data_span.data(), &error_result);
   EXPECTS(error_result.empty());
   EXPECTS(_acl_compressed_tracks != nullptr);
+
+  // Database
+
+  if (bit_reader_read<bool>(reader)) {
+    const gsl::index database_size{bit_reader_read<gsl::index>(reader, 32)};
+    _acl_compressed_database_storage =
+        acl_allocate_storage(database_size, alignof(acl::compressed_database));
+
+    std::span<uint8_t> database_span{_acl_compressed_database_storage.get(),
+                                     gsl::narrow<size_t>(database_size)};
+    reader.align();
+    reader.read_bytes(std::as_writable_bytes(database_span));
+
+    // Tiers are either read on demand at their offsets in cooked data, or copied right away
+
+    for (std::unique_ptr<acl_database_streamer>* streamer :
+         {&_acl_streamer_medium, &_acl_streamer_low}) {
+      const gsl::index bulk_data_size{bit_reader_read<gsl::index>(reader, 32)};
+      reader.align();
+
+      if (tiers_reader) {
+        *streamer = std::make_unique<acl_database_streamer>(
+            tiers_reader, gsl::narrow<size_t>(bit_reader_get_bytes_read(reader)),
+            gsl::narrow<size_t>(bulk_data_size));
+        reader.skip_bytes(bulk_data_size);
+      }
+      else {
+        std::vector<uint8_t> bulk_data(gsl::narrow<size_t>(bulk_data_size));
+        reader.read_bytes(std::as_writable_bytes(std::span{bulk_data}));
+        *streamer = std::make_unique<acl_database_streamer>(std::move(bulk_data));
+      }
+    }
+
+    _acl_compressed_database = acl::make_compressed_database(database_span.data(), &error_result);
+    EXPECTS(error_result.empty());
+    EXPECTS(_acl_compressed_database != nullptr);
+
+    database_init();
+
+    if (!tiers_reader) {
+      stream_in(clip_streaming_tier::medium);
+      stream_in(clip_streaming_tier::low);
+    }
+  }
 }
 
 clip_impl_acl::clip_impl_acl(const float duration_s,
                              const std::vector<clip_uncooked_track>& tracks,
                              const bool is_additive,
-                             const skeleton& skeleton)
+                             const skeleton& skeleton,
+                             const std::optional<clip_acl_database_settings>& database_settings,
+                             const bool optimize_loops)
 {
   _metadata.duration_s = duration_s;
   _metadata.is_additive = is_additive;
@@ -214,13 +360,73 @@ clip_impl_acl::clip_impl_acl(const float duration_s,
         std::min(_metadata.shallow_joint_index, joint_index_opt.value());
   }
 
-  _acl_compressed_tracks_storage = acl_compress(duration_s, tracks, skeleton, _acl_allocator);
+  _acl_compressed_tracks_storage =
+      acl_compress(duration_s, tracks, skeleton, database_settings.has_value(), optimize_loops,
+                   _acl_allocator);
 
   acl::error_result error_result;
   _acl_compressed_tracks =
       acl::make_compressed_tracks(_acl_compressed_tracks_storage.get(), &error_result);
   EXPECTS(error_result.empty());
   EXPECTS(_acl_compressed_tracks != nullptr);
+
+  if (!database_settings.has_value()) {
+    return;
+  }
+
+  // Split keys between compressed tracks, that keep only the most important ones,
+  // and a database, with bulk data of its tiers stored separately
+
+  acl::compression_database_settings acl_database_settings;
+  acl_database_settings.medium_importance_tier_proportion =
+      database_settings->medium_tier_proportion;
+  acl_database_settings.low_importance_tier_proportion = database_settings->low_tier_proportion;
+
+  acl::compressed_tracks* acl_database_tracks{nullptr};
+  acl::compressed_database* acl_database{nullptr};
+  error_result = acl::build_database(_acl_allocator, acl_database_settings, &_acl_compressed_tracks,
+                                     1, &acl_database_tracks, acl_database);
+  EXPECTS(error_result.empty());
+
+  acl::compressed_database* acl_split_database{nullptr};
+  uint8_t* acl_bulk_data_medium{nullptr};
+  uint8_t* acl_bulk_data_low{nullptr};
+  error_result = acl::split_database_bulk_data(_acl_allocator, *acl_database, acl_split_database,
+                                               acl_bulk_data_medium, acl_bulk_data_low);
+  EXPECTS(error_result.empty());
+
+  _acl_compressed_tracks_storage = acl_allocate_compressed_tracks_storage(
+      acl_database_tracks->get_size());
+  memcpy(_acl_compressed_tracks_storage.get(), acl_database_tracks,
+         acl_database_tracks->get_size());
+  _acl_compressed_tracks = acl::make_compressed_tracks(_acl_compressed_tracks_storage.get());
+
+  _acl_compressed_database_storage =
+      acl_allocate_storage(acl_split_database->get_size(), alignof(acl::compressed_database));
+  memcpy(_acl_compressed_database_storage.get(), acl_split_database,
+         acl_split_database->get_size());
+  _acl_compressed_database =
+      acl::make_compressed_database(_acl_compressed_database_storage.get());
+
+  const uint32_t bulk_data_medium_size{
+      acl_split_database->get_bulk_data_size(acl::quality_tier::medium_importance)};
+  const uint32_t bulk_data_low_size{
+      acl_split_database->get_bulk_data_size(acl::quality_tier::lowest_importance)};
+  _acl_streamer_medium = std::make_unique<acl_database_streamer>(
+      std::vector<uint8_t>(acl_bulk_data_medium, acl_bulk_data_medium + bulk_data_medium_size));
+  _acl_streamer_low = std::make_unique<acl_database_streamer>(
+      std::vector<uint8_t>(acl_bulk_data_low, acl_bulk_data_low + bulk_data_low_size));
+
+  acl::deallocate_type_array(_acl_allocator, acl_bulk_data_medium, bulk_data_medium_size);
+  acl::deallocate_type_array(_acl_allocator, acl_bulk_data_low, bulk_data_low_size);
+  _acl_allocator.deallocate(acl_split_database, acl_split_database->get_size());
+  _acl_allocator.deallocate(acl_database, acl_database->get_size());
+  _acl_allocator.deallocate(acl_database_tracks, acl_database_tracks->get_size());
+
+  database_init();
+
+  stream_in(clip_streaming_tier::medium);
+  stream_in(clip_streaming_tier::low);
 }
 
 void clip_impl_acl::serialize(bit_writer& writer) const
@@ -236,10 +442,29 @@ void clip_impl_acl::serialize(bit_writer& writer) const
 
   bit_writer_write(writer, _acl_compressed_tracks->get_size());
 
-  std::span<uint8_t> data_span{_acl_compressed_tracks_storage.get(),
-                               _acl_compressed_tracks->get_size()};
-  for (gsl::index i{0}; i < _acl_compressed_tracks->get_size(); ++i) {
-    bit_writer_write(writer, data_span[i]);
+  std::span<const uint8_t> data_span{_acl_compressed_tracks_storage.get(),
+                                     _acl_compressed_tracks->get_size()};
+  writer.align();
+  writer.write_bytes(std::as_bytes(data_span));
+
+  // Database
+
+  bit_writer_write(writer, _acl_compressed_database != nullptr);
+  if (_acl_compressed_database != nullptr) {
+    bit_writer_write(writer, _acl_compressed_database->get_size());
+
+    std::span<const uint8_t> database_span{_acl_compressed_database_storage.get(),
+                                           _acl_compressed_database->get_size()};
+    writer.align();
+    writer.write_bytes(std::as_bytes(database_span));
+
+    for (const acl_database_streamer* streamer :
+         {_acl_streamer_medium.get(), _acl_streamer_low.get()}) {
+      const std::vector<uint8_t> bulk_data{streamer->copy_bulk_data()};
+      bit_writer_write(writer, bulk_data.size(), 32);
+      writer.align();
+      writer.write_bytes(std::as_bytes(std::span{bulk_data}));
+    }
   }
 }
 
@@ -250,6 +475,59 @@ const clip_metadata_base* clip_impl_acl::get_metadata() const
 
 std::unique_ptr<clip_player_base> clip_impl_acl::create_player() const
 {
-  return std::make_unique<clip_player_acl>(_metadata, *_acl_compressed_tracks);
+  return std::make_unique<clip_player_acl>(
+      _metadata, *_acl_compressed_tracks,
+      _acl_compressed_database != nullptr ? &_acl_database_context : nullptr);
+}
+
+size_t clip_impl_acl::get_streaming_tier_size(const clip_streaming_tier tier) const
+{
+  return _acl_compressed_database != nullptr ? get_streamer(tier).get_size() : 0;
+}
+
+size_t clip_impl_acl::get_streaming_tier_resident_size(const clip_streaming_tier tier) const
+{
+  return _acl_compressed_database != nullptr ? get_streamer(tier).get_resident_size() : 0;
+}
+
+bool clip_impl_acl::is_streamed_in(const clip_streaming_tier tier) const
+{
+  return get_streaming_tier_size(tier) > 0 &&
+         _acl_database_context.is_streamed_in(acl_quality_tier(tier));
+}
+
+void clip_impl_acl::stream_in(const clip_streaming_tier tier)
+{
+  if (get_streaming_tier_size(tier) == 0 || is_streamed_in(tier)) {
+    return;
+  }
+
+  // Streamer completes requests synchronously
+  _acl_database_context.stream_in(acl_quality_tier(tier));
+  EXPECTS(is_streamed_in(tier));
+}
+
+void clip_impl_acl::stream_out(const clip_streaming_tier tier)
+{
+  if (!is_streamed_in(tier)) {
+    return;
+  }
+
+  // Streamer completes requests synchronously
+  _acl_database_context.stream_out(acl_quality_tier(tier));
+  EXPECTS(!is_streamed_in(tier));
+}
+
+void clip_impl_acl::database_init()
+{
+  [[maybe_unused]] const bool init_result{_acl_database_context.initialize(
+      _acl_allocator, *_acl_compressed_database, *_acl_streamer_medium, *_acl_streamer_low)};
+  EXPECTS(init_result);
+}
+
+acl_database_streamer& clip_impl_acl::get_streamer(const clip_streaming_tier tier) const
+{
+  EXPECTS(_acl_streamer_medium != nullptr && _acl_streamer_low != nullptr);
+  return tier == clip_streaming_tier::medium ? *_acl_streamer_medium : *_acl_streamer_low;
 }
 }  // namespace eely::internal
\ No newline at end of file
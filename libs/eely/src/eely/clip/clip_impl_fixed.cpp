@@ -5,6 +5,7 @@
 #include "eely/clip/clip_cooking_none_fixed.h"
 #include "eely/clip/clip_player_fixed.h"
 #include "eely/clip/clip_utils.h"
+#include "eely/math/math_utils.h"
 #include "eely/math/quantization.h"
 #include "eely/math/transform.h"
 #include "eely/skeleton/skeleton_utils.h"
@@ -12,7 +13,9 @@
 #include <gsl/narrow>
 #include <gsl/util>
 
+#include <algorithm>
 #include <memory>
+#include <span>
 #include <vector>
 
 namespace eely::internal {
@@ -80,8 +83,11 @@ static void write_cooked_key(const cooked_key& key,
   if (key.joint_index_changed) {
     flags_and_joint_index |= compression_key_flags::has_joint_index;
 
+    // Joint is written as a slot index, so that player can find its cursors without searching
     static_assert(bits_joints_count <= 11);
-    flags_and_joint_index |= (key.joint_index << 5);
+    const gsl::index slot_index{
+        joint_components_get_slot_index(metadata.joints_components, key.joint_index)};
+    flags_and_joint_index |= (slot_index << 5);
   }
 
   if (key.time_s.has_value()) {
@@ -176,6 +182,41 @@ static void write_cooked_key(const cooked_key& key,
   }
 }
 
+static float range_scale_calculate(const float range_length)
+{
+  return float_near(range_length, 0.0F) ? 0.0F : range_length / 65535.0F;
+}
+
+static void metadata_update_dequantization(clip_metadata_fixed& metadata)
+{
+  metadata.time_scale = range_scale_calculate(metadata.duration_s);
+
+  metadata.slots_dequantization.clear();
+  metadata.slots_dequantization.reserve(metadata.joints_components.size());
+  for (const joint_components& j : metadata.joints_components) {
+    const auto range_iter{std::find_if(
+        metadata.joints_ranges.begin(), metadata.joints_ranges.end(),
+        [&j](const joint_range& range) { return range.joint_index == j.joint_index; })};
+
+    joint_dequantization& dequantization{metadata.slots_dequantization.emplace_back()};
+    if (range_iter == metadata.joints_ranges.end()) {
+      continue;
+    }
+
+    const float translation_from{range_iter->range_translation_from};
+    const float translation_scale{range_scale_calculate(range_iter->range_translation_length)};
+    const float scale_from{range_iter->range_scale_from};
+    const float scale_scale{range_scale_calculate(range_iter->range_scale_length)};
+
+    dequantization.translation_range_from = {translation_from, translation_from,
+                                             translation_from, 0.0F};
+    dequantization.translation_range_scale = {translation_scale, translation_scale,
+                                              translation_scale, 0.0F};
+    dequantization.scale_range_from = {scale_from, scale_from, scale_from, 0.0F};
+    dequantization.scale_range_scale = {scale_scale, scale_scale, scale_scale, 0.0F};
+  }
+}
+
 clip_impl_fixed::clip_impl_fixed(bit_reader& reader)
 {
   // Metadata
@@ -216,9 +257,10 @@ clip_impl_fixed::clip_impl_fixed(bit_reader& reader)
   EXPECTS(data_size > 0);
 
   _data.resize(data_size);
-  for (gsl::index i{0}; i < data_size; ++i) {
-    _data[i] = bit_reader_read<uint16_t>(reader);
-  }
+  reader.align();
+  reader.read_bytes(std::as_writable_bytes(std::span{_data}));
+
+  metadata_update_dequantization(_metadata);
 }
 
 clip_impl_fixed::clip_impl_fixed(const float duration_s,
@@ -236,6 +278,7 @@ clip_impl_fixed::clip_impl_fixed(const float duration_s,
   _metadata.is_additive = is_additive;
   joint_components_collect(reduced_tracks, skeleton, _metadata.joints_components);
   joints_ranges_collect(tracks, skeleton, _metadata.joints_ranges);
+  metadata_update_dequantization(_metadata);
 
   // Data
 
@@ -269,9 +312,8 @@ void clip_impl_fixed::serialize(bit_writer& writer) const
   // Data
 
   bit_writer_write(writer, _data.size(), 32);
-  for (uint16_t d : _data) {
-    bit_writer_write(writer, d);
-  }
+  writer.align();
+  writer.write_bytes(std::as_bytes(std::span{_data}));
 }
 
 const clip_metadata_base* clip_impl_fixed::get_metadata() const
@@ -12,10 +12,13 @@
 #include <gsl/narrow>
 
 #include <memory>
+#include <span>
 #include <vector>
 
 namespace eely::internal {
-static void write_cooked_key(const cooked_key& key, std::vector<uint32_t>& data)
+static void write_cooked_key(const cooked_key& key,
+                             const clip_metadata_none& metadata,
+                             std::vector<uint32_t>& data)
 {
   uint32_t flags_and_joint_index{0};
   std::optional<uint32_t> time_s;
@@ -26,8 +29,10 @@ static void write_cooked_key(const cooked_key& key, std::vector<uint32_t>& data)
   if (key.joint_index_changed) {
     flags_and_joint_index |= compression_key_flags::has_joint_index;
 
-    const uint32_t joint_index{gsl::narrow<uint32_t>(key.joint_index)};
-    flags_and_joint_index |= (joint_index << 21);  // 21 for joint index to occupy last 11 bits
+    // Joint is written as a slot index, so that player can find its cursors without searching
+    const uint32_t slot_index{gsl::narrow<uint32_t>(
+        joint_components_get_slot_index(metadata.joints_components, key.joint_index))};
+    flags_and_joint_index |= (slot_index << 21);  // 21 for slot index to occupy last 11 bits
   }
 
   if (key.time_s.has_value()) {
@@ -106,9 +111,8 @@ clip_impl_none::clip_impl_none(bit_reader& reader)
   EXPECTS(data_size > 0);
 
   _data.resize(data_size);
-  for (gsl::index i{0}; i < data_size; ++i) {
-    _data[i] = bit_reader_read<uint32_t>(reader);
-  }
+  reader.align();
+  reader.read_bytes(std::as_writable_bytes(std::span{_data}));
 }
 
 clip_impl_none::clip_impl_none(const float duration_s,
@@ -128,7 +132,7 @@ clip_impl_none::clip_impl_none(const float duration_s,
 
   // Data
 
-  const auto writer = [this](const cooked_key& key) { write_cooked_key(key, _data); };
+  const auto writer = [this](const cooked_key& key) { write_cooked_key(key, _metadata, _data); };
   clip_cook(reduced_tracks, skeleton, writer);
 }
 
@@ -148,9 +152,8 @@ void clip_impl_none::serialize(bit_writer& writer) const
   // Data
 
   bit_writer_write(writer, _data.size(), 32);
-  for (uint32_t d : _data) {
-    bit_writer_write(writer, d);
-  }
+  writer.align();
+  writer.write_bytes(std::as_bytes(std::span{_data}));
 }
 
 const clip_metadata_base* clip_impl_none::get_metadata() const
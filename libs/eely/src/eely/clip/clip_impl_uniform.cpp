@@ -0,0 +1,316 @@
+#include "eely/clip/clip_impl_uniform.h"
+
+#include "eely/base/assert.h"
+#include "eely/base/base_utils.h"
+#include "eely/base/bit_reader.h"
+#include "eely/base/bit_writer.h"
+#include "eely/clip/clip_cooking_none_fixed.h"
+#include "eely/clip/clip_cursor.h"
+#include "eely/clip/clip_player_uniform.h"
+#include "eely/clip/clip_utils.h"
+#include "eely/math/math_utils.h"
+#include "eely/math/quaternion.h"
+#include "eely/math/transform.h"
+#include "eely/skeleton/skeleton_utils.h"
+
+#include <gsl/narrow>
+#include <gsl/util>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace eely::internal {
+// Values of a single component sampled across all frames.
+// Translations and scales use only first three elements.
+using component_samples = std::vector<std::array<float, 4>>;
+
+static gsl::index get_component_size(const transform_components component)
+{
+  return component == transform_components::rotation ? 4 : 3;
+}
+
+template <transform_components TComponent>
+static void sample_component(const clip_track_columnar& track,
+                             const auto& default_value,
+                             const float duration_s,
+                             const gsl::index frames_count,
+                             component_samples& out_samples)
+{
+  out_samples.resize(frames_count);
+
+  const auto& keys{clip_track_columnar_get_keys<TComponent>(track)};
+
+  // Hold first key's value before it, same as other schemes do
+  const float first_key_time_s{keys.times.empty() ? 0.0F : keys.times.front()};
+
+  gsl::index cursor{0};
+
+  for (gsl::index f{0}; f < frames_count; ++f) {
+    // Sample exactly at the clip's duration for the last frame,
+    // regular sampling with `clip_sample_track` cannot guarantee that
+    const float frame_time_s{frames_count > 1 ? duration_s * static_cast<float>(f) /
+                                                    static_cast<float>(frames_count - 1)
+                                              : 0.0F};
+    const float time_s{std::max(frame_time_s, first_key_time_s)};
+
+    const auto value{clip_sample_component_keys(keys, default_value, time_s, cursor)};
+
+    if constexpr (TComponent == transform_components::rotation) {
+      out_samples[f] = {value.x, value.y, value.z, value.w};
+
+      // Keep neighbouring quaternions in the same hemisphere,
+      // so that lerping between frames takes the shortest path
+      if (f > 0) {
+        const std::array<float, 4>& prev{out_samples[f - 1]};
+        std::array<float, 4>& curr{out_samples[f]};
+
+        const float dot{prev[0] * curr[0] + prev[1] * curr[1] + prev[2] * curr[2] +
+                        prev[3] * curr[3]};
+        if (dot < 0.0F) {
+          std::transform(curr.begin(), curr.end(), curr.begin(), [](float v) { return -v; });
+        }
+      }
+    }
+    else {
+      out_samples[f] = {value.x, value.y, value.z, 0.0F};
+    }
+  }
+}
+
+static void calculate_range(const component_samples& samples,
+                            const gsl::index size,
+                            clip_track_uniform& out_track)
+{
+  std::array<float, 4> range_from;
+  std::array<float, 4> range_to;
+  range_from.fill(std::numeric_limits<float>::max());
+  range_to.fill(std::numeric_limits<float>::lowest());
+
+  for (const std::array<float, 4>& sample : samples) {
+    for (gsl::index i{0}; i < size; ++i) {
+      range_from[i] = std::min(range_from[i], sample[i]);
+      range_to[i] = std::max(range_to[i], sample[i]);
+    }
+  }
+
+  std::array<float, 4> range_scale{};
+  for (gsl::index i{0}; i < size; ++i) {
+    const float range_length{range_to[i] - range_from[i]};
+    range_scale[i] = float_near(range_length, 0.0F) ? 0.0F : range_length / 65535.0F;
+  }
+
+  if (size < 4) {
+    range_from[3] = 0.0F;
+  }
+
+  out_track.range_from = {range_from[0], range_from[1], range_from[2], range_from[3]};
+  out_track.range_scale = {range_scale[0], range_scale[1], range_scale[2], range_scale[3]};
+}
+
+static uint16_t quantize(const float value, const float range_from, const float range_scale)
+{
+  if (range_scale == 0.0F) {
+    return 0;
+  }
+
+  // Round to nearest instead of truncating, error is halved this way
+  const long data{std::lround((value - range_from) / range_scale)};
+  return gsl::narrow_cast<uint16_t>(std::clamp(data, 0L, 65535L));
+}
+
+static void metadata_update_frame_size(clip_metadata_uniform& metadata)
+{
+  metadata.frame_size = 0;
+  for (const clip_track_uniform& track : metadata.tracks) {
+    metadata.frame_size += get_component_size(track.component);
+  }
+}
+
+clip_impl_uniform::clip_impl_uniform(bit_reader& reader)
+{
+  // Metadata
+
+  _metadata.duration_s = bit_reader_read<float>(reader);
+  EXPECTS(_metadata.duration_s >= 0.0F);
+
+  _metadata.is_additive = bit_reader_read<bool>(reader);
+
+  _metadata.frames_count = bit_reader_read<gsl::index>(reader, 32);
+  EXPECTS(_metadata.frames_count > 0);
+
+  const auto tracks_count{bit_reader_read<gsl::index>(reader, 16)};
+  _metadata.tracks.resize(tracks_count);
+  for (gsl::index i{0}; i < tracks_count; ++i) {
+    clip_track_uniform& track{_metadata.tracks[i]};
+
+    track.joint_index = bit_reader_read<gsl::index>(reader, bits_joints_count);
+    track.component = static_cast<transform_components>(
+        bit_reader_read<int>(reader, bits_transform_components));
+
+    track.range_from.x = bit_reader_read<float>(reader);
+    track.range_from.y = bit_reader_read<float>(reader);
+    track.range_from.z = bit_reader_read<float>(reader);
+    track.range_from.w = bit_reader_read<float>(reader);
+    track.range_scale.x = bit_reader_read<float>(reader);
+    track.range_scale.y = bit_reader_read<float>(reader);
+    track.range_scale.z = bit_reader_read<float>(reader);
+    track.range_scale.w = bit_reader_read<float>(reader);
+  }
+
+  metadata_update_frame_size(_metadata);
+
+  // Data
+
+  const auto data_size{bit_reader_read<gsl::index>(reader, 32)};
+  EXPECTS(data_size > 0);
+
+  _data.resize(data_size);
+  reader.align();
+  reader.read_bytes(std::as_writable_bytes(std::span{_data}));
+}
+
+clip_impl_uniform::clip_impl_uniform(const float duration_s,
+                                     const std::vector<clip_uncooked_track>& tracks,
+                                     const bool is_additive,
+                                     const skeleton& skeleton)
+{
+  std::vector<clip_uncooked_track> reduced_tracks{remove_rest_pose_keys(tracks, skeleton)};
+
+  std::vector<joint_components> joints_components;
+  joint_components_collect(reduced_tracks, skeleton, joints_components);
+
+  // Metadata
+
+  _metadata.duration_s = duration_s;
+  _metadata.is_additive = is_additive;
+  _metadata.frames_count =
+      gsl::narrow<gsl::index>(std::ceil(duration_s * clip_uniform_sample_rate)) + 1;
+
+  // Sample every animated component,
+  // tracks are ordered by joint index and then by component
+
+  std::vector<component_samples> samples;
+
+  for (const joint_components& j : joints_components) {
+    const auto track_iter{std::find_if(
+        reduced_tracks.begin(), reduced_tracks.end(), [&skeleton, &j](const auto& track) {
+          return skeleton.get_joint_index(track.joint_id) == j.joint_index;
+        })};
+    EXPECTS(track_iter != reduced_tracks.end());
+
+    const transform& rest_pose_transform{skeleton.get_rest_pose_transforms()[j.joint_index]};
+
+    const clip_track_columnar columnar_track{clip_track_columnar_from_uncooked(*track_iter)};
+
+    for (const transform_components component :
+         {transform_components::translation, transform_components::rotation,
+          transform_components::scale}) {
+      if (!has_flag(j.components, component)) {
+        continue;
+      }
+
+      component_samples& component_samples{samples.emplace_back()};
+
+      switch (component) {
+        case transform_components::translation: {
+          sample_component<transform_components::translation>(
+              columnar_track, rest_pose_transform.translation, duration_s, _metadata.frames_count,
+              component_samples);
+        } break;
+
+        case transform_components::rotation: {
+          sample_component<transform_components::rotation>(
+              columnar_track, rest_pose_transform.rotation, duration_s, _metadata.frames_count,
+              component_samples);
+        } break;
+
+        case transform_components::scale: {
+          sample_component<transform_components::scale>(columnar_track,
+                                                        rest_pose_transform.scale, duration_s,
+                                                        _metadata.frames_count, component_samples);
+        } break;
+
+        default: {
+          EXPECTS(false);
+        } break;
+      }
+
+      clip_track_uniform& track{
+          _metadata.tracks.emplace_back(clip_track_uniform{.joint_index = j.joint_index,
+                                                           .component = component})};
+      calculate_range(component_samples, get_component_size(component), track);
+    }
+  }
+
+  metadata_update_frame_size(_metadata);
+
+  // Data, frame after frame
+
+  _data.reserve(_metadata.frames_count * _metadata.frame_size + 1);
+
+  for (gsl::index f{0}; f < _metadata.frames_count; ++f) {
+    for (gsl::index t{0}; t < std::ssize(_metadata.tracks); ++t) {
+      const clip_track_uniform& track{_metadata.tracks[t]};
+      const std::array<float, 4>& sample{samples[t][f]};
+
+      const std::array<float, 4> range_from{track.range_from.x, track.range_from.y,
+                                            track.range_from.z, track.range_from.w};
+      const std::array<float, 4> range_scale{track.range_scale.x, track.range_scale.y,
+                                             track.range_scale.z, track.range_scale.w};
+
+      for (gsl::index i{0}; i < get_component_size(track.component); ++i) {
+        _data.push_back(quantize(sample[i], range_from[i], range_scale[i]));
+      }
+    }
+  }
+
+  // Padding, so that player can always read four values at once
+  _data.push_back(0);
+}
+
+void clip_impl_uniform::serialize(bit_writer& writer) const
+{
+  // Metadata
+
+  bit_writer_write(writer, _metadata.duration_s);
+  bit_writer_write(writer, _metadata.is_additive);
+
+  bit_writer_write(writer, _metadata.frames_count, 32);
+
+  bit_writer_write(writer, _metadata.tracks.size(), 16);
+  for (const clip_track_uniform& track : _metadata.tracks) {
+    bit_writer_write(writer, track.joint_index, bits_joints_count);
+    bit_writer_write(writer, static_cast<int>(track.component), bits_transform_components);
+
+    bit_writer_write(writer, track.range_from.x);
+    bit_writer_write(writer, track.range_from.y);
+    bit_writer_write(writer, track.range_from.z);
+    bit_writer_write(writer, track.range_from.w);
+    bit_writer_write(writer, track.range_scale.x);
+    bit_writer_write(writer, track.range_scale.y);
+    bit_writer_write(writer, track.range_scale.z);
+    bit_writer_write(writer, track.range_scale.w);
+  }
+
+  // Data
+
+  bit_writer_write(writer, _data.size(), 32);
+  writer.align();
+  writer.write_bytes(std::as_bytes(std::span{_data}));
+}
+
+const clip_metadata_base* clip_impl_uniform::get_metadata() const
+{
+  return &_metadata;
+}
+
+std::unique_ptr<clip_player_base> clip_impl_uniform::create_player() const
+{
+  return std::make_unique<clip_player_uniform>(_metadata, _data);
+}
+}  // namespace eely::internal
\ No newline at end of file
@@ -1,9 +1,13 @@
 #include "eely/clip/clip_player_acl.h"
 
+#include "eely/base/profiling.h"
 #include "eely/clip/clip_impl_acl.h"
+#include "eely/clip/clip_player_base.h"
 #include "eely/skeleton/skeleton_pose.h"
 
 #include <acl/core/compressed_tracks.h>
+#include <acl/core/interpolation_utils.h>
+#include <acl/core/sample_looping_policy.h>
 #include <acl/core/track_writer.h>
 #include <acl/decompression/decompress.h>
 
@@ -46,21 +50,59 @@ struct acl_output_writer final : public acl::track_writer {
   }
 };
 
+static acl::sample_rounding_policy acl_rounding_policy(const clip_sample_rounding rounding)
+{
+  switch (rounding) {
+    case clip_sample_rounding::floor: {
+      return acl::sample_rounding_policy::floor;
+    }
+
+    case clip_sample_rounding::ceil: {
+      return acl::sample_rounding_policy::ceil;
+    }
+
+    case clip_sample_rounding::nearest: {
+      return acl::sample_rounding_policy::nearest;
+    }
+
+    default: {
+      return acl::sample_rounding_policy::none;
+    }
+  }
+}
+
+static acl::sample_looping_policy acl_looping_policy(const clip_looping_policy policy)
+{
+  return policy == clip_looping_policy::wrap ? acl::sample_looping_policy::wrap
+                                             : acl::sample_looping_policy::as_compressed;
+}
+
 clip_player_acl::clip_player_acl(const clip_metadata_acl& metadata,
-                                 const acl::compressed_tracks& acl_compressed_tracks)
+                                 const acl::compressed_tracks& acl_compressed_tracks,
+                                 const acl_database_context* acl_database_context)
     : _metadata{metadata}
 {
-  [[maybe_unused]] const bool init_result{_decompression_context.initialize(acl_compressed_tracks)};
+  [[maybe_unused]] const bool init_result{
+      acl_database_context != nullptr
+          ? _decompression_context.initialize(acl_compressed_tracks, *acl_database_context)
+          : _decompression_context.initialize(acl_compressed_tracks)};
   EXPECTS(init_result);
 }
 
 float clip_player_acl::get_duration_s()
 {
-  return _metadata.duration_s;
+  if (get_looping_policy() == clip_looping_policy::as_cooked) {
+    return _metadata.duration_s;
+  }
+
+  return _decompression_context.get_compressed_tracks()->get_duration(
+      acl_looping_policy(get_looping_policy()));
 }
 
 void clip_player_acl::play(const float time_s, skeleton_pose& out_pose)
 {
+  EELY_PROFILE_SCOPE(profiling_scope_type::clip_player, "acl");
+
   if (_metadata.is_additive) {
     out_pose.reset(skeleton_pose::type::additive);
   }
@@ -71,7 +113,8 @@ void clip_player_acl::play(const float time_s, skeleton_pose& out_pose)
   out_pose.sequence_start(_metadata.shallow_joint_index);
 
   acl_output_writer writer{.pose = &out_pose};
-  _decompression_context.seek(time_s, acl::sample_rounding_policy::none);
+  _decompression_context.set_looping_policy(acl_looping_policy(get_looping_policy()));
+  _decompression_context.seek(time_s, acl_rounding_policy(get_sample_rounding()));
   _decompression_context.decompress_tracks(writer);
 }
 }  // namespace eely::internal
\ No newline at end of file
@@ -1,6 +1,7 @@
 #include "eely/clip/clip_player_fixed.h"
 
 #include "eely/base/base_utils.h"
+#include "eely/base/profiling.h"
 #include "eely/clip/clip_cooking_none_fixed.h"
 #include "eely/clip/clip_cursor.h"
 #include "eely/clip/clip_impl_fixed.h"
@@ -11,6 +12,8 @@
 #include <gsl/narrow>
 #include <gsl/util>
 
+#include <rtm/vector4f.h>
+
 #include <cstdint>
 #include <span>
 
@@ -29,6 +32,8 @@ float clip_player_fixed::get_duration_s()
 
 void clip_player_fixed::play(const float time_s, skeleton_pose& out_pose)
 {
+  EELY_PROFILE_SCOPE(profiling_scope_type::clip_player, "fixed");
+
   using flags = compression_key_flags;
 
   if (_metadata.is_additive) {
@@ -47,13 +52,12 @@ void clip_player_fixed::play(const float time_s, skeleton_pose& out_pose)
 
   gsl::index data_pos{_cursor.last_data_pos};
 
-  gsl::index cursor_translation_index{0};
-  gsl::index cursor_rotation_index{0};
-  gsl::index cursor_scale_index{0};
-  gsl::index metadata_index{0};
-
   const gsl::index data_size{std::ssize(_data)};
 
+  // Quaternion components are quantized within [-1, 1]
+  const rtm::vector4f rotation_range_from{rtm::vector_set(-1.0F)};
+  const rtm::vector4f rotation_range_scale{rtm::vector_set(2.0F / 65535.0F)};
+
   while (data_pos < data_size) {
     const uint16_t header{_data[data_pos]};
 
@@ -66,31 +70,24 @@ void clip_player_fixed::play(const float time_s, skeleton_pose& out_pose)
     EXPECTS(has_translation || has_rotation || has_scale);
 
     if (has_joint_index) {
-      _cursor.last_data_joint_index = header >> 5;
+      _cursor.last_data_slot_index = header >> 5;
     }
 
-    cursor_component<float3>* translation{nullptr};
-    cursor_component<quaternion>* rotation{nullptr};
-    cursor_component<float3>* scale{nullptr};
+    const cursor_slot& slot{_cursor.slots[_cursor.last_data_slot_index]};
 
     bool outdated{false};
 
     if (has_translation) {
-      translation = &get_by_joint_index(_cursor.translations, cursor_translation_index,
-                                        _cursor.last_data_joint_index);
-      outdated |= cursor_component_is_outdated(*translation, time_s);
+      outdated |=
+          cursor_component_is_outdated(_cursor.translations, slot.translation_index, time_s);
     }
 
     if (has_rotation) {
-      rotation = &get_by_joint_index(_cursor.rotations, cursor_rotation_index,
-                                     _cursor.last_data_joint_index);
-      outdated |= cursor_component_is_outdated(*rotation, time_s);
+      outdated |= cursor_component_is_outdated(_cursor.rotations, slot.rotation_index, time_s);
     }
 
     if (has_scale) {
-      scale =
-          &get_by_joint_index(_cursor.scales, cursor_scale_index, _cursor.last_data_joint_index);
-      outdated |= cursor_component_is_outdated(*scale, time_s);
+      outdated |= cursor_component_is_outdated(_cursor.scales, slot.scale_index, time_s);
     }
 
     if (!outdated) {
@@ -102,62 +99,52 @@ void clip_player_fixed::play(const float time_s, skeleton_pose& out_pose)
     ++data_pos;
 
     if (has_time) {
-      _cursor.last_data_time_s = float_dequantize({.data = _data[data_pos],
-                                                   .bits_count = 16,
-                                                   .range_from = 0.0F,
-                                                   .range_length = _metadata.duration_s});
+      _cursor.last_data_time_s = static_cast<float>(_data[data_pos]) * _metadata.time_scale;
       ++data_pos;
     }
 
     if (has_translation) {
-      const joint_range& joint_metadata{get_by_joint_index(_metadata.joints_ranges, metadata_index,
-                                                           _cursor.last_data_joint_index)};
-
-      float_dequantize_params params{.bits_count = 16,
-                                     .range_from = joint_metadata.range_translation_from,
-                                     .range_length = joint_metadata.range_translation_length};
-
-      params.data = _data[data_pos + 0];
-      const float x{float_dequantize(params)};
-
-      params.data = _data[data_pos + 1];
-      const float y{float_dequantize(params)};
-
-      params.data = _data[data_pos + 2];
-      const float z{float_dequantize(params)};
+      const joint_dequantization& dequantization{
+          _metadata.slots_dequantization[_cursor.last_data_slot_index]};
 
+      const rtm::vector4f value{vector_dequantize3(
+          &_data[data_pos], rtm::vector_load(&dequantization.translation_range_from.x),
+          rtm::vector_load(&dequantization.translation_range_scale.x))};
       data_pos += 3;
 
-      cursor_component_advance(*translation, float3{x, y, z}, _cursor.last_data_time_s);
+      float3 translation;
+      rtm::vector_store3(value, &translation.x);
+
+      cursor_component_advance(_cursor.translations, slot.translation_index, translation,
+                               _cursor.last_data_time_s);
     }
 
     if (has_rotation) {
-      quaternion value{quaternion_dequantize(_data.subspan(data_pos, 4))};
+      const rtm::vector4f value{
+          vector_dequantize4(&_data[data_pos], rotation_range_from, rotation_range_scale)};
       data_pos += 4;
 
-      cursor_component_advance(*rotation, value, _cursor.last_data_time_s);
+      quaternion rotation;
+      rtm::vector_store(value, &rotation.x);
+
+      cursor_component_advance(_cursor.rotations, slot.rotation_index, rotation,
+                               _cursor.last_data_time_s);
     }
 
     if (has_scale) {
-      const joint_range& joint_metadata{get_by_joint_index(_metadata.joints_ranges, metadata_index,
-                                                           _cursor.last_data_joint_index)};
-
-      float_dequantize_params params{.bits_count = 16,
-                                     .range_from = joint_metadata.range_scale_from,
-                                     .range_length = joint_metadata.range_scale_length};
-
-      params.data = _data[data_pos + 0];
-      const float x{float_dequantize(params)};
-
-      params.data = _data[data_pos + 1];
-      const float y{float_dequantize(params)};
-
-      params.data = _data[data_pos + 2];
-      const float z{float_dequantize(params)};
+      const joint_dequantization& dequantization{
+          _metadata.slots_dequantization[_cursor.last_data_slot_index]};
 
+      const rtm::vector4f value{vector_dequantize3(
+          &_data[data_pos], rtm::vector_load(&dequantization.scale_range_from.x),
+          rtm::vector_load(&dequantization.scale_range_scale.x))};
       data_pos += 3;
 
-      cursor_component_advance(*scale, float3{x, y, z}, _cursor.last_data_time_s);
+      float3 scale;
+      rtm::vector_store3(value, &scale.x);
+
+      cursor_component_advance(_cursor.scales, slot.scale_index, scale,
+                               _cursor.last_data_time_s);
     }
   }
 
@@ -1,6 +1,7 @@
 #include "eely/clip/clip_player_none.h"
 
 #include "eely/base/base_utils.h"
+#include "eely/base/profiling.h"
 #include "eely/clip/clip_cooking_none_fixed.h"
 #include "eely/clip/clip_cursor.h"
 #include "eely/clip/clip_impl_none.h"
@@ -28,6 +29,8 @@ float clip_player_none::get_duration_s()
 
 void clip_player_none::play(const float time_s, skeleton_pose& out_pose)
 {
+  EELY_PROFILE_SCOPE(profiling_scope_type::clip_player, "none");
+
   using flags = compression_key_flags;
 
   if (_metadata.is_additive) {
@@ -46,10 +49,6 @@ void clip_player_none::play(const float time_s, skeleton_pose& out_pose)
 
   gsl::index data_pos{_cursor.last_data_pos};
 
-  gsl::index cursor_translation_index{0};
-  gsl::index cursor_rotation_index{0};
-  gsl::index cursor_scale_index{0};
-
   const gsl::index data_size{std::ssize(_data)};
 
   while (data_pos < data_size) {
@@ -64,31 +63,24 @@ void clip_player_none::play(const float time_s, skeleton_pose& out_pose)
     EXPECTS(has_translation || has_rotation || has_scale);
 
     if (has_joint_index) {
-      _cursor.last_data_joint_index = header >> 21;
+      _cursor.last_data_slot_index = header >> 21;
     }
 
-    cursor_component<float3>* translation{nullptr};
-    cursor_component<quaternion>* rotation{nullptr};
-    cursor_component<float3>* scale{nullptr};
+    const cursor_slot& slot{_cursor.slots[_cursor.last_data_slot_index]};
 
     bool outdated{false};
 
     if (has_translation) {
-      translation = &get_by_joint_index(_cursor.translations, cursor_translation_index,
-                                        _cursor.last_data_joint_index);
-      outdated |= cursor_component_is_outdated(*translation, time_s);
+      outdated |=
+          cursor_component_is_outdated(_cursor.translations, slot.translation_index, time_s);
     }
 
     if (has_rotation) {
-      rotation = &get_by_joint_index(_cursor.rotations, cursor_rotation_index,
-                                     _cursor.last_data_joint_index);
-      outdated |= cursor_component_is_outdated(*rotation, time_s);
+      outdated |= cursor_component_is_outdated(_cursor.rotations, slot.rotation_index, time_s);
     }
 
     if (has_scale) {
-      scale =
-          &get_by_joint_index(_cursor.scales, cursor_scale_index, _cursor.last_data_joint_index);
-      outdated |= cursor_component_is_outdated(*scale, time_s);
+      outdated |= cursor_component_is_outdated(_cursor.scales, slot.scale_index, time_s);
     }
 
     if (!outdated) {
@@ -109,7 +101,8 @@ void clip_player_none::play(const float time_s, skeleton_pose& out_pose)
                    bit_cast<float>(_data[data_pos + 2])};
       data_pos += 3;
 
-      cursor_component_advance(*translation, value, _cursor.last_data_time_s);
+      cursor_component_advance(_cursor.translations, slot.translation_index, value,
+                               _cursor.last_data_time_s);
     }
 
     if (has_rotation) {
@@ -117,7 +110,8 @@ void clip_player_none::play(const float time_s, skeleton_pose& out_pose)
                        bit_cast<float>(_data[data_pos + 2]), bit_cast<float>(_data[data_pos + 3])};
       data_pos += 4;
 
-      cursor_component_advance(*rotation, value, _cursor.last_data_time_s);
+      cursor_component_advance(_cursor.rotations, slot.rotation_index, value,
+                               _cursor.last_data_time_s);
     }
 
     if (has_scale) {
@@ -125,7 +119,8 @@ void clip_player_none::play(const float time_s, skeleton_pose& out_pose)
                    bit_cast<float>(_data[data_pos + 2])};
       data_pos += 3;
 
-      cursor_component_advance(*scale, value, _cursor.last_data_time_s);
+      cursor_component_advance(_cursor.scales, slot.scale_index, value,
+                               _cursor.last_data_time_s);
     }
   }
 
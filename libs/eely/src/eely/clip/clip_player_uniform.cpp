@@ -0,0 +1,135 @@
+#include "eely/clip/clip_player_uniform.h"
+
+#include "eely/base/assert.h"
+#include "eely/base/profiling.h"
+#include "eely/clip/clip_impl_uniform.h"
+#include "eely/math/float3.h"
+#include "eely/math/quantization.h"
+#include "eely/math/quaternion.h"
+#include "eely/math/transform.h"
+#include "eely/skeleton/skeleton_pose.h"
+
+#include <gsl/narrow>
+#include <gsl/util>
+
+#include <rtm/quatf.h>
+#include <rtm/vector4f.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <span>
+
+namespace eely::internal {
+clip_player_uniform::clip_player_uniform(const clip_metadata_uniform& metadata,
+                                         std::span<const uint16_t> data)
+    : _metadata(metadata), _data{data}
+{
+}
+
+float clip_player_uniform::get_duration_s()
+{
+  return _metadata.duration_s;
+}
+
+void clip_player_uniform::play(const float time_s, skeleton_pose& out_pose)
+{
+  EELY_PROFILE_SCOPE(profiling_scope_type::clip_player, "uniform");
+
+  if (_metadata.is_additive) {
+    out_pose.reset(skeleton_pose::type::additive);
+  }
+  else {
+    out_pose.reset(skeleton_pose::type::absolute);
+  }
+
+  if (_metadata.tracks.empty()) {
+    return;
+  }
+
+  // Find two frames around requested time,
+  // no state is needed since frames are placed uniformly
+
+  const gsl::index last_frame{_metadata.frames_count - 1};
+  const float time_normalized{
+      _metadata.duration_s > 0.0F ? std::clamp(time_s / _metadata.duration_s, 0.0F, 1.0F) : 0.0F};
+  const float frame_position{time_normalized * static_cast<float>(last_frame)};
+
+  gsl::index frame_left{
+      std::min(gsl::narrow_cast<gsl::index>(std::floor(frame_position)), last_frame)};
+  gsl::index frame_right{std::min(frame_left + 1, last_frame)};
+  float alpha{frame_position - static_cast<float>(frame_left)};
+
+  // With rounding only one frame is used, and it is placed on the left
+  switch (get_sample_rounding()) {
+    case clip_sample_rounding::none: {
+    } break;
+
+    case clip_sample_rounding::floor: {
+      frame_right = frame_left;
+    } break;
+
+    case clip_sample_rounding::ceil: {
+      frame_left = alpha > 0.0F ? frame_right : frame_left;
+      frame_right = frame_left;
+    } break;
+
+    case clip_sample_rounding::nearest: {
+      frame_left = alpha >= 0.5F ? frame_right : frame_left;
+      frame_right = frame_left;
+    } break;
+  }
+
+  const bool interpolate{frame_left != frame_right};
+  alpha = interpolate ? alpha : 0.0F;
+
+  const uint16_t* data_left{&_data[frame_left * _metadata.frame_size]};
+  const uint16_t* data_right{&_data[frame_right * _metadata.frame_size]};
+
+  out_pose.sequence_start(_metadata.tracks.front().joint_index);
+
+  for (const clip_track_uniform& track : _metadata.tracks) {
+    const rtm::vector4f range_from = rtm::vector_load(&track.range_from.x);
+    const rtm::vector4f range_scale = rtm::vector_load(&track.range_scale.x);
+
+    const rtm::vector4f value_left = vector_dequantize4(data_left, range_from, range_scale);
+    const rtm::vector4f value_right =
+        interpolate ? vector_dequantize4(data_right, range_from, range_scale) : value_left;
+
+    switch (track.component) {
+      case transform_components::translation: {
+        float3 translation;
+        rtm::vector_store3(rtm::vector_lerp(value_left, value_right, alpha), &translation.x);
+        out_pose.sequence_set_translation_joint_space(track.joint_index, translation);
+
+        data_left += 3;
+        data_right += 3;
+      } break;
+
+      case transform_components::rotation: {
+        quaternion rotation;
+        rtm::quat_store(rtm::quat_lerp(rtm::vector_to_quat(value_left),
+                                       rtm::vector_to_quat(value_right), alpha),
+                        &rotation.x);
+        out_pose.sequence_set_rotation_joint_space(track.joint_index, rotation);
+
+        data_left += 4;
+        data_right += 4;
+      } break;
+
+      case transform_components::scale: {
+        float3 scale;
+        rtm::vector_store3(rtm::vector_lerp(value_left, value_right, alpha), &scale.x);
+        out_pose.sequence_set_scale_joint_space(track.joint_index, scale);
+
+        data_left += 3;
+        data_right += 3;
+      } break;
+
+      default: {
+        EXPECTS(false);
+      } break;
+    }
+  }
+}
+}  // namespace eely::internal
\ No newline at end of file
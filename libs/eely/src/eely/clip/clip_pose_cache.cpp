@@ -0,0 +1,133 @@
+#include "eely/clip/clip_pose_cache.h"
+
+#include "eely/base/assert.h"
+#include "eely/clip/clip.h"
+#include "eely/clip/clip_player_base.h"
+#include "eely/skeleton/skeleton_pose.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+
+namespace eely {
+clip_pose_cache::clip_pose_cache(const float time_tolerance_s)
+{
+  set_time_tolerance_s(time_tolerance_s);
+}
+
+void clip_pose_cache::set_time_tolerance_s(const float time_tolerance_s)
+{
+  EXPECTS(time_tolerance_s > 0.0F);
+
+  _time_tolerance_s = time_tolerance_s;
+  clear();
+}
+
+float clip_pose_cache::get_time_tolerance_s() const
+{
+  return _time_tolerance_s;
+}
+
+void clip_pose_cache::clear()
+{
+  std::unique_lock lock{_mutex};
+
+  for (auto& [_, pose] : _poses) {
+    _poses_free.push_back(std::move(pose));
+  }
+
+  _poses.clear();
+}
+
+void clip_pose_cache::play(const clip& clip,
+                           clip_player_base& player,
+                           const float time_s,
+                           skeleton_pose& out_pose)
+{
+  // Player's duration depends on its looping policy,
+  // bucket time is clamped the same way player's time is
+  const float duration_s{player.get_duration_s()};
+  const auto time_bucket{static_cast<std::int64_t>(
+      std::lround(std::clamp(time_s, 0.0F, duration_s) / _time_tolerance_s))};
+  const skeleton_pose::type pose_type{clip.is_additive() ? skeleton_pose::type::additive
+                                                         : skeleton_pose::type::absolute};
+  const key key{.clip = &clip,
+                .time_bucket = time_bucket,
+                .pose_type = pose_type,
+                .sample_rounding = player.get_sample_rounding(),
+                .looping_policy = player.get_looping_policy()};
+
+  {
+    std::shared_lock lock{_mutex};
+
+    const auto iter{_poses.find(key)};
+    if (iter != _poses.end()) {
+      EXPECTS(&iter->second->get_skeleton() == &out_pose.get_skeleton());
+
+      out_pose = *iter->second;
+      ++_hits_count;
+      return;
+    }
+  }
+
+  // Decode outside of the lock, so that other players are not blocked.
+  // Several players can miss the same entry at once, in this case first one is kept
+
+  const float time_bucket_s{
+      std::clamp(static_cast<float>(time_bucket) * _time_tolerance_s, 0.0F, duration_s)};
+  player.play(time_bucket_s, out_pose);
+  ++_misses_count;
+
+  std::unique_lock lock{_mutex};
+
+  if (_poses.contains(key)) {
+    return;
+  }
+
+  std::unique_ptr<skeleton_pose> pose;
+  if (_poses_free.empty()) {
+    pose = std::make_unique<skeleton_pose>(out_pose);
+  }
+  else {
+    pose = std::move(_poses_free.back());
+    _poses_free.pop_back();
+    *pose = out_pose;
+  }
+
+  _poses.emplace(key, std::move(pose));
+}
+
+std::int64_t clip_pose_cache::get_hits_count() const
+{
+  return _hits_count;
+}
+
+std::int64_t clip_pose_cache::get_misses_count() const
+{
+  return _misses_count;
+}
+
+void clip_pose_cache::reset_counters()
+{
+  _hits_count = 0;
+  _misses_count = 0;
+}
+
+std::size_t clip_pose_cache::key_hash::operator()(const key& key) const
+{
+  std::size_t result{std::hash<const clip*>{}(key.clip)};
+  result ^= std::hash<std::int64_t>{}(key.time_bucket) + 0x9e3779b9 + (result << 6) + (result >> 2);
+  result ^= std::hash<int>{}(static_cast<int>(key.pose_type)) + 0x9e3779b9 + (result << 6) +
+            (result >> 2);
+  result ^= std::hash<int>{}(static_cast<int>(key.sample_rounding)) + 0x9e3779b9 +
+            (result << 6) + (result >> 2);
+  result ^= std::hash<int>{}(static_cast<int>(key.looping_policy)) + 0x9e3779b9 +
+            (result << 6) + (result >> 2);
+  return result;
+}
+}  // namespace eely
\ No newline at end of file
@@ -39,6 +39,15 @@ clip_uncooked::clip_uncooked(const project_uncooked& project, internal::bit_read
   _compression_scheme =
       bit_reader_read<clip_compression_scheme>(reader, bits_clip_compression_scheme);
 
+  if (bit_reader_read<bool>(reader)) {
+    clip_acl_database_settings settings;
+    settings.medium_tier_proportion = bit_reader_read<float>(reader);
+    settings.low_tier_proportion = bit_reader_read<float>(reader);
+    _acl_database_settings = settings;
+  }
+
+  _acl_optimize_loops = bit_reader_read<bool>(reader);
+
   const auto tracks_count{bit_reader_read<gsl::index>(reader, bits_joints_count)};
   for (gsl::index track_index{0}; track_index < tracks_count; ++track_index) {
     clip_uncooked_track t;
@@ -79,6 +88,14 @@ void clip_uncooked::serialize(internal::bit_writer& writer) const
 
   bit_writer_write(writer, _compression_scheme, bits_clip_compression_scheme);
 
+  bit_writer_write(writer, _acl_database_settings.has_value());
+  if (_acl_database_settings.has_value()) {
+    bit_writer_write(writer, _acl_database_settings->medium_tier_proportion);
+    bit_writer_write(writer, _acl_database_settings->low_tier_proportion);
+  }
+
+  bit_writer_write(writer, _acl_optimize_loops);
+
   const gsl::index tracks_count{std::ssize(_tracks)};
   EXPECTS(tracks_count <= joints_max_count);
   bit_writer_write(writer, tracks_count, bits_joints_count);
@@ -146,6 +163,27 @@ void clip_uncooked::set_compression_scheme(const clip_compression_scheme scheme)
   _compression_scheme = scheme;
 }
 
+const std::optional<clip_acl_database_settings>& clip_uncooked::get_acl_database_settings() const
+{
+  return _acl_database_settings;
+}
+
+void clip_uncooked::set_acl_database_settings(
+    const std::optional<clip_acl_database_settings>& settings)
+{
+  _acl_database_settings = settings;
+}
+
+bool clip_uncooked::get_acl_optimize_loops() const
+{
+  return _acl_optimize_loops;
+}
+
+void clip_uncooked::set_acl_optimize_loops(const bool optimize_loops)
+{
+  _acl_optimize_loops = optimize_loops;
+}
+
 float clip_uncooked::get_duration_s() const
 {
   float duration_s{0.0F};
@@ -198,6 +236,8 @@ void clip_additive_uncooked::serialize(internal::bit_writer& writer) const
 {
   using namespace eely::internal;
 
+  resource_uncooked::serialize(writer);
+
   bit_writer_write(writer, _target_skeleton_id);
   bit_writer_write(writer, _skeleton_mask_id);
 
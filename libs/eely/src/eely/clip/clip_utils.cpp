@@ -21,6 +21,33 @@
 #include <vector>
 
 namespace eely::internal {
+clip_track_columnar clip_track_columnar_from_uncooked(const clip_uncooked_track& track)
+{
+  clip_track_columnar result{.joint_id = track.joint_id};
+
+  auto push_key = [](auto& keys, const float time_s, const auto& value) {
+    keys.times.push_back(time_s);
+    keys.values.push_back(value);
+  };
+
+  // Map is already sorted by time, so are the resulting arrays
+  for (const auto& [time_s, key] : track.keys) {
+    if (key.translation.has_value()) {
+      push_key(result.translations, time_s, key.translation.value());
+    }
+
+    if (key.rotation.has_value()) {
+      push_key(result.rotations, time_s, key.rotation.value());
+    }
+
+    if (key.scale.has_value()) {
+      push_key(result.scales, time_s, key.scale.value());
+    }
+  }
+
+  return result;
+}
+
 gsl::index clip_sampling_info_calculate_samples(const clip_sampling_info& info)
 {
   const float duration_s{info.time_to_s - info.time_from_s};
@@ -36,15 +63,25 @@ void clip_sample_track(const clip_uncooked_track& track,
   const float sample_timestep_s{1.0F / static_cast<float>(sampling_info.rate)};
   const gsl::index samples_count{clip_sampling_info_calculate_samples(sampling_info)};
 
+  const clip_track_columnar columnar{clip_track_columnar_from_uncooked(track)};
+
+  // Sample times only increase, so keys of each component are swept once
+  gsl::index translation_cursor{0};
+  gsl::index rotation_cursor{0};
+  gsl::index scale_cursor{0};
+
+  out_samples.reserve(out_samples.size() + samples_count);
+
   for (gsl::index sample_index{0}; sample_index < samples_count; ++sample_index) {
     const float sample_time_s = static_cast<float>(sample_index) * sample_timestep_s;
 
-    const transform sample{clip_sample_component<transform_components::translation>(
-                               track, default_value.translation, sample_time_s),
-                           clip_sample_component<transform_components::rotation>(
-                               track, default_value.rotation, sample_time_s),
-                           clip_sample_component<transform_components::scale>(
-                               track, default_value.scale, sample_time_s)};
+    const transform sample{
+        clip_sample_component_keys(columnar.translations, default_value.translation,
+                                   sample_time_s, translation_cursor),
+        clip_sample_component_keys(columnar.rotations, default_value.rotation, sample_time_s,
+                                   rotation_cursor),
+        clip_sample_component_keys(columnar.scales, default_value.scale, sample_time_s,
+                                   scale_cursor)};
 
     out_samples.push_back(sample);
   }
@@ -98,7 +135,7 @@ void clip_calculate_tracks(const project_uncooked& project,
 
       if (result_key.translation.has_value() || result_key.rotation.has_value() ||
           result_key.scale.has_value()) {
-        result_track.keys[original_time] = result_key;
+        result_track.keys.emplace_hint(result_track.keys.end(), original_time, result_key);
       }
     }
 
@@ -242,18 +279,20 @@ void clip_calculate_additive_tracks(const project_uncooked& project,
       const transform delta{transform_diff(
           kvp.second[i], base_track_samples[std::min(i, base_track_samples.size() - 1)])};
 
+      clip_uncooked_key& diff_key{
+          diff_track.keys.emplace_hint(diff_track.keys.end(), time_s, clip_uncooked_key{})
+              ->second};
+
       if (!float_near(weight.translation, 0.0F)) {
-        diff_track.keys[time_s].translation =
-            float3_lerp(float3::zeroes, delta.translation, weight.translation);
+        diff_key.translation = float3_lerp(float3::zeroes, delta.translation, weight.translation);
       }
 
       if (!float_near(weight.rotation, 0.0F)) {
-        diff_track.keys[time_s].rotation =
-            quaternion_slerp(quaternion::identity, delta.rotation, weight.rotation);
+        diff_key.rotation = quaternion_slerp(quaternion::identity, delta.rotation, weight.rotation);
       }
 
       if (!float_near(weight.scale, 0.0F)) {
-        diff_track.keys[time_s].scale = float3_lerp(float3::ones, delta.scale, weight.scale);
+        diff_key.scale = float3_lerp(float3::ones, delta.scale, weight.scale);
       }
     }
 
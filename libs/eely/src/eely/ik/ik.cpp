@@ -0,0 +1,385 @@
+#include "eely/ik/ik.h"
+
+#include "eely/base/assert.h"
+#include "eely/math/float3.h"
+#include "eely/math/math_utils.h"
+#include "eely/math/quaternion.h"
+#include "eely/math/transform.h"
+#include "eely/skeleton/skeleton.h"
+#include "eely/skeleton/skeleton_pose.h"
+
+#include <gsl/util>
+
+#include <algorithm>
+#include <cmath>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace eely {
+// Return object space rotation of joint's parent, or identity for root joints.
+static quaternion get_parent_rotation_object_space(const skeleton_pose& pose,
+                                                   const gsl::index joint_index)
+{
+  const std::optional<gsl::index> parent_index{
+      pose.get_skeleton().get_joint_parent_index(joint_index)};
+
+  return parent_index.has_value() ? pose.get_transform_object_space(parent_index.value()).rotation
+                                  : quaternion::identity;
+}
+
+// Return component of `v` that is orthogonal to a normalized `axis`.
+static float3 vector_reject(const float3& v, const float3& axis)
+{
+  return v - axis * vector_dot(v, axis);
+}
+
+std::optional<ik_two_bone_joints> ik_two_bone_joints_from_limb(const skeleton& skeleton,
+                                                               const ik_limb limb)
+{
+  const skeleton::mapping& mapping{skeleton.get_mapping()};
+
+  std::optional<gsl::index> root;
+  std::optional<gsl::index> mid;
+  std::optional<gsl::index> tip;
+
+  switch (limb) {
+    case ik_limb::left_arm: {
+      root = mapping.left_arm;
+      mid = mapping.left_forearm;
+      tip = mapping.left_hand;
+    } break;
+
+    case ik_limb::right_arm: {
+      root = mapping.right_arm;
+      mid = mapping.right_forearm;
+      tip = mapping.right_hand;
+    } break;
+
+    case ik_limb::left_leg: {
+      root = mapping.left_up_leg;
+      mid = mapping.left_leg;
+      tip = mapping.left_foot;
+    } break;
+
+    case ik_limb::right_leg: {
+      root = mapping.right_up_leg;
+      mid = mapping.right_leg;
+      tip = mapping.right_foot;
+    } break;
+  }
+
+  if (!root.has_value() || !mid.has_value() || !tip.has_value()) {
+    return std::nullopt;
+  }
+
+  return ik_two_bone_joints{.root = root.value(), .mid = mid.value(), .tip = tip.value()};
+}
+
+void ik_two_bone_solve(skeleton_pose& pose,
+                       const ik_two_bone_joints& joints,
+                       const float3& target_object_space,
+                       const std::optional<float3>& pole_object_space,
+                       const float weight)
+{
+  const skeleton& skeleton{pose.get_skeleton()};
+
+  EXPECTS(skeleton.get_joint_parent_index(joints.mid) == joints.root);
+  EXPECTS(skeleton.get_joint_parent_index(joints.tip) == joints.mid);
+
+  if (weight <= 0.0F) {
+    return;
+  }
+
+  const quaternion root_parent_rotation{get_parent_rotation_object_space(pose, joints.root)};
+  const transform root_transform{pose.get_transform_object_space(joints.root)};
+  const transform mid_transform{pose.get_transform_object_space(joints.mid)};
+  const float3 tip_position{pose.get_transform_object_space(joints.tip).translation};
+
+  const float3& a{root_transform.translation};
+  const float3& b{mid_transform.translation};
+  const float3& c{tip_position};
+  const float3& t{target_object_space};
+
+  const float length_ab{float3_distance(a, b)};
+  const float length_bc{float3_distance(b, c)};
+  if (length_ab <= epsilon_default || length_bc <= epsilon_default) {
+    return;
+  }
+
+  // Find an angle at the mid joint that makes root-to-tip distance equal to root-to-target one,
+  // using the law of cosines.
+  // Distance is clamped so that chain never becomes fully straight,
+  // otherwise bending direction is lost for the next solve.
+
+  const float length_at{std::clamp(float3_distance(a, t), epsilon_default,
+                                   (length_ab + length_bc) * (1.0F - epsilon_default))};
+
+  const float3 ba{(a - b) * (1.0F / length_ab)};
+  const float3 bc{(c - b) * (1.0F / length_bc)};
+
+  const float angle_current{std::acos(std::clamp(vector_dot(ba, bc), -1.0F, 1.0F))};
+  const float angle_desired{std::acos(std::clamp(
+      (length_ab * length_ab + length_bc * length_bc - length_at * length_at) /
+          (2.0F * length_ab * length_bc),
+      -1.0F, 1.0F))};
+
+  // Bend around the normal of a chain's plane.
+  // If chain is straight, plane is undefined, so use a pole or mid joint's frame instead.
+
+  float3 bend_axis{vector_cross(ba, bc)};
+  if (vector_length(bend_axis) <= epsilon_default) {
+    const float3 hint{pole_object_space.has_value()
+                          ? pole_object_space.value() - b
+                          : vector_rotate(float3::z_axis, mid_transform.rotation)};
+    bend_axis = vector_cross(ba, hint);
+
+    if (vector_length(bend_axis) <= epsilon_default) {
+      bend_axis = vector_cross(ba, std::abs(ba.y) < 0.9F ? float3::y_axis : float3::x_axis);
+    }
+  }
+  bend_axis = vector_normalized(bend_axis);
+
+  const quaternion bend{quaternion_from_axis_angle(bend_axis.x, bend_axis.y, bend_axis.z,
+                                                   angle_desired - angle_current)};
+
+  // After bending, root-to-tip distance is correct,
+  // so aligning root-to-tip direction with root-to-target one reaches the target.
+
+  const float3 tip_bent{b + vector_rotate(c - b, bend)};
+
+  quaternion align{quaternion::identity};
+
+  const float3 at{t - a};
+  const float3 ac{tip_bent - a};
+  if (vector_length(at) > epsilon_default && vector_length(ac) > epsilon_default) {
+    const float3 at_normalized{vector_normalized(at)};
+    align = quaternion_shortest_arc(vector_normalized(ac), at_normalized);
+
+    // Twist whole chain around root-to-target direction,
+    // so that mid joint points towards a pole.
+
+    if (pole_object_space.has_value()) {
+      const float3 mid_direction{vector_reject(vector_rotate(b - a, align), at_normalized)};
+      const float3 pole_direction{vector_reject(pole_object_space.value() - a, at_normalized)};
+
+      if (vector_length(mid_direction) > epsilon_default &&
+          vector_length(pole_direction) > epsilon_default) {
+        align = quaternion_shortest_arc(vector_normalized(mid_direction),
+                                        vector_normalized(pole_direction)) *
+                align;
+      }
+    }
+  }
+
+  const quaternion root_rotation{align * root_transform.rotation};
+  const quaternion mid_rotation{align * bend * mid_transform.rotation};
+
+  const quaternion root_rotation_joint_space_original{
+      pose.get_transform_joint_space(joints.root).rotation};
+  const quaternion mid_rotation_joint_space_original{
+      pose.get_transform_joint_space(joints.mid).rotation};
+
+  const quaternion root_rotation_joint_space{
+      quaternion_normalized(quaternion_inverse(root_parent_rotation) * root_rotation)};
+  const quaternion mid_rotation_joint_space{
+      quaternion_normalized(quaternion_inverse(root_rotation) * mid_rotation)};
+
+  pose.sequence_start(joints.root);
+  pose.sequence_set_rotation_joint_space(
+      joints.root,
+      quaternion_slerp(root_rotation_joint_space_original, root_rotation_joint_space, weight));
+  pose.sequence_set_rotation_joint_space(
+      joints.mid,
+      quaternion_slerp(mid_rotation_joint_space_original, mid_rotation_joint_space, weight));
+}
+
+bool ik_chain_collect(const skeleton& skeleton,
+                      const gsl::index root,
+                      const gsl::index tip,
+                      std::vector<gsl::index>& out_chain)
+{
+  out_chain.clear();
+
+  std::optional<gsl::index> current{tip};
+  while (current.has_value()) {
+    out_chain.push_back(current.value());
+
+    if (current.value() == root) {
+      std::reverse(out_chain.begin(), out_chain.end());
+      return true;
+    }
+
+    current = skeleton.get_joint_parent_index(current.value());
+  }
+
+  out_chain.clear();
+  return false;
+}
+
+// Rotate chain's joints so that its bones point towards solved positions,
+// optionally forcing joint constraints.
+// Positions are then recalculated from resulting rotations,
+// so that they stay valid even if constraints changed them.
+static void fabrik_apply_rotations(const skeleton& skeleton,
+                                   std::span<const gsl::index> chain,
+                                   const quaternion& root_parent_rotation,
+                                   const std::vector<float3>& bones,
+                                   const bool constrained,
+                                   std::vector<float3>& positions,
+                                   std::vector<quaternion>& rotations_joint_space)
+{
+  const gsl::index bones_count{std::ssize(bones)};
+
+  quaternion parent_rotation{root_parent_rotation};
+
+  for (gsl::index i{0}; i < bones_count; ++i) {
+    quaternion rotation{parent_rotation * rotations_joint_space[i]};
+
+    const float3 bone_current{vector_rotate(bones[i], rotation)};
+    const float3 bone_desired{positions[i + 1] - positions[i]};
+
+    if (vector_length(bone_desired) > epsilon_default) {
+      rotation = quaternion_normalized(
+          quaternion_shortest_arc(vector_normalized(bone_current),
+                                  vector_normalized(bone_desired)) *
+          rotation);
+    }
+
+    if (constrained && skeleton.get_joint_parent_index(chain[i]).has_value()) {
+      constraint_force(skeleton.get_constraint(chain[i]), parent_rotation, rotation);
+    }
+
+    rotations_joint_space[i] =
+        quaternion_normalized(quaternion_inverse(parent_rotation) * rotation);
+    positions[i + 1] = positions[i] + vector_rotate(bones[i], rotation);
+
+    parent_rotation = rotation;
+  }
+}
+
+ik_fabrik_result ik_fabrik_solve(skeleton_pose& pose,
+                                 std::span<const gsl::index> chain,
+                                 const float3& target_object_space,
+                                 const ik_fabrik_settings& settings,
+                                 ik_fabrik_scratch& scratch,
+                                 const float weight)
+{
+  const skeleton& skeleton{pose.get_skeleton()};
+  const gsl::index joints_count{std::ssize(chain)};
+
+  EXPECTS(joints_count >= 2);
+
+  if (weight <= 0.0F) {
+    return ik_fabrik_result{};
+  }
+
+  // Solve on a copy of chain's positions and rotations,
+  // pose is written only once in the end.
+  // Bones are stored relative to their joint's rotation,
+  // which keeps their lengths and takes scale into account.
+
+  std::vector<float3>& positions{scratch.positions};
+  std::vector<quaternion>& rotations_joint_space{scratch.rotations_joint_space};
+  std::vector<float3>& bones{scratch.bones};
+  std::vector<float>& lengths{scratch.lengths};
+
+  positions.resize(joints_count);
+  rotations_joint_space.resize(joints_count - 1);
+  bones.resize(joints_count - 1);
+  lengths.resize(joints_count - 1);
+
+  const quaternion root_parent_rotation{get_parent_rotation_object_space(pose, chain.front())};
+
+  float chain_length{0.0F};
+
+  for (gsl::index i{0}; i < joints_count; ++i) {
+    EXPECTS(i == 0 || skeleton.get_joint_parent_index(chain[i]) == chain[i - 1]);
+
+    const transform& transform_object_space{pose.get_transform_object_space(chain[i])};
+    positions[i] = transform_object_space.translation;
+
+    if (i > 0) {
+      const gsl::index bone_index{i - 1};
+      const float3 bone{positions[i] - positions[bone_index]};
+      const quaternion& bone_rotation{pose.get_transform_object_space(chain[bone_index]).rotation};
+
+      bones[bone_index] = vector_rotate(bone, quaternion_inverse(bone_rotation));
+      lengths[bone_index] = vector_length(bone);
+      rotations_joint_space[bone_index] =
+          pose.get_transform_joint_space(chain[bone_index]).rotation;
+
+      chain_length += lengths[bone_index];
+    }
+  }
+
+  std::vector<quaternion>& rotations_joint_space_original{scratch.rotations_joint_space_original};
+  rotations_joint_space_original.assign(rotations_joint_space.begin(),
+                                        rotations_joint_space.end());
+
+  const float3 root_position{positions.front()};
+  const gsl::index tip_index{joints_count - 1};
+
+  ik_fabrik_result result;
+  result.error = float3_distance(positions[tip_index], target_object_space);
+
+  if (float3_distance(root_position, target_object_space) >= chain_length) {
+    // Target is out of reach, the best we can do is to stretch towards it
+
+    const float3 direction{vector_normalized(target_object_space - root_position)};
+    for (gsl::index i{0}; i < tip_index; ++i) {
+      positions[i + 1] = positions[i] + direction * lengths[i];
+    }
+
+    fabrik_apply_rotations(skeleton, chain, root_parent_rotation, bones, settings.constrained,
+                           positions, rotations_joint_space);
+
+    result.iterations = 1;
+    result.error = float3_distance(positions[tip_index], target_object_space);
+  }
+  else {
+    while (result.error > settings.tolerance && result.iterations < settings.max_iterations) {
+      // Backward pass: put tip at target and pull joints towards it
+
+      positions[tip_index] = target_object_space;
+      for (gsl::index i{tip_index - 1}; i >= 0; --i) {
+        const float3 direction{vector_normalized(positions[i] - positions[i + 1])};
+        positions[i] = positions[i + 1] + direction * lengths[i];
+      }
+
+      // Forward pass: put root back and pull joints towards it
+
+      positions.front() = root_position;
+      for (gsl::index i{0}; i < tip_index; ++i) {
+        const float3 direction{vector_normalized(positions[i + 1] - positions[i])};
+        positions[i + 1] = positions[i] + direction * lengths[i];
+      }
+
+      // Constraints are forced after each pass,
+      // so that next pass starts from a valid configuration.
+
+      if (settings.constrained) {
+        fabrik_apply_rotations(skeleton, chain, root_parent_rotation, bones, true, positions,
+                               rotations_joint_space);
+      }
+
+      ++result.iterations;
+      result.error = float3_distance(positions[tip_index], target_object_space);
+    }
+
+    if (!settings.constrained) {
+      fabrik_apply_rotations(skeleton, chain, root_parent_rotation, bones, false, positions,
+                             rotations_joint_space);
+    }
+  }
+
+  pose.sequence_start(chain.front());
+  for (gsl::index i{0}; i < tip_index; ++i) {
+    pose.sequence_set_rotation_joint_space(
+        chain[i], quaternion_slerp(rotations_joint_space_original[i], rotations_joint_space[i],
+                                   weight));
+  }
+
+  return result;
+}
+}  // namespace eely
\ No newline at end of file
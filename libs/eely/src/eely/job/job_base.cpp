@@ -1,14 +1,19 @@
 #include "eely/job/job_base.h"
 
+#include "eely/base/profiling.h"
 #include "eely/job/job_queue.h"
 #include "eely/skeleton/skeleton_pose.h"
 #include "eely/skeleton/skeleton_pose_pool.h"
 
 #include <memory>
+#include <typeinfo>
 
 namespace eely::internal {
 void job_base::execute(job_queue& queue)
 {
+  // Type name is implementation defined, but readable enough to tell jobs apart
+  EELY_PROFILE_SCOPE(profiling_scope_type::job, typeid(*this).name(), _profiling_node_id);
+
   _result = execute_impl(queue);
 }
 
@@ -26,4 +31,11 @@ void job_base::release_result_pose()
 {
   _result.reset();
 }
+
+#if defined(EELY_PROFILING)
+void job_base::set_profiling_node_id(const int node_id)
+{
+  _profiling_node_id = node_id;
+}
+#endif
 }  // namespace eely::internal
\ No newline at end of file
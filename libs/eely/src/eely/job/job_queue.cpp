@@ -9,15 +9,25 @@
 #include <gsl/util>
 
 #include <algorithm>
+#include <memory_resource>
+#include <utility>
 #include <vector>
 
 namespace eely::internal {
-job_queue::job_queue(const skeleton& skeleton) : _pose_pool{skeleton} {}
+job_queue::job_queue(const skeleton& skeleton, std::pmr::memory_resource* memory_resource)
+    : _jobs{memory_resource}, _pose_pool{skeleton}, _saved_poses{memory_resource}
+{
+}
 
 gsl::index job_queue::add_job(job_base& job)
 {
   EXPECTS(std::find(_jobs.begin(), _jobs.end(), &job) == _jobs.end());
   _jobs.push_back(&job);
+
+#if defined(EELY_PROFILING)
+  job.set_profiling_node_id(_profiling_node_id);
+#endif
+
   return std::ssize(_jobs) - 1;
 }
 
@@ -46,6 +56,13 @@ const skeleton_pose_pool::ptr& job_queue::restore_pose(const gsl::index pose_slo
   return _saved_poses[pose_slot];
 }
 
+#if defined(EELY_PROFILING)
+int job_queue::exchange_profiling_node_id(const int node_id)
+{
+  return std::exchange(_profiling_node_id, node_id);
+}
+#endif
+
 job_base& job_queue::get_job(gsl::index job_index)
 {
   job_base* result{_jobs.at(job_index)};
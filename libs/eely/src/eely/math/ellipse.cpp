@@ -3,7 +3,9 @@
 #include "eely/base/assert.h"
 #include "eely/math/math_utils.h"
 
+#include <algorithm>
 #include <cmath>
+#include <numbers>
 
 namespace eely::internal {
 static bool is_ellipse_valid(const ellipse& ellipse)
@@ -130,6 +132,56 @@ float2 ellipse_project_point(const ellipse& ellipse, const float2& point)
   return result;
 }
 
+float2 ellipse_project_point_fixed(const ellipse& ellipse, const float2& point)
+{
+  // Trigonometry-free iteration over the ellipse's evolute by Carl Chatfield:
+  // every step approximates the ellipse near the current point with a circle
+  // centered at the curvature center and projects the point onto it
+  // https://blog.chatfield.io/simple-method-for-distance-to-ellipse/
+
+  EXPECTS(is_ellipse_valid(ellipse));
+
+  // Points on axes are handled the same way as in `ellipse_project_point`
+
+  if (float_near(point.x, 0.0F)) {
+    return float2{0.0F, std::copysign(ellipse.radius_y, point.y)};
+  }
+
+  if (float_near(point.y, 0.0F)) {
+    return float2{std::copysign(ellipse.radius_x, point.x), 0.0F};
+  }
+
+  static constexpr int iterations{3};
+
+  const float a{ellipse.radius_x};
+  const float b{ellipse.radius_y};
+  const float evolute_x_coeff{(a * a - b * b) / a};
+  const float evolute_y_coeff{(b * b - a * a) / b};
+
+  const float point_x{std::fabs(point.x)};
+  const float point_y{std::fabs(point.y)};
+
+  float t_x{std::numbers::sqrt2_v<float> / 2.0F};
+  float t_y{std::numbers::sqrt2_v<float> / 2.0F};
+
+  for (int i{0}; i < iterations; ++i) {
+    const float evolute_x{evolute_x_coeff * t_x * t_x * t_x};
+    const float evolute_y{evolute_y_coeff * t_y * t_y * t_y};
+
+    const float r{std::hypot(a * t_x - evolute_x, b * t_y - evolute_y)};
+    const float q{std::hypot(point_x - evolute_x, point_y - evolute_y)};
+
+    t_x = std::clamp(((point_x - evolute_x) * r / q + evolute_x) / a, 0.0F, 1.0F);
+    t_y = std::clamp(((point_y - evolute_y) * r / q + evolute_y) / b, 0.0F, 1.0F);
+
+    const float t_length{std::hypot(t_x, t_y)};
+    t_x /= t_length;
+    t_y /= t_length;
+  }
+
+  return float2{std::copysign(a * t_x, point.x), std::copysign(b * t_y, point.y)};
+}
+
 bool ellipse_is_point_on(const ellipse& ellipse, const float2& point)
 {
   // General equation: (x * x) / (a * a) + (y * y) / (b * b) = 1.
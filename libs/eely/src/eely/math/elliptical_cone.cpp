@@ -78,7 +78,8 @@ float3 elliptical_cone_project_direction(const elliptical_cone& cone, float3 dir
   // Project point onto the ellipse and build a new direction
 
   const auto [projection_point_z, projection_point_y]{
-      ellipse_project_point(cone.ellipse, float2{ellipse_plane_point.z, ellipse_plane_point.y})};
+      ellipse_project_point_fixed(cone.ellipse,
+                                  float2{ellipse_plane_point.z, ellipse_plane_point.y})};
 
   float3 projected_direction{cone.height, projection_point_y, projection_point_z};
   projected_direction = vector_normalized(projected_direction);
@@ -2,6 +2,7 @@
 
 #include <gsl/narrow>
 
+#include <bit>
 #include <cstdint>
 
 namespace eely::internal {
@@ -49,4 +50,68 @@ std::array<uint16_t, 4> quaternion_quantize(const quaternion& q)
 
   return result;
 }
+
+uint16_t float_to_half(const float value)
+{
+  static constexpr uint32_t float_infinity{0x7F800000U};
+  static constexpr uint32_t float_half_overflow{0x477FF000U};
+  static constexpr uint32_t float_half_min_normal{0x38800000U};
+  static constexpr uint32_t float_half_min_subnormal_half{0x33000000U};
+  static constexpr uint32_t half_infinity{0x7C00U};
+  static constexpr uint32_t half_quiet_nan_bit{0x0200U};
+
+  const auto bits{std::bit_cast<uint32_t>(value)};
+  const uint32_t sign{(bits >> 16U) & 0x8000U};
+  const uint32_t abs_bits{bits & 0x7FFFFFFFU};
+
+  uint32_t result{0};
+
+  if (abs_bits >= float_infinity) {
+    result = half_infinity | (abs_bits > float_infinity ? half_quiet_nan_bit : 0U);
+  }
+  else if (abs_bits >= float_half_overflow) {
+    result = half_infinity;
+  }
+  else if (abs_bits >= float_half_min_normal) {
+    // Rebias exponent from 127 to 15 and round mantissa from 23 to 10 bits
+    result = abs_bits - ((127U - 15U) << 23U);
+    result += 0x0FFFU + ((result >> 13U) & 1U);
+    result >>= 13U;
+  }
+  else if (abs_bits >= float_half_min_subnormal_half) {
+    // Result is a subnormal half, shift mantissa with implicit bit into place
+    const uint32_t exponent{abs_bits >> 23U};
+    const uint32_t mantissa{(abs_bits & 0x007FFFFFU) | 0x00800000U};
+    const uint32_t shift{126U - exponent};
+
+    result = mantissa >> shift;
+
+    const uint32_t remainder{mantissa & ((1U << shift) - 1U)};
+    const uint32_t halfway{1U << (shift - 1U)};
+    if (remainder > halfway || (remainder == halfway && (result & 1U) != 0U)) {
+      ++result;
+    }
+  }
+
+  return gsl::narrow_cast<uint16_t>(sign | result);
+}
+
+float half_to_float(const uint16_t value)
+{
+  const uint32_t sign{(static_cast<uint32_t>(value) & 0x8000U) << 16U};
+  const uint32_t exponent{(static_cast<uint32_t>(value) >> 10U) & 0x1FU};
+  const uint32_t mantissa{static_cast<uint32_t>(value) & 0x03FFU};
+
+  if (exponent == 0x1FU) {
+    return std::bit_cast<float>(sign | 0x7F800000U | (mantissa << 13U));
+  }
+
+  if (exponent == 0) {
+    // Zero or subnormal, both are exactly representable as floats
+    const float magnitude{static_cast<float>(mantissa) * 0x1p-24F};
+    return sign != 0 ? -magnitude : magnitude;
+  }
+
+  return std::bit_cast<float>(sign | ((exponent + 127U - 15U) << 23U) | (mantissa << 13U));
+}
 }  // namespace eely::internal
\ No newline at end of file
@@ -7,6 +7,10 @@
 #include "eely/math/float3.h"
 #include "eely/math/math_utils.h"
 
+#if defined(EELY_MATH_RTM)
+#include "eely/math/math_rtm.h"
+#endif
+
 #include <cmath>
 
 namespace eely {
@@ -14,6 +18,14 @@ const quaternion quaternion::identity{0.0F, 0.0F, 0.0F, 1.0F};
 
 quaternion operator*(const quaternion& q0, const quaternion& q1)
 {
+#if defined(EELY_MATH_RTM)
+  using namespace eely::internal;
+
+  // rtm multiplication order is reversed, see `transform_mul_rtm`
+  quaternion result;
+  quaternion_from_rtm(rtm::quat_mul(quaternion_to_rtm(q1), quaternion_to_rtm(q0)), result);
+  return result;
+#else
   const float3 v0{q0.x, q0.y, q0.z};
   const float3 v1{q1.x, q1.y, q1.z};
 
@@ -21,6 +33,7 @@ quaternion operator*(const quaternion& q0, const quaternion& q1)
   const float w{q0.w * q1.w - vector_dot(v0, v1)};
 
   return quaternion{v.x, v.y, v.z, w};
+#endif
 }
 
 bool operator==(const quaternion& q0, const quaternion& q1)
@@ -227,9 +240,17 @@ bool quaternion_near(const quaternion& q0, const quaternion& q1, const float eps
 
 float3 vector_rotate(const float3& v, const quaternion& q)
 {
+#if defined(EELY_MATH_RTM)
+  using namespace eely::internal;
+
+  float3 result;
+  float3_from_rtm(rtm::quat_mul_vector3(float3_to_rtm(v), quaternion_to_rtm(q)), result);
+  return result;
+#else
   const quaternion v_ext{v.x, v.y, v.z, 0.0F};
   const quaternion v_rotated_ext{q * v_ext * quaternion_inverse(q)};
   return float3{v_rotated_ext.x, v_rotated_ext.y, v_rotated_ext.z};
+#endif
 }
 
 namespace internal {
@@ -6,17 +6,29 @@
 #include "eely/math/math_utils.h"
 #include "eely/math/quaternion.h"
 
+#if defined(EELY_MATH_RTM)
+#include "eely/math/math_rtm.h"
+#endif
+
 namespace eely {
 const transform transform::identity{float3{0.0F, 0.0F, 0.0F}, quaternion{0.0F, 0.0F, 0.0F, 1.0F},
                                     float3{1.0F, 1.0F, 1.0F}};
 
 transform operator*(const transform& t0, const transform& t1)
 {
+#if defined(EELY_MATH_RTM)
+  using namespace eely::internal;
+
+  transform result;
+  transform_from_rtm(transform_mul_rtm(transform_to_rtm(t0), transform_to_rtm(t1)), result);
+  return result;
+#else
   const float3 translation{transform_location(t0, t1.translation)};
   const quaternion rotation{t0.rotation * t1.rotation};
   const float3 scale{t0.scale * t1.scale};
 
   return transform{translation, rotation, scale};
+#endif
 }
 
 bool operator==(const transform& t0, const transform& t1)
@@ -31,11 +43,19 @@ bool operator!=(const transform& t0, const transform& t1)
 
 float3 transform_location(const transform& t0, const float3& l)
 {
+#if defined(EELY_MATH_RTM)
+  using namespace eely::internal;
+
+  float3 result;
+  float3_from_rtm(rtm::qvv_mul_point3(float3_to_rtm(l), transform_to_rtm(t0)), result);
+  return result;
+#else
   float3 result{l * t0.scale};
   result = vector_rotate(result, t0.rotation);
   result = result + t0.translation;
 
   return result;
+#endif
 }
 
 transform transform_inverse(const transform& t)
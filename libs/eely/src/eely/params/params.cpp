@@ -1,10 +1,20 @@
 #include "eely/params/params.h"
 
+#include "eely/base/base_utils.h"
 #include "eely/base/bit_writer.h"
 
+#include <atomic>
+#include <cstdint>
 #include <variant>
 
 namespace eely::internal {
+std::uint64_t params_version_next()
+{
+  // Parameters can be changed from multiple threads, e.g. one per character
+  static std::atomic<std::uint64_t> version{0};
+  return version.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
 void bit_writer_write(bit_writer& writer, const param_value& value)
 {
   bit_writer_write(writer, value.index(), bits_param_value_type_index);
@@ -16,7 +26,9 @@ void bit_writer_write(bit_writer& writer, const param_value& value)
 
     case 1: {
       static_assert(std::is_same_v<std::variant_alternative_t<1, param_value>, int>);
-      bit_writer_write(writer, std::get<int>(value), bits_param_value_int);
+
+      // All bits are written, so that negative and large values are kept as is
+      bit_writer_write(writer, bit_cast<uint32_t>(std::get<int>(value)));
     } break;
 
     case 2: {
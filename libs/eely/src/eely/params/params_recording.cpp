@@ -0,0 +1,172 @@
+#include "eely/params/params_recording.h"
+
+#include "eely/base/bit_reader.h"
+#include "eely/base/bit_writer.h"
+#include "eely/base/string_id.h"
+#include "eely/params/params.h"
+
+#include <gsl/util>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+namespace eely {
+static constexpr gsl::index bits_recording_ids_count{16};
+static constexpr gsl::index bits_recording_frames_count{32};
+
+// Parameter is visited once per frame, so there are no more changes than ids
+static constexpr gsl::index bits_recording_changes_count{bits_recording_ids_count};
+
+static constexpr gsl::index recording_ids_max_count{(1LL << bits_recording_ids_count) - 1};
+static constexpr gsl::index recording_frames_max_count{(1LL << bits_recording_frames_count) - 1};
+
+params_recorder::params_recorder(const uint32_t random_seed) : _random_seed{random_seed} {}
+
+void params_recorder::record(const float dt_s, const params& params)
+{
+  if (std::ssize(_frames) >= recording_frames_max_count) {
+    throw std::runtime_error("Too many frames to record");
+  }
+
+  // Check for new ids first, so that nothing is recorded if there are too many of them
+  gsl::index ids_count{std::ssize(_ids)};
+  params.for_each_changed(_recorded_version,
+                          [this, &ids_count](const string_id& id, const param_value& /*value*/) {
+                            if (!_id_to_index.contains(id)) {
+                              ++ids_count;
+                            }
+                          });
+
+  if (ids_count > recording_ids_max_count) {
+    throw std::runtime_error("Too many parameters to record");
+  }
+
+  frame& f{_frames.emplace_back()};
+  f.dt_s = dt_s;
+
+  params.for_each_changed(_recorded_version, [this, &f](const string_id& id,
+                                                        const param_value& value) {
+    auto [iter, inserted]{_id_to_index.try_emplace(id, std::ssize(_ids))};
+    if (inserted) {
+      _ids.push_back(id);
+    }
+
+    f.changes.emplace_back(iter->second, value);
+  });
+
+  _recorded_version = params.get_version();
+}
+
+gsl::index params_recorder::get_frames_count() const
+{
+  return std::ssize(_frames);
+}
+
+void params_recorder::serialize(internal::bit_writer& writer) const
+{
+  using namespace eely::internal;
+
+  bit_writer_write(writer, _random_seed);
+
+  bit_writer_write(writer, _ids.size(), bits_recording_ids_count);
+  for (const string_id& id : _ids) {
+    bit_writer_write(writer, id);
+  }
+
+  bit_writer_write(writer, _frames.size(), bits_recording_frames_count);
+  for (const frame& f : _frames) {
+    bit_writer_write(writer, f.dt_s);
+
+    bit_writer_write(writer, f.changes.size(), bits_recording_changes_count);
+    for (const auto& [id_index, value] : f.changes) {
+      bit_writer_write(writer, id_index, bits_recording_ids_count);
+      bit_writer_write(writer, value);
+    }
+  }
+}
+
+std::vector<std::byte> params_recorder::serialize() const
+{
+  using namespace eely::internal;
+
+  bit_writer counting_writer;
+  serialize(counting_writer);
+
+  std::vector<std::byte> result(bit_writer_get_bytes_written(counting_writer));
+
+  bit_writer writer{result};
+  serialize(writer);
+
+  return result;
+}
+
+params_replayer::params_replayer(const std::span<const std::byte> recording)
+    : _recording{recording}, _reader{recording}
+{
+  read_header();
+}
+
+uint32_t params_replayer::get_random_seed() const
+{
+  return _random_seed;
+}
+
+gsl::index params_replayer::get_frames_count() const
+{
+  return _frames_count;
+}
+
+bool params_replayer::is_finished() const
+{
+  return _frame_index >= _frames_count;
+}
+
+float params_replayer::replay(params& out_params)
+{
+  using namespace eely::internal;
+
+  if (is_finished()) {
+    throw std::runtime_error("Attempt to replay past the last recorded frame");
+  }
+
+  const auto dt_s{bit_reader_read<float>(_reader)};
+
+  const auto changes_count{bit_reader_read<gsl::index>(_reader, bits_recording_changes_count)};
+  for (gsl::index i{0}; i < changes_count; ++i) {
+    const auto id_index{bit_reader_read<gsl::index>(_reader, bits_recording_ids_count)};
+    const auto value{bit_reader_read<param_value>(_reader)};
+
+    out_params.set(_ids.at(id_index), value);
+  }
+
+  ++_frame_index;
+
+  return dt_s;
+}
+
+void params_replayer::restart()
+{
+  _reader = internal::bit_reader{_recording};
+  read_header();
+}
+
+void params_replayer::read_header()
+{
+  using namespace eely::internal;
+
+  _random_seed = bit_reader_read<uint32_t>(_reader);
+
+  const auto ids_count{bit_reader_read<gsl::index>(_reader, bits_recording_ids_count)};
+  _ids.clear();
+  _ids.reserve(ids_count);
+  for (gsl::index i{0}; i < ids_count; ++i) {
+    _ids.push_back(bit_reader_read<string_id>(_reader));
+  }
+
+  _frames_count = bit_reader_read<gsl::index>(_reader, bits_recording_frames_count);
+  _frame_index = 0;
+}
+}  // namespace eely
\ No newline at end of file
@@ -15,20 +15,40 @@
 #include "eely/skeleton_mask/skeleton_mask.h"
 #include "eely/skeleton_mask/skeleton_mask_uncooked.h"
 
+#include <fmt/format.h>
+
+#include <gsl/narrow>
+
+#include <array>
 #include <bit>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <span>
+#include <stdexcept>
+#include <unordered_set>
+#include <utility>
 #include <vector>
 
 namespace eely {
+static constexpr gsl::index bits_version{16};
 static constexpr gsl::index bits_resources_count{16};
 
-project::project(const std::span<std::byte>& buffer)
+project::project(const std::span<std::byte>& buffer) : project{buffer, project_data_reader{}} {}
+
+project::project(const std::span<std::byte>& buffer, project_data_reader tiers_reader)
+    : _tiers_reader{std::move(tiers_reader)}
 {
   using namespace eely::internal;
 
   bit_reader reader{buffer};
 
+  const auto version{bit_reader_read<uint32_t>(reader, bits_version)};
+  if (version != project_cooked_version) {
+    throw std::runtime_error{fmt::format("Project was cooked with format version {}, expected {}",
+                                         version, project_cooked_version)};
+  }
+
   const auto resources_count{bit_reader_read<gsl::index>(reader, bits_resources_count)};
 
   for (gsl::index i{0}; i < resources_count; ++i) {
@@ -37,38 +57,130 @@ project::project(const std::span<std::byte>& buffer)
   }
 }
 
+size_t project::clips_stream(const std::span<const string_id> clip_ids_by_priority,
+                             const size_t budget_bytes)
+{
+  static constexpr std::array<clip_streaming_tier, 2> tiers{clip_streaming_tier::medium,
+                                                            clip_streaming_tier::low};
+
+  size_t streamed_bytes{0};
+  std::unordered_set<string_id> prioritized_ids;
+
+  for (const string_id& id : clip_ids_by_priority) {
+    auto iter{_resources.find(id)};
+    auto* clip_ptr{iter != _resources.end() ? dynamic_cast<clip*>(iter->second.get()) : nullptr};
+    if (clip_ptr == nullptr || !prioritized_ids.insert(id).second) {
+      continue;
+    }
+
+    // Tiers are streamed in order, so that quality is not increased partially
+    bool fits{true};
+    for (const clip_streaming_tier tier : tiers) {
+      const size_t tier_size{clip_ptr->get_streaming_tier_size(tier)};
+      fits = fits && streamed_bytes + tier_size <= budget_bytes;
+
+      if (fits) {
+        clip_ptr->stream_in(tier);
+        streamed_bytes += tier_size;
+      }
+      else {
+        clip_ptr->stream_out(tier);
+      }
+    }
+  }
+
+  for (auto& [id, r] : _resources) {
+    auto* clip_ptr{dynamic_cast<clip*>(r.get())};
+    if (clip_ptr == nullptr || prioritized_ids.contains(id)) {
+      continue;
+    }
+
+    for (const clip_streaming_tier tier : tiers) {
+      clip_ptr->stream_out(tier);
+    }
+  }
+
+  return streamed_bytes;
+}
+
+const project_data_reader& project::get_tiers_reader() const
+{
+  return _tiers_reader;
+}
+
 void project::cook(const project_uncooked& project_uncooked, const std::span<std::byte>& out_buffer)
 {
   using namespace eely::internal;
 
   bit_writer writer{out_buffer};
+  cook(project_uncooked, writer);
+}
+
+void project::cook(const project_uncooked& project_uncooked, internal::bit_writer& writer)
+{
+  project tmp_project;
+  const std::vector<const resource*> cooking_order{tmp_project.cook_resources(project_uncooked)};
+  serialize_resources(cooking_order, writer);
+}
+
+std::vector<std::byte> project::cook(const project_uncooked& project_uncooked)
+{
+  using namespace eely::internal;
+
+  project tmp_project;
+  const std::vector<const resource*> cooking_order{tmp_project.cook_resources(project_uncooked)};
 
-  // Cook and write resources in topological order,
-  // so that when a resource is being deserialized or cooked,
-  // all of its dependencies are ready
+  // Serialization of already cooked resources is cheap compared to cooking,
+  // measure it with a counting writer and write into an exactly sized buffer
 
-  std::vector<const resource*> resources_ordered;
+  bit_writer counting_writer;
+  serialize_resources(cooking_order, counting_writer);
+
+  std::vector<std::byte> result(bit_writer_get_bytes_written(counting_writer));
+
+  bit_writer writer{result};
+  serialize_resources(cooking_order, writer);
+
+  return result;
+}
+
+size_t project::cook_size(const project_uncooked& project_uncooked)
+{
+  using namespace eely::internal;
 
   project tmp_project;
+  const std::vector<const resource*> cooking_order{tmp_project.cook_resources(project_uncooked)};
+
+  bit_writer counting_writer;
+  serialize_resources(cooking_order, counting_writer);
+
+  return gsl::narrow<size_t>(bit_writer_get_bytes_written(counting_writer));
+}
+
+std::vector<const resource*> project::cook_resources(const project_uncooked& project_uncooked)
+{
+  // Cook resources in topological order,
+  // so that when a resource is being cooked, all of its dependencies are ready
+
+  std::vector<const resource*> cooking_order;
 
-  const auto cook_resource = [&tmp_project, &project_uncooked,
-                              &resources_ordered](const resource_uncooked* resource_uncooked) {
+  const auto cook_resource = [this, &project_uncooked, &cooking_order](const resource_uncooked* resource_uncooked) {
     std::unique_ptr<resource> resource_cooked;
 
     if (const auto* skel_res_uncooked{dynamic_cast<const skeleton_uncooked*>(resource_uncooked)}) {
-      resource_cooked = std::make_unique<skeleton>(tmp_project, *skel_res_uncooked);
+      resource_cooked = std::make_unique<skeleton>(*this, *skel_res_uncooked);
     }
     else if (const auto* clip_res_uncooked{dynamic_cast<const clip_uncooked*>(resource_uncooked)}) {
-      resource_cooked = std::make_unique<clip>(tmp_project, project_uncooked, *clip_res_uncooked);
+      resource_cooked = std::make_unique<clip>(*this, project_uncooked, *clip_res_uncooked);
     }
     else if (const auto* clip_additive_res_uncooked{dynamic_cast<const clip_additive_uncooked*>(resource_uncooked)}) {
-      resource_cooked = std::make_unique<clip>(tmp_project, project_uncooked, *clip_additive_res_uncooked);
+      resource_cooked = std::make_unique<clip>(*this, project_uncooked, *clip_additive_res_uncooked);
     }
     else if (const auto* skeleton_mask_res_uncooked{dynamic_cast<const skeleton_mask_uncooked*>(resource_uncooked)}) {
-      resource_cooked = std::make_unique<skeleton_mask>(tmp_project, *skeleton_mask_res_uncooked);
+      resource_cooked = std::make_unique<skeleton_mask>(*this, *skeleton_mask_res_uncooked);
     }
     else if (const auto* anim_graph_res_uncooked{dynamic_cast<const anim_graph_uncooked*>(resource_uncooked)}) {
-      resource_cooked = std::make_unique<anim_graph>(tmp_project, *anim_graph_res_uncooked);
+      resource_cooked = std::make_unique<anim_graph>(*this, *anim_graph_res_uncooked);
     }
     else {
       EXPECTS(false);
@@ -76,15 +188,27 @@ void project::cook(const project_uncooked& project_uncooked, const std::span<std
 
     const string_id& id{resource_cooked->get_id()};
 
-    tmp_project._resources[id] = std::move(resource_cooked);
-    resources_ordered.push_back(tmp_project._resources[id].get());
+    _resources[id] = std::move(resource_cooked);
+    cooking_order.push_back(_resources[id].get());
   };
 
   project_uncooked.for_each_resource_topological(cook_resource);
 
-  bit_writer_write(writer, resources_ordered.size(), bits_resources_count);
+  return cooking_order;
+}
+
+void project::serialize_resources(const std::vector<const resource*>& cooking_order,
+                                  internal::bit_writer& writer)
+{
+  using namespace eely::internal;
+
+  // Write resources in the order they were cooked,
+  // so that when a resource is being deserialized, all of its dependencies are ready
+
+  bit_writer_write(writer, project_cooked_version, bits_version);
+  bit_writer_write(writer, cooking_order.size(), bits_resources_count);
 
-  for (const resource* r : resources_ordered) {
+  for (const resource* r : cooking_order) {
     resource_serialize(*r, writer);
   }
 }
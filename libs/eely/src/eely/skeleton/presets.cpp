@@ -19,6 +19,14 @@ void mixamo_init(skeleton_uncooked& skeleton_uncooked)
   mapping.right_forearm = "mixamorig:RightForeArm";
   mapping.right_hand = "mixamorig:RightHand";
 
+  mapping.left_up_leg = "mixamorig:LeftUpLeg";
+  mapping.left_leg = "mixamorig:LeftLeg";
+  mapping.left_foot = "mixamorig:LeftFoot";
+
+  mapping.right_up_leg = "mixamorig:RightUpLeg";
+  mapping.right_leg = "mixamorig:RightLeg";
+  mapping.right_foot = "mixamorig:RightFoot";
+
   // TODO: setup rest of the joints
 
   skeleton_uncooked.get_joint(mapping.left_arm)->constraint = skeleton_uncooked::constraint{
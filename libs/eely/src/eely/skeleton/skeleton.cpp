@@ -34,6 +34,10 @@ skeleton::constraint bit_reader_read<skeleton::constraint>(bit_reader& reader)
   constraint.limit_swing_y_rad = bit_reader_read<std::optional<float>>(reader);
   constraint.limit_swing_z_rad = bit_reader_read<std::optional<float>>(reader);
   constraint.distance = bit_reader_read<float>(reader);
+  constraint.child_constraint_delta_inverse = bit_reader_read<quaternion>(reader);
+  constraint.swing_cone.height = bit_reader_read<float>(reader);
+  constraint.swing_cone.ellipse.radius_x = bit_reader_read<float>(reader);
+  constraint.swing_cone.ellipse.radius_y = bit_reader_read<float>(reader);
 
   return constraint;
 }
@@ -46,6 +50,10 @@ void bit_writer_write(bit_writer& writer, const skeleton::constraint& value)
   bit_writer_write(writer, value.limit_swing_y_rad);
   bit_writer_write(writer, value.limit_swing_z_rad);
   bit_writer_write(writer, value.distance);
+  bit_writer_write(writer, value.child_constraint_delta_inverse);
+  bit_writer_write(writer, value.swing_cone.height);
+  bit_writer_write(writer, value.swing_cone.ellipse.radius_x);
+  bit_writer_write(writer, value.swing_cone.ellipse.radius_y);
 }
 
 template <>
@@ -63,6 +71,14 @@ inline skeleton::mapping bit_reader_read<skeleton::mapping>(bit_reader& reader)
   mapping.right_forearm = bit_reader_read<std::optional<gsl::index>>(reader, bits_joints_count);
   mapping.right_hand = bit_reader_read<std::optional<gsl::index>>(reader, bits_joints_count);
 
+  mapping.left_up_leg = bit_reader_read<std::optional<gsl::index>>(reader, bits_joints_count);
+  mapping.left_leg = bit_reader_read<std::optional<gsl::index>>(reader, bits_joints_count);
+  mapping.left_foot = bit_reader_read<std::optional<gsl::index>>(reader, bits_joints_count);
+
+  mapping.right_up_leg = bit_reader_read<std::optional<gsl::index>>(reader, bits_joints_count);
+  mapping.right_leg = bit_reader_read<std::optional<gsl::index>>(reader, bits_joints_count);
+  mapping.right_foot = bit_reader_read<std::optional<gsl::index>>(reader, bits_joints_count);
+
   return mapping;
 }
 
@@ -77,6 +93,14 @@ void bit_writer_write(bit_writer& writer, const skeleton::mapping& value)
   bit_writer_write(writer, value.right_arm, bits_joints_count);
   bit_writer_write(writer, value.right_forearm, bits_joints_count);
   bit_writer_write(writer, value.right_hand, bits_joints_count);
+
+  bit_writer_write(writer, value.left_up_leg, bits_joints_count);
+  bit_writer_write(writer, value.left_leg, bits_joints_count);
+  bit_writer_write(writer, value.left_foot, bits_joints_count);
+
+  bit_writer_write(writer, value.right_up_leg, bits_joints_count);
+  bit_writer_write(writer, value.right_leg, bits_joints_count);
+  bit_writer_write(writer, value.right_foot, bits_joints_count);
 }
 }  // namespace internal
 
@@ -179,7 +203,26 @@ skeleton::skeleton(const project& project, const skeleton_uncooked& uncooked)
       constraint_cooked.limit_twist_rad = constraint_uncooked_opt->limit_twist_rad;
       constraint_cooked.limit_swing_y_rad = constraint_uncooked_opt->limit_swing_y_rad;
       constraint_cooked.limit_swing_z_rad = constraint_uncooked_opt->limit_swing_z_rad;
+
+      // Precalculate constraint shapes to avoid doing that on every `constraint_force` call
+
+      if (constraint_cooked.limit_swing_y_rad.has_value() &&
+          constraint_cooked.limit_swing_z_rad.has_value()) {
+        constraint_cooked.swing_cone = elliptical_cone_from_height_and_angles(
+            1.0F, constraint_cooked.limit_swing_y_rad.value(),
+            constraint_cooked.limit_swing_z_rad.value());
+      }
+
+      if (parent_index.has_value() && (constraint_cooked.limit_twist_rad.has_value() ||
+                                       constraint_cooked.limit_swing_y_rad.has_value() ||
+                                       constraint_cooked.limit_swing_z_rad.has_value())) {
+        _constrained_joint_indices.push_back(i);
+      }
     }
+
+    constraint_cooked.child_constraint_delta_inverse =
+        quaternion_inverse(constraint_cooked.child_constraint_delta);
+
     _constraints[i] = constraint_cooked;
   }
 
@@ -194,6 +237,16 @@ skeleton::skeleton(const project& project, const skeleton_uncooked& uncooked)
   _mapping.right_arm = uncooked.get_joint_index(uncooked_mapping.right_arm);
   _mapping.right_forearm = uncooked.get_joint_index(uncooked_mapping.right_forearm);
   _mapping.right_hand = uncooked.get_joint_index(uncooked_mapping.right_hand);
+
+  _mapping.left_up_leg = uncooked.get_joint_index(uncooked_mapping.left_up_leg);
+  _mapping.left_leg = uncooked.get_joint_index(uncooked_mapping.left_leg);
+  _mapping.left_foot = uncooked.get_joint_index(uncooked_mapping.left_foot);
+
+  _mapping.right_up_leg = uncooked.get_joint_index(uncooked_mapping.right_up_leg);
+  _mapping.right_leg = uncooked.get_joint_index(uncooked_mapping.right_leg);
+  _mapping.right_foot = uncooked.get_joint_index(uncooked_mapping.right_foot);
+
+  calculate_inverse_bind_transforms();
 }
 
 skeleton::skeleton(const project& project, internal::bit_reader& reader) : resource(project, reader)
@@ -214,7 +267,15 @@ skeleton::skeleton(const project& project, internal::bit_reader& reader) : resou
     _constraints[i] = bit_reader_read<constraint>(reader);
   }
 
+  const auto constrained_joints_count{bit_reader_read<gsl::index>(reader, bits_joints_count)};
+  _constrained_joint_indices.resize(constrained_joints_count);
+  for (gsl::index i{0}; i < constrained_joints_count; ++i) {
+    _constrained_joint_indices[i] = bit_reader_read<gsl::index>(reader, bits_joints_count);
+  }
+
   _mapping = bit_reader_read<mapping>(reader);
+
+  calculate_inverse_bind_transforms();
 }
 
 void skeleton::serialize(internal::bit_writer& writer) const
@@ -233,6 +294,11 @@ void skeleton::serialize(internal::bit_writer& writer) const
     bit_writer_write(writer, _constraints[i]);
   }
 
+  bit_writer_write(writer, std::ssize(_constrained_joint_indices), bits_joints_count);
+  for (const gsl::index joint_index : _constrained_joint_indices) {
+    bit_writer_write(writer, joint_index, bits_joints_count);
+  }
+
   bit_writer_write(writer, _mapping);
 }
 
@@ -269,23 +335,102 @@ const std::vector<transform>& skeleton::get_rest_pose_transforms() const
   return _rest_pose;
 }
 
+const std::vector<transform>& skeleton::get_inverse_bind_transforms() const
+{
+  return _inverse_bind;
+}
+
 const skeleton::constraint& skeleton::get_constraint(const gsl::index index) const
 {
   return _constraints.at(index);
 }
 
+const std::vector<gsl::index>& skeleton::get_constrained_joint_indices() const
+{
+  return _constrained_joint_indices;
+}
+
 const skeleton::mapping& skeleton::get_mapping() const
 {
   return _mapping;
 }
 
-bool constraint_force(skeleton_pose& pose)
+void skeleton::calculate_inverse_bind_transforms()
 {
-  bool constrained{false};
+  const gsl::index joints_count{get_joints_count()};
+
+  // Parents always precede their children,
+  // so object space transforms can be calculated in a single pass
+
+  std::vector<transform> bind(joints_count);
+  _inverse_bind.resize(joints_count);
+
+  for (gsl::index i{0}; i < joints_count; ++i) {
+    const std::optional<gsl::index> parent_index{get_joint_parent_index(i)};
+    if (parent_index.has_value()) {
+      bind[i] = bind[parent_index.value()] * _rest_pose[i];
+    }
+    else {
+      bind[i] = _rest_pose[i];
+    }
 
+    _inverse_bind[i] = transform_inverse(bind[i]);
+  }
+}
+
+bool constraint_force(skeleton_pose& pose,
+                      std::vector<quaternion>& rotations_object_space_scratch)
+{
   const skeleton& skeleton{pose.get_skeleton()};
-  for (gsl::index i{0}; i < skeleton.get_joints_count(); ++i) {
-    constrained |= constraint_force(pose, i);
+
+  const std::vector<gsl::index>& constrained_joint_indices{
+      skeleton.get_constrained_joint_indices()};
+  if (constrained_joint_indices.empty()) {
+    return false;
+  }
+
+  // Constraints change only rotations and keep joint space translations and scales,
+  // so only object space rotations are needed.
+  // They're calculated in a single pass alongside constraining,
+  // instead of recalculating whole object space transforms after every changed joint.
+
+  const gsl::index joints_count{skeleton.get_joints_count()};
+  std::vector<quaternion>& rotations_object_space{rotations_object_space_scratch};
+  rotations_object_space.resize(joints_count);
+
+  pose.sequence_start(constrained_joint_indices.front());
+
+  bool constrained{false};
+  auto constrained_joint_it{constrained_joint_indices.begin()};
+
+  for (gsl::index i{0}; i < joints_count; ++i) {
+    const quaternion& rotation_joint_space{pose.get_transform_joint_space(i).rotation};
+
+    const std::optional<gsl::index> parent_index{skeleton.get_joint_parent_index(i)};
+    if (!parent_index.has_value()) {
+      rotations_object_space[i] = rotation_joint_space;
+      continue;
+    }
+
+    const quaternion& parent_rotation_object_space{rotations_object_space[parent_index.value()]};
+    rotations_object_space[i] = parent_rotation_object_space * rotation_joint_space;
+
+    if (constrained_joint_it == constrained_joint_indices.end() || *constrained_joint_it != i) {
+      continue;
+    }
+
+    ++constrained_joint_it;
+
+    if (!constraint_force(skeleton.get_constraint(i), parent_rotation_object_space,
+                          rotations_object_space[i])) {
+      continue;
+    }
+
+    constrained = true;
+
+    pose.sequence_set_rotation_joint_space(
+        i, quaternion_normalized(quaternion_inverse(parent_rotation_object_space) *
+                                 rotations_object_space[i]));
   }
 
   return constrained;
@@ -329,9 +474,8 @@ bool constraint_force(skeleton_pose& pose, gsl::index joint_index)
 
   child_constraint_orientation = parent_constraint_orientation * delta;
 
-  // TODO: inverses of predefined rotations can be precomputed during cooking
   const quaternion new_child_orientation{child_constraint_orientation *
-                                         quaternion_inverse(constraint.child_constraint_delta)};
+                                         constraint.child_constraint_delta_inverse};
 
   const transform new_child_transform_joint_space{
       transform_inverse(parent_transform_object_space) *
@@ -342,6 +486,27 @@ bool constraint_force(skeleton_pose& pose, gsl::index joint_index)
   return constrained;
 }
 
+bool constraint_force(const skeleton::constraint& constraint,
+                      const quaternion& parent_rotation_object_space,
+                      quaternion& rotation_object_space)
+{
+  const quaternion parent_constraint_orientation{parent_rotation_object_space *
+                                                 constraint.parent_constraint_delta};
+
+  quaternion delta{
+      quaternion_normalized(quaternion_inverse(parent_constraint_orientation) *
+                            rotation_object_space * constraint.child_constraint_delta)};
+
+  if (!constraint_force(constraint, delta)) {
+    return false;
+  }
+
+  rotation_object_space =
+      parent_constraint_orientation * delta * constraint.child_constraint_delta_inverse;
+
+  return true;
+}
+
 bool constraint_force(const skeleton::constraint& constraint, quaternion& q)
 {
   using namespace eely::internal;
@@ -381,8 +546,7 @@ bool constraint_force(const skeleton::constraint& constraint, quaternion& q)
       // Constraint is form of an elliptical cone
       // Project onto it if needed
 
-      const elliptical_cone cone{
-          elliptical_cone_from_height_and_angles(1.0F, limit_swing_y_rad, limit_swing_z_rad)};
+      const elliptical_cone& cone{constraint.swing_cone};
 
       float3 direction{vector_rotate(float3::x_axis, swing_yz)};
 
@@ -1,15 +1,104 @@
 #include "eely/skeleton/skeleton_pose.h"
 
 #include "eely/base/assert.h"
+#include "eely/base/profiling.h"
+#include "eely/math/math_rtm.h"
+#include "eely/math/quantization.h"
 #include "eely/math/transform.h"
+#include "eely/skeleton_mask/skeleton_mask.h"
 
 #include <gsl/util>
 
+#include <rtm/matrix3x4f.h>
+#include <rtm/quatf.h>
+#include <rtm/qvvf.h>
+#include <rtm/vector4f.h>
+
+#include <array>
+#include <cstddef>
+#include <cstring>
 #include <limits>
 #include <optional>
 #include <vector>
 
 namespace eely {
+template <std::size_t N>
+static void skinning_palette_store(const std::array<rtm::vector4f, N>& values,
+                                   const bool half,
+                                   std::byte* const out_data)
+{
+  std::array<float, N * 4> floats;
+  for (gsl::index i{0}; i < std::ssize(values); ++i) {
+    rtm::vector_store(values[i], &floats[i * 4]);
+  }
+
+  if (!half) {
+    std::memcpy(out_data, floats.data(), sizeof(floats));
+    return;
+  }
+
+  std::array<uint16_t, N * 4> halves;
+  for (gsl::index i{0}; i < std::ssize(floats); ++i) {
+    halves[i] = internal::float_to_half(floats[i]);
+  }
+
+  std::memcpy(out_data, halves.data(), sizeof(halves));
+}
+
+template <skinning_palette_format Format>
+static void skinning_palette_write_joint(rtm::qvvf_arg0 skinning_transform,
+                                         std::byte* const out_data)
+{
+  static constexpr bool half{Format == skinning_palette_format::matrix3x4_half ||
+                             Format == skinning_palette_format::dual_quaternion_half};
+
+  if constexpr (Format == skinning_palette_format::matrix3x4 ||
+                Format == skinning_palette_format::matrix3x4_half) {
+    // rtm stores axes as rows, transpose them to get rows for column vectors
+    const rtm::matrix3x4f m = rtm::matrix_from_qvv(skinning_transform);
+
+    std::array<rtm::vector4f, 3> rows;
+    RTM_MATRIXF_TRANSPOSE_4X3(m.x_axis, m.y_axis, m.z_axis, m.w_axis, rows[0], rows[1], rows[2]);
+
+    skinning_palette_store(rows, half, out_data);
+  }
+  else {
+    // Dual part is `0.5 * t * r`, rtm multiplication order is reversed
+    const rtm::quatf real = skinning_transform.rotation;
+    const rtm::quatf translation =
+        rtm::vector_to_quat(rtm::vector_set_w(skinning_transform.translation, 0.0F));
+    const rtm::quatf dual = rtm::quat_mul(real, translation);
+
+    const std::array<rtm::vector4f, 2> values{rtm::quat_to_vector(real),
+                                              rtm::vector_mul(rtm::quat_to_vector(dual), 0.5F)};
+    skinning_palette_store(values, half, out_data);
+  }
+}
+
+gsl::index skinning_palette_get_joint_size(const skinning_palette_format format)
+{
+  switch (format) {
+    case skinning_palette_format::matrix3x4: {
+      return 12 * sizeof(float);
+    } break;
+
+    case skinning_palette_format::matrix3x4_half: {
+      return 12 * sizeof(uint16_t);
+    } break;
+
+    case skinning_palette_format::dual_quaternion: {
+      return 8 * sizeof(float);
+    } break;
+
+    case skinning_palette_format::dual_quaternion_half: {
+      return 8 * sizeof(uint16_t);
+    } break;
+  }
+
+  EXPECTS(false);
+  return 0;
+}
+
 skeleton_pose::skeleton_pose(const skeleton& skeleton, const type pose_type) : _skeleton{&skeleton}
 {
   reset(pose_type);
@@ -48,16 +137,119 @@ void skeleton_pose::set_transform_object_space(const gsl::index index, const tra
   set_transform_joint_space(index, transform_inverse(parent_object_space_transform) * transform);
 }
 
+template <skinning_palette_format Format>
+static void skinning_palette_write(const skeleton& skeleton,
+                                   const std::vector<transform>& transforms_joint_space,
+                                   std::vector<transform>& transforms_object_space,
+                                   const gsl::index shallow_changed_joint_index,
+                                   const std::span<std::byte> out_buffer)
+{
+  using namespace eely::internal;
+
+  const gsl::index joints_count{skeleton.get_joints_count()};
+  const gsl::index joint_size{skinning_palette_get_joint_size(Format)};
+  const std::vector<transform>& inverse_bind{skeleton.get_inverse_bind_transforms()};
+
+  for (gsl::index index{0}; index < joints_count; ++index) {
+    rtm::qvvf object_space;
+
+    if (index < shallow_changed_joint_index) {
+      object_space = transform_to_rtm(transforms_object_space[index]);
+    }
+    else {
+      object_space = transform_to_rtm(transforms_joint_space[index]);
+
+      const std::optional<gsl::index> parent_index{skeleton.get_joint_parent_index(index)};
+      if (parent_index.has_value()) {
+        object_space = transform_mul_rtm(
+            transform_to_rtm(transforms_object_space[parent_index.value()]), object_space);
+      }
+
+      transform_from_rtm(object_space, transforms_object_space[index]);
+    }
+
+    skinning_palette_write_joint<Format>(
+        transform_mul_rtm(object_space, transform_to_rtm(inverse_bind[index])),
+        out_buffer.data() + index * joint_size);
+  }
+}
+
+void skeleton_pose::write_skinning_palette(const skinning_palette_format format,
+                                           const std::span<std::byte> out_buffer) const
+{
+  const gsl::index joints_count{get_joints_count()};
+  EXPECTS(std::ssize(out_buffer) >= joints_count * skinning_palette_get_joint_size(format));
+
+  // Object space transforms are recalculated in the same loop,
+  // so that every joint is loaded only once
+  _transforms_object_space.resize(joints_count);
+  const gsl::index shallow_index{_shallow_changed_joint_index.value_or(joints_count)};
+
+  switch (format) {
+    case skinning_palette_format::matrix3x4: {
+      skinning_palette_write<skinning_palette_format::matrix3x4>(
+          *_skeleton, _transforms_joint_space, _transforms_object_space, shallow_index, out_buffer);
+    } break;
+
+    case skinning_palette_format::matrix3x4_half: {
+      skinning_palette_write<skinning_palette_format::matrix3x4_half>(
+          *_skeleton, _transforms_joint_space, _transforms_object_space, shallow_index, out_buffer);
+    } break;
+
+    case skinning_palette_format::dual_quaternion: {
+      skinning_palette_write<skinning_palette_format::dual_quaternion>(
+          *_skeleton, _transforms_joint_space, _transforms_object_space, shallow_index, out_buffer);
+    } break;
+
+    case skinning_palette_format::dual_quaternion_half: {
+      skinning_palette_write<skinning_palette_format::dual_quaternion_half>(
+          *_skeleton, _transforms_joint_space, _transforms_object_space, shallow_index, out_buffer);
+    } break;
+  }
+
+  _shallow_changed_joint_index = std::nullopt;
+}
+
 void skeleton_pose::recalculate_object_space_transforms() const
 {
   if (!_shallow_changed_joint_index.has_value()) {
     return;
   }
 
+  EELY_PROFILE_SCOPE(profiling_scope_type::object_space, "recalculate_object_space_transforms");
+
   const gsl::index joints_count{_skeleton->get_joints_count()};
 
   _transforms_object_space.resize(joints_count);
 
+#if defined(EELY_MATH_RTM)
+  using namespace eely::internal;
+
+  // Object space transform of a previous joint is kept in registers,
+  // since in chains (spine, limbs, fingers) parent is usually the joint right before a child.
+  // Other parents are loaded back from memory
+  rtm::qvvf previous_object_space = rtm::qvv_identity();
+  gsl::index previous_index{-1};
+
+  for (gsl::index index{_shallow_changed_joint_index.value()}; index < joints_count; ++index) {
+    const std::optional<gsl::index> parent_index{_skeleton->get_joint_parent_index(index)};
+    const rtm::qvvf joint_space = transform_to_rtm(_transforms_joint_space[index]);
+
+    rtm::qvvf object_space = joint_space;
+    if (parent_index.has_value()) {
+      const gsl::index parent{parent_index.value()};
+      object_space = transform_mul_rtm(parent == previous_index
+                                           ? previous_object_space
+                                           : transform_to_rtm(_transforms_object_space[parent]),
+                                       joint_space);
+    }
+
+    transform_from_rtm(object_space, _transforms_object_space[index]);
+
+    previous_object_space = object_space;
+    previous_index = index;
+  }
+#else
   for (gsl::index index{_shallow_changed_joint_index.value()}; index < joints_count; ++index) {
     const std::optional<gsl::index> parent_index{_skeleton->get_joint_parent_index(index)};
     if (parent_index.has_value()) {
@@ -68,6 +260,7 @@ void skeleton_pose::recalculate_object_space_transforms() const
       _transforms_object_space[index] = _transforms_joint_space[index];
     }
   }
+#endif
 
   _shallow_changed_joint_index = std::nullopt;
 }
@@ -86,6 +279,22 @@ void skeleton_pose_blend(const skeleton_pose& p0,
 
   out_result.sequence_start(0);
 
+#if defined(EELY_MATH_RTM)
+  using namespace eely::internal;
+
+  for (gsl::index i{0}; i < joints_count; ++i) {
+    const rtm::qvvf t0{transform_to_rtm(p0.get_transform_joint_space(i))};
+    const rtm::qvvf t1{transform_to_rtm(p1.get_transform_joint_space(i))};
+
+    transform result;
+    transform_from_rtm(rtm::qvv_set(quaternion_slerp_rtm(t0.rotation, t1.rotation, weight),
+                                    rtm::vector_lerp(t0.translation, t1.translation, weight),
+                                    rtm::vector_lerp(t0.scale, t1.scale, weight)),
+                       result);
+
+    out_result.sequence_set_transform_joint_space(i, result);
+  }
+#else
   for (gsl::index i{0}; i < joints_count; ++i) {
     const transform& t0{p0.get_transform_joint_space(i)};
     const transform& t1{p1.get_transform_joint_space(i)};
@@ -96,6 +305,7 @@ void skeleton_pose_blend(const skeleton_pose& p0,
         i, quaternion_slerp(t0.rotation, t1.rotation, weight));
     out_result.sequence_set_scale_joint_space(i, float3_lerp(t0.scale, t1.scale, weight));
   }
+#endif
 }
 
 void skeleton_pose_add(const skeleton_pose& p0, const skeleton_pose& p1, skeleton_pose& out_result)
@@ -109,10 +319,140 @@ void skeleton_pose_add(const skeleton_pose& p0, const skeleton_pose& p1, skeleto
 
   out_result.sequence_start(0);
 
+#if defined(EELY_MATH_RTM)
+  using namespace eely::internal;
+
+  for (gsl::index i{0}; i < joints_count; ++i) {
+    transform result;
+    transform_from_rtm(transform_mul_rtm(transform_to_rtm(p0.get_transform_joint_space(i)),
+                                         transform_to_rtm(p1.get_transform_joint_space(i))),
+                       result);
+    out_result.sequence_set_transform_joint_space(i, result);
+  }
+#else
   for (gsl::index i{0}; i < joints_count; ++i) {
     const transform& t0{p0.get_transform_joint_space(i)};
     const transform& t1{p1.get_transform_joint_space(i)};
     out_result.sequence_set_transform_joint_space(i, t0 * t1);
   }
+#endif
+}
+
+void skeleton_pose_nlerp(const skeleton_pose& p0,
+                         const skeleton_pose& p1,
+                         const float weight,
+                         skeleton_pose& out_result)
+{
+  EXPECTS(p0.get_joints_count() == p1.get_joints_count());
+  EXPECTS(p0.get_joints_count() == out_result.get_joints_count());
+  EXPECTS(&p0.get_skeleton() == &p1.get_skeleton());
+  EXPECTS(&p0.get_skeleton() == &out_result.get_skeleton());
+
+  using namespace eely::internal;
+
+  const gsl::index joints_count{p0.get_joints_count()};
+
+  out_result.sequence_start(0);
+
+  for (gsl::index i{0}; i < joints_count; ++i) {
+    const rtm::qvvf t0{transform_to_rtm(p0.get_transform_joint_space(i))};
+    const rtm::qvvf t1{transform_to_rtm(p1.get_transform_joint_space(i))};
+
+    transform result;
+    transform_from_rtm(rtm::qvv_set(rtm::quat_lerp(t0.rotation, t1.rotation, weight),
+                                    rtm::vector_lerp(t0.translation, t1.translation, weight),
+                                    rtm::vector_lerp(t0.scale, t1.scale, weight)),
+                       result);
+
+    out_result.sequence_set_transform_joint_space(i, result);
+  }
+}
+
+void skeleton_pose_blend_masked(const skeleton_pose& p0,
+                                const skeleton_pose& p1,
+                                const skeleton_mask& mask,
+                                const float weight,
+                                skeleton_pose& out_result)
+{
+  EXPECTS(p0.get_joints_count() == p1.get_joints_count());
+  EXPECTS(p0.get_joints_count() == out_result.get_joints_count());
+  EXPECTS(&p0.get_skeleton() == &p1.get_skeleton());
+  EXPECTS(&p0.get_skeleton() == &out_result.get_skeleton());
+  EXPECTS(weight >= 0.0F && weight <= 1.0F);
+  EXPECTS(mask.get_joints_count() == p0.get_joints_count());
+
+  using namespace eely::internal;
+
+  const gsl::index joints_count{p0.get_joints_count()};
+
+  out_result.sequence_start(0);
+
+  for (gsl::index i{0}; i < joints_count; ++i) {
+    const joint_weight& mask_weight{mask.get_weight(i)};
+    const rtm::qvvf t0{transform_to_rtm(p0.get_transform_joint_space(i))};
+    const rtm::qvvf t1{transform_to_rtm(p1.get_transform_joint_space(i))};
+
+    // Rotations use normalized lerp instead of slerp:
+    // this runs for every joint of every layer, and layered poses are usually close enough
+    // for the difference to be unnoticeable.
+
+    transform result;
+    transform_from_rtm(
+        rtm::qvv_set(rtm::quat_lerp(t0.rotation, t1.rotation, mask_weight.rotation * weight),
+                     rtm::vector_lerp(t0.translation, t1.translation,
+                                      mask_weight.translation * weight),
+                     rtm::vector_lerp(t0.scale, t1.scale, mask_weight.scale * weight)),
+        result);
+
+    out_result.sequence_set_transform_joint_space(i, result);
+  }
+}
+
+void skeleton_pose_add_masked(const skeleton_pose& p0,
+                              const skeleton_pose& p1,
+                              const skeleton_mask& mask,
+                              const float weight,
+                              skeleton_pose& out_result)
+{
+  EXPECTS(p0.get_joints_count() == p1.get_joints_count());
+  EXPECTS(p0.get_joints_count() == out_result.get_joints_count());
+  EXPECTS(&p0.get_skeleton() == &p1.get_skeleton());
+  EXPECTS(&p0.get_skeleton() == &out_result.get_skeleton());
+  EXPECTS(weight >= 0.0F && weight <= 1.0F);
+  EXPECTS(mask.get_joints_count() == p0.get_joints_count());
+
+  using namespace eely::internal;
+
+  const gsl::index joints_count{p0.get_joints_count()};
+
+  const rtm::quatf identity_rotation = rtm::quat_identity();
+  const rtm::vector4f identity_scale = rtm::vector_set(1.0F);
+
+  out_result.sequence_start(0);
+
+  for (gsl::index i{0}; i < joints_count; ++i) {
+    const joint_weight& mask_weight{mask.get_weight(i)};
+    const rtm::qvvf t1{transform_to_rtm(p1.get_transform_joint_space(i))};
+
+    // Scale additive transform towards identity according to weights
+    // and then add it as usual.
+
+    const rtm::qvvf t1_weighted{rtm::qvv_set(
+        rtm::quat_lerp(identity_rotation, t1.rotation, mask_weight.rotation * weight),
+        rtm::vector_mul(t1.translation, mask_weight.translation * weight),
+        rtm::vector_lerp(identity_scale, t1.scale, mask_weight.scale * weight))};
+
+    transform result;
+#if defined(EELY_MATH_RTM)
+    transform_from_rtm(
+        transform_mul_rtm(transform_to_rtm(p0.get_transform_joint_space(i)), t1_weighted), result);
+#else
+    transform t1_weighted_stored;
+    transform_from_rtm(t1_weighted, t1_weighted_stored);
+    result = p0.get_transform_joint_space(i) * t1_weighted_stored;
+#endif
+
+    out_result.sequence_set_transform_joint_space(i, result);
+  }
 }
 }  // namespace eely
\ No newline at end of file
@@ -56,6 +56,14 @@ inline skeleton_uncooked::mapping bit_reader_read<skeleton_uncooked::mapping>(bi
   mapping.right_forearm = bit_reader_read<string_id>(reader);
   mapping.right_hand = bit_reader_read<string_id>(reader);
 
+  mapping.left_up_leg = bit_reader_read<string_id>(reader);
+  mapping.left_leg = bit_reader_read<string_id>(reader);
+  mapping.left_foot = bit_reader_read<string_id>(reader);
+
+  mapping.right_up_leg = bit_reader_read<string_id>(reader);
+  mapping.right_leg = bit_reader_read<string_id>(reader);
+  mapping.right_foot = bit_reader_read<string_id>(reader);
+
   return mapping;
 }
 
@@ -70,6 +78,14 @@ void bit_writer_write(bit_writer& writer, const skeleton_uncooked::mapping& valu
   bit_writer_write(writer, value.right_arm);
   bit_writer_write(writer, value.right_forearm);
   bit_writer_write(writer, value.right_hand);
+
+  bit_writer_write(writer, value.left_up_leg);
+  bit_writer_write(writer, value.left_leg);
+  bit_writer_write(writer, value.left_foot);
+
+  bit_writer_write(writer, value.right_up_leg);
+  bit_writer_write(writer, value.right_leg);
+  bit_writer_write(writer, value.right_foot);
 }
 }  // namespace internal
 
@@ -2,6 +2,7 @@
 
 #include "eely/base/bit_reader.h"
 #include "eely/base/bit_writer.h"
+#include "eely/base/string_id.h"
 #include "eely/project/project.h"
 #include "eely/project/resource.h"
 #include "eely/skeleton/skeleton.h"
@@ -19,6 +20,8 @@ skeleton_mask::skeleton_mask(const project& project, internal::bit_reader& reade
 {
   using namespace eely::internal;
 
+  _skeleton_id = bit_reader_read<string_id>(reader);
+
   const auto weights_count{bit_reader_read<gsl::index>(reader, internal::bits_joints_count)};
 
   _weights.resize(weights_count);
@@ -30,7 +33,7 @@ skeleton_mask::skeleton_mask(const project& project, internal::bit_reader& reade
 }
 
 skeleton_mask::skeleton_mask(const project& project, const skeleton_mask_uncooked& uncooked)
-    : resource(project, uncooked.get_id())
+    : resource(project, uncooked.get_id()), _skeleton_id{uncooked.get_target_skeleton_id()}
 {
   const skeleton& skeleton{
       *project.get_resource<eely::skeleton>(uncooked.get_target_skeleton_id())};
@@ -57,6 +60,7 @@ void skeleton_mask::serialize(internal::bit_writer& writer) const
 
   resource::serialize(writer);
 
+  bit_writer_write(writer, _skeleton_id);
   bit_writer_write(writer, _weights.size(), bits_joints_count);
   for (const joint_weight weight : _weights) {
     bit_writer_write(writer, weight.translation);
@@ -5,6 +5,8 @@
 #include <eely/anim_graph/anim_graph_node_base.h>
 #include <eely/anim_graph/anim_graph_node_blend.h>
 #include <eely/anim_graph/anim_graph_node_clip.h>
+#include <eely/anim_graph/anim_graph_node_ik.h>
+#include <eely/anim_graph/anim_graph_node_layer.h>
 #include <eely/anim_graph/anim_graph_node_param.h>
 #include <eely/anim_graph/anim_graph_node_param_comparison.h>
 #include <eely/anim_graph/anim_graph_node_random.h>
@@ -29,6 +31,8 @@ namespace eely {
 // Renders and edits (TODO) animation graph resource.
 // If a graph is being played, also shows current graph's state,
 // e.g. which nodes are active and their weights etc.
+// When compiled with `EELY_PROFILING`, nodes are also colored by their cost,
+// and show their subtree's share of graph computation time.
 class anim_graph_editor final {
 public:
   explicit anim_graph_editor(const anim_graph& anim_graph, const anim_graph_player* player);
@@ -89,12 +93,15 @@ private:
       const anim_graph_node_base& node) const;
   [[nodiscard]] float get_player_node_weight(
       const internal::anim_graph_player_node_base& player_node) const;
+  [[nodiscard]] const anim_graph_player_node_cost* get_player_node_cost(
+      const anim_graph_node_base& node) const;
   [[nodiscard]] std::vector<const anim_graph_node_state*> get_transition_sources(
       const anim_graph_node_state_transition& node_transition);
 
   // Rendering
 
   [[nodiscard]] ImVec4 get_node_weight_color(const anim_graph_node_base& node) const;
+  [[nodiscard]] ImVec4 get_node_cost_color(const anim_graph_node_base& node) const;
   [[nodiscard]] ImVec4 get_link_weight_color(const anim_graph_node_base& node_from,
                                              const anim_graph_node_base& node_to) const;
 
@@ -119,12 +126,15 @@ private:
                                   const std::string& label,
                                   std::optional<int> child_node_id,
                                   bool mid_arrow = false);
+  void render_node_cost(const anim_graph_node_base& node) const;
   deferred_imgui_render create_phase_bar_deferred_renderer(const anim_graph_node_base& node);
 
   void render_node(const anim_graph_node_base& node);
   void render_node_and(const anim_graph_node_and& node);
   void render_node_blend(const anim_graph_node_blend& node);
   void render_node_clip(const anim_graph_node_clip& node) const;
+  void render_node_ik(const anim_graph_node_ik& node);
+  void render_node_layer(const anim_graph_node_layer& node);
   void render_node_param_comparison(const anim_graph_node_param_comparison& node) const;
   void render_node_param(const anim_graph_node_param& node) const;
   void render_node_random(const anim_graph_node_random& node);
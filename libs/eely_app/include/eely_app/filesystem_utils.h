@@ -1,9 +1,14 @@
+#pragma once
+
 #include <cstddef>
 #include <filesystem>
 #include <vector>
 
 namespace eely {
 // Return path to currently running executable.
+std::filesystem::path get_executable_path();
+
+// Return path to directory of currently running executable.
 std::filesystem::path get_executable_dir();
 
 // Return binary file's content.
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <eely/project/project.h>
+
+#include <cstddef>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace eely {
+// Function that imports resources and returns them cooked into a project buffer.
+using project_cook_function = std::function<std::vector<std::byte>()>;
+
+// Load project from a cache file, so that resources are not imported and cooked on every start.
+// If the cache is missing or stale, project is cooked with `cook` and the cache is rewritten.
+// Cache is stale if the executable or any of the sources has changed since it was written,
+// directories among sources are checked recursively and should not contain the cache itself.
+// Cache that cannot be loaded is treated as stale.
+std::unique_ptr<project> project_load_cached(const std::filesystem::path& cache_path,
+                                             const std::vector<std::filesystem::path>& source_paths,
+                                             const project_cook_function& cook);
+
+// Same as above, with the cache stored next to the executable and named after it,
+// and app's resources (`res` directory next to the executable) as sources.
+std::unique_ptr<project> project_load_cached(const project_cook_function& cook);
+}  // namespace eely
\ No newline at end of file
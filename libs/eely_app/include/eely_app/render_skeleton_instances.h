@@ -0,0 +1,84 @@
+#pragma once
+
+#include "eely_app/matrix4x4.h"
+
+#include <eely/math/float4.h>
+
+#include <bgfx/bgfx.h>
+
+#include <entt/entity/registry.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace eely {
+// Instance of a bone, rendered as a line from a joint to its parent.
+// Layout matches `i_data0`, `i_data1` and `i_data2` inputs of `bones.vs` shader.
+struct render_bone_instance final {
+  // World space position of a joint, `w` is unused.
+  float4 from;
+
+  // World space position of joint's parent, `w` is unused.
+  float4 to;
+
+  // Color of a line.
+  float4 color;
+};
+
+// Instances of everything skeletons are rendered with.
+struct render_skeleton_instances final {
+  // Bones of all skeletons.
+  std::vector<render_bone_instance> bones;
+
+  // Model matrices of joint coordinate frames.
+  std::vector<matrix4x4> joint_frames;
+
+  // Model matrices of unit cones scaled into joint constraint limits.
+  std::vector<matrix4x4> constraint_limits;
+};
+
+// Gather instances of all skeletons in a registry that have transform and skeleton components.
+// Previous content of `out_instances` is replaced, while its memory is reused.
+void render_skeleton_instances_gather(const entt::registry& registry,
+                                      render_skeleton_instances& out_instances);
+
+// Render a mesh once per instance with a single draw,
+// instance data is copied into a transient instance buffer.
+// Instances that do not fit into transient memory left for a frame are skipped.
+// Return number of instances rendered, which is zero if instancing is not supported.
+uint32_t render_instances_submit(bgfx::ViewId view_id,
+                                 std::span<const std::byte> instances_data,
+                                 uint16_t instance_stride,
+                                 bgfx::VertexBufferHandle vbuffer_handle,
+                                 bgfx::IndexBufferHandle ibuffer_handle,
+                                 bgfx::ProgramHandle program_handle,
+                                 uint64_t state);
+
+// Same as above, with instance data and stride taken from a span of instances.
+template <typename T>
+uint32_t render_instances_submit(bgfx::ViewId view_id,
+                                 std::span<const T> instances,
+                                 bgfx::VertexBufferHandle vbuffer_handle,
+                                 bgfx::IndexBufferHandle ibuffer_handle,
+                                 bgfx::ProgramHandle program_handle,
+                                 uint64_t state);
+
+// Implementation
+
+template <typename T>
+uint32_t render_instances_submit(const bgfx::ViewId view_id,
+                                 const std::span<const T> instances,
+                                 const bgfx::VertexBufferHandle vbuffer_handle,
+                                 const bgfx::IndexBufferHandle ibuffer_handle,
+                                 const bgfx::ProgramHandle program_handle,
+                                 const uint64_t state)
+{
+  static_assert(sizeof(T) % 16 == 0, "Instance stride must be a multiple of 16 bytes");
+
+  return render_instances_submit(view_id, std::as_bytes(instances),
+                                 static_cast<uint16_t>(sizeof(T)), vbuffer_handle, ibuffer_handle,
+                                 program_handle, state);
+}
+}  // namespace eely
\ No newline at end of file
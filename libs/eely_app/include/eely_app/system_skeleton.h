@@ -6,4 +6,8 @@
 
 namespace eely {
 void system_skeleton_update(app& app, entt::registry& registry, float dt_s);
+
+// Same as `system_skeleton_update`, but spreads skeletons across worker threads.
+// Useful for scenes with a lot of characters.
+void system_skeleton_update_parallel(app& app, entt::registry& registry, float dt_s);
 }  // namespace eely
\ No newline at end of file
@@ -0,0 +1,11 @@
+$input a_position, i_data0, i_data1, i_data2
+$output v_color0
+
+#include <bgfx_shader.sh>
+
+// Unit line along X axis is stretched from `i_data0` to `i_data1` world space positions.
+void main() {
+    vec3 position = mix(i_data0.xyz, i_data1.xyz, a_position.x);
+    gl_Position = mul(u_viewProj, vec4(position, 1.0));
+    v_color0 = i_data2;
+}
\ No newline at end of file
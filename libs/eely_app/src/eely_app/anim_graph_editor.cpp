@@ -5,6 +5,8 @@
 #include <eely/anim_graph/anim_graph_node_base.h>
 #include <eely/anim_graph/anim_graph_node_blend.h>
 #include <eely/anim_graph/anim_graph_node_clip.h>
+#include <eely/anim_graph/anim_graph_node_ik.h>
+#include <eely/anim_graph/anim_graph_node_layer.h>
 #include <eely/anim_graph/anim_graph_node_param.h>
 #include <eely/anim_graph/anim_graph_node_param_comparison.h>
 #include <eely/anim_graph/anim_graph_node_random.h>
@@ -17,6 +19,8 @@
 #include <eely/anim_graph/anim_graph_player.h>
 #include <eely/anim_graph/anim_graph_player_node_base.h>
 #include <eely/anim_graph/anim_graph_player_node_blend.h>
+#include <eely/anim_graph/anim_graph_player_node_ik.h>
+#include <eely/anim_graph/anim_graph_player_node_layer.h>
 #include <eely/anim_graph/anim_graph_player_node_pose_base.h>
 #include <eely/anim_graph/anim_graph_player_node_state_transition.h>
 #include <eely/anim_graph/anim_graph_uncooked.h>
@@ -33,8 +37,11 @@
 #include <imgui_internal.h>
 #include <imgui_node_editor.h>
 
+#include <algorithm>
+#include <array>
 #include <cstdint>
 #include <functional>
+#include <optional>
 #include <sstream>
 #include <string>
 #include <variant>
@@ -67,6 +74,8 @@ static const std::unordered_map<anim_graph_node_type, ImU32> node_type_to_accent
     {anim_graph_node_type::and_logic, IM_COL32(250, 88, 182, 255)},
     {anim_graph_node_type::blend, IM_COL32(3, 201, 136, 255)},
     {anim_graph_node_type::clip, IM_COL32(33, 146, 255, 255)},
+    {anim_graph_node_type::ik, IM_COL32(0, 172, 193, 255)},
+    {anim_graph_node_type::layer, IM_COL32(255, 196, 0, 255)},
     {anim_graph_node_type::param_comparison, IM_COL32(39, 0, 130, 255)},
     {anim_graph_node_type::param, IM_COL32(250, 218, 157, 255)},
     {anim_graph_node_type::random, IM_COL32(220, 95, 0, 255)},
@@ -90,12 +99,18 @@ static constexpr ImVec4 weight_color_full{0.95F, 0.95F, 0.95F, 1.0F};
 static constexpr ImVec4 weight_color_none{0.45F, 0.45F, 0.45F, 1.0F};
 static constexpr ImVec4 weight_color_inactive{0.3F, 0.3F, 0.3F, 1.0F};
 
+// Node's own share of graph computation time at which it's colored as the most expensive one
+static constexpr float cost_share_full{0.25F};
+static constexpr ImVec4 cost_color_full{0.55F, 0.12F, 0.1F, 1.0F};
+
 static constexpr float phase_bar_height{2.5F};
 static constexpr ImVec2 phase_bar_indentation{20.0F, 4.0F};
 
 static constexpr ImVec2 node_min_size_and{150.0F, 50.0F};
 static constexpr ImVec2 node_min_size_blend{150.0F, 50.0F};
 static constexpr ImVec2 node_min_size_clip{100.0F, 50.0F};
+static constexpr ImVec2 node_min_size_ik{150.0F, 50.0F};
+static constexpr ImVec2 node_min_size_layer{150.0F, 50.0F};
 static constexpr ImVec2 node_min_size_param_comparison{150.0F, 50.0F};
 static constexpr ImVec2 node_min_size_param{100.0F, 50.0F};
 static constexpr ImVec2 node_min_size_random{150.0F, 50.0F};
@@ -353,6 +368,15 @@ float anim_graph_editor::get_player_node_weight(
         }
       } break;
 
+      case anim_graph_node_type::layer: {
+        const auto& node_layer{
+            polymorphic_downcast<const anim_graph_player_node_layer*>(other_node.get())};
+
+        if (node_layer->get_layer_node() == &player_node) {
+          return node_layer->get_current_weight();
+        }
+      } break;
+
       default: {
       } break;
     }
@@ -363,6 +387,16 @@ float anim_graph_editor::get_player_node_weight(
   return _player->is_player_node_active(player_node) ? 1.0F : 0.0F;
 }
 
+const anim_graph_player_node_cost* anim_graph_editor::get_player_node_cost(
+    const anim_graph_node_base& node) const
+{
+  if (_player == nullptr) {
+    return nullptr;
+  }
+
+  return _player->get_profiled_node_cost(node.get_id());
+}
+
 std::vector<const anim_graph_node_state*> anim_graph_editor::get_transition_sources(
     const anim_graph_node_state_transition& node_transition)
 {
@@ -408,6 +442,20 @@ ImVec4 anim_graph_editor::get_node_weight_color(const anim_graph_node_base& node
   return color;
 }
 
+ImVec4 anim_graph_editor::get_node_cost_color(const anim_graph_node_base& node) const
+{
+  const ImVec4 color_default{ax::NodeEditor::GetStyle().Colors[ax::NodeEditor::StyleColor_NodeBg]};
+
+  const anim_graph_player_node_cost* cost{get_player_node_cost(node)};
+  const float computation_us{_player != nullptr ? _player->get_profiled_computation_us() : 0.0F};
+  if (cost == nullptr || computation_us <= 0.0F) {
+    return color_default;
+  }
+
+  const float share{(cost->self_us + cost->jobs_us) / computation_us};
+  return ImLerp(color_default, cost_color_full, std::clamp(share / cost_share_full, 0.0F, 1.0F));
+}
+
 ImVec4 anim_graph_editor::get_link_weight_color(const anim_graph_node_base& node_from,
                                                 const anim_graph_node_base& node_to) const
 {
@@ -606,6 +654,33 @@ void anim_graph_editor::render_output_pin_and_link(const anim_graph_node_base& n
   }
 }
 
+void anim_graph_editor::render_node_cost(const anim_graph_node_base& node) const
+{
+  if (_player == nullptr || !_player->is_profiling_enabled()) {
+    return;
+  }
+
+  // Show subtree's share of graph computation,
+  // node's own cost is shown with a background color
+
+  std::string text{"-"};
+
+  const anim_graph_player_node_cost* cost{get_player_node_cost(node)};
+  const float computation_us{_player->get_profiled_computation_us()};
+  if (cost != nullptr && computation_us > 0.0F) {
+    text = fmt::format("{:.1f}us ({:.0f}%), jobs: {:.1f}", cost->subtree_us,
+                       cost->subtree_us / computation_us * 100.0F, cost->jobs_count);
+  }
+
+  ImGui::BeginHorizontal("cost");
+  {
+    ImGui::Spring();
+    ImGui::TextDisabled("%s", text.c_str());
+    ImGui::Spring();
+  }
+  ImGui::EndHorizontal();
+}
+
 anim_graph_editor::deferred_imgui_render anim_graph_editor::create_phase_bar_deferred_renderer(
     const anim_graph_node_base& node)
 {
@@ -662,6 +737,7 @@ void anim_graph_editor::render_node(const anim_graph_node_base& node)
 
   ax::NodeEditor::PushStyleColor(ax::NodeEditor::StyleColor_NodeBorder,
                                  get_node_weight_color(node));
+  ax::NodeEditor::PushStyleColor(ax::NodeEditor::StyleColor_NodeBg, get_node_cost_color(node));
 
   // We need to `ImGui::PushID` as well,
   // because nested scope ids can be repeated between nodes.
@@ -685,6 +761,14 @@ void anim_graph_editor::render_node(const anim_graph_node_base& node)
       render_node_clip(*polymorphic_downcast<const anim_graph_node_clip*>(&node));
     } break;
 
+    case anim_graph_node_type::ik: {
+      render_node_ik(*polymorphic_downcast<const anim_graph_node_ik*>(&node));
+    } break;
+
+    case anim_graph_node_type::layer: {
+      render_node_layer(*polymorphic_downcast<const anim_graph_node_layer*>(&node));
+    } break;
+
     case anim_graph_node_type::param_comparison: {
       render_node_param_comparison(
           *polymorphic_downcast<const anim_graph_node_param_comparison*>(&node));
@@ -728,12 +812,14 @@ void anim_graph_editor::render_node(const anim_graph_node_base& node)
     } break;
   }
 
+  render_node_cost(node);
+
   ImGui::PopID();
   ax::NodeEditor::EndNode();
 
   render_node_accent_mark(node);
 
-  ax::NodeEditor::PopStyleColor(1);
+  ax::NodeEditor::PopStyleColor(2);
 }
 
 void anim_graph_editor::render_node_and(const anim_graph_node_and& node)
@@ -811,6 +897,119 @@ void anim_graph_editor::render_node_clip(const anim_graph_node_clip& node) const
   ImGui::EndVertical();
 }
 
+void anim_graph_editor::render_node_ik(const anim_graph_node_ik& node)
+{
+  using namespace eely::internal;
+
+  static const std::unordered_map<ik_limb, const char*> limb_to_label{
+      {ik_limb::left_arm, "left arm"},
+      {ik_limb::right_arm, "right arm"},
+      {ik_limb::left_leg, "left leg"},
+      {ik_limb::right_leg, "right leg"}};
+
+  const bool fabrik{node.get_solver() == anim_graph_node_ik::solver::fabrik};
+
+  ImGui::BeginVertical("root");
+  {
+    set_node_min_size(node_min_size_ik);
+
+    render_node_header_default(node, fabrik ? "IK [FABRIK]" : "IK [TWO BONE]");
+
+    ImGui::BeginHorizontal("chain");
+    {
+      ImGui::TextUnformatted(fabrik ? "chain:" : "limb:");
+      ImGui::BeginDisabled(!_editable);
+      ImGui::Button(fabrik ? fmt::format("{} - {}", node.get_chain_root_joint_id(),
+                                         node.get_chain_tip_joint_id())
+                                 .c_str()
+                           : limb_to_label.at(node.get_limb()));
+      ImGui::EndDisabled();
+    }
+    ImGui::EndHorizontal();
+
+    // Show how much work FABRIK solver did on a last play
+
+    const auto* player_node_ik{
+        polymorphic_downcast<const anim_graph_player_node_ik*>(get_player_node(node))};
+    if (fabrik && player_node_ik != nullptr) {
+      const ik_fabrik_result& result{player_node_ik->get_last_fabrik_result()};
+
+      ImGui::BeginHorizontal("result");
+      {
+        ImGui::TextUnformatted(
+            fmt::format("iterations: {}, error: {:.4f}", result.iterations, result.error)
+                .c_str());
+      }
+      ImGui::EndHorizontal();
+    }
+
+    ImGui::BeginHorizontal("body");
+    {
+      ImGui::Spring();
+
+      ImGui::BeginVertical("pins_output");
+      {
+        const std::array<std::optional<int>, 3>& target_node_ids{node.get_target_node_ids()};
+
+        render_output_pin_and_link(node, 0, pin_location::right, "pose", node.get_pose_node_id());
+        render_output_pin_and_link(node, 1, pin_location::right, "x", target_node_ids[0]);
+        render_output_pin_and_link(node, 2, pin_location::right, "y", target_node_ids[1]);
+        render_output_pin_and_link(node, 3, pin_location::right, "z", target_node_ids[2]);
+        render_output_pin_and_link(node, 4, pin_location::right, "weight",
+                                   node.get_weight_node_id());
+      }
+      ImGui::EndVertical();
+    }
+    ImGui::EndHorizontal();
+  }
+  ImGui::EndVertical();
+}
+
+void anim_graph_editor::render_node_layer(const anim_graph_node_layer& node)
+{
+  ImGui::BeginVertical("root");
+  {
+    set_node_min_size(node_min_size_layer);
+
+    render_node_header_default(node, "LAYER");
+
+    ImGui::BeginHorizontal("mode");
+    {
+      ImGui::TextUnformatted("mode:");
+      ImGui::BeginDisabled(!_editable);
+      ImGui::Button(node.get_mode() == anim_graph_node_layer::mode::blend ? "blend" : "add");
+      ImGui::EndDisabled();
+    }
+    ImGui::EndHorizontal();
+
+    ImGui::BeginHorizontal("mask");
+    {
+      ImGui::TextUnformatted("mask:");
+      ImGui::BeginDisabled(!_editable);
+      ImGui::Button(node.get_skeleton_mask_id().c_str());
+      ImGui::EndDisabled();
+    }
+    ImGui::EndHorizontal();
+
+    ImGui::BeginHorizontal("body");
+    {
+      ImGui::Spring();
+
+      ImGui::BeginVertical("pins_output");
+      {
+        render_output_pin_and_link(node, 0, pin_location::right, "weight",
+                                   node.get_weight_node_id());
+        render_output_pin_and_link(node, 1, pin_location::right, "base", node.get_base_node_id());
+        render_output_pin_and_link(node, 2, pin_location::right, "layer",
+                                   node.get_layer_node_id());
+      }
+      ImGui::EndVertical();
+    }
+    ImGui::EndHorizontal();
+  }
+  ImGui::EndVertical();
+}
+
 void anim_graph_editor::render_node_param_comparison(
     const anim_graph_node_param_comparison& node) const
 {
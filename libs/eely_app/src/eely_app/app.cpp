@@ -99,6 +99,10 @@ app::app(const unsigned int width, const unsigned int height, const std::string&
   bgfx_init.resolution.height = height;
   bgfx_init.resolution.reset = bgfx_reset_flags;
   bgfx_init.platformData = bgfx_platform_data;
+
+  // Instance data of skeletons is allocated from transient vertex memory every frame,
+  // default size is enough for a few hundred skeletons only
+  bgfx_init.limits.transientVbSize = 64 * 1024 * 1024;
   if (!bgfx::init(bgfx_init)) {
     throw std::runtime_error{"bgfx::init error"};
   }
@@ -18,21 +18,27 @@
 #endif
 
 namespace eely {
-std::filesystem::path get_executable_dir()
+std::filesystem::path get_executable_path()
 {
-  static const std::filesystem::path executable_dir = []() {
+  static const std::filesystem::path executable_path = []() {
 #if EELY_PLATFORM_WIN64
     std::array<WCHAR, MAX_PATH> path;
     if (GetModuleFileNameW(NULL, path.data(), MAX_PATH) != 0) {
-      return std::filesystem::path{path.data()}.parent_path();
+      return std::filesystem::path{path.data()};
     }
 
-    throw std::runtime_error("Couldn't get executable dir");
+    throw std::runtime_error("Couldn't get executable path");
 #else
     static_assert(false, "Platform is not supported");
 #endif
   }();
 
+  return executable_path;
+}
+
+std::filesystem::path get_executable_dir()
+{
+  static const std::filesystem::path executable_dir{get_executable_path().parent_path()};
   return executable_dir;
 }
 
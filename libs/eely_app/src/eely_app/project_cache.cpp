@@ -0,0 +1,167 @@
+#include "eely_app/project_cache.h"
+
+#include "eely_app/base_utils.h"
+#include "eely_app/filesystem_utils.h"
+
+#include <eely/project/project.h>
+
+#include <gsl/narrow>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <ios>
+#include <memory>
+#include <span>
+#include <system_error>
+#include <vector>
+
+namespace eely {
+// Header written in front of a cooked project in a cache file.
+struct project_cache_header final {
+  // Identifies cache files.
+  uint32_t magic{0};
+
+  // Version of cache file layout.
+  uint32_t version{0};
+
+  // Hash of the executable and sources a project was cooked from.
+  uint64_t fingerprint{0};
+
+  // Size of a cooked project following the header.
+  uint64_t project_size{0};
+};
+
+static constexpr uint32_t project_cache_magic{0x45'45'4C'59};
+static constexpr uint32_t project_cache_version{1};
+
+static size_t fingerprint_add_file(const size_t fingerprint, const std::filesystem::path& path)
+{
+  size_t result{hash_combine(fingerprint, path)};
+  result = hash_combine(result, std::filesystem::file_size(path));
+  result = hash_combine(result, std::filesystem::last_write_time(path).time_since_epoch().count());
+  return result;
+}
+
+static size_t calculate_fingerprint(const std::vector<std::filesystem::path>& source_paths)
+{
+  namespace fs = std::filesystem;
+
+  // Executable is taken into account, since it contains code that imports and cooks resources
+  size_t result{fingerprint_add_file(0, get_executable_path())};
+
+  for (const fs::path& source_path : source_paths) {
+    if (!fs::is_directory(source_path)) {
+      result = fingerprint_add_file(result, source_path);
+      continue;
+    }
+
+    // Directory iteration order is unspecified, so files are sorted to get the same hash
+    std::vector<fs::path> file_paths;
+    for (const fs::directory_entry& entry : fs::recursive_directory_iterator{source_path}) {
+      if (entry.is_regular_file()) {
+        file_paths.push_back(entry.path());
+      }
+    }
+
+    std::sort(file_paths.begin(), file_paths.end());
+
+    for (const fs::path& file_path : file_paths) {
+      result = fingerprint_add_file(result, file_path);
+    }
+  }
+
+  return result;
+}
+
+static std::unique_ptr<project> try_load(const std::filesystem::path& cache_path,
+                                         const size_t fingerprint)
+{
+  std::error_code error_code;
+  const uintmax_t file_size{std::filesystem::file_size(cache_path, error_code)};
+  if (error_code || file_size <= sizeof(project_cache_header)) {
+    return nullptr;
+  }
+
+  std::vector<std::byte> data{load_binary(cache_path)};
+
+  project_cache_header header;
+  std::memcpy(&header, data.data(), sizeof(header));
+
+  if (header.magic != project_cache_magic || header.version != project_cache_version ||
+      header.fingerprint != fingerprint ||
+      header.project_size != data.size() - sizeof(project_cache_header)) {
+    return nullptr;
+  }
+
+  // Cache that cannot be loaded is treated as stale, so that the project is cooked again
+  try {
+    return std::make_unique<project>(std::span{data}.subspan(sizeof(project_cache_header)));
+  }
+  catch (const std::exception&) {
+    return nullptr;
+  }
+}
+
+static void write(const std::filesystem::path& cache_path,
+                  const size_t fingerprint,
+                  const std::span<const std::byte> project_buffer)
+{
+  const project_cache_header header{.magic = project_cache_magic,
+                                    .version = project_cache_version,
+                                    .fingerprint = fingerprint,
+                                    .project_size = project_buffer.size()};
+
+  // Cache is written into a temporary file first, so that an interrupted write
+  // does not leave a corrupted cache behind.
+  // Cache is optional, so it is fine if it cannot be written
+  std::filesystem::path temp_path{cache_path};
+  temp_path += ".tmp";
+
+  {
+    std::ofstream file{temp_path, std::ios::binary | std::ios::trunc};
+
+    // NOLINTBEGIN(cppcoreguidelines-pro-type-reinterpret-cast), old interface
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(project_buffer.data()),
+               gsl::narrow<std::streamsize>(project_buffer.size()));
+    // NOLINTEND(cppcoreguidelines-pro-type-reinterpret-cast)
+
+    if (!file) {
+      return;
+    }
+  }
+
+  std::error_code error_code;
+  std::filesystem::rename(temp_path, cache_path, error_code);
+}
+
+std::unique_ptr<project> project_load_cached(const std::filesystem::path& cache_path,
+                                             const std::vector<std::filesystem::path>& source_paths,
+                                             const project_cook_function& cook)
+{
+  const size_t fingerprint{calculate_fingerprint(source_paths)};
+
+  std::unique_ptr<project> result{try_load(cache_path, fingerprint)};
+  if (result != nullptr) {
+    return result;
+  }
+
+  std::vector<std::byte> buffer{cook()};
+  write(cache_path, fingerprint, buffer);
+
+  return std::make_unique<project>(buffer);
+}
+
+std::unique_ptr<project> project_load_cached(const project_cook_function& cook)
+{
+  std::filesystem::path cache_path{get_executable_path()};
+  cache_path.replace_extension(".eely_project");
+
+  return project_load_cached(cache_path, {get_executable_dir() / "res"}, cook);
+}
+}  // namespace eely
\ No newline at end of file
@@ -0,0 +1,196 @@
+#include "eely_app/render_skeleton_instances.h"
+
+#include "eely_app/component_skeleton.h"
+#include "eely_app/component_transform.h"
+#include "eely_app/matrix4x4.h"
+
+#include <eely/base/base_utils.h>
+#include <eely/math/elliptical_cone.h>
+#include <eely/math/float3.h>
+#include <eely/math/float4.h>
+#include <eely/math/transform.h>
+#include <eely/skeleton/skeleton.h>
+#include <eely/skeleton/skeleton_pose.h>
+
+#include <bgfx/bgfx.h>
+#include <bgfx/defines.h>
+
+#include <entt/entity/registry.hpp>
+
+#include <gsl/narrow>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <span>
+
+namespace eely {
+// Instances are copied into instance buffers as is.
+static_assert(sizeof(render_bone_instance) == 3 * sizeof(float4));
+static_assert(sizeof(matrix4x4) == 16 * sizeof(float));
+
+// Height of constraint limit cones.
+static constexpr float constraint_limits_cone_height{0.1F};
+
+static void gather_bones(const component_skeleton& component_skeleton,
+                         const component_transform& component_transform,
+                         std::vector<render_bone_instance>& out_bones)
+{
+  if (!component_skeleton.pose_render) {
+    return;
+  }
+
+  const skeleton& skeleton{*component_skeleton.skeleton};
+  const skeleton_pose& pose{component_skeleton.pose};
+
+  const auto get_joint_location = [&](const gsl::index index) {
+    const float3 location{transform_location(component_transform.transform,
+                                             pose.get_transform_object_space(index).translation)};
+    return float4{location.x, location.y, location.z, 1.0F};
+  };
+
+  const gsl::index joints_count{skeleton.get_joints_count()};
+  for (gsl::index i{0}; i < joints_count; ++i) {
+    const std::optional<gsl::index> parent_index{skeleton.get_joint_parent_index(i)};
+    if (!parent_index.has_value()) {
+      continue;
+    }
+
+    out_bones.push_back({.from = get_joint_location(i),
+                         .to = get_joint_location(parent_index.value()),
+                         .color = component_skeleton.pose_render_color});
+  }
+}
+
+static void gather_joints(const component_skeleton& component_skeleton,
+                          const component_transform& component_transform,
+                          render_skeleton_instances& out_instances)
+{
+  using namespace eely::internal;
+
+  for (const auto& [id, flags] : component_skeleton.joint_renders) {
+    if (flags == component_skeleton::joint_render_flags::none) {
+      continue;
+    }
+
+    const std::optional<gsl::index> index_opt{component_skeleton.skeleton->get_joint_index(id)};
+    if (!index_opt.has_value()) {
+      continue;
+    }
+
+    const gsl::index index{index_opt.value()};
+
+    const transform joint_world_transform{
+        component_transform.transform * component_skeleton.pose.get_transform_object_space(index)};
+
+    if (has_flag(flags, component_skeleton::joint_render_flags::frame)) {
+      transform frame_transform{joint_world_transform};
+      frame_transform.scale = float3{0.3F, 0.3F, 0.3F};
+      out_instances.joint_frames.push_back(matrix4x4_from_transform(frame_transform));
+    }
+
+    const std::optional<gsl::index> parent_index_opt{
+        component_skeleton.skeleton->get_joint_parent_index(index)};
+
+    const skeleton::constraint& constraint{component_skeleton.skeleton->get_constraint(index)};
+
+    // Frame of joint's constraint attached to its parent
+    std::optional<transform> parent_constraint_frame;
+    if (parent_index_opt.has_value()) {
+      const gsl::index parent_index{parent_index_opt.value()};
+
+      const transform parent_joint_world_transform{
+          component_transform.transform *
+          component_skeleton.pose.get_transform_object_space(parent_index)};
+
+      parent_constraint_frame = component_transform.transform * parent_joint_world_transform;
+      parent_constraint_frame->translation = joint_world_transform.translation;
+      parent_constraint_frame->rotation =
+          parent_constraint_frame->rotation * constraint.parent_constraint_delta;
+    }
+
+    if (has_flag(flags, component_skeleton::joint_render_flags::constraint_parent_frame) &&
+        parent_constraint_frame.has_value()) {
+      transform frame_transform{parent_constraint_frame.value()};
+      frame_transform.scale = float3{0.5F, 0.5F, 0.5F};
+      out_instances.joint_frames.push_back(matrix4x4_from_transform(frame_transform));
+    }
+
+    if (has_flag(flags, component_skeleton::joint_render_flags::constraint_child_frame)) {
+      transform frame_transform{component_transform.transform * joint_world_transform};
+      frame_transform.rotation = frame_transform.rotation * constraint.child_constraint_delta;
+      frame_transform.scale = float3{0.5F, 0.5F, 0.5F};
+      out_instances.joint_frames.push_back(matrix4x4_from_transform(frame_transform));
+    }
+
+    // TODO: render twist & separate swing limits
+    if (has_flag(flags, component_skeleton::joint_render_flags::constraint_limits) &&
+        parent_constraint_frame.has_value() && constraint.limit_swing_y_rad.has_value() &&
+        constraint.limit_swing_z_rad.has_value()) {
+      // Unit cone along +X axis is scaled into an elliptical one,
+      // ellipse's X radius goes along Z axis and Y radius along Y axis
+      const elliptical_cone cone{elliptical_cone_from_height_and_angles(
+          constraint_limits_cone_height, constraint.limit_swing_y_rad.value(),
+          constraint.limit_swing_z_rad.value())};
+
+      transform cone_transform{parent_constraint_frame.value()};
+      cone_transform.scale = float3{cone.height, cone.ellipse.radius_y, cone.ellipse.radius_x};
+      out_instances.constraint_limits.push_back(matrix4x4_from_transform(cone_transform));
+    }
+  }
+}
+
+void render_skeleton_instances_gather(const entt::registry& registry,
+                                      render_skeleton_instances& out_instances)
+{
+  out_instances.bones.clear();
+  out_instances.joint_frames.clear();
+  out_instances.constraint_limits.clear();
+
+  auto view{registry.view<const component_transform, const component_skeleton>()};
+  for (const entt::entity entity : view) {
+    const auto& comp_transform{view.get<const component_transform>(entity)};
+    const auto& comp_skeleton{view.get<const component_skeleton>(entity)};
+
+    gather_bones(comp_skeleton, comp_transform, out_instances.bones);
+    gather_joints(comp_skeleton, comp_transform, out_instances);
+  }
+}
+
+uint32_t render_instances_submit(const bgfx::ViewId view_id,
+                                 const std::span<const std::byte> instances_data,
+                                 const uint16_t instance_stride,
+                                 const bgfx::VertexBufferHandle vbuffer_handle,
+                                 const bgfx::IndexBufferHandle ibuffer_handle,
+                                 const bgfx::ProgramHandle program_handle,
+                                 const uint64_t state)
+{
+  Expects(instance_stride > 0 && instance_stride % 16 == 0);
+  Expects(instances_data.size() % instance_stride == 0);
+
+  if ((bgfx::getCaps()->supported & BGFX_CAPS_INSTANCING) == 0) {
+    return 0;
+  }
+
+  // Transient memory is limited per frame, render as many instances as it can fit
+  const uint32_t instances_count{bgfx::getAvailInstanceDataBuffer(
+      gsl::narrow<uint32_t>(instances_data.size() / instance_stride), instance_stride)};
+  if (instances_count == 0) {
+    return 0;
+  }
+
+  bgfx::InstanceDataBuffer bgfx_idbuffer;
+  bgfx::allocInstanceDataBuffer(&bgfx_idbuffer, instances_count, instance_stride);
+  std::memcpy(bgfx_idbuffer.data, instances_data.data(),
+              static_cast<size_t>(instances_count) * instance_stride);
+
+  bgfx::setVertexBuffer(0, vbuffer_handle);
+  bgfx::setIndexBuffer(ibuffer_handle);
+  bgfx::setInstanceDataBuffer(&bgfx_idbuffer);
+  bgfx::setState(state);
+  bgfx::submit(view_id, program_handle);
+
+  return instances_count;
+}
+}  // namespace eely
\ No newline at end of file
@@ -6,38 +6,77 @@
 
 #include <entt/entity/registry.hpp>
 
+#include <algorithm>
+#include <execution>
+#include <vector>
+
 namespace eely {
-void system_skeleton_update(app& /*app*/, entt::registry& registry, const float dt_s)
+static void update_clip(component_clip& component_clip,
+                        component_skeleton& component_skeleton,
+                        const float dt_s)
 {
-  auto clips_view{registry.view<component_skeleton, component_clip>()};
-  for (entt::entity entity : clips_view) {
-    component_clip& component_clip{clips_view.get<eely::component_clip>(entity)};
-    if (component_clip.player == nullptr) {
-      continue;
-    }
+  if (component_clip.player == nullptr) {
+    return;
+  }
+
+  if (component_clip.play_time_s > component_clip.player->get_duration_s()) {
+    component_clip.play_time_s = 0.0F;
+  }
+
+  component_clip.player->play(component_clip.play_time_s, component_skeleton.pose);
 
-    component_skeleton& component_skeleton{clips_view.get<eely::component_skeleton>(entity)};
+  component_clip.play_time_s += dt_s * component_clip.speed;
+}
 
-    if (component_clip.play_time_s > component_clip.player->get_duration_s()) {
-      component_clip.play_time_s = 0.0F;
-    }
+static void update_anim_graph(component_anim_graph& component_anim_graph,
+                              component_skeleton& component_skeleton,
+                              const float dt_s)
+{
+  if (component_anim_graph.player == nullptr) {
+    return;
+  }
 
-    component_clip.player->play(component_clip.play_time_s, component_skeleton.pose);
+  component_anim_graph.player->play(dt_s, *component_anim_graph.params, component_skeleton.pose);
+}
 
-    component_clip.play_time_s += dt_s * component_clip.speed;
+void system_skeleton_update(app& /*app*/, entt::registry& registry, const float dt_s)
+{
+  auto clips_view{registry.view<component_skeleton, component_clip>()};
+  for (entt::entity entity : clips_view) {
+    update_clip(clips_view.get<component_clip>(entity), clips_view.get<component_skeleton>(entity),
+                dt_s);
   }
 
   auto anim_graphs_view{registry.view<component_skeleton, component_anim_graph>()};
   for (entt::entity entity : anim_graphs_view) {
-    component_anim_graph& component_anim_graph{
-        anim_graphs_view.get<eely::component_anim_graph>(entity)};
-    if (component_anim_graph.player == nullptr) {
-      continue;
-    }
+    update_anim_graph(anim_graphs_view.get<component_anim_graph>(entity),
+                      anim_graphs_view.get<component_skeleton>(entity), dt_s);
+  }
+}
 
-    component_skeleton& component_skeleton{anim_graphs_view.get<eely::component_skeleton>(entity)};
+void system_skeleton_update_parallel(app& /*app*/, entt::registry& registry, const float dt_s)
+{
+  // Players don't share any mutable state, so each entity can be updated independently.
+  // Entities are gathered into a contiguous list first,
+  // since views do not provide random access iterators needed for good work splitting.
+  // Components are only read via `get` during the update, which does not modify the registry.
 
-    component_anim_graph.player->play(dt_s, *component_anim_graph.params, component_skeleton.pose);
-  }
+  std::vector<entt::entity> entities;
+
+  auto clips_view{registry.view<component_skeleton, component_clip>()};
+  entities.assign(clips_view.begin(), clips_view.end());
+  std::for_each(std::execution::par, entities.begin(), entities.end(),
+                [&clips_view, dt_s](const entt::entity entity) {
+                  update_clip(clips_view.get<component_clip>(entity),
+                              clips_view.get<component_skeleton>(entity), dt_s);
+                });
+
+  auto anim_graphs_view{registry.view<component_skeleton, component_anim_graph>()};
+  entities.assign(anim_graphs_view.begin(), anim_graphs_view.end());
+  std::for_each(std::execution::par, entities.begin(), entities.end(),
+                [&anim_graphs_view, dt_s](const entt::entity entity) {
+                  update_anim_graph(anim_graphs_view.get<component_anim_graph>(entity),
+                                    anim_graphs_view.get<component_skeleton>(entity), dt_s);
+                });
 }
 }  // namespace eely
\ No newline at end of file
@@ -0,0 +1,765 @@
+#include "tests/test_utils.h"
+
+#include <eely/anim_graph/anim_graph.h>
+#include <eely/anim_graph/anim_graph_node_and.h>
+#include <eely/anim_graph/anim_graph_node_clip.h>
+#include <eely/anim_graph/anim_graph_node_param_comparison.h>
+#include <eely/anim_graph/anim_graph_node_random.h>
+#include <eely/anim_graph/anim_graph_node_state.h>
+#include <eely/anim_graph/anim_graph_node_state_condition.h>
+#include <eely/anim_graph/anim_graph_node_state_machine.h>
+#include <eely/anim_graph/anim_graph_node_state_transition.h>
+#include <eely/anim_graph/anim_graph_player.h>
+#include <eely/anim_graph/anim_graph_player_node_pose_base.h>
+#include <eely/anim_graph/anim_graph_uncooked.h>
+#include <eely/base/counting_memory_resource.h>
+#include <eely/clip/clip_uncooked.h>
+#include <eely/math/float3.h>
+#include <eely/math/transform.h>
+#include <eely/params/params.h>
+#include <eely/project/project.h>
+#include <eely/project/project_uncooked.h>
+#include <eely/skeleton/skeleton.h>
+#include <eely/skeleton/skeleton_pose.h>
+#include <eely/skeleton/skeleton_uncooked.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace eely {
+// Add a two joint skeleton used by all graphs in these tests.
+static void add_test_skeleton(project_uncooked& project_uncooked)
+{
+  auto& skeleton_uncooked{project_uncooked.add_resource<eely::skeleton_uncooked>("skeleton")};
+  skeleton_uncooked.get_joints() = {
+      {.id = "root", .parent_index = std::nullopt, .rest_pose_transform = transform{}},
+      {.id = "child",
+       .parent_index = 0,
+       .rest_pose_transform = transform{float3{1.0F, 0.0F, 0.0F}}}};
+}
+
+// Add a clip that moves root along X axis with unit speed,
+// `y` offsets root along Y axis to tell clips apart.
+static void add_test_clip(project_uncooked& project_uncooked,
+                          const string_id& id,
+                          const float duration_s,
+                          const float y = 0.0F)
+{
+  auto& clip_uncooked{project_uncooked.add_resource<eely::clip_uncooked>(id)};
+  clip_uncooked.set_target_skeleton_id("skeleton");
+  clip_uncooked.set_compression_scheme(clip_compression_scheme::none);
+  clip_uncooked.set_tracks(
+      {{.joint_id = "root",
+        .keys = {{0.0F, {.translation = float3{0.0F, y, 0.0F}}},
+                 {duration_s, {.translation = float3{duration_s, y, 0.0F}}}}}});
+}
+
+// Add a state machine that goes from clip "a" to clip "b" in the middle of "a".
+// Return id of the state machine node.
+static int add_test_state_machine(anim_graph_uncooked& graph_uncooked)
+{
+  auto& node_clip_a{graph_uncooked.add_node<anim_graph_node_clip>()};
+  node_clip_a.set_clip_id("a");
+  auto& node_clip_b{graph_uncooked.add_node<anim_graph_node_clip>()};
+  node_clip_b.set_clip_id("b");
+
+  auto& node_state_a{graph_uncooked.add_node<anim_graph_node_state>()};
+  node_state_a.set_name("a");
+  node_state_a.set_pose_node(node_clip_a.get_id());
+  auto& node_state_b{graph_uncooked.add_node<anim_graph_node_state>()};
+  node_state_b.set_name("b");
+  node_state_b.set_pose_node(node_clip_b.get_id());
+
+  auto& node_condition{graph_uncooked.add_node<anim_graph_node_state_condition>()};
+  node_condition.set_phase(0.5F);
+  auto& node_transition{graph_uncooked.add_node<anim_graph_node_state_transition>()};
+  node_transition.set_condition_node(node_condition.get_id());
+  node_transition.set_destination_state_node(node_state_b.get_id());
+  node_transition.set_duration_s(0.2F);
+  node_state_a.get_out_transition_nodes().push_back(node_transition.get_id());
+
+  auto& node_state_machine{graph_uncooked.add_node<anim_graph_node_state_machine>()};
+  node_state_machine.get_state_nodes() = {node_state_a.get_id(), node_state_b.get_id()};
+  return node_state_machine.get_id();
+}
+
+// Add graph "flat" with a state machine from `add_test_state_machine` as a root,
+// and graph "nested" with the same state machine inside a state of another state machine,
+// which goes to clip "c" when "leave" param is set.
+static void add_test_state_machine_graphs(project_uncooked& project_uncooked)
+{
+  add_test_clip(project_uncooked, "a", 1.0F, 1.0F);
+  add_test_clip(project_uncooked, "b", 1.0F, 2.0F);
+  add_test_clip(project_uncooked, "c", 1.0F, 3.0F);
+
+  auto& graph_flat{project_uncooked.add_resource<anim_graph_uncooked>("flat")};
+  graph_flat.set_skeleton_id("skeleton");
+  graph_flat.set_root_node_id(add_test_state_machine(graph_flat));
+
+  auto& graph_nested{project_uncooked.add_resource<anim_graph_uncooked>("nested")};
+  graph_nested.set_skeleton_id("skeleton");
+
+  auto& node_state_inner{graph_nested.add_node<anim_graph_node_state>()};
+  node_state_inner.set_name("inner");
+  node_state_inner.set_pose_node(add_test_state_machine(graph_nested));
+
+  auto& node_clip_c{graph_nested.add_node<anim_graph_node_clip>()};
+  node_clip_c.set_clip_id("c");
+  auto& node_state_c{graph_nested.add_node<anim_graph_node_state>()};
+  node_state_c.set_name("c");
+  node_state_c.set_pose_node(node_clip_c.get_id());
+
+  auto& node_condition{graph_nested.add_node<anim_graph_node_param_comparison>()};
+  node_condition.set_param_id("leave");
+  node_condition.set_value(true);
+  auto& node_transition{graph_nested.add_node<anim_graph_node_state_transition>()};
+  node_transition.set_condition_node(node_condition.get_id());
+  node_transition.set_destination_state_node(node_state_c.get_id());
+  node_transition.set_duration_s(0.0F);
+  node_state_inner.get_out_transition_nodes().push_back(node_transition.get_id());
+
+  auto& node_state_machine{graph_nested.add_node<anim_graph_node_state_machine>()};
+  node_state_machine.get_state_nodes() = {node_state_inner.get_id(), node_state_c.get_id()};
+  graph_nested.set_root_node_id(node_state_machine.get_id());
+}
+
+// Add graph "conditions" that goes from clip "a" to clip "b"
+// when "go" param is set and phase of "a" is past its middle.
+static void add_test_conditions_graph(project_uncooked& project_uncooked)
+{
+  add_test_clip(project_uncooked, "a", 1.0F, 1.0F);
+  add_test_clip(project_uncooked, "b", 1.0F, 2.0F);
+
+  auto& graph_uncooked{project_uncooked.add_resource<anim_graph_uncooked>("conditions")};
+  graph_uncooked.set_skeleton_id("skeleton");
+
+  auto& node_clip_a{graph_uncooked.add_node<anim_graph_node_clip>()};
+  node_clip_a.set_clip_id("a");
+  auto& node_clip_b{graph_uncooked.add_node<anim_graph_node_clip>()};
+  node_clip_b.set_clip_id("b");
+
+  auto& node_state_a{graph_uncooked.add_node<anim_graph_node_state>()};
+  node_state_a.set_name("a");
+  node_state_a.set_pose_node(node_clip_a.get_id());
+  auto& node_state_b{graph_uncooked.add_node<anim_graph_node_state>()};
+  node_state_b.set_name("b");
+  node_state_b.set_pose_node(node_clip_b.get_id());
+
+  auto& node_condition_param{graph_uncooked.add_node<anim_graph_node_param_comparison>()};
+  node_condition_param.set_param_id("go");
+  node_condition_param.set_value(true);
+  auto& node_condition_phase{graph_uncooked.add_node<anim_graph_node_state_condition>()};
+  node_condition_phase.set_phase(0.5F);
+  auto& node_condition{graph_uncooked.add_node<anim_graph_node_and>()};
+  node_condition.get_children_nodes() = {node_condition_param.get_id(),
+                                         node_condition_phase.get_id()};
+
+  auto& node_transition{graph_uncooked.add_node<anim_graph_node_state_transition>()};
+  node_transition.set_condition_node(node_condition.get_id());
+  node_transition.set_destination_state_node(node_state_b.get_id());
+  node_transition.set_duration_s(0.2F);
+  node_state_a.get_out_transition_nodes().push_back(node_transition.get_id());
+
+  auto& node_state_machine{graph_uncooked.add_node<anim_graph_node_state_machine>()};
+  node_state_machine.get_state_nodes() = {node_state_a.get_id(), node_state_b.get_id()};
+  graph_uncooked.set_root_node_id(node_state_machine.get_id());
+}
+
+// Add graph "random" that plays clips "r0" to "r3" in random order,
+// each clip offsets root along Y axis by its number.
+static void add_test_random_graph(project_uncooked& project_uncooked)
+{
+  auto& graph_uncooked{project_uncooked.add_resource<anim_graph_uncooked>("random")};
+  graph_uncooked.set_skeleton_id("skeleton");
+
+  auto& node_random{graph_uncooked.add_node<anim_graph_node_random>()};
+
+  for (int i{0}; i < 4; ++i) {
+    const string_id clip_id{"r" + std::to_string(i)};
+    add_test_clip(project_uncooked, clip_id, 0.2F, static_cast<float>(i));
+
+    auto& node_clip{graph_uncooked.add_node<anim_graph_node_clip>()};
+    node_clip.set_clip_id(clip_id);
+    node_random.get_children_nodes().push_back(node_clip.get_id());
+  }
+
+  graph_uncooked.set_root_node_id(node_random.get_id());
+}
+
+// Play a graph from `add_test_random_graph` seeded with `seed` for `frames_count` frames,
+// and return number of a clip played on every frame.
+static std::vector<int> play_test_random_graph(const anim_graph& graph,
+                                               const skeleton& skeleton,
+                                               const uint32_t seed,
+                                               const int frames_count)
+{
+  params params;
+  anim_graph_player player{graph};
+  player.set_random_seed(seed);
+  skeleton_pose pose{skeleton};
+
+  std::vector<int> clips;
+  for (int i{0}; i < frames_count; ++i) {
+    player.play(0.05F, params, pose);
+    clips.push_back(static_cast<int>(std::lround(pose.get_transform_joint_space(0).translation.y)));
+  }
+
+  return clips;
+}
+
+// Return translation of a root joint along X axis.
+static float get_root_x(const skeleton_pose& pose)
+{
+  return pose.get_transform_joint_space(0).translation.x;
+}
+
+// Play a graph for `frames_count` frames, setting "leave" param from `leave_frame` onwards,
+// and return root translations of every frame.
+static std::vector<float3> play_test_graph(const anim_graph& graph,
+                                           const skeleton& skeleton,
+                                           const int frames_count,
+                                           const int leave_frame)
+{
+  params params;
+  anim_graph_player player{graph};
+  player.set_random_seed(0);
+  skeleton_pose pose{skeleton};
+
+  std::vector<float3> translations;
+  for (int i{0}; i < frames_count; ++i) {
+    params.set_value("leave", i >= leave_frame);
+    player.play(0.05F, params, pose);
+    translations.push_back(pose.get_transform_joint_space(0).translation);
+  }
+
+  return translations;
+}
+}  // namespace eely
+
+TEST(anim_graph_player, update_period)
+{
+  using namespace eely;
+
+  std::vector<std::byte> buffer;
+
+  {
+    project_uncooked project_uncooked{measurement_unit::meters,
+                                      axis_system::y_up_x_right_z_forward};
+    add_test_skeleton(project_uncooked);
+    add_test_clip(project_uncooked, "clip", 10.0F);
+
+    auto& graph_uncooked{project_uncooked.add_resource<anim_graph_uncooked>("graph")};
+    graph_uncooked.set_skeleton_id("skeleton");
+    auto& node_clip{graph_uncooked.add_node<anim_graph_node_clip>()};
+    node_clip.set_clip_id("clip");
+    graph_uncooked.set_root_node_id(node_clip.get_id());
+
+    buffer = project::cook(project_uncooked);
+  }
+
+  project project{buffer};
+  const auto& graph{*project.get_resource<anim_graph>("graph")};
+  const auto& skeleton{*project.get_resource<eely::skeleton>("skeleton")};
+
+  const params params;
+  constexpr float dt_s{0.1F};
+
+  anim_graph_player player_reference{graph};
+  skeleton_pose pose_reference{skeleton};
+
+  anim_graph_player player{graph};
+  player.set_update_period(3, 0);
+  EXPECT_EQ(player.get_update_period(), 3);
+  skeleton_pose pose{skeleton};
+
+  // First call always computes, then every third one does,
+  // and time of skipped calls is passed to the next computation
+  const std::vector<bool> computed_expected{true, false, false, true, false, false, true};
+  for (const bool computed : computed_expected) {
+    EXPECT_EQ(player.is_next_play_computed(), computed);
+
+    player_reference.play(dt_s, params, pose_reference);
+    player.play(dt_s, params, pose);
+
+    if (computed) {
+      EXPECT_NEAR(get_root_x(pose), get_root_x(pose_reference), 1e-4F);
+    }
+  }
+
+  // Skipped calls are extrapolated from the two last computed poses,
+  // which matches linear motion exactly
+  player_reference.play(dt_s, params, pose_reference);
+  player.play(dt_s, params, pose);
+  EXPECT_NEAR(get_root_x(pose), get_root_x(pose_reference), 1e-4F);
+
+  // Extrapolation does not go further than one computation interval
+  const float last_computed_x{get_root_x(pose_reference) - dt_s};
+  player.play(1.0F, params, pose);
+  EXPECT_NEAR(get_root_x(pose), last_computed_x + 3.0F * dt_s, 1e-4F);
+
+  // Offset selects which calls compute
+  anim_graph_player player_offset{graph};
+  player_offset.set_update_period(3, 1);
+  skeleton_pose pose_offset{skeleton};
+
+  const std::vector<bool> computed_offset_expected{true, false, true, false, false, true};
+  for (const bool computed : computed_offset_expected) {
+    EXPECT_EQ(player_offset.is_next_play_computed(), computed);
+    player_offset.play(dt_s, params, pose_offset);
+  }
+
+  // Players with different seeds compute on different calls by default
+  anim_graph_player player_stagger_0{graph};
+  anim_graph_player player_stagger_1{graph};
+  player_stagger_0.set_random_seed(0);
+  player_stagger_1.set_random_seed(1);
+  player_stagger_0.set_update_period(2);
+  player_stagger_1.set_update_period(2);
+  player_stagger_0.play(dt_s, params, pose);
+  player_stagger_1.play(dt_s, params, pose);
+  EXPECT_NE(player_stagger_0.is_next_play_computed(), player_stagger_1.is_next_play_computed());
+
+  // Invalid arguments are rejected in release builds as well
+  EXPECT_THROW(player.set_update_period(0), std::runtime_error);
+  EXPECT_THROW(player.set_update_period(2, -1), std::runtime_error);
+  EXPECT_EQ(player.get_update_period(), 3);
+}
+
+TEST(anim_graph_player, nested_state_condition)
+{
+  using namespace eely;
+
+  std::vector<std::byte> buffer;
+
+  {
+    project_uncooked project_uncooked{measurement_unit::meters,
+                                      axis_system::y_up_x_right_z_forward};
+    add_test_skeleton(project_uncooked);
+    add_test_state_machine_graphs(project_uncooked);
+    buffer = project::cook(project_uncooked);
+  }
+
+  project project{buffer};
+  const auto& graph_flat{*project.get_resource<anim_graph>("flat")};
+  const auto& graph_nested{*project.get_resource<anim_graph>("nested")};
+  const auto& skeleton{*project.get_resource<eely::skeleton>("skeleton")};
+
+  // State condition of the inner machine must check phase of the inner machine,
+  // so that nested machine transitions on the same frames as the standalone one
+  constexpr int frames_count{40};
+  const std::vector<float3> flat{play_test_graph(graph_flat, skeleton, frames_count, frames_count)};
+  const std::vector<float3> nested{
+      play_test_graph(graph_nested, skeleton, frames_count, frames_count)};
+
+  for (int i{0}; i < frames_count; ++i) {
+    EXPECT_NEAR(nested[i].x, flat[i].x, 1e-4F);
+    EXPECT_NEAR(nested[i].y, flat[i].y, 1e-4F);
+  }
+
+  // Inner machine has transitioned from "a" to "b"
+  EXPECT_NEAR(flat.front().y, 1.0F, 1e-4F);
+  EXPECT_NEAR(flat.back().y, 2.0F, 1e-4F);
+
+  // Outer machine still transitions on its own conditions
+  const std::vector<float3> left{play_test_graph(graph_nested, skeleton, frames_count, 5)};
+  EXPECT_NEAR(left.back().y, 3.0F, 1e-4F);
+}
+
+TEST(anim_graph_player, play_concurrently)
+{
+  using namespace eely;
+
+  std::vector<std::byte> buffer;
+
+  {
+    project_uncooked project_uncooked{measurement_unit::meters,
+                                      axis_system::y_up_x_right_z_forward};
+    add_test_skeleton(project_uncooked);
+    add_test_state_machine_graphs(project_uncooked);
+    buffer = project::cook(project_uncooked);
+  }
+
+  project project{buffer};
+  const auto& graph{*project.get_resource<anim_graph>("nested")};
+  const auto& skeleton{*project.get_resource<eely::skeleton>("skeleton")};
+
+  constexpr int frames_count{200};
+  const std::vector<int> leave_frames{30, 70};
+
+  // Players of the same graph share only immutable graph and project data,
+  // so playing them from different threads gives the same results as playing them serially
+  std::vector<std::vector<float3>> serial;
+  for (const int leave_frame : leave_frames) {
+    serial.push_back(play_test_graph(graph, skeleton, frames_count, leave_frame));
+  }
+
+  std::vector<std::vector<float3>> concurrent(leave_frames.size());
+  {
+    std::vector<std::jthread> threads;
+    for (gsl::index i{0}; i < std::ssize(leave_frames); ++i) {
+      threads.emplace_back([&, i]() {
+        concurrent[i] = play_test_graph(graph, skeleton, frames_count, leave_frames[i]);
+      });
+    }
+  }
+
+  for (gsl::index i{0}; i < std::ssize(leave_frames); ++i) {
+    for (int frame{0}; frame < frames_count; ++frame) {
+      EXPECT_EQ(concurrent[i][frame].x, serial[i][frame].x);
+      EXPECT_EQ(concurrent[i][frame].y, serial[i][frame].y);
+      EXPECT_EQ(concurrent[i][frame].z, serial[i][frame].z);
+    }
+  }
+}
+
+TEST(anim_graph_player, cached_conditions)
+{
+  using namespace eely;
+
+  std::vector<std::byte> buffer;
+
+  {
+    project_uncooked project_uncooked{measurement_unit::meters,
+                                      axis_system::y_up_x_right_z_forward};
+    add_test_skeleton(project_uncooked);
+    add_test_conditions_graph(project_uncooked);
+    buffer = project::cook(project_uncooked);
+  }
+
+  project project{buffer};
+  const auto& graph{*project.get_resource<anim_graph>("conditions")};
+  const auto& skeleton{*project.get_resource<eely::skeleton>("skeleton")};
+
+  constexpr int frames_count{60};
+
+  // Results of a play that are visible outside of a player
+  struct frame_result final {
+    float3 translation;
+    std::vector<int> active_nodes;
+  };
+
+  // Play a graph with params returned for every frame
+  const auto play = [&](auto&& get_params) {
+    anim_graph_player player{graph};
+    skeleton_pose pose{skeleton};
+
+    std::vector<frame_result> results;
+    for (int frame{0}; frame < frames_count; ++frame) {
+      player.play(0.05F, get_params(frame), pose);
+
+      frame_result& result{results.emplace_back()};
+      result.translation = pose.get_transform_joint_space(0).translation;
+      for (const auto& node : player.get_nodes()) {
+        if (player.is_player_node_active(*node)) {
+          result.active_nodes.push_back(node->get_id());
+        }
+      }
+    }
+
+    return results;
+  };
+
+  // Param versions are unique across params objects,
+  // alternating between two equal objects makes reference player evaluate conditions on every frame
+  const auto play_uncached = [&](const int go_frame) {
+    std::array<params, 2> params_copies;
+    return play([&](const int frame) -> const params& {
+      params& params{params_copies.at(frame % 2)};
+      params.set_value("go", frame >= go_frame);
+      return params;
+    });
+  };
+
+  const auto expect_equal = [](const std::vector<frame_result>& results,
+                               const std::vector<frame_result>& expected) {
+    ASSERT_EQ(results.size(), expected.size());
+    for (gsl::index i{0}; i < std::ssize(results); ++i) {
+      EXPECT_EQ(results[i].translation.x, expected[i].translation.x);
+      EXPECT_EQ(results[i].translation.y, expected[i].translation.y);
+
+      // Condition nodes are active on frames their cached results are reused
+      EXPECT_EQ(results[i].active_nodes, expected[i].active_nodes);
+    }
+
+    // Transition has happened
+    EXPECT_EQ(results.back().translation.y, 2.0F);
+  };
+
+  // Param changes when phase is already past the middle,
+  // so transition starts right away
+  {
+    params params;
+    const std::vector<frame_result> results{play([&](const int frame) -> const eely::params& {
+      params.set_value("go", frame >= 15);
+      return params;
+    })};
+    expect_equal(results, play_uncached(15));
+  }
+
+  // Param changes when phase is before the middle,
+  // so transition starts once phase crosses it without any param changes
+  {
+    params params;
+    const std::vector<frame_result> results{play([&](const int frame) -> const eely::params& {
+      params.set_value("go", frame >= 25);
+      return params;
+    })};
+    expect_equal(results, play_uncached(25));
+  }
+
+  // Another params object with a different value is passed
+  {
+    std::array<params, 2> params_swapped;
+    params_swapped[0].set_value("go", false);
+    params_swapped[1].set_value("go", true);
+    const std::vector<frame_result> results{play([&](const int frame) -> const eely::params& {
+      return params_swapped.at(frame >= 15 ? 1 : 0);
+    })};
+    expect_equal(results, play_uncached(15));
+  }
+
+  // Params object is recreated at the same address with a different value,
+  // after the same number of changes as the previous one
+  {
+    std::optional<params> params_recreated;
+    const std::vector<frame_result> results{play([&](const int frame) -> const eely::params& {
+      if (frame == 0 || frame == 15) {
+        params_recreated.emplace();
+        params_recreated->set_value("go", frame >= 15);
+      }
+      return *params_recreated;
+    })};
+    expect_equal(results, play_uncached(15));
+  }
+}
+
+TEST(anim_graph_player, memory_resource_bytes)
+{
+  using namespace eely;
+
+  std::vector<std::byte> buffer;
+
+  {
+    project_uncooked project_uncooked{measurement_unit::meters,
+                                      axis_system::y_up_x_right_z_forward};
+    add_test_skeleton(project_uncooked);
+    add_test_state_machine_graphs(project_uncooked);
+    buffer = project::cook(project_uncooked);
+  }
+
+  project project{buffer};
+  const auto& graph{*project.get_resource<anim_graph>("nested")};
+  const auto& skeleton{*project.get_resource<eely::skeleton>("skeleton")};
+
+  params params;
+  params.set_value("leave", false);
+  skeleton_pose pose{skeleton};
+
+  // Nested graph has two state machines, four states, three clips and two transitions,
+  // which is a typical locomotion setup.
+  // Bytes are measured after playing through every state,
+  // so that job queue's lists grown during computations are included
+  counting_memory_resource memory_resource;
+  int64_t bytes_constructed{0};
+  int64_t bytes_played{0};
+
+  {
+    anim_graph_player player{graph, &memory_resource};
+    bytes_constructed = memory_resource.get_allocated_bytes();
+
+    for (int i{0}; i < 40; ++i) {
+      params.set_value("leave", i >= 30);
+      player.play(0.05F, params, pose);
+    }
+
+    bytes_played = memory_resource.get_allocated_bytes();
+  }
+
+  // Player does not keep anything after destruction
+  EXPECT_EQ(memory_resource.get_allocated_bytes(), 0);
+
+  RecordProperty("bytes_constructed", std::to_string(bytes_constructed));
+  RecordProperty("bytes_played", std::to_string(bytes_played));
+
+  // Guard against regressions of runtime nodes' size,
+  // clip cursors, poses and containers owned by nodes are not included
+  EXPECT_GT(bytes_constructed, 0);
+  EXPECT_LE(bytes_played, 3 * 1024);
+}
+
+TEST(anim_graph_player, profiling)
+{
+  using namespace eely;
+
+  std::vector<std::byte> buffer;
+
+  {
+    project_uncooked project_uncooked{measurement_unit::meters,
+                                      axis_system::y_up_x_right_z_forward};
+    add_test_skeleton(project_uncooked);
+    add_test_state_machine_graphs(project_uncooked);
+    buffer = project::cook(project_uncooked);
+  }
+
+  project project{buffer};
+  const auto& graph{*project.get_resource<anim_graph>("nested")};
+  const auto& skeleton{*project.get_resource<eely::skeleton>("skeleton")};
+
+  params params;
+  params.set_value("leave", false);
+  skeleton_pose pose{skeleton};
+
+  anim_graph_player player{graph};
+  const int root_id{graph.get_root_node_id()};
+
+  const auto play_window = [&]() {
+    for (int i{0}; i < anim_graph_player::profiling_window_size; ++i) {
+      player.play(0.05F, params, pose);
+    }
+  };
+
+  // Players don't gather results unless asked to
+
+  EXPECT_FALSE(player.is_profiling_enabled());
+  play_window();
+  EXPECT_EQ(player.get_profiled_computation_us(), 0.0F);
+  EXPECT_EQ(player.get_profiled_node_cost(root_id), nullptr);
+
+  // Results are available after a full window only when compiled with profiling
+
+  player.set_profiling_enabled(true);
+  EXPECT_EQ(player.is_profiling_enabled(), profiling_is_enabled());
+
+  play_window();
+  if (profiling_is_enabled()) {
+    EXPECT_GT(player.get_profiled_computation_us(), 0.0F);
+    EXPECT_NE(player.get_profiled_node_cost(root_id), nullptr);
+  }
+  else {
+    EXPECT_EQ(player.get_profiled_computation_us(), 0.0F);
+    EXPECT_EQ(player.get_profiled_node_cost(root_id), nullptr);
+  }
+
+  // Disabling drops gathered results
+
+  player.set_profiling_enabled(false);
+  EXPECT_FALSE(player.is_profiling_enabled());
+  EXPECT_EQ(player.get_profiled_computation_us(), 0.0F);
+  EXPECT_EQ(player.get_profiled_node_cost(root_id), nullptr);
+}
+
+TEST(anim_graph_player, clip_policies)
+{
+  using namespace eely;
+  using namespace eely::internal;
+
+  static constexpr float sample_interval_s{1.0F / 30.0F};
+
+  std::vector<std::byte> buffer;
+
+  {
+    project_uncooked project_uncooked{measurement_unit::meters,
+                                      axis_system::y_up_x_right_z_forward};
+    add_test_skeleton(project_uncooked);
+    add_test_clip(project_uncooked, "clip", 1.0F);
+    project_uncooked.get_resource<clip_uncooked>("clip")->set_compression_scheme(
+        clip_compression_scheme::acl);
+
+    for (const auto& [id, rounding, looping] :
+         {std::tuple{"default", clip_sample_rounding::none, clip_looping_policy::as_cooked},
+          std::tuple{"floor_wrap", clip_sample_rounding::floor, clip_looping_policy::wrap}}) {
+      auto& graph_uncooked{project_uncooked.add_resource<anim_graph_uncooked>(id)};
+      graph_uncooked.set_skeleton_id("skeleton");
+      auto& node_clip{graph_uncooked.add_node<anim_graph_node_clip>()};
+      node_clip.set_clip_id("clip");
+      node_clip.set_sample_rounding(rounding);
+      node_clip.set_looping_policy(looping);
+      graph_uncooked.set_root_node_id(node_clip.get_id());
+    }
+
+    buffer = project::cook(project_uncooked);
+  }
+
+  project project{buffer};
+  const auto& skeleton{*project.get_resource<eely::skeleton>("skeleton")};
+
+  // Policies are cooked with the node
+  const auto& graph{*project.get_resource<anim_graph>("floor_wrap")};
+  const auto& node_clip{*polymorphic_downcast<const anim_graph_node_clip*>(
+      graph.get_nodes().front().get())};
+  EXPECT_EQ(node_clip.get_sample_rounding(), clip_sample_rounding::floor);
+  EXPECT_EQ(node_clip.get_looping_policy(), clip_looping_policy::wrap);
+
+  // Return `true` if root was at a sample on every frame, and node's duration
+  const auto play = [&](const anim_graph& graph) {
+    const params params;
+    anim_graph_player player{graph};
+    skeleton_pose pose{skeleton};
+
+    bool at_samples{true};
+    for (int i{0}; i < 20; ++i) {
+      player.play(0.05F, params, pose);
+      const float samples{get_root_x(pose) / sample_interval_s};
+      at_samples = at_samples && std::abs(samples - std::round(samples)) < 0.1F;
+    }
+
+    const auto* player_node{polymorphic_downcast<const anim_graph_player_node_pose_base*>(
+        player.get_player_node(graph.get_root_node_id()))};
+    return std::pair{at_samples, player_node->get_duration_s()};
+  };
+
+  // Floor rounding snaps to samples, wrapping makes clip longer by one sample
+  const auto [at_samples_default, duration_default_s] =
+      play(*project.get_resource<anim_graph>("default"));
+  EXPECT_FALSE(at_samples_default);
+  EXPECT_NEAR(duration_default_s, 1.0F, 0.001F);
+
+  const auto [at_samples, duration_s] = play(graph);
+  EXPECT_TRUE(at_samples);
+  EXPECT_NEAR(duration_s, 1.0F + sample_interval_s, 0.001F);
+}
+
+TEST(anim_graph_player, random_seed)
+{
+  using namespace eely;
+
+  std::vector<std::byte> buffer;
+
+  {
+    project_uncooked project_uncooked{measurement_unit::meters,
+                                      axis_system::y_up_x_right_z_forward};
+    add_test_skeleton(project_uncooked);
+    add_test_random_graph(project_uncooked);
+    buffer = project::cook(project_uncooked);
+  }
+
+  project project{buffer};
+  const auto& graph{*project.get_resource<anim_graph>("random")};
+  const auto& skeleton{*project.get_resource<eely::skeleton>("skeleton")};
+
+  // Every clip lasts four frames, so that a hundred choices are made
+  constexpr int frames_count{400};
+
+  const std::vector<int> clips{play_test_random_graph(graph, skeleton, 1, frames_count)};
+
+  // Choices are actually random
+  for (int i{0}; i < 4; ++i) {
+    EXPECT_NE(std::find(clips.begin(), clips.end(), i), clips.end());
+  }
+
+  // Same seed gives the same choices, different seeds diverge
+  EXPECT_EQ(play_test_random_graph(graph, skeleton, 1, frames_count), clips);
+  EXPECT_NE(play_test_random_graph(graph, skeleton, 2, frames_count), clips);
+}
\ No newline at end of file
@@ -84,4 +84,77 @@ TEST(bit_reader_writer, utils)
   reader.read(9);
   EXPECT_EQ(bit_reader_get_bytes_read(reader), 3);
   EXPECT_EQ(bit_writer_get_bytes_written(writer), 3);
+}
+
+TEST(bit_reader_writer, counting)
+{
+  using namespace eely;
+  using namespace eely::internal;
+
+  // Counting writer should advance exactly as a regular one, without a buffer to write into
+
+  std::array<std::byte, 8> buffer;
+
+  bit_writer writer{buffer};
+  bit_writer counting_writer;
+
+  for (bit_writer* w : {&writer, &counting_writer}) {
+    w->write({.value = 0b101, .size_bits = 3});
+    w->align();
+    w->write({.value = 0xFFFF, .size_bits = 16});
+    w->patch({.value = 0b11, .size_bits = 2, .offset_bits = 1});
+    bit_writer_write(*w, 1.0F);
+  }
+
+  EXPECT_EQ(counting_writer.get_bit_position(), writer.get_bit_position());
+  EXPECT_EQ(bit_writer_get_bytes_written(counting_writer), 7);
+}
+
+TEST(bit_reader_writer, bytes)
+{
+  using namespace eely;
+  using namespace eely::internal;
+
+  std::array<std::byte, 13> bytes;
+  for (gsl::index i{0}; i < std::ssize(bytes); ++i) {
+    bytes[i] = static_cast<std::byte>(i * 17 + 3);
+  }
+
+  // Aligned and unaligned bytes must be laid out as if they were written one by one
+
+  std::array<std::byte, 28> expected_buffer{};
+  std::array<std::byte, 28> buffer{};
+
+  bit_writer expected_writer{expected_buffer};
+  bit_writer writer{buffer};
+
+  for (const gsl::index offset_bits : {8, 3}) {
+    expected_writer.write({.value = 0b101, .size_bits = offset_bits});
+    writer.write({.value = 0b101, .size_bits = offset_bits});
+
+    for (const std::byte b : bytes) {
+      expected_writer.write({.value = static_cast<uint32_t>(b), .size_bits = 8});
+    }
+    writer.write_bytes(bytes);
+  }
+
+  EXPECT_EQ(writer.get_bit_position(), expected_writer.get_bit_position());
+  EXPECT_EQ(buffer, expected_buffer);
+
+  bit_reader reader{buffer};
+
+  for (const gsl::index offset_bits : {8, 3}) {
+    EXPECT_EQ(reader.read(offset_bits), 0b101);
+
+    std::array<std::byte, 13> read_bytes;
+    reader.read_bytes(read_bytes);
+    EXPECT_EQ(read_bytes, bytes);
+  }
+
+  reader.align();
+  EXPECT_EQ(reader.get_position_bits(), 224);
+
+  std::array<std::byte, 3> past_end_bytes;
+  EXPECT_ANY_THROW(reader.read_bytes(past_end_bytes));
+  EXPECT_ANY_THROW(writer.write_bytes(bytes));
 }
\ No newline at end of file
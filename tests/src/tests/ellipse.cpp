@@ -5,6 +5,9 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <cmath>
+
 void test_ellipse(const float radius_x, const float radius_y)
 {
   using namespace eely;
@@ -69,6 +72,16 @@ void test_ellipse(const float radius_x, const float radius_y)
       ellipse, ellipse_project_point(ellipse, float2{2 * radius_x, -2 * radius_y})));
   EXPECT_TRUE(ellipse_is_point_on(
       ellipse, ellipse_project_point(ellipse, float2{-2 * radius_x, -2 * radius_y})));
+
+  // `ellipse_project_point_fixed` should agree with iterative projection
+
+  for (const float2& point : {float2{2 * radius_x, 2 * radius_y}, float2{-3 * radius_x, radius_y},
+                              float2{radius_x / 2.0F, -radius_y / 3.0F},
+                              float2{0.1F, 3 * radius_y}, float2{3 * radius_x, -0.1F}}) {
+    const float2 projection{ellipse_project_point_fixed(ellipse, point)};
+    EXPECT_TRUE(ellipse_is_point_on(ellipse, projection));
+    EXPECT_TRUE(float2_near(projection, ellipse_project_point(ellipse, point), 1e-2F));
+  }
 }
 
 TEST(ellipse, ellipse)
@@ -81,4 +94,30 @@ TEST(ellipse, ellipse)
   test_ellipse(4.0F, 4.0F);
   test_ellipse(20.0F, 4.0F);
   test_ellipse(4.0F, 20.0F);
+}
+
+TEST(ellipse, project_point_fixed_error)
+{
+  using namespace eely;
+  using namespace eely::internal;
+
+  const auto distance = [](const float2& a, const float2& b) {
+    return std::hypot(a.x - b.x, a.y - b.y);
+  };
+
+  for (const float ratio : {1.0F, 1.5F, 3.0F, 7.5F, 16.0F, 64.0F}) {
+    const ellipse ellipse{.radius_x = 1.0F, .radius_y = ratio};
+    const float max_error{ellipse_project_point_fixed_max_error * std::max(1.0F, ratio)};
+
+    for (float angle_rad{0.003F}; angle_rad < pi * 2.0F; angle_rad += pi / 90.0F) {
+      for (const float scale : {0.1F, 0.5F, 0.9F, 1.1F, 2.0F, 10.0F}) {
+        const float2 point{std::cos(angle_rad) * scale, std::sin(angle_rad) * scale * ratio};
+
+        const float2 projection{ellipse_project_point_fixed(ellipse, point)};
+        EXPECT_TRUE(ellipse_is_point_on(ellipse, projection));
+        EXPECT_LE(distance(projection, point),
+                  distance(ellipse_project_point(ellipse, point), point) + max_error);
+      }
+    }
+  }
 }
\ No newline at end of file
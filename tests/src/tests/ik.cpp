@@ -0,0 +1,251 @@
+#include "tests/test_utils.h"
+
+#include <eely/ik/ik.h>
+#include <eely/math/float3.h>
+#include <eely/math/quaternion.h>
+#include <eely/project/project.h>
+#include <eely/project/project_uncooked.h>
+#include <eely/skeleton/skeleton.h>
+#include <eely/skeleton/skeleton_pose.h>
+#include <eely/skeleton/skeleton_uncooked.h>
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <span>
+#include <string>
+#include <vector>
+
+TEST(ik, two_bone)
+{
+  using namespace eely;
+
+  std::array<std::byte, 2048> buffer;
+
+  {
+    project_uncooked project_uncooked(measurement_unit::meters,
+                                      axis_system::y_up_x_right_z_forward);
+
+    auto& skeleton_uncooked =
+        project_uncooked.add_resource<eely::skeleton_uncooked>("test_skeleton");
+    skeleton_uncooked.get_joints() = {
+        {.id = "root", .parent_index = std::nullopt, .rest_pose_transform = transform{}},
+        {.id = "arm",
+         .parent_index = 0,
+         .rest_pose_transform = transform{float3{0.0F, 1.0F, 0.0F}}},
+        {.id = "forearm",
+         .parent_index = 1,
+         .rest_pose_transform = transform{float3{1.0F, 0.0F, 0.0F},
+                                          quaternion_from_axis_angle(0.0F, 0.0F, 1.0F, 0.2F)}},
+        {.id = "hand",
+         .parent_index = 2,
+         .rest_pose_transform = transform{float3{1.0F, 0.0F, 0.0F}}}};
+
+    skeleton_uncooked::mapping& mapping{skeleton_uncooked.get_mapping()};
+    mapping.left_arm = "arm";
+    mapping.left_forearm = "forearm";
+    mapping.left_hand = "hand";
+
+    project::cook(project_uncooked, buffer);
+  }
+
+  project project{buffer};
+
+  const skeleton& skeleton{*project.get_resource<eely::skeleton>("test_skeleton")};
+
+  EXPECT_FALSE(ik_two_bone_joints_from_limb(skeleton, ik_limb::right_leg).has_value());
+
+  const std::optional<ik_two_bone_joints> joints{
+      ik_two_bone_joints_from_limb(skeleton, ik_limb::left_arm)};
+  ASSERT_TRUE(joints.has_value());
+  EXPECT_EQ(joints->root, 1);
+  EXPECT_EQ(joints->mid, 2);
+  EXPECT_EQ(joints->tip, 3);
+
+  // Reachable target is reached exactly, bone lengths are kept
+
+  {
+    skeleton_pose pose{skeleton};
+
+    const float3 target{0.5F, 2.0F, 0.8F};
+    const float3 pole{0.0F, 3.0F, 0.0F};
+    ik_two_bone_solve(pose, *joints, target, pole);
+
+    const float3 a{pose.get_transform_object_space(joints->root).translation};
+    const float3 b{pose.get_transform_object_space(joints->mid).translation};
+    const float3 c{pose.get_transform_object_space(joints->tip).translation};
+
+    expect_float3_near(c, target, 1e-4F);
+    EXPECT_NEAR(float3_distance(a, b), 1.0F, 1e-4F);
+    EXPECT_NEAR(float3_distance(b, c), 1.0F, 1e-4F);
+
+    // Mid joint bends towards a pole
+    const float3 at{vector_normalized(target - a)};
+    const float3 mid_offset{(b - a) - at * vector_dot(b - a, at)};
+    const float3 pole_offset{(pole - a) - at * vector_dot(pole - a, at)};
+    EXPECT_GT(vector_dot(mid_offset, pole_offset), 0.0F);
+  }
+
+  // Unreachable target makes chain point towards it
+
+  {
+    skeleton_pose pose{skeleton};
+
+    const float3 target{0.0F, 1.0F, 5.0F};
+    ik_two_bone_solve(pose, *joints, target, std::nullopt);
+
+    const float3 a{pose.get_transform_object_space(joints->root).translation};
+    const float3 c{pose.get_transform_object_space(joints->tip).translation};
+
+    expect_float3_near(vector_normalized(c - a), vector_normalized(target - a), 1e-2F);
+  }
+
+  // Zero weight keeps pose intact
+
+  {
+    skeleton_pose pose{skeleton};
+    const skeleton_pose pose_original{pose};
+
+    ik_two_bone_solve(pose, *joints, float3{0.5F, 2.0F, 0.8F}, std::nullopt, 0.0F);
+
+    for (gsl::index i{0}; i < pose.get_joints_count(); ++i) {
+      expect_transform_near(pose.get_transform_joint_space(i),
+                            pose_original.get_transform_joint_space(i));
+    }
+  }
+}
+
+// Cook a project with a skeleton of a root and a constrained chain of five joints.
+static void cook_fabrik_test_project(std::span<std::byte> buffer)
+{
+  using namespace eely;
+
+  project_uncooked project_uncooked(measurement_unit::meters, axis_system::y_up_x_right_z_forward);
+
+  const skeleton_uncooked::constraint constraint{.limit_twist_rad = pi / 8.0F,
+                                                 .limit_swing_y_rad = pi / 4.0F,
+                                                 .limit_swing_z_rad = pi / 4.0F};
+
+  auto& skeleton_uncooked =
+      project_uncooked.add_resource<eely::skeleton_uncooked>("test_skeleton");
+  auto& joints{skeleton_uncooked.get_joints()};
+  joints.push_back(
+      {.id = "root", .parent_index = std::nullopt, .rest_pose_transform = transform{}});
+  for (int i{1}; i < 6; ++i) {
+    joints.push_back({.id = string_id{"joint_"} + std::to_string(i),
+                      .parent_index = i - 1,
+                      .rest_pose_transform = transform{float3{0.5F, 0.0F, 0.0F}},
+                      .constraint = constraint});
+  }
+
+  project::cook(project_uncooked, buffer);
+}
+
+TEST(ik, fabrik)
+{
+  using namespace eely;
+
+  std::array<std::byte, 2048> buffer;
+  cook_fabrik_test_project(buffer);
+
+  project project{buffer};
+
+  const skeleton& skeleton{*project.get_resource<eely::skeleton>("test_skeleton")};
+
+  std::vector<gsl::index> chain;
+  EXPECT_FALSE(ik_chain_collect(skeleton, 3, 1, chain));
+  ASSERT_TRUE(ik_chain_collect(skeleton, 1, 5, chain));
+  EXPECT_EQ(chain, (std::vector<gsl::index>{1, 2, 3, 4, 5}));
+
+  const float3 target{1.2F, 1.0F, 0.5F};
+
+  ik_fabrik_scratch scratch;
+
+  // Unconstrained chain reaches a target within tolerance
+
+  {
+    skeleton_pose pose{skeleton};
+
+    const ik_fabrik_settings settings{
+        .max_iterations = 32, .tolerance = 1e-3F, .constrained = false};
+    const ik_fabrik_result result{ik_fabrik_solve(pose, chain, target, settings, scratch)};
+
+    EXPECT_GT(result.iterations, 0);
+    EXPECT_LE(result.iterations, settings.max_iterations);
+    EXPECT_LE(result.error, settings.tolerance);
+    expect_float3_near(pose.get_transform_object_space(chain.back()).translation, target,
+                       settings.tolerance * 2.0F);
+
+    for (gsl::index i{1}; i < std::ssize(chain); ++i) {
+      EXPECT_NEAR(float3_distance(pose.get_transform_object_space(chain[i - 1]).translation,
+                                  pose.get_transform_object_space(chain[i]).translation),
+                  0.5F, 1e-4F);
+    }
+
+    // Solving again from a solved pose exits early
+    const ik_fabrik_result result_solved{ik_fabrik_solve(pose, chain, target, settings, scratch)};
+    EXPECT_EQ(result_solved.iterations, 0);
+  }
+
+  // Constrained chain respects joint limits
+
+  {
+    skeleton_pose pose{skeleton};
+
+    const ik_fabrik_settings settings{
+        .max_iterations = 32, .tolerance = 1e-3F, .constrained = true};
+    const ik_fabrik_result result{ik_fabrik_solve(pose, chain, target, settings, scratch)};
+
+    EXPECT_LE(result.iterations, settings.max_iterations);
+    EXPECT_NEAR(float3_distance(pose.get_transform_object_space(chain.back()).translation, target),
+                result.error, 1e-4F);
+
+    skeleton_pose pose_constrained{pose};
+    std::vector<quaternion> rotations_object_space_scratch;
+    constraint_force(pose_constrained, rotations_object_space_scratch);
+    for (gsl::index i{0}; i < pose.get_joints_count(); ++i) {
+      expect_transform_near(pose.get_transform_joint_space(i),
+                            pose_constrained.get_transform_joint_space(i), 1e-3F);
+    }
+  }
+}
+
+// Benchmark of solving a constrained chain with FABRIK,
+// run with `--gtest_also_run_disabled_tests --gtest_filter=ik.DISABLED_*`.
+TEST(ik, DISABLED_benchmark_fabrik)
+{
+  using namespace eely;
+
+  constexpr int solves_count{10000};
+
+  std::array<std::byte, 2048> buffer;
+  cook_fabrik_test_project(buffer);
+
+  project project{buffer};
+  const skeleton& skeleton{*project.get_resource<eely::skeleton>("test_skeleton")};
+
+  std::vector<gsl::index> chain;
+  ASSERT_TRUE(ik_chain_collect(skeleton, 1, 5, chain));
+
+  const ik_fabrik_settings settings{.max_iterations = 10, .tolerance = 1e-3F, .constrained = true};
+  ik_fabrik_scratch scratch;
+
+  const skeleton_pose pose_rest{skeleton};
+  skeleton_pose pose{skeleton};
+
+  const auto begin{std::chrono::steady_clock::now()};
+
+  for (int i{0}; i < solves_count; ++i) {
+    pose = pose_rest;
+    ik_fabrik_solve(pose, chain, float3{1.2F, 1.0F, 0.5F}, settings, scratch);
+  }
+
+  const auto end{std::chrono::steady_clock::now()};
+
+  const float solve_us{std::chrono::duration<float, std::micro>(end - begin).count() /
+                       static_cast<float>(solves_count)};
+  std::printf("FABRIK solve: %.3f us\n", solve_us);  // NOLINT
+}
\ No newline at end of file
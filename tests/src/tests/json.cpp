@@ -0,0 +1,107 @@
+#include <eely_cook/json.h>
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <variant>
+#include <vector>
+
+TEST(json, valid)
+{
+  using namespace eely;
+
+  const json_value value{json_parse(R"( {
+    "name": "clip",
+    "numbers": [0, -1.5, 2e3, 0.25E-2],
+    "flags": {"on": true, "off": false, "none": null},
+    "empty": [{}, []]
+  } )")};
+
+  const auto& object{std::get<json_value::object>(value.data)};
+  ASSERT_EQ(std::ssize(object), 4);
+
+  // Members keep their order
+  EXPECT_EQ(object[0].first, "name");
+  EXPECT_EQ(object[1].first, "numbers");
+  EXPECT_EQ(object[2].first, "flags");
+  EXPECT_EQ(object[3].first, "empty");
+
+  EXPECT_EQ(json_as_string(json_get(value, "name")), "clip");
+  EXPECT_EQ(json_as_floats(json_get(value, "numbers"), 4),
+            (std::vector<float>{0.0F, -1.5F, 2000.0F, 0.0025F}));
+
+  const json_value& flags{json_get(value, "flags")};
+  EXPECT_TRUE(json_as_bool(json_get(flags, "on")));
+  EXPECT_FALSE(json_as_bool(json_get(flags, "off")));
+  EXPECT_TRUE(std::holds_alternative<std::nullptr_t>(json_get(flags, "none").data));
+  EXPECT_EQ(json_find(flags, "missing"), nullptr);
+
+  const json_value::array& empty{json_as_array(json_get(value, "empty"))};
+  ASSERT_EQ(std::ssize(empty), 2);
+  EXPECT_TRUE(std::get<json_value::object>(empty[0].data).empty());
+  EXPECT_TRUE(json_as_array(empty[1]).empty());
+
+  EXPECT_THROW(json_get(value, "missing"), std::runtime_error);
+  EXPECT_THROW(json_as_float(json_get(value, "name")), std::runtime_error);
+  EXPECT_THROW(json_as_bool(json_get(value, "name")), std::runtime_error);
+  EXPECT_THROW(json_as_floats(json_get(value, "numbers"), 3), std::runtime_error);
+}
+
+TEST(json, escapes)
+{
+  using namespace eely;
+
+  const json_value value{json_parse(R"("a\"b\\c\/d\be\ff\ng\rh\ti")")};
+  EXPECT_EQ(json_as_string(value), "a\"b\\c/d\be\ff\ng\rh\ti");
+
+  // Unicode escapes are not supported
+  EXPECT_THROW(json_parse(R"("\u0041")"), std::runtime_error);
+  EXPECT_THROW(json_parse(R"("\x")"), std::runtime_error);
+}
+
+TEST(json, malformed)
+{
+  using namespace eely;
+
+  const std::vector<std::string> texts{"",
+                                       " ",
+                                       "{",
+                                       "[1, 2",
+                                       "[1, ]",
+                                       "[1 2]",
+                                       R"({"a" 1})",
+                                       R"({"a": 1,})",
+                                       "{1: 2}",
+                                       R"("abc)",
+                                       "tru",
+                                       "nul",
+                                       "1 2",
+                                       "-",
+                                       "+1",
+                                       ".5",
+                                       "1e999",
+                                       "inf",
+                                       "-inf",
+                                       "nan",
+                                       "-nan",
+                                       "infinity"};
+
+  for (const std::string& text : texts) {
+    EXPECT_THROW(json_parse(text), std::runtime_error) << text;
+  }
+}
+
+TEST(json, depth)
+{
+  using namespace eely;
+
+  const auto nested = [](const int depth) {
+    return std::string(depth, '[') + std::string(depth, ']');
+  };
+
+  EXPECT_NO_THROW(json_parse(nested(64)));
+  EXPECT_THROW(json_parse(nested(65)), std::runtime_error);
+  EXPECT_THROW(json_parse(nested(100000)), std::runtime_error);
+}
\ No newline at end of file
@@ -0,0 +1,156 @@
+#include <eely/params/params.h>
+#include <eely/params/params_recording.h>
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+TEST(params, versions)
+{
+  using namespace eely;
+
+  params params;
+
+  EXPECT_EQ(params.get_version("speed"), 0U);
+
+  // Mutable access always counts as a change
+  params.get_value<float>("speed") = 1.0F;
+  const std::uint64_t speed_version{params.get_version("speed")};
+  EXPECT_GT(speed_version, 0U);
+  EXPECT_EQ(params.get_version(), speed_version);
+
+  // Setting the same value is not a change
+  params.set_value("speed", 1.0F);
+  EXPECT_EQ(params.get_version("speed"), speed_version);
+  EXPECT_EQ(params.get_version(), speed_version);
+
+  params.set_value("speed", 2.0F);
+  EXPECT_GT(params.get_version("speed"), speed_version);
+  EXPECT_FLOAT_EQ(params.get_value<float>("speed"), 2.0F);
+
+  // Changing one parameter doesn't affect versions of others
+  const std::uint64_t speed_version_changed{params.get_version("speed")};
+  params.set_value("crouch", true);
+  EXPECT_EQ(params.get_version("speed"), speed_version_changed);
+  EXPECT_GT(params.get_version("crouch"), speed_version_changed);
+  EXPECT_EQ(params.get_version(), params.get_version("crouch"));
+}
+
+TEST(params, versions_unique_across_objects)
+{
+  using namespace eely;
+
+  params params_a;
+  params params_b;
+
+  // Same changes in two objects result in different versions
+  params_a.set_value("speed", 1.0F);
+  params_b.set_value("speed", 2.0F);
+  EXPECT_NE(params_a.get_version("speed"), params_b.get_version("speed"));
+  EXPECT_NE(params_a.get_version(), params_b.get_version());
+
+  // Copy keeps versions, since its values are the same
+  params params_copy{params_a};
+  EXPECT_EQ(params_copy.get_version("speed"), params_a.get_version("speed"));
+  EXPECT_EQ(params_copy.get_version(), params_a.get_version());
+
+  // Moved-from object gets a new version, since its values are gone
+  const std::uint64_t version{params_a.get_version()};
+  params params_moved{std::move(params_a)};
+  EXPECT_EQ(params_moved.get_version(), version);
+  EXPECT_NE(params_a.get_version(), version);  // NOLINT(bugprone-use-after-move)
+  EXPECT_EQ(params_a.get_version("speed"), 0U);  // NOLINT(bugprone-use-after-move)
+}
+
+TEST(params, recording)
+{
+  using namespace eely;
+
+  params params_recorded;
+  params_recorder recorder{42};
+
+  params_recorded.set_value("speed", 1.5F);
+  params_recorded.set_value("crouch", false);
+  params_recorded.set_value("weapon", 3);
+  recorder.record(0.016F, params_recorded);
+
+  // Nothing changed
+  recorder.record(0.017F, params_recorded);
+
+  params_recorded.set_value("crouch", true);
+  recorder.record(0.018F, params_recorded);
+
+  EXPECT_EQ(recorder.get_frames_count(), 3);
+
+  const std::vector<std::byte> recording{recorder.serialize()};
+
+  params_replayer replayer{recording};
+  EXPECT_EQ(replayer.get_random_seed(), 42U);
+  EXPECT_EQ(replayer.get_frames_count(), 3);
+
+  for (int pass{0}; pass < 2; ++pass) {
+    params params_replayed;
+
+    EXPECT_FLOAT_EQ(replayer.replay(params_replayed), 0.016F);
+    EXPECT_FLOAT_EQ(params_replayed.get_value<float>("speed"), 1.5F);
+    EXPECT_FALSE(params_replayed.get_value<bool>("crouch"));
+    EXPECT_EQ(params_replayed.get_value<int>("weapon"), 3);
+
+    const std::uint64_t version{params_replayed.get_version()};
+    EXPECT_FLOAT_EQ(replayer.replay(params_replayed), 0.017F);
+    EXPECT_EQ(params_replayed.get_version(), version);
+
+    EXPECT_FLOAT_EQ(replayer.replay(params_replayed), 0.018F);
+    EXPECT_TRUE(params_replayed.get_value<bool>("crouch"));
+    EXPECT_FLOAT_EQ(params_replayed.get_value<float>("speed"), 1.5F);
+
+    EXPECT_TRUE(replayer.is_finished());
+    EXPECT_ANY_THROW(replayer.replay(params_replayed));
+
+    replayer.restart();
+  }
+}
+
+TEST(params, recording_limits)
+{
+  using namespace eely;
+
+  // Ints are recorded with all their bits
+
+  params params_recorded;
+  params_recorded.set_value("negative", -3);
+  params_recorded.set_value("min", std::numeric_limits<int>::min());
+  params_recorded.set_value("max", std::numeric_limits<int>::max());
+
+  params_recorder recorder{0};
+  recorder.record(0.016F, params_recorded);
+
+  const std::vector<std::byte> recording{recorder.serialize()};
+  params_replayer replayer{recording};
+
+  params params_replayed;
+  replayer.replay(params_replayed);
+  EXPECT_EQ(params_replayed.get_value<int>("negative"), -3);
+  EXPECT_EQ(params_replayed.get_value<int>("min"), std::numeric_limits<int>::min());
+  EXPECT_EQ(params_replayed.get_value<int>("max"), std::numeric_limits<int>::max());
+
+  // Number of different parameters is limited by its bit width,
+  // frame that would exceed it is not recorded
+
+  params params_many;
+  for (int i{0}; i < 65535 - 3; ++i) {
+    params_many.set_value(std::to_string(i), i);
+  }
+  recorder.record(0.016F, params_many);
+  EXPECT_EQ(recorder.get_frames_count(), 2);
+
+  params_many.set_value("one_too_many", true);
+  EXPECT_THROW(recorder.record(0.016F, params_many), std::runtime_error);
+  EXPECT_EQ(recorder.get_frames_count(), 2);
+}
\ No newline at end of file
@@ -0,0 +1,112 @@
+#include <eely/base/profiling.h>
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST(profiling, record)
+{
+  using namespace eely;
+
+  profiling_clear();
+
+  {
+    EELY_PROFILE_SCOPE(profiling_scope_type::node, "outer", 1);
+    EELY_PROFILE_SCOPE(profiling_scope_type::job, "inner");
+  }
+
+  std::thread thread{[]() { EELY_PROFILE_SCOPE(profiling_scope_type::clip_player, "thread"); }};
+  thread.join();
+
+  const std::vector<profiling_event> events{profiling_collect_events()};
+
+  if (!profiling_is_enabled()) {
+    EXPECT_TRUE(events.empty());
+    return;
+  }
+
+  ASSERT_EQ(events.size(), 3);
+
+  // Scopes are recorded when they end, so inner scope goes first
+  EXPECT_STREQ(events[0].name, "inner");
+  EXPECT_EQ(events[0].id, -1);
+  EXPECT_STREQ(events[1].name, "outer");
+  EXPECT_EQ(events[1].id, 1);
+  EXPECT_EQ(events[0].thread_index, events[1].thread_index);
+  EXPECT_LE(events[1].begin_ns, events[0].begin_ns);
+  EXPECT_GE(events[1].end_ns, events[0].end_ns);
+
+  EXPECT_STREQ(events[2].name, "thread");
+  EXPECT_NE(events[2].thread_index, events[0].thread_index);
+
+  profiling_clear();
+  EXPECT_TRUE(profiling_collect_events().empty());
+}
+
+TEST(profiling, aggregate_nodes)
+{
+  using namespace eely;
+
+  const std::vector<profiling_event> events{
+      {.name = "blend", .id = 1, .type = profiling_scope_type::node, .begin_ns = 0, .end_ns = 100},
+      {.name = "clip", .id = 2, .type = profiling_scope_type::node, .begin_ns = 10, .end_ns = 40},
+      {.name = "clip", .id = 2, .type = profiling_scope_type::node, .begin_ns = 40, .end_ns = 60},
+      {.name = "job", .type = profiling_scope_type::job, .begin_ns = 45, .end_ns = 50},
+      {.name = "job", .id = 2, .type = profiling_scope_type::job, .begin_ns = 110, .end_ns = 120},
+      {.name = "blend",
+       .id = 1,
+       .type = profiling_scope_type::node,
+       .thread_index = 1,
+       .begin_ns = 20,
+       .end_ns = 50}};
+
+  const auto stats{profiling_aggregate_nodes(events)};
+  ASSERT_EQ(stats.size(), 2);
+
+  const profiling_node_stats& blend_stats{stats.at(1)};
+  EXPECT_EQ(blend_stats.calls_count, 2);
+  EXPECT_EQ(blend_stats.total_ns, 130);
+  EXPECT_EQ(blend_stats.self_ns, 80);
+  EXPECT_EQ(blend_stats.max_ns, 100);
+  EXPECT_EQ(blend_stats.jobs_count, 0);
+  EXPECT_EQ(blend_stats.subtree_jobs_ns, 10);
+
+  const profiling_node_stats& clip_stats{stats.at(2)};
+  EXPECT_EQ(clip_stats.calls_count, 2);
+  EXPECT_EQ(clip_stats.total_ns, 50);
+  EXPECT_EQ(clip_stats.self_ns, 45);
+  EXPECT_EQ(clip_stats.max_ns, 30);
+  EXPECT_EQ(clip_stats.jobs_count, 1);
+  EXPECT_EQ(clip_stats.jobs_ns, 10);
+  EXPECT_EQ(clip_stats.subtree_jobs_ns, 10);
+}
+
+TEST(profiling, chrome_trace)
+{
+  using namespace eely;
+
+  const std::vector<profiling_event> events{
+      {.name = "clip",
+       .id = 3,
+       .type = profiling_scope_type::node,
+       .begin_ns = 1500,
+       .end_ns = 4000},
+      {.name = "uniform",
+       .type = profiling_scope_type::clip_player,
+       .thread_index = 2,
+       .begin_ns = 2000,
+       .end_ns = 3000}};
+
+  const std::string trace{profiling_events_to_chrome_trace(events)};
+
+  EXPECT_EQ(trace,
+            "{\"traceEvents\":[\n"
+            R"({"name":"clip","cat":"node","ph":"X","ts":1.500,"dur":2.500,)"
+            R"("pid":0,"tid":0,"args":{"id":3}},)"
+            "\n"
+            R"({"name":"uniform","cat":"clip_player","ph":"X","ts":2.000,"dur":1.000,)"
+            R"("pid":0,"tid":2,"args":{"id":-1}})"
+            "\n],\"displayTimeUnit\":\"ns\"}");
+}
\ No newline at end of file
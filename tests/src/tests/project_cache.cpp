@@ -0,0 +1,93 @@
+#include <eely_app/project_cache.h>
+
+#include <eely/project/project.h>
+#include <eely/project/project_uncooked.h>
+#include <eely/skeleton/skeleton.h>
+#include <eely/skeleton/skeleton_uncooked.h>
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <ios>
+#include <memory>
+#include <vector>
+
+TEST(project_cache, project_load_cached)
+{
+  using namespace eely;
+  namespace fs = std::filesystem;
+
+  const fs::path dir{fs::temp_directory_path() / "eely_tests_project_cache"};
+  const fs::path cache_path{dir / "project.eely_project"};
+  const fs::path sources_dir{dir / "res"};
+
+  fs::remove_all(dir);
+  fs::create_directories(sources_dir);
+  std::ofstream{sources_dir / "source.fbx"} << "source";
+
+  int cooks_count{0};
+  const auto cook = [&cooks_count]() {
+    ++cooks_count;
+
+    project_uncooked project_uncooked{measurement_unit::meters,
+                                      axis_system::y_up_x_right_z_forward};
+    auto& skeleton_uncooked{project_uncooked.add_resource<eely::skeleton_uncooked>("skeleton")};
+    skeleton_uncooked.get_joints() = {{.id = "root"}};
+
+    return project::cook(project_uncooked);
+  };
+
+  // Project is cooked when there is no cache
+  {
+    const std::unique_ptr<project> project{project_load_cached(cache_path, {sources_dir}, cook)};
+    EXPECT_NE(project->get_resource<skeleton>("skeleton"), nullptr);
+    EXPECT_EQ(cooks_count, 1);
+    EXPECT_TRUE(fs::exists(cache_path));
+  }
+
+  // Project is loaded from an up-to-date cache
+  {
+    const std::unique_ptr<project> project{project_load_cached(cache_path, {sources_dir}, cook)};
+    EXPECT_NE(project->get_resource<skeleton>("skeleton"), nullptr);
+    EXPECT_EQ(cooks_count, 1);
+  }
+
+  // Project is cooked again once a source changes
+  {
+    std::ofstream{sources_dir / "source.fbx", std::ios::app} << "changed";
+
+    const std::unique_ptr<project> project{project_load_cached(cache_path, {sources_dir}, cook)};
+    EXPECT_NE(project->get_resource<skeleton>("skeleton"), nullptr);
+    EXPECT_EQ(cooks_count, 2);
+  }
+
+  // Corrupted cache is not loaded
+  {
+    fs::resize_file(cache_path, fs::file_size(cache_path) - 1);
+
+    const std::unique_ptr<project> project{project_load_cached(cache_path, {sources_dir}, cook)};
+    EXPECT_NE(project->get_resource<skeleton>("skeleton"), nullptr);
+    EXPECT_EQ(cooks_count, 3);
+  }
+
+  // Cache with an up-to-date header and a body that cannot be loaded is cooked again
+  {
+    const uintmax_t cache_size{fs::file_size(cache_path)};
+    {
+      std::fstream file{cache_path, std::ios::binary | std::ios::in | std::ios::out};
+      file.seekp(static_cast<std::streamoff>(cache_size / 2));
+      for (uintmax_t i{cache_size / 2}; i < cache_size; ++i) {
+        file.put(static_cast<char>(0xFF));
+      }
+    }
+
+    const std::unique_ptr<project> project{project_load_cached(cache_path, {sources_dir}, cook)};
+    EXPECT_NE(project->get_resource<skeleton>("skeleton"), nullptr);
+    EXPECT_EQ(cooks_count, 4);
+  }
+
+  fs::remove_all(dir);
+}
\ No newline at end of file
@@ -0,0 +1,178 @@
+#include <eely_cook/json.h>
+#include <eely_cook/project_json.h>
+
+#include <eely/anim_graph/anim_graph.h>
+#include <eely/anim_graph/anim_graph_player.h>
+#include <eely/base/string_id.h>
+#include <eely/clip/clip.h>
+#include <eely/clip/clip_player_base.h>
+#include <eely/params/params.h>
+#include <eely/project/project.h>
+#include <eely/project/project_uncooked.h>
+#include <eely/skeleton/skeleton.h>
+#include <eely/skeleton/skeleton_pose.h>
+#include <eely/skeleton_mask/skeleton_mask.h>
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace eely {
+// Skeleton with a single joint and two clips moving it to x = 1 and x = 3.
+static constexpr const char* test_project_resources{R"(
+  "skeletons": [{"id": "skeleton", "joints": [{"id": "root"}]}],
+  "clips": [
+    {"id": "walk", "skeleton": "skeleton", "compression": "none", "tracks": [{"joint": "root",
+      "keys": [{"time": 0, "translation": [1, 0, 0]}, {"time": 1, "translation": [1, 0, 0]}]}]},
+    {"id": "run", "skeleton": "skeleton", "compression": "none", "tracks": [{"joint": "root",
+      "keys": [{"time": 0, "translation": [3, 0, 0]}, {"time": 1, "translation": [3, 0, 0]}]}]}
+  ])"};
+
+// Cook a project from a JSON description of test resources and specified graphs.
+static std::vector<std::byte> cook_test_project(const std::string& graphs)
+{
+  const json_value description{
+      json_parse("{" + std::string{test_project_resources} + R"(, "anim_graphs": )" + graphs +
+                 "}")};
+  return project::cook(*project_uncooked_from_json(description));
+}
+}  // namespace eely
+
+TEST(project_json, resources)
+{
+  using namespace eely;
+
+  const json_value description{json_parse(R"({
+    "measurement_unit": "meters",
+    "skeletons": [{"id": "skeleton", "joints": [
+      {"id": "root"},
+      {"id": "child", "parent": "root", "translation": [0, 1, 0]}]}],
+    "skeleton_masks": [{"id": "mask", "skeleton": "skeleton",
+      "weights": [{"joint": "child", "translation": 0, "rotation": 0.5, "scale": 1}]}],
+    "clips": [{"id": "move", "skeleton": "skeleton", "compression": "none", "tracks": [
+      {"joint": "root", "keys": [{"time": 0, "translation": [0, 0, 0]},
+                                 {"time": 2, "translation": [4, 0, 0]}]}]}]
+  })")};
+
+  std::vector<std::byte> buffer{project::cook(*project_uncooked_from_json(description))};
+  project project{buffer};
+
+  EXPECT_EQ(project.get_ids<eely::skeleton>(), std::vector<string_id>{"skeleton"});
+  EXPECT_EQ(project.get_ids<skeleton_mask>(), std::vector<string_id>{"mask"});
+  EXPECT_EQ(project.get_ids<eely::clip>(), std::vector<string_id>{"move"});
+
+  // Skeleton
+
+  const auto& skeleton{*project.get_resource<eely::skeleton>("skeleton")};
+  ASSERT_EQ(skeleton.get_joints_count(), 2);
+
+  const std::optional<gsl::index> child_index{skeleton.get_joint_index("child")};
+  ASSERT_TRUE(child_index.has_value());
+  EXPECT_EQ(skeleton.get_joint_parent_index(child_index.value()), 0);
+  EXPECT_FLOAT_EQ(skeleton.get_rest_pose_transforms()[child_index.value()].translation.y, 1.0F);
+
+  // Skeleton mask, joints without weights are masked in completely
+
+  const auto& mask{*project.get_resource<skeleton_mask>("mask")};
+  EXPECT_EQ(mask.get_target_skeleton_id(), "skeleton");
+  EXPECT_FLOAT_EQ(mask.get_weight(child_index.value()).translation, 0.0F);
+  EXPECT_FLOAT_EQ(mask.get_weight(child_index.value()).rotation, 0.5F);
+  EXPECT_FLOAT_EQ(mask.get_weight(0).translation, 1.0F);
+
+  // Clip, joints without tracks keep their rest pose
+
+  const auto& clip{*project.get_resource<eely::clip>("move")};
+  EXPECT_FLOAT_EQ(clip.get_duration_s(), 2.0F);
+
+  skeleton_pose pose{skeleton};
+  std::unique_ptr<clip_player_base> player{clip.create_player()};
+  player->play(1.0F, pose);
+  EXPECT_NEAR(pose.get_transform_joint_space(0).translation.x, 2.0F, 1e-4F);
+  EXPECT_NEAR(pose.get_transform_joint_space(child_index.value()).translation.y, 1.0F, 1e-4F);
+}
+
+TEST(project_json, anim_graph)
+{
+  using namespace eely;
+
+  // Nodes are referenced before they are listed
+  std::vector<std::byte> buffer{cook_test_project(R"([
+    {"id": "blend", "skeleton": "skeleton", "root": "speed", "nodes": [
+      {"id": "speed", "type": "speed", "child": "blend", "speed_provider": "playback_speed"},
+      {"id": "blend", "type": "blend", "factor_node": "factor",
+       "poses": [{"node": "walk", "factor": 0}, {"node": "run", "factor": 1}]},
+      {"id": "walk", "type": "clip", "clip": "walk", "looping_policy": "wrap"},
+      {"id": "run", "type": "clip", "clip": "run", "sample_rounding": "nearest"},
+      {"id": "factor", "type": "param", "param": "factor"},
+      {"id": "playback_speed", "type": "param", "param": "playback_speed"}]},
+    {"id": "state_machine", "skeleton": "skeleton", "root": "state_machine", "nodes": [
+      {"id": "state_machine", "type": "state_machine", "states": ["walk_state", "run_state"]},
+      {"id": "walk_state", "type": "state", "name": "walk", "pose": "walk",
+       "transitions": ["to_run"]},
+      {"id": "run_state", "type": "state", "name": "run", "pose": "run"},
+      {"id": "to_run", "type": "state_transition", "condition": "is_running",
+       "destination": "run_state", "duration": 0.5, "reversible": false},
+      {"id": "is_running", "type": "param_comparison", "param": "gait", "value_int": 1},
+      {"id": "walk", "type": "clip", "clip": "walk"},
+      {"id": "run", "type": "clip", "clip": "run"}]}
+  ])")};
+
+  project project{buffer};
+  const auto& skeleton{*project.get_resource<eely::skeleton>("skeleton")};
+  skeleton_pose pose{skeleton};
+
+  const auto& graph_blend{*project.get_resource<anim_graph>("blend")};
+  EXPECT_EQ(graph_blend.get_skeleton_id(), "skeleton");
+  EXPECT_EQ(std::ssize(graph_blend.get_nodes()), 6);
+
+  params params;
+  params.set_value("factor", 0.5F);
+  params.set_value("playback_speed", 1.0F);
+
+  anim_graph_player player_blend{graph_blend};
+  player_blend.play(0.1F, params, pose);
+  EXPECT_NEAR(pose.get_transform_joint_space(0).translation.x, 2.0F, 1e-4F);
+
+  const auto& graph_state_machine{*project.get_resource<anim_graph>("state_machine")};
+  EXPECT_EQ(std::ssize(graph_state_machine.get_nodes()), 7);
+
+  params.set_value("gait", 0);
+
+  anim_graph_player player_state_machine{graph_state_machine};
+  player_state_machine.play(0.1F, params, pose);
+  EXPECT_NEAR(pose.get_transform_joint_space(0).translation.x, 1.0F, 1e-4F);
+
+  // Integer param matches comparison's integer value, transition finishes after its duration
+  params.set_value("gait", 1);
+  player_state_machine.play(0.1F, params, pose);
+  player_state_machine.play(0.5F, params, pose);
+  EXPECT_NEAR(pose.get_transform_joint_space(0).translation.x, 3.0F, 1e-4F);
+}
+
+TEST(project_json, anim_graph_malformed)
+{
+  using namespace eely;
+
+  EXPECT_THROW(cook_test_project(R"([{"id": "graph", "skeleton": "skeleton", "nodes": [
+                   {"id": "node", "type": "unknown"}]}])"),
+               std::runtime_error);
+
+  EXPECT_THROW(cook_test_project(R"([{"id": "graph", "skeleton": "skeleton", "nodes": [
+                   {"id": "node", "type": "speed", "child": "missing"}]}])"),
+               std::runtime_error);
+
+  EXPECT_THROW(cook_test_project(R"([{"id": "graph", "skeleton": "skeleton", "nodes": [
+                   {"id": "node", "type": "clip", "clip": "walk"},
+                   {"id": "node", "type": "clip", "clip": "run"}]}])"),
+               std::runtime_error);
+
+  EXPECT_THROW(cook_test_project(R"([{"id": "graph", "skeleton": "skeleton", "nodes": [
+                   {"id": "node", "type": "param_comparison", "param": "gait",
+                    "value_int": 1.5}]}])"),
+               std::runtime_error);
+}
\ No newline at end of file
@@ -6,8 +6,17 @@
 
 #include <gtest/gtest.h>
 
+#include <rtm/vector4f.h>
+
+#include <array>
+#include <chrono>
 #include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <limits>
+#include <numeric>
 #include <random>
+#include <vector>
 
 static float quantize_and_dequantize(const eely::internal::float_quantize_params& params)
 {
@@ -117,4 +126,150 @@ TEST(quantization, quaternions)
 
     check_quaternion_quantize(value);
   }
+}
+
+TEST(quantization, half)
+{
+  using namespace eely;
+  using namespace eely::internal;
+
+  EXPECT_EQ(float_to_half(0.0F), 0x0000);
+  EXPECT_EQ(float_to_half(-0.0F), 0x8000);
+  EXPECT_EQ(float_to_half(1.0F), 0x3C00);
+  EXPECT_EQ(float_to_half(-2.0F), 0xC000);
+  EXPECT_EQ(float_to_half(65504.0F), 0x7BFF);
+  EXPECT_EQ(float_to_half(65520.0F), 0x7C00);
+  EXPECT_EQ(float_to_half(std::numeric_limits<float>::infinity()), 0x7C00);
+  EXPECT_EQ(float_to_half(0x1p-24F), 0x0001);
+  EXPECT_EQ(float_to_half(0x1p-14F), 0x0400);
+
+  // Ties round to even
+  EXPECT_EQ(float_to_half(1.0F + 0x1p-11F), 0x3C00);
+  EXPECT_EQ(float_to_half(1.0F + 0x3p-11F), 0x3C02);
+
+  EXPECT_TRUE(std::isnan(half_to_float(float_to_half(std::nanf("")))));
+
+  static constexpr int random_samples = 200;
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<float> distr(-100.0F, 100.0F);
+  for (int i{0}; i < random_samples; ++i) {
+    const float value{distr(gen)};
+    EXPECT_NEAR(half_to_float(float_to_half(value)), value, std::abs(value) * 0x1p-11F);
+  }
+
+  for (uint32_t bits{0}; bits <= 0xFFFFU; ++bits) {
+    const auto half{static_cast<uint16_t>(bits)};
+    if ((half & 0x7C00U) != 0x7C00U || (half & 0x03FFU) == 0) {
+      EXPECT_EQ(float_to_half(half_to_float(half)), half);
+    }
+  }
+}
+
+TEST(quantization, vectors)
+{
+  using namespace eely;
+  using namespace eely::internal;
+
+  // Vectorized dequantization with precomputed scales
+  // should match the scalar one within float rounding
+
+  static constexpr int random_samples = 200;
+  std::mt19937 gen(seed);
+  std::uniform_int_distribution<int> distr_data(0, 65535);
+  std::uniform_real_distribution<float> distr_range(-10.0F, 10.0F);
+  for (int i{0}; i < random_samples; ++i) {
+    const float range_from{distr_range(gen)};
+    const float range_length{std::abs(distr_range(gen))};
+
+    const std::array<uint16_t, 4> data{
+        static_cast<uint16_t>(distr_data(gen)), static_cast<uint16_t>(distr_data(gen)),
+        static_cast<uint16_t>(distr_data(gen)), static_cast<uint16_t>(distr_data(gen))};
+
+    const rtm::vector4f from{rtm::vector_set(range_from)};
+    const rtm::vector4f scale{rtm::vector_set(range_length / 65535.0F)};
+
+    std::array<float, 4> result4{};
+    rtm::vector_store(vector_dequantize4(data.data(), from, scale), result4.data());
+
+    std::array<float, 4> result3{};
+    rtm::vector_store(vector_dequantize3(data.data(), from, scale), result3.data());
+
+    for (gsl::index c{0}; c < 4; ++c) {
+      const float expected{float_dequantize({.data = data[c],
+                                             .bits_count = 16,
+                                             .range_from = range_from,
+                                             .range_length = range_length})};
+
+      EXPECT_NEAR(result4[c], expected, 1e-5F);
+
+      if (c < 3) {
+        EXPECT_NEAR(result3[c], expected, 1e-5F);
+      }
+    }
+
+    EXPECT_FLOAT_EQ(result3[3], range_from);
+  }
+}
+
+// Benchmark of dequantizing vectors with precomputed scales against scalar dequantization,
+// run with `--gtest_also_run_disabled_tests --gtest_filter=quantization.DISABLED_*`.
+TEST(quantization, DISABLED_benchmark_vectors)
+{
+  using namespace eely;
+  using namespace eely::internal;
+
+  // Same number of values as in a 70 joint clip with 61 keys of translations and rotations
+  constexpr gsl::index values_count{70 * 61 * 8};
+  constexpr int repeats_count{1000};
+
+  std::mt19937 gen(seed);
+  std::uniform_int_distribution<int> distr_data(0, 65535);
+
+  std::vector<uint16_t> data(values_count);
+  for (uint16_t& value : data) {
+    value = static_cast<uint16_t>(distr_data(gen));
+  }
+
+  const float range_from{-1.0F};
+  const float range_length{2.0F};
+  const rtm::vector4f from{rtm::vector_set(range_from)};
+  const rtm::vector4f scale{rtm::vector_set(range_length / 65535.0F)};
+
+  std::vector<float> results(values_count);
+
+  const auto benchmark = [&](const char* name, const auto& dequantize) {
+    const auto begin{std::chrono::steady_clock::now()};
+    for (int r{0}; r < repeats_count; ++r) {
+      dequantize();
+    }
+    const auto end{std::chrono::steady_clock::now()};
+
+    const float value_ns{std::chrono::duration<float, std::nano>(end - begin).count() /
+                         static_cast<float>(values_count * repeats_count)};
+    std::printf("%s: %.3f ns per value\n", name, value_ns);  // NOLINT
+  };
+
+  benchmark("float_dequantize", [&]() {
+    for (gsl::index i{0}; i < values_count; ++i) {
+      results[i] = float_dequantize({.data = data[i],
+                                     .bits_count = 16,
+                                     .range_from = range_from,
+                                     .range_length = range_length});
+    }
+  });
+
+  benchmark("vector_dequantize4", [&]() {
+    for (gsl::index i{0}; i < values_count; i += 4) {
+      rtm::vector_store(vector_dequantize4(&data[i], from, scale), &results[i]);
+    }
+  });
+
+  benchmark("vector_dequantize3", [&]() {
+    for (gsl::index i{0}; i + 4 <= values_count; i += 3) {
+      rtm::vector_store(vector_dequantize3(&data[i], from, scale), &results[i]);
+    }
+  });
+
+  // Keep results alive, so that loops are not optimized out
+  EXPECT_FALSE(std::isnan(std::accumulate(results.begin(), results.end(), 0.0F)));
 }
\ No newline at end of file
@@ -0,0 +1,151 @@
+#include "tests/test_utils.h"
+
+#include <eely_app/component_skeleton.h>
+#include <eely_app/component_transform.h>
+#include <eely_app/matrix4x4.h>
+#include <eely_app/render_skeleton_instances.h>
+
+#include <eely/math/float3.h>
+#include <eely/math/float4.h>
+#include <eely/math/transform.h>
+#include <eely/project/project.h>
+#include <eely/project/project_uncooked.h>
+#include <eely/skeleton/skeleton.h>
+#include <eely/skeleton/skeleton_pose.h>
+#include <eely/skeleton/skeleton_uncooked.h>
+
+#include <bgfx/bgfx.h>
+#include <bgfx/defines.h>
+#include <bgfx/platform.h>
+
+#include <entt/entity/registry.hpp>
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+TEST(render_skeleton_instances, gather)
+{
+  using namespace eely;
+
+  std::array<std::byte, 1024> buffer;
+
+  // Cook test data
+  {
+    project_uncooked project_uncooked(measurement_unit::meters,
+                                      axis_system::y_up_x_right_z_forward);
+
+    auto& skeleton_uncooked =
+        project_uncooked.add_resource<eely::skeleton_uncooked>("test_skeleton");
+    skeleton_uncooked.get_joints() = {
+        {.id = "root", .parent_index = std::nullopt, .rest_pose_transform = transform{}},
+        {.id = "child_0",
+         .parent_index = 0,
+         .rest_pose_transform = transform{float3{-1.0F, 0.0F, 0.0F}}},
+        {.id = "child_1",
+         .parent_index = 0,
+         .rest_pose_transform = transform{float3{1.0F, 0.0F, 0.0F}}}};
+
+    project::cook(project_uncooked, buffer);
+  }
+
+  project project{buffer};
+  const skeleton* skeleton{project.get_resource<eely::skeleton>("test_skeleton")};
+
+  entt::registry registry;
+
+  // Skeleton with its pose rendered
+  const entt::entity rendered{registry.create()};
+  registry.emplace<component_transform>(rendered, transform{float3{0.0F, 0.0F, 5.0F}});
+  auto& rendered_skeleton{
+      registry.emplace<component_skeleton>(rendered, skeleton, skeleton_pose{*skeleton})};
+  rendered_skeleton.pose_render_color = float4{1.0F, 0.0F, 0.0F, 1.0F};
+
+  // Skeleton with only a single joint frame rendered
+  const entt::entity hidden{registry.create()};
+  registry.emplace<component_transform>(hidden, transform{float3{0.0F, 2.0F, 0.0F}});
+  auto& hidden_skeleton{
+      registry.emplace<component_skeleton>(hidden, skeleton, skeleton_pose{*skeleton})};
+  hidden_skeleton.pose_render = false;
+  hidden_skeleton.joint_renders["child_1"] = component_skeleton::joint_render_flags::frame;
+
+  render_skeleton_instances instances;
+
+  // Previous content is replaced
+  instances.bones.resize(10);
+
+  render_skeleton_instances_gather(registry, instances);
+
+  ASSERT_EQ(instances.bones.size(), 2);
+  EXPECT_TRUE(instances.constraint_limits.empty());
+
+  // Bones go from joints to their parents in world space
+  const render_bone_instance& bone_0{instances.bones[0]};
+  expect_float3_near(float3{bone_0.from.x, bone_0.from.y, bone_0.from.z},
+                     float3{-1.0F, 0.0F, 5.0F});
+  expect_float3_near(float3{bone_0.to.x, bone_0.to.y, bone_0.to.z}, float3{0.0F, 0.0F, 5.0F});
+  EXPECT_FLOAT_EQ(bone_0.color.x, 1.0F);
+  EXPECT_FLOAT_EQ(bone_0.color.y, 0.0F);
+
+  const render_bone_instance& bone_1{instances.bones[1]};
+  expect_float3_near(float3{bone_1.from.x, bone_1.from.y, bone_1.from.z},
+                     float3{1.0F, 0.0F, 5.0F});
+
+  // Joint frame is placed at joint's world position
+  ASSERT_EQ(instances.joint_frames.size(), 1);
+  const matrix4x4& frame{instances.joint_frames[0]};
+  expect_float3_near(float3{frame(3, 0), frame(3, 1), frame(3, 2)}, float3{1.0F, 2.0F, 0.0F});
+  EXPECT_NEAR(frame(0, 0), 0.3F, epsilon_default);
+}
+
+TEST(render_skeleton_instances, submit)
+{
+  using namespace eely;
+
+  // Noop renderer does not need a window, and rendering on the calling thread is requested
+  // by calling `bgfx::renderFrame` before initialization
+  bgfx::renderFrame();
+
+  bgfx::Init bgfx_init;
+  bgfx_init.type = bgfx::RendererType::Noop;
+  ASSERT_TRUE(bgfx::init(bgfx_init));
+
+  // Noop renderer reports instancing as supported, so instances are always rendered here
+  const bool instancing_supported{(bgfx::getCaps()->supported & BGFX_CAPS_INSTANCING) != 0};
+  if (!instancing_supported) {
+    bgfx::shutdown();
+  }
+  ASSERT_TRUE(instancing_supported);
+
+  const std::array<float3, 2> vertices{float3{0.0F, 0.0F, 0.0F}, float3{1.0F, 0.0F, 0.0F}};
+  const std::array<uint16_t, 2> indices{0, 1};
+
+  bgfx::VertexLayout bgfx_vlayout;
+  bgfx_vlayout.begin().add(bgfx::Attrib::Position, 3, bgfx::AttribType::Float).end();
+
+  const bgfx::VertexBufferHandle bgfx_vbuffer_handle{
+      bgfx::createVertexBuffer(bgfx::copy(vertices.data(), sizeof(vertices)), bgfx_vlayout)};
+  const bgfx::IndexBufferHandle bgfx_ibuffer_handle{
+      bgfx::createIndexBuffer(bgfx::copy(indices.data(), sizeof(indices)))};
+
+  const auto submit = [&](const std::span<const render_bone_instance> bones) {
+    return render_instances_submit(0, bones, bgfx_vbuffer_handle, bgfx_ibuffer_handle,
+                                   BGFX_INVALID_HANDLE, BGFX_STATE_DEFAULT);
+  };
+
+  // Thousands of instances are rendered with a single draw
+  const std::vector<render_bone_instance> bones(5000);
+  EXPECT_EQ(submit(bones), 5000);
+
+  EXPECT_EQ(submit({}), 0);
+
+  bgfx::frame();
+
+  bgfx::destroy(bgfx_ibuffer_handle);
+  bgfx::destroy(bgfx_vbuffer_handle);
+
+  bgfx::shutdown();
+}
\ No newline at end of file
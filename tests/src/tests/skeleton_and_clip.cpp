@@ -5,7 +5,9 @@
 #include <eely/base/bit_writer.h>
 #include <eely/clip/clip.h>
 #include <eely/clip/clip_player_base.h>
+#include <eely/clip/clip_pose_cache.h>
 #include <eely/clip/clip_uncooked.h>
+#include <eely/clip/clip_utils.h>
 #include <eely/math/quaternion.h>
 #include <eely/project/axis_system.h>
 #include <eely/project/measurement_unit.h>
@@ -17,9 +19,15 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <array>
+#include <cmath>
 #include <cstddef>
+#include <cstdint>
+#include <memory>
 #include <random>
+#include <span>
+#include <stdexcept>
 #include <variant>
 #include <vector>
 
@@ -28,7 +36,7 @@ static void test_skeleton_and_cip_with_scheme(eely::clip_compression_scheme comp
   using namespace eely;
   using namespace eely::internal;
 
-  std::array<std::byte, 1024> buffer;
+  std::array<std::byte, 16384> buffer;
 
   constexpr gsl::index root_index{0};
   constexpr gsl::index child_0_index{1};
@@ -122,14 +130,26 @@ static void test_skeleton_and_cip_with_scheme(eely::clip_compression_scheme comp
   skeleton_pose pose{*skeleton};
 
   // Remember acceptable errors
-  // TODO: calculate and test compressed clips errors
+  // TODO: calculate and test `fixed` and `acl` clips errors
+
+  // Uniform clips quantize every component in its own range,
+  // largest one in this test is a bit less than 13 units
+  const float uniform_quantize_error{calculate_acceptable_quantize_error(
+      {.bits_count = 16, .range_from = 0.0F, .range_length = 13.0F})};
 
-  const auto calculate_joint_translation_acceptible_error = []() { return epsilon_default; };
+  const auto calculate_joint_translation_acceptible_error = [&]() {
+    return compression_scheme == clip_compression_scheme::uniform ? uniform_quantize_error
+                                                                   : epsilon_default;
+  };
 
-  const auto calculate_joint_scale_acceptible_error = []() { return epsilon_default; };
+  const auto calculate_joint_scale_acceptible_error = [&]() {
+    return compression_scheme == clip_compression_scheme::uniform ? uniform_quantize_error
+                                                                   : epsilon_default;
+  };
 
-  const float acceptible_error_quaternion = [/*compression_scheme*/]() {
-    return epsilon_default;
+  // Uniform clips also lerp between resampled frames instead of slerping between keys
+  const float acceptible_error_quaternion = [compression_scheme]() {
+    return compression_scheme == clip_compression_scheme::uniform ? 1e-3F : epsilon_default;
   }();
 
   const float acceptible_error_root_translation{calculate_joint_translation_acceptible_error()};
@@ -266,4 +286,451 @@ static void test_skeleton_and_cip_with_scheme(eely::clip_compression_scheme comp
 TEST(skeleton_and_clip, cook_and_play)
 {
   test_skeleton_and_cip_with_scheme(eely::clip_compression_scheme::none);
+  test_skeleton_and_cip_with_scheme(eely::clip_compression_scheme::uniform);
+}
+
+TEST(skeleton_and_clip, pose_cache)
+{
+  using namespace eely;
+
+  std::array<std::byte, 1024> buffer;
+
+  const float3 translation_0{0.0F, 1.0F, 2.0F};
+  const float3 translation_1{4.0F, -2.0F, 6.0F};
+
+  {
+    project_uncooked project_uncooked(measurement_unit::meters,
+                                      axis_system::y_up_x_right_z_forward);
+
+    auto& skeleton_uncooked =
+        project_uncooked.add_resource<eely::skeleton_uncooked>("test_skeleton");
+    skeleton_uncooked.get_joints() = {
+        {.id = "root", .parent_index = std::nullopt, .rest_pose_transform = transform{}}};
+
+    auto& clip_uncooked = project_uncooked.add_resource<eely::clip_uncooked>("test_clip");
+    clip_uncooked.set_compression_scheme(clip_compression_scheme::none);
+    clip_uncooked.set_target_skeleton_id(skeleton_uncooked.get_id());
+    clip_uncooked.set_tracks({{.joint_id = "root",
+                               .keys = {{0.0F, {.translation = translation_0}},
+                                        {1.0F, {.translation = translation_1}}}}});
+
+    project::cook(project_uncooked, buffer);
+  }
+
+  project project{buffer};
+
+  const skeleton& skeleton{*project.get_resource<eely::skeleton>("test_skeleton")};
+  const clip& clip{*project.get_resource<eely::clip>("test_clip")};
+
+  std::unique_ptr<clip_player_base> player_0{clip.create_player()};
+  std::unique_ptr<clip_player_base> player_1{clip.create_player()};
+
+  skeleton_pose pose_0{skeleton};
+  skeleton_pose pose_1{skeleton};
+
+  clip_pose_cache cache{0.1F};
+
+  // Both times fall into the same bucket, pose is decoded at bucket's time
+
+  cache.play(clip, *player_0, 0.49F, pose_0);
+  cache.play(clip, *player_1, 0.52F, pose_1);
+
+  EXPECT_EQ(cache.get_misses_count(), 1);
+  EXPECT_EQ(cache.get_hits_count(), 1);
+  expect_float3_near(pose_0.get_transform_joint_space(0).translation,
+                     float3_lerp(translation_0, translation_1, 0.5F));
+  expect_float3_near(pose_1.get_transform_joint_space(0).translation,
+                     pose_0.get_transform_joint_space(0).translation);
+
+  // Different bucket
+
+  cache.play(clip, *player_1, 0.7F, pose_1);
+
+  EXPECT_EQ(cache.get_misses_count(), 2);
+  EXPECT_EQ(cache.get_hits_count(), 1);
+  expect_float3_near(pose_1.get_transform_joint_space(0).translation,
+                     float3_lerp(translation_0, translation_1, 0.7F));
+
+  // Cleared cache decodes again
+
+  cache.clear();
+  cache.reset_counters();
+
+  cache.play(clip, *player_0, 0.5F, pose_0);
+
+  EXPECT_EQ(cache.get_misses_count(), 1);
+  EXPECT_EQ(cache.get_hits_count(), 0);
+
+  // Players with different rounding or looping policies don't share poses
+
+  player_1->set_sample_rounding(clip_sample_rounding::floor);
+  cache.play(clip, *player_1, 0.5F, pose_1);
+
+  EXPECT_EQ(cache.get_misses_count(), 2);
+  EXPECT_EQ(cache.get_hits_count(), 0);
+
+  player_1->set_sample_rounding(clip_sample_rounding::none);
+  player_1->set_looping_policy(clip_looping_policy::wrap);
+  cache.play(clip, *player_1, 0.5F, pose_1);
+
+  EXPECT_EQ(cache.get_misses_count(), 3);
+  EXPECT_EQ(cache.get_hits_count(), 0);
+
+  player_1->set_looping_policy(clip_looping_policy::as_cooked);
+  cache.play(clip, *player_1, 0.5F, pose_1);
+
+  EXPECT_EQ(cache.get_misses_count(), 3);
+  EXPECT_EQ(cache.get_hits_count(), 1);
+}
+
+TEST(skeleton_and_clip, acl_database)
+{
+  using namespace eely;
+
+  std::vector<std::byte> buffer(1024 * 1024);
+
+  {
+    project_uncooked project_uncooked(measurement_unit::meters,
+                                      axis_system::y_up_x_right_z_forward);
+
+    auto& skeleton_uncooked =
+        project_uncooked.add_resource<eely::skeleton_uncooked>("test_skeleton");
+    skeleton_uncooked.get_joints() = {
+        {.id = "root", .parent_index = std::nullopt, .rest_pose_transform = transform{}},
+        {.id = "child", .parent_index = 0, .rest_pose_transform = transform{}}};
+
+    clip_uncooked_track track{.joint_id = "child"};
+    for (int i{0}; i <= 120; ++i) {
+      const float time_s{static_cast<float>(i) / 30.0F};
+      track.keys[time_s] = {
+          .translation = float3{std::sin(time_s * 3.0F), std::cos(time_s * 5.0F), time_s},
+          .rotation = quaternion_from_yaw_pitch_roll_intrinsic(std::sin(time_s * 4.0F),
+                                                               std::cos(time_s * 2.0F), time_s)};
+    }
+
+    auto& clip_uncooked = project_uncooked.add_resource<eely::clip_uncooked>("test_clip");
+    clip_uncooked.set_compression_scheme(clip_compression_scheme::acl);
+    clip_uncooked.set_acl_database_settings(
+        clip_acl_database_settings{.medium_tier_proportion = 0.25F, .low_tier_proportion = 0.5F});
+    clip_uncooked.set_target_skeleton_id(skeleton_uncooked.get_id());
+    clip_uncooked.set_tracks({track});
+
+    project::cook(project_uncooked, buffer);
+  }
+
+  project project{buffer};
+
+  const skeleton& skeleton{*project.get_resource<eely::skeleton>("test_skeleton")};
+  const clip& clip{*project.get_resource<eely::clip>("test_clip")};
+
+  const size_t medium_size{clip.get_streaming_tier_size(clip_streaming_tier::medium)};
+  const size_t low_size{clip.get_streaming_tier_size(clip_streaming_tier::low)};
+  EXPECT_GT(medium_size, 0);
+  EXPECT_GT(low_size, 0);
+
+  // Clip is fully streamed in after loading
+
+  EXPECT_TRUE(clip.is_streamed_in(clip_streaming_tier::medium));
+  EXPECT_TRUE(clip.is_streamed_in(clip_streaming_tier::low));
+
+  std::unique_ptr<clip_player_base> player{clip.create_player()};
+  skeleton_pose pose{skeleton};
+
+  const auto play_and_get_translation = [&pose](clip_player_base& player, const float time_s) {
+    player.play(time_s, pose);
+    return pose.get_transform_joint_space(1).translation;
+  };
+
+  static constexpr float time_s{1.7F};
+  const float3 translation_full{play_and_get_translation(*player, time_s)};
+  expect_float3_near(translation_full,
+                     float3{std::sin(time_s * 3.0F), std::cos(time_s * 5.0F), time_s}, 0.01F);
+
+  // Budget only fits the medium tier
+
+  EXPECT_EQ(project.clips_stream(std::array<string_id, 1>{"test_clip"}, medium_size),
+            medium_size);
+  EXPECT_TRUE(clip.is_streamed_in(clip_streaming_tier::medium));
+  EXPECT_FALSE(clip.is_streamed_in(clip_streaming_tier::low));
+
+  // Clips that are not listed are streamed out, but can still be played
+
+  EXPECT_EQ(project.clips_stream({}, medium_size + low_size), 0);
+  EXPECT_FALSE(clip.is_streamed_in(clip_streaming_tier::medium));
+  EXPECT_FALSE(clip.is_streamed_in(clip_streaming_tier::low));
+
+  expect_float3_near(play_and_get_translation(*player, time_s), translation_full, 0.1F);
+
+  // Without a reader tier data was copied when loading and stays resident
+
+  EXPECT_EQ(clip.get_streaming_tier_resident_size(clip_streaming_tier::medium), medium_size);
+  EXPECT_EQ(clip.get_streaming_tier_resident_size(clip_streaming_tier::low), low_size);
+
+  // Streaming back restores full quality
+
+  EXPECT_EQ(project.clips_stream(std::array<string_id, 1>{"test_clip"}, medium_size + low_size),
+            medium_size + low_size);
+  EXPECT_TRUE(clip.is_streamed_in(clip_streaming_tier::medium));
+  EXPECT_TRUE(clip.is_streamed_in(clip_streaming_tier::low));
+
+  expect_float3_near(play_and_get_translation(*player, time_s), translation_full);
+
+  // With a reader tiers are read from cooked data when streamed in and released when streamed out,
+  // only chunk data is read so chunk headers and padding may be skipped
+
+  size_t read_bytes{0};
+  eely::project project_streamed{
+      buffer, [&buffer, &read_bytes](const size_t offset, const std::span<std::byte> out_bytes) {
+        std::copy_n(buffer.begin() + gsl::narrow<std::ptrdiff_t>(offset), out_bytes.size(),
+                    out_bytes.begin());
+        read_bytes += out_bytes.size();
+      }};
+
+  const auto& clip_streamed{*project_streamed.get_resource<eely::clip>("test_clip")};
+  std::unique_ptr<clip_player_base> player_streamed{clip_streamed.create_player()};
+
+  EXPECT_EQ(read_bytes, 0);
+  EXPECT_FALSE(clip_streamed.is_streamed_in(clip_streaming_tier::medium));
+  EXPECT_FALSE(clip_streamed.is_streamed_in(clip_streaming_tier::low));
+  EXPECT_EQ(clip_streamed.get_streaming_tier_resident_size(clip_streaming_tier::medium), 0);
+  EXPECT_EQ(clip_streamed.get_streaming_tier_resident_size(clip_streaming_tier::low), 0);
+
+  EXPECT_EQ(project_streamed.clips_stream(std::array<string_id, 1>{"test_clip"}, medium_size),
+            medium_size);
+  EXPECT_GT(read_bytes, 0);
+  EXPECT_LE(read_bytes, medium_size);
+  const size_t read_bytes_medium{read_bytes};
+  EXPECT_EQ(clip_streamed.get_streaming_tier_resident_size(clip_streaming_tier::medium),
+            medium_size);
+  EXPECT_EQ(clip_streamed.get_streaming_tier_resident_size(clip_streaming_tier::low), 0);
+
+  EXPECT_EQ(project_streamed.clips_stream(std::array<string_id, 1>{"test_clip"},
+                                          medium_size + low_size),
+            medium_size + low_size);
+  EXPECT_GT(read_bytes, read_bytes_medium);
+  EXPECT_LE(read_bytes, medium_size + low_size);
+  EXPECT_EQ(clip_streamed.get_streaming_tier_resident_size(clip_streaming_tier::low), low_size);
+
+  expect_float3_near(play_and_get_translation(*player_streamed, time_s), translation_full);
+
+  EXPECT_EQ(project_streamed.clips_stream({}, medium_size + low_size), 0);
+  EXPECT_EQ(clip_streamed.get_streaming_tier_resident_size(clip_streaming_tier::medium), 0);
+  EXPECT_EQ(clip_streamed.get_streaming_tier_resident_size(clip_streaming_tier::low), 0);
+
+  expect_float3_near(play_and_get_translation(*player_streamed, time_s), translation_full, 0.1F);
+}
+
+TEST(skeleton_and_clip, rounding_and_looping)
+{
+  using namespace eely;
+
+  std::vector<std::byte> buffer(1024 * 1024);
+
+  // Clip with one key per sample, last key doesn't match the first one
+  static constexpr float sample_interval_s{1.0F / 30.0F};
+  const auto translation_at = [](const int sample) {
+    return float3{static_cast<float>(sample), 0.0F, 0.0F};
+  };
+
+  {
+    project_uncooked project_uncooked(measurement_unit::meters,
+                                      axis_system::y_up_x_right_z_forward);
+
+    auto& skeleton_uncooked =
+        project_uncooked.add_resource<eely::skeleton_uncooked>("test_skeleton");
+    skeleton_uncooked.get_joints() = {
+        {.id = "root", .parent_index = std::nullopt, .rest_pose_transform = transform{}}};
+
+    clip_uncooked_track track{.joint_id = "root"};
+    for (int i{0}; i <= 30; ++i) {
+      track.keys[static_cast<float>(i) * sample_interval_s] = {.translation = translation_at(i)};
+    }
+
+    for (const auto& [id, scheme] : {std::pair{"acl", clip_compression_scheme::acl},
+                                     std::pair{"uniform", clip_compression_scheme::uniform}}) {
+      auto& clip_uncooked = project_uncooked.add_resource<eely::clip_uncooked>(id);
+      clip_uncooked.set_compression_scheme(scheme);
+      clip_uncooked.set_target_skeleton_id(skeleton_uncooked.get_id());
+      clip_uncooked.set_tracks({track});
+    }
+
+    // Looped clip, last key matches the first one
+    clip_uncooked_track track_looped{track};
+    track_looped.keys.rbegin()->second = track_looped.keys.begin()->second;
+
+    for (const auto& [id, optimize_loops] :
+         {std::pair{"acl_looped", true}, std::pair{"acl_looped_kept", false}}) {
+      auto& clip_uncooked = project_uncooked.add_resource<eely::clip_uncooked>(id);
+      clip_uncooked.set_compression_scheme(clip_compression_scheme::acl);
+      clip_uncooked.set_acl_optimize_loops(optimize_loops);
+      clip_uncooked.set_target_skeleton_id(skeleton_uncooked.get_id());
+      clip_uncooked.set_tracks({track_looped});
+    }
+
+    project::cook(project_uncooked, buffer);
+  }
+
+  project project{buffer};
+
+  const skeleton& skeleton{*project.get_resource<eely::skeleton>("test_skeleton")};
+  skeleton_pose pose{skeleton};
+
+  for (const char* id : {"acl", "uniform"}) {
+    std::unique_ptr<clip_player_base> player{
+        project.get_resource<eely::clip>(id)->create_player()};
+
+    const auto play = [&player, &pose](const float time_s) {
+      player->play(time_s, pose);
+      return pose.get_transform_joint_space(0).translation;
+    };
+
+    // Time between 10th and 11th samples, closer to 10th
+
+    const float time_s{10.3F * sample_interval_s};
+
+    EXPECT_NEAR(play(time_s).x, 10.3F, 0.01F);
+
+    player->set_sample_rounding(clip_sample_rounding::floor);
+    EXPECT_NEAR(play(time_s).x, 10.0F, 0.01F);
+
+    player->set_sample_rounding(clip_sample_rounding::ceil);
+    EXPECT_NEAR(play(time_s).x, 11.0F, 0.01F);
+
+    player->set_sample_rounding(clip_sample_rounding::nearest);
+    EXPECT_NEAR(play(time_s).x, 10.0F, 0.01F);
+  }
+
+  // Wrapping makes clip longer by one sample and interpolates last sample into the first one
+
+  const clip& clip_acl{*project.get_resource<eely::clip>("acl")};
+  std::unique_ptr<clip_player_base> player{clip_acl.create_player()};
+  const float duration_s{player->get_duration_s()};
+
+  player->set_looping_policy(clip_looping_policy::wrap);
+  EXPECT_NEAR(player->get_duration_s(), duration_s + sample_interval_s, 0.001F);
+
+  player->play(duration_s + sample_interval_s * 0.5F, pose);
+  EXPECT_NEAR(pose.get_transform_joint_space(0).translation.x, 15.0F, 0.01F);
+
+  // Cache plays at the same time, it is not clamped to clip's cooked duration
+
+  clip_pose_cache cache{sample_interval_s * 0.5F};
+  cache.play(clip_acl, *player, duration_s + sample_interval_s * 0.5F, pose);
+  EXPECT_NEAR(pose.get_transform_joint_space(0).translation.x, 15.0F, 0.01F);
+
+  // Matching last sample is dropped only if loops are optimized,
+  // then wrapping doesn't add another sample interval
+
+  for (const auto& [id, duration_wrapped_s] :
+       {std::pair{"acl_looped", duration_s},
+        std::pair{"acl_looped_kept", duration_s + sample_interval_s}}) {
+    std::unique_ptr<clip_player_base> player_looped{
+        project.get_resource<eely::clip>(id)->create_player()};
+    EXPECT_NEAR(player_looped->get_duration_s(), duration_s, 0.001F);
+
+    player_looped->set_looping_policy(clip_looping_policy::wrap);
+    EXPECT_NEAR(player_looped->get_duration_s(), duration_wrapped_s, 0.001F);
+  }
+}
+
+TEST(skeleton_and_clip, columnar_sampling)
+{
+  using namespace eely;
+  using namespace eely::internal;
+
+  // Components are keyed at different times, some keys have no components at all
+
+  clip_uncooked_track track{.joint_id = "root"};
+  track.keys[0.5F] = {.translation = float3{1.0F, 0.0F, 0.0F}};
+  track.keys[1.0F] = {.rotation = quaternion::identity};
+  track.keys[1.5F] = {.translation = float3{3.0F, 0.0F, 0.0F}, .scale = float3{2.0F, 2.0F, 2.0F}};
+  track.keys[2.0F] = {};
+  track.keys[2.5F] = {.translation = float3{5.0F, 0.0F, 0.0F}};
+
+  const clip_track_columnar columnar{clip_track_columnar_from_uncooked(track)};
+  EXPECT_EQ(columnar.translations.times, (std::vector<float>{0.5F, 1.5F, 2.5F}));
+  EXPECT_EQ(columnar.rotations.times, (std::vector<float>{1.0F}));
+  EXPECT_EQ(columnar.scales.times, (std::vector<float>{1.5F}));
+
+  gsl::index cursor{0};
+  const auto sample_translation = [&columnar, &cursor](const float time_s) {
+    return clip_sample_component_keys(columnar.translations, float3::zeroes, time_s, cursor).x;
+  };
+
+  // Default value before the first key, interpolated in between, last value after the last key
+  EXPECT_FLOAT_EQ(sample_translation(0.0F), 0.0F);
+  EXPECT_FLOAT_EQ(sample_translation(0.5F), 1.0F);
+  EXPECT_FLOAT_EQ(sample_translation(1.0F), 2.0F);
+  EXPECT_FLOAT_EQ(sample_translation(2.0F), 4.0F);
+  EXPECT_FLOAT_EQ(sample_translation(3.0F), 5.0F);
+
+  // Going back in time restarts the sweep
+  EXPECT_FLOAT_EQ(sample_translation(0.75F), 1.5F);
+
+  std::vector<transform> samples;
+  clip_sample_track(track, transform{}, {.time_from_s = 0.0F, .time_to_s = 3.0F, .rate = 2},
+                    samples);
+  ASSERT_EQ(samples.size(), 7U);
+  expect_float3_near(samples[0].scale, float3::ones);
+  expect_float3_near(samples[3].scale, float3{2.0F, 2.0F, 2.0F});
+  expect_float3_near(samples[6].translation, float3{5.0F, 0.0F, 0.0F});
+}
+
+TEST(skeleton_and_clip, cook_size)
+{
+  using namespace eely;
+
+  project_uncooked project_uncooked(measurement_unit::meters, axis_system::y_up_x_right_z_forward);
+
+  auto& skeleton_uncooked = project_uncooked.add_resource<eely::skeleton_uncooked>("test_skeleton");
+  skeleton_uncooked.get_joints() = {
+      {.id = "root", .parent_index = std::nullopt, .rest_pose_transform = transform{}}};
+
+  clip_uncooked_track track{.joint_id = "root"};
+  for (int i{0}; i <= 30; ++i) {
+    track.keys[static_cast<float>(i) / 30.0F] = {
+        .translation = float3{static_cast<float>(i), 0.0F, 0.0F}};
+  }
+
+  auto& clip_uncooked = project_uncooked.add_resource<eely::clip_uncooked>("test_clip");
+  clip_uncooked.set_compression_scheme(clip_compression_scheme::fixed);
+  clip_uncooked.set_target_skeleton_id(skeleton_uncooked.get_id());
+  clip_uncooked.set_tracks({track});
+
+  // Measured size matches cooked one exactly, and nothing less is enough
+
+  const size_t size{project::cook_size(project_uncooked)};
+
+  std::vector<std::byte> buffer{project::cook(project_uncooked)};
+  EXPECT_EQ(buffer.size(), size);
+
+  std::vector<std::byte> buffer_exact(size);
+  EXPECT_NO_THROW(project::cook(project_uncooked, buffer_exact));
+  EXPECT_EQ(buffer_exact, buffer);
+
+  std::vector<std::byte> buffer_small(size - 1);
+  EXPECT_ANY_THROW(project::cook(project_uncooked, buffer_small));
+
+  project project{buffer};
+  EXPECT_NE(project.get_resource<eely::clip>("test_clip"), nullptr);
+}
+
+TEST(skeleton_and_clip, cooked_version)
+{
+  using namespace eely;
+  using namespace eely::internal;
+
+  project_uncooked project_uncooked(measurement_unit::meters, axis_system::y_up_x_right_z_forward);
+
+  auto& skeleton_uncooked = project_uncooked.add_resource<eely::skeleton_uncooked>("test_skeleton");
+  skeleton_uncooked.get_joints() = {
+      {.id = "root", .parent_index = std::nullopt, .rest_pose_transform = transform{}}};
+
+  std::vector<std::byte> buffer{project::cook(project_uncooked)};
+  EXPECT_NO_THROW(eely::project{buffer});
+
+  // Projects cooked with another format version are rejected instead of misread
+  bit_writer writer{buffer};
+  writer.write({.value = project_cooked_version + 1, .size_bits = 16});
+  EXPECT_THROW(eely::project{buffer}, std::runtime_error);
 }
\ No newline at end of file
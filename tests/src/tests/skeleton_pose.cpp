@@ -1,13 +1,20 @@
 #include "tests/test_utils.h"
 
 #include "eely/math/quaternion.h"
+#include <eely/math/quantization.h>
 #include <eely/project/project.h>
 #include <eely/project/project_uncooked.h>
 #include <eely/skeleton/skeleton.h>
 #include <eely/skeleton/skeleton_pose.h>
+#include <eely/skeleton_mask/skeleton_mask.h>
+#include <eely/skeleton_mask/skeleton_mask_uncooked.h>
 
 #include <gtest/gtest.h>
 
+#include <random>
+#include <span>
+#include <string>
+
 TEST(skeleton_pose, skeleton_pose)
 {
   using namespace eely;
@@ -104,4 +111,417 @@ TEST(skeleton_pose, skeleton_pose)
                         transform{float3{0.0F, 0.0F, 2.0F}, root_transform.rotation});
   expect_transform_near(pose.get_transform_object_space(child_1_index),
                         transform{float3{0.0F, 0.0F, 0.0F}, root_transform.rotation});
+}
+
+TEST(skeleton_pose, blend_and_add_masked)
+{
+  using namespace eely;
+  using namespace eely::internal;
+
+  std::array<std::byte, 1024> buffer;
+
+  constexpr gsl::index root_index{0};
+  constexpr gsl::index child_index{1};
+
+  {
+    project_uncooked project_uncooked(measurement_unit::meters,
+                                      axis_system::y_up_x_right_z_forward);
+
+    auto& skeleton_uncooked =
+        project_uncooked.add_resource<eely::skeleton_uncooked>("test_skeleton");
+    skeleton_uncooked.get_joints() = {
+        {.id = "root", .parent_index = std::nullopt, .rest_pose_transform = transform{}},
+        {.id = "child", .parent_index = 0, .rest_pose_transform = transform{}}};
+
+    auto& mask_uncooked =
+        project_uncooked.add_resource<eely::skeleton_mask_uncooked>("test_skeleton_mask");
+    mask_uncooked.set_target_skeleton_id("test_skeleton");
+    mask_uncooked.get_weights()["root"] = {.translation = 0.0F, .rotation = 0.0F, .scale = 0.0F};
+    mask_uncooked.get_weights()["child"] = {.translation = 1.0F, .rotation = 1.0F, .scale = 1.0F};
+
+    project::cook(project_uncooked, buffer);
+  }
+
+  project project{buffer};
+
+  const skeleton* skeleton{project.get_resource<eely::skeleton>("test_skeleton")};
+  const skeleton_mask* mask{project.get_resource<eely::skeleton_mask>("test_skeleton_mask")};
+
+  // Mask remembers which skeleton it was cooked for
+  EXPECT_EQ(mask->get_target_skeleton_id(), "test_skeleton");
+  EXPECT_EQ(mask->get_joints_count(), skeleton->get_joints_count());
+
+  const transform layer_transform{float3{2.0F, 0.0F, 0.0F},
+                                  quaternion_from_axis_angle(0.0F, 1.0F, 0.0F, pi / 2.0F)};
+
+  skeleton_pose base{*skeleton};
+  skeleton_pose layer{*skeleton};
+  layer.set_transform_joint_space(root_index, layer_transform);
+  layer.set_transform_joint_space(child_index, layer_transform);
+
+  skeleton_pose result{*skeleton};
+
+  // Masked out root keeps base transform, child is fully replaced
+  skeleton_pose_blend_masked(base, layer, *mask, 1.0F, result);
+  expect_transform_near(result.get_transform_joint_space(root_index), transform{});
+  expect_transform_near(result.get_transform_joint_space(child_index), layer_transform);
+
+  skeleton_pose_blend_masked(base, layer, *mask, 0.5F, result);
+  expect_transform_near(
+      result.get_transform_joint_space(child_index),
+      transform{float3{1.0F, 0.0F, 0.0F}, quaternion_from_axis_angle(0.0F, 1.0F, 0.0F, pi / 4.0F)});
+
+  // Additive layer on top of identity base is the layer itself
+  skeleton_pose_add_masked(base, layer, *mask, 1.0F, result);
+  expect_transform_near(result.get_transform_joint_space(root_index), transform{});
+  expect_transform_near(result.get_transform_joint_space(child_index), layer_transform);
+}
+
+TEST(skeleton_pose, nlerp)
+{
+  using namespace eely;
+  using namespace eely::internal;
+
+  std::array<std::byte, 1024> buffer;
+
+  constexpr gsl::index root_index{0};
+
+  {
+    project_uncooked project_uncooked(measurement_unit::meters,
+                                      axis_system::y_up_x_right_z_forward);
+
+    auto& skeleton_uncooked =
+        project_uncooked.add_resource<eely::skeleton_uncooked>("test_skeleton");
+    skeleton_uncooked.get_joints() = {
+        {.id = "root", .parent_index = std::nullopt, .rest_pose_transform = transform{}}};
+
+    project::cook(project_uncooked, buffer);
+  }
+
+  project project{buffer};
+
+  const skeleton* skeleton{project.get_resource<eely::skeleton>("test_skeleton")};
+
+  const transform layer_transform{float3{2.0F, 0.0F, 0.0F},
+                                  quaternion_from_axis_angle(0.0F, 1.0F, 0.0F, pi / 2.0F)};
+
+  skeleton_pose base{*skeleton};
+  skeleton_pose layer{*skeleton};
+  layer.set_transform_joint_space(root_index, layer_transform);
+
+  skeleton_pose result{*skeleton};
+
+  skeleton_pose_nlerp(base, layer, 0.5F, result);
+  expect_transform_near(
+      result.get_transform_joint_space(root_index),
+      transform{float3{1.0F, 0.0F, 0.0F}, quaternion_from_axis_angle(0.0F, 1.0F, 0.0F, pi / 4.0F)});
+
+  // Normalized lerp can also extrapolate past the second pose
+  skeleton_pose_nlerp(base, layer, 2.0F, result);
+  EXPECT_TRUE(float_near(result.get_transform_joint_space(root_index).translation.x, 4.0F));
+}
+
+TEST(skeleton_pose, skinning_palette)
+{
+  using namespace eely;
+  using namespace eely::internal;
+
+  std::array<std::byte, 1024> buffer;
+
+  constexpr gsl::index root_index{0};
+  constexpr gsl::index child_index{1};
+
+  {
+    project_uncooked project_uncooked(measurement_unit::meters,
+                                      axis_system::y_up_x_right_z_forward);
+
+    auto& skeleton_uncooked =
+        project_uncooked.add_resource<eely::skeleton_uncooked>("test_skeleton");
+    skeleton_uncooked.get_joints() = {
+        {.id = "root",
+         .parent_index = std::nullopt,
+         .rest_pose_transform = transform{float3{0.0F, 1.0F, 0.0F}}},
+        {.id = "child",
+         .parent_index = 0,
+         .rest_pose_transform = transform{float3{1.0F, 0.0F, 0.0F}}}};
+
+    project::cook(project_uncooked, buffer);
+  }
+
+  project project{buffer};
+
+  const skeleton* skeleton{project.get_resource<eely::skeleton>("test_skeleton")};
+  expect_transform_near(skeleton->get_inverse_bind_transforms()[root_index],
+                        transform{float3{0.0F, -1.0F, 0.0F}});
+  expect_transform_near(skeleton->get_inverse_bind_transforms()[child_index],
+                        transform{float3{-1.0F, -1.0F, 0.0F}});
+
+  skeleton_pose pose{*skeleton};
+
+  // Rest pose has identity palette
+
+  std::array<float, 24> matrices;
+  pose.write_skinning_palette(skinning_palette_format::matrix3x4,
+                              std::as_writable_bytes(std::span{matrices}));
+  for (gsl::index joint{0}; joint < 2; ++joint) {
+    for (gsl::index row{0}; row < 3; ++row) {
+      for (gsl::index column{0}; column < 4; ++column) {
+        EXPECT_FLOAT_EQ(matrices[joint * 12 + row * 4 + column], row == column ? 1.0F : 0.0F);
+      }
+    }
+  }
+
+  // Skinning vertex from bind space should give the same result as using posed joints
+
+  const transform root_transform{float3{0.0F, 2.0F, 1.0F},
+                                 quaternion_from_axis_angle(0.0F, 1.0F, 0.0F, pi / 2.0F)};
+  pose.set_transform_joint_space(root_index, root_transform);
+
+  const float3 vertex_bind_space{2.0F, 1.0F, 0.0F};
+  const float3 vertex_expected{transform_location(pose.get_transform_object_space(child_index),
+                                                  float3{1.0F, 0.0F, 0.0F})};
+
+  // Change pose again, so that palette pass has to recalculate object space transforms
+  pose.set_transform_joint_space(root_index, root_transform);
+  pose.write_skinning_palette(skinning_palette_format::matrix3x4,
+                              std::as_writable_bytes(std::span{matrices}));
+
+  const float* child_matrix{&matrices[12]};
+  const float3 vertex_matrix{
+      child_matrix[0] * vertex_bind_space.x + child_matrix[1] * vertex_bind_space.y +
+          child_matrix[2] * vertex_bind_space.z + child_matrix[3],
+      child_matrix[4] * vertex_bind_space.x + child_matrix[5] * vertex_bind_space.y +
+          child_matrix[6] * vertex_bind_space.z + child_matrix[7],
+      child_matrix[8] * vertex_bind_space.x + child_matrix[9] * vertex_bind_space.y +
+          child_matrix[10] * vertex_bind_space.z + child_matrix[11]};
+  expect_float3_near(vertex_matrix, vertex_expected);
+
+  // Palette pass also recalculates object space transforms
+
+  expect_transform_near(pose.get_transform_object_space(root_index), root_transform);
+
+  std::array<uint16_t, 24> matrices_half;
+  pose.write_skinning_palette(skinning_palette_format::matrix3x4_half,
+                              std::as_writable_bytes(std::span{matrices_half}));
+  for (gsl::index i{0}; i < std::ssize(matrices); ++i) {
+    EXPECT_NEAR(half_to_float(matrices_half[i]), matrices[i], 1e-3F);
+  }
+
+  std::array<float, 16> dual_quaternions;
+  pose.write_skinning_palette(skinning_palette_format::dual_quaternion,
+                              std::as_writable_bytes(std::span{dual_quaternions}));
+
+  const quaternion real{dual_quaternions[8], dual_quaternions[9], dual_quaternions[10],
+                        dual_quaternions[11]};
+  const quaternion dual{dual_quaternions[12], dual_quaternions[13], dual_quaternions[14],
+                        dual_quaternions[15]};
+  const quaternion translation{dual * quaternion_inverse(real)};
+  const float3 vertex_dual_quaternion{
+      vector_rotate(vertex_bind_space, real) +
+      float3{translation.x * 2.0F, translation.y * 2.0F, translation.z * 2.0F}};
+  expect_float3_near(vertex_dual_quaternion, vertex_expected);
+
+  std::array<uint16_t, 16> dual_quaternions_half;
+  pose.write_skinning_palette(skinning_palette_format::dual_quaternion_half,
+                              std::as_writable_bytes(std::span{dual_quaternions_half}));
+  for (gsl::index i{0}; i < std::ssize(dual_quaternions); ++i) {
+    EXPECT_NEAR(half_to_float(dual_quaternions_half[i]), dual_quaternions[i], 1e-3F);
+  }
+}
+
+TEST(skeleton_pose, constraint_force)
+{
+  using namespace eely;
+  using namespace eely::internal;
+
+  std::array<std::byte, 2048> buffer;
+
+  {
+    project_uncooked project_uncooked(measurement_unit::meters,
+                                      axis_system::y_up_x_right_z_forward);
+
+    const skeleton_uncooked::constraint constraint{.limit_twist_rad = pi / 8.0F,
+                                                   .limit_swing_y_rad = pi / 4.0F,
+                                                   .limit_swing_z_rad = pi / 3.0F};
+
+    auto& skeleton_uncooked =
+        project_uncooked.add_resource<eely::skeleton_uncooked>("test_skeleton");
+    skeleton_uncooked.get_joints() = {
+        {.id = "root", .parent_index = std::nullopt, .rest_pose_transform = transform{}},
+        {.id = "upper",
+         .parent_index = 0,
+         .rest_pose_transform = transform{float3{1.0F, 0.0F, 0.0F}},
+         .constraint = constraint},
+        {.id = "unconstrained",
+         .parent_index = 1,
+         .rest_pose_transform = transform{float3{1.0F, 0.0F, 0.0F}}},
+        {.id = "lower",
+         .parent_index = 2,
+         .rest_pose_transform = transform{float3{1.0F, 0.0F, 0.0F}},
+         .constraint = constraint},
+        {.id = "end",
+         .parent_index = 3,
+         .rest_pose_transform = transform{float3{1.0F, 0.0F, 0.0F}}}};
+
+    project::cook(project_uncooked, buffer);
+  }
+
+  project project{buffer};
+
+  const skeleton* skeleton{project.get_resource<eely::skeleton>("test_skeleton")};
+  EXPECT_EQ(skeleton->get_constrained_joint_indices(), (std::vector<gsl::index>{1, 3}));
+
+  skeleton_pose pose_batched{*skeleton};
+  pose_batched.set_transform_joint_space(
+      0, transform{float3{0.0F, 1.0F, 0.0F}, quaternion_from_axis_angle(0.0F, 0.0F, 1.0F, 0.3F)});
+  for (gsl::index i{1}; i < 4; ++i) {
+    pose_batched.set_transform_joint_space(
+        i, transform{float3{1.0F, 0.0F, 0.0F},
+                     quaternion_from_yaw_pitch_roll_intrinsic(pi / 2.0F, pi / 3.0F, pi / 2.0F)});
+  }
+
+  skeleton_pose pose_per_joint{pose_batched};
+
+  std::vector<quaternion> rotations_object_space_scratch;
+  EXPECT_TRUE(constraint_force(pose_batched, rotations_object_space_scratch));
+
+  bool constrained_per_joint{false};
+  for (gsl::index i{0}; i < pose_per_joint.get_joints_count(); ++i) {
+    constrained_per_joint |= constraint_force(pose_per_joint, i);
+  }
+  EXPECT_TRUE(constrained_per_joint);
+
+  for (gsl::index i{0}; i < pose_batched.get_joints_count(); ++i) {
+    expect_transform_near(pose_batched.get_transform_joint_space(i),
+                          pose_per_joint.get_transform_joint_space(i), 1e-4F);
+    expect_transform_near(pose_batched.get_transform_object_space(i),
+                          pose_per_joint.get_transform_object_space(i), 1e-4F);
+  }
+
+  // Forcing constraints again barely changes already constrained pose
+  skeleton_pose pose_constrained{pose_batched};
+  constraint_force(pose_batched, rotations_object_space_scratch);
+  for (gsl::index i{0}; i < pose_batched.get_joints_count(); ++i) {
+    expect_transform_near(pose_batched.get_transform_joint_space(i),
+                          pose_constrained.get_transform_joint_space(i), 1e-3F);
+  }
+}
+
+namespace eely {
+// Scalar reference math, independent of `EELY_MATH_RTM`
+static quaternion scalar_quaternion_mul(const quaternion& q0, const quaternion& q1)
+{
+  return quaternion{q0.w * q1.x + q1.w * q0.x + q0.y * q1.z - q0.z * q1.y,
+                    q0.w * q1.y + q1.w * q0.y + q0.z * q1.x - q0.x * q1.z,
+                    q0.w * q1.z + q1.w * q0.z + q0.x * q1.y - q0.y * q1.x,
+                    q0.w * q1.w - q0.x * q1.x - q0.y * q1.y - q0.z * q1.z};
+}
+
+static transform scalar_transform_mul(const transform& t0, const transform& t1)
+{
+  const float3 scaled{t1.translation * t0.scale};
+  const quaternion rotated{scalar_quaternion_mul(
+      scalar_quaternion_mul(t0.rotation, quaternion{scaled.x, scaled.y, scaled.z, 0.0F}),
+      quaternion_inverse(t0.rotation))};
+
+  return transform{float3{rotated.x, rotated.y, rotated.z} + t0.translation,
+                   scalar_quaternion_mul(t0.rotation, t1.rotation), t0.scale * t1.scale};
+}
+}  // namespace eely
+
+TEST(skeleton_pose, scalar_reference)
+{
+  using namespace eely;
+
+  std::array<std::byte, 2048> buffer;
+
+  // Chains with branches, so that parents are not always previous joints
+  const std::vector<std::optional<gsl::index>> parent_indices{std::nullopt, 0, 1, 2, 1, 4, 0, 6};
+  const gsl::index joints_count{std::ssize(parent_indices)};
+
+  {
+    project_uncooked project_uncooked(measurement_unit::meters,
+                                      axis_system::y_up_x_right_z_forward);
+
+    auto& skeleton_uncooked =
+        project_uncooked.add_resource<eely::skeleton_uncooked>("test_skeleton");
+    for (gsl::index i{0}; i < joints_count; ++i) {
+      skeleton_uncooked.get_joints().push_back({.id = "joint_" + std::to_string(i),
+                                                .parent_index = parent_indices[i],
+                                                .rest_pose_transform = transform{}});
+    }
+
+    project::cook(project_uncooked, buffer);
+  }
+
+  project project{buffer};
+
+  const skeleton* skeleton{project.get_resource<eely::skeleton>("test_skeleton")};
+
+  std::mt19937 random_generator{seed};
+  std::uniform_real_distribution<float> distribution{-1.0F, 1.0F};
+  std::uniform_real_distribution<float> scale_distribution{0.5F, 1.5F};
+
+  const auto random_transform = [&]() {
+    const float3 translation{distribution(random_generator), distribution(random_generator),
+                             distribution(random_generator)};
+    const quaternion rotation{quaternion_from_yaw_pitch_roll_intrinsic(
+        pi * distribution(random_generator), pi * distribution(random_generator),
+        pi * distribution(random_generator))};
+    const float3 scale{scale_distribution(random_generator), scale_distribution(random_generator),
+                       scale_distribution(random_generator)};
+    return transform{translation, rotation, scale};
+  };
+
+  skeleton_pose p0{*skeleton};
+  skeleton_pose p1{*skeleton};
+  for (gsl::index i{0}; i < joints_count; ++i) {
+    p0.set_transform_joint_space(i, random_transform());
+    p1.set_transform_joint_space(i, random_transform());
+  }
+
+  constexpr float epsilon{1e-4F};
+
+  // Object space
+  std::vector<transform> object_space(joints_count);
+  for (gsl::index i{0}; i < joints_count; ++i) {
+    const transform& joint_space{p0.get_transform_joint_space(i)};
+    const std::optional<gsl::index>& parent_index{parent_indices[i]};
+    object_space[i] = parent_index.has_value()
+                          ? scalar_transform_mul(object_space[parent_index.value()], joint_space)
+                          : joint_space;
+    expect_transform_near(p0.get_transform_object_space(i), object_space[i], epsilon);
+  }
+
+  skeleton_pose result{*skeleton};
+
+  // Blend
+  for (const float weight : {0.0F, 0.3F, 1.0F}) {
+    skeleton_pose_blend(p0, p1, weight, result);
+    for (gsl::index i{0}; i < joints_count; ++i) {
+      const transform& t0{p0.get_transform_joint_space(i)};
+      const transform& t1{p1.get_transform_joint_space(i)};
+      expect_transform_near(result.get_transform_joint_space(i),
+                            transform{float3_lerp(t0.translation, t1.translation, weight),
+                                      quaternion_slerp(t0.rotation, t1.rotation, weight),
+                                      float3_lerp(t0.scale, t1.scale, weight)},
+                            epsilon);
+    }
+  }
+
+  // Blending a pose with itself keeps it as is
+  skeleton_pose_blend(p0, p0, 0.5F, result);
+  for (gsl::index i{0}; i < joints_count; ++i) {
+    expect_transform_near(result.get_transform_joint_space(i), p0.get_transform_joint_space(i),
+                          epsilon);
+  }
+
+  // Add
+  skeleton_pose_add(p0, p1, result);
+  for (gsl::index i{0}; i < joints_count; ++i) {
+    expect_transform_near(result.get_transform_joint_space(i),
+                          scalar_transform_mul(p0.get_transform_joint_space(i),
+                                               p1.get_transform_joint_space(i)),
+                          epsilon);
+  }
 }
\ No newline at end of file